@@ -0,0 +1,88 @@
+#pragma once
+
+/// @file userver/cache/byte_size.hpp
+/// @brief @copybrief cache::EstimateByteSize
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace impl {
+
+template <typename T>
+using GetOwnedByteSizeResult = decltype(GetOwnedByteSize(std::declval<const T&>()));
+
+// Heap memory of the nodes of the node-based containers, besides the element
+inline constexpr std::size_t kContainerNodeOverhead = 2 * sizeof(void*);
+
+template <typename T>
+std::size_t OwnedByteSize(const T& value);
+
+template <typename Range>
+std::size_t OwnedByteSizeOfElements(const Range& range) {
+    using Element = meta::RangeValueType<Range>;
+    if constexpr (std::is_trivially_copyable_v<Element>) {
+        return 0;
+    } else {
+        std::size_t result = 0;
+        for (const auto& element : range) result += OwnedByteSize(element);
+        return result;
+    }
+}
+
+template <typename T>
+std::size_t OwnedByteSize(const T& value) {
+    if constexpr (meta::kIsDetected<GetOwnedByteSizeResult, T>) {
+        return GetOwnedByteSize(value);
+    } else if constexpr (meta::kIsInstantiationOf<std::basic_string, T>) {
+        const auto* data = reinterpret_cast<const char*>(value.data());
+        const auto* self = reinterpret_cast<const char*>(&value);
+        // Short strings are stored inside the object
+        const bool is_inline = data >= self && data < self + sizeof(T);
+        return is_inline ? 0 : (value.capacity() + 1) * sizeof(typename T::value_type);
+    } else if constexpr (meta::kIsInstantiationOf<std::pair, T>) {
+        return OwnedByteSize(value.first) + OwnedByteSize(value.second);
+    } else if constexpr (meta::kIsOptional<T>) {
+        return value ? OwnedByteSize(*value) : 0;
+    } else if constexpr (meta::kIsInstantiationOf<std::unique_ptr, T> || meta::kIsInstantiationOf<std::shared_ptr, T>) {
+        return value ? sizeof(*value) + OwnedByteSize(*value) : 0;
+    } else if constexpr (meta::kIsFixedSizeContainer<T>) {
+        return OwnedByteSizeOfElements(value);
+    } else if constexpr (meta::kIsVector<T>) {
+        return value.capacity() * sizeof(typename T::value_type) + OwnedByteSizeOfElements(value);
+    } else if constexpr (meta::kIsRange<T> && meta::kIsSizable<T> && !meta::kIsRecursiveRange<T>) {
+        return value.size() * (sizeof(meta::RangeValueType<T>) + kContainerNodeOverhead) +
+               OwnedByteSizeOfElements(value);
+    } else {
+        return 0;
+    }
+}
+
+}  // namespace impl
+
+/// @brief Approximate memory footprint of a value, used by the byte-bounded
+/// LRU caches, see cache::LruCacheComponent.
+///
+/// Accounts the object itself and the memory it owns: the buffers of strings
+/// and vectors, the nodes of other containers, the contents of std::optional
+/// and the pointees of smart pointers (the shared ones are accounted for each
+/// owner). The memory of other types is not visible, define
+/// `std::size_t GetOwnedByteSize(const T&)` in the namespace of `T` that
+/// returns the size of the memory owned by the object outside of `sizeof(T)`.
+template <typename T>
+std::size_t EstimateByteSize(const T& value) {
+    return sizeof(T) + impl::OwnedByteSize(value);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include <fmt/format.h>
@@ -195,6 +196,20 @@ protected:
     template <typename... Args>
     void Emplace(Args&&... args);
 
+    /// @brief Sets a copy of the current value of cache, modified by
+    /// `apply_delta(T&)`. A default constructed T is modified if the cache is
+    /// empty.
+    ///
+    /// Copying a large T on every incremental update is expensive, use a T
+    /// that shares the unchanged data between copies, e.g.
+    /// cache::SharedChunkedMap, for the update to take the time proportional
+    /// to the size of the delta.
+    ///
+    /// @warning Do not forget to update cache::UpdateStatisticsScope, otherwise
+    /// the behavior is undefined.
+    template <typename Func>
+    void ApplyDelta(Func&& apply_delta);
+
     /// Clears the content of the cache by string a default constructed T.
     void Clear();
 
@@ -307,6 +322,17 @@ void CachingComponentBase<T>::Emplace(Args&&... args) {
     Set(std::make_unique<T>(std::forward<Args>(args)...));
 }
 
+template <typename T>
+template <typename Func>
+void CachingComponentBase<T>::ApplyDelta(Func&& apply_delta) {
+    static_assert(std::is_copy_constructible_v<T>, "ApplyDelta requires a copyable cache value");
+
+    const auto old_value = cache_.ReadCopy();
+    auto new_value = old_value ? std::make_unique<T>(*old_value) : std::make_unique<T>();
+    std::forward<Func>(apply_delta)(*new_value);
+    Set(std::move(new_value));
+}
+
 template <typename T>
 void CachingComponentBase<T>::Clear() {
     cache_.Assign(std::make_unique<const T>());
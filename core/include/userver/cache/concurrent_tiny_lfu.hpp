@@ -0,0 +1,569 @@
+#pragma once
+
+/// @file userver/cache/concurrent_tiny_lfu.hpp
+/// @brief @copybrief cache::ConcurrentTinyLfu
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <userver/cache/impl/epoch_reclamation.hpp>
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/dump/dumper.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+/// @brief Sharded cache with lock-free reads and the W-TinyLFU eviction
+/// policy, a drop-in replacement for cache::NWayLRU for the read-heavy loads.
+///
+/// Reads do not take any locks and do not write to the shared memory for the
+/// hot keys: an access sets a CLOCK reference bit of the entry and bumps the
+/// approximate frequency of the key in a count-min sketch, both writes are
+/// skipped when the bit is already set or the counter is saturated. Writes
+/// take the mutex of the shard.
+///
+/// New entries go to a small FIFO window (1% of the shard). An entry that
+/// leaves the window is admitted into the main CLOCK area only if its key was
+/// accessed more often than the key of the entry that would be evicted for
+/// it, so the one-off keys do not wash the popular ones out of the cache.
+///
+/// The removed entries are freed once the concurrent readers are gone, see
+/// cache::impl::EpochGuard. Copying of `U` must not switch the coroutine.
+template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class ConcurrentTinyLfu final {
+public:
+    /// For the description of `ways` and `way_size`,
+    /// see the cache::NWayLRU::NWayLRU constructor.
+    ConcurrentTinyLfu(std::size_t ways, std::size_t way_size, const Hash& hash = Hash(), const Equal& equal = Equal());
+
+    ConcurrentTinyLfu(ConcurrentTinyLfu&&) = delete;
+    ConcurrentTinyLfu& operator=(ConcurrentTinyLfu&&) = delete;
+    ~ConcurrentTinyLfu();
+
+    void Put(const T& key, U value);
+
+    template <typename Validator>
+    std::optional<U> Get(const T& key, Validator validator);
+
+    std::optional<U> Get(const T& key) {
+        return Get(key, [](const U&) { return true; });
+    }
+
+    U GetOr(const T& key, const U& default_value);
+
+    void Invalidate();
+
+    void InvalidateByKey(const T& key);
+
+    /// Iterates over all items. May be slow for big caches.
+    template <typename Function>
+    void VisitAll(Function func) const;
+
+    std::size_t GetSize() const;
+
+    /// For the description of `way_size`,
+    /// see the cache::NWayLRU::NWayLRU constructor.
+    void UpdateWaySize(std::size_t way_size);
+
+    /// Same format as cache::NWayLRU::Write
+    void Write(dump::Writer& writer) const;
+    void Read(dump::Reader& reader);
+
+    /// The dump::Dumper will be notified of any cache updates. This method is not
+    /// thread-safe.
+    void SetDumper(std::shared_ptr<dump::Dumper> dumper);
+
+private:
+    struct Node final {
+        Node(const T& key, U&& value, std::uint64_t hash) : key(key), value(std::move(value)), hash(hash) {}
+
+        const T key;
+        const U value;
+        const std::uint64_t hash;
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> referenced{false};
+
+        // Guarded by the mutex of the shard
+        Node* ring_prev{nullptr};
+        Node* ring_next{nullptr};
+        bool in_window{true};
+    };
+
+    // Intrusive list of the entries in the eviction order, guarded by the mutex
+    struct Ring final {
+        void PushBack(Node* node) noexcept;
+        void Remove(Node* node) noexcept;
+        void Replace(Node* old_node, Node* node) noexcept;
+
+        Node* head{nullptr};
+        Node* tail{nullptr};
+        std::size_t size{0};
+    };
+
+    // Replaced as a whole on resize, so the readers never see it rehashing
+    struct Table final {
+        explicit Table(std::size_t capacity);
+
+        // Keeps the access frequencies of the `other` table
+        Table(std::size_t capacity, const Table& other);
+
+        static std::size_t GetMask(std::size_t capacity) noexcept;
+
+        const std::size_t mask;
+        const std::unique_ptr<std::atomic<Node*>[]> buckets;
+        impl::FrequencySketch sketch;
+    };
+
+    struct alignas(concurrent::impl::kDestructiveInterferenceSize) Shard final {
+        mutable engine::Mutex mutex;
+        std::atomic<Table*> table{nullptr};
+        std::atomic<std::size_t> size{0};
+        std::size_t capacity{0};
+        std::size_t window_capacity{0};
+        Ring window;
+        Ring main;
+        impl::RetiredList retired;
+    };
+
+    static std::uint64_t MixHash(std::uint64_t hash) noexcept;
+
+    static void SetCapacity(Shard& shard, std::size_t capacity) noexcept;
+
+    Shard& GetShard(std::uint64_t hash) const noexcept;
+
+    // The following functions must be called with the shard mutex locked
+    std::atomic<Node*>* FindLink(const Shard& shard, const T& key, std::uint64_t hash) const;
+    void Erase(Shard& shard, Node* node);
+    void Clear(Shard& shard);
+    void EvictIfNeeded(Shard& shard);
+    Node* SelectVictim(Shard& shard) noexcept;
+    void Rebuild(Shard& shard);
+
+    void NotifyDumper();
+
+    const std::size_t ways_;
+    const std::unique_ptr<Shard[]> shards_;
+    Hash hash_fn_;
+    Equal equal_;
+    std::shared_ptr<dump::Dumper> dumper_{nullptr};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Ring::PushBack(Node* node) noexcept {
+    node->ring_prev = tail;
+    node->ring_next = nullptr;
+    if (tail) {
+        tail->ring_next = node;
+    } else {
+        head = node;
+    }
+    tail = node;
+    ++size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Ring::Remove(Node* node) noexcept {
+    (node->ring_prev ? node->ring_prev->ring_next : head) = node->ring_next;
+    (node->ring_next ? node->ring_next->ring_prev : tail) = node->ring_prev;
+    node->ring_prev = node->ring_next = nullptr;
+    --size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Ring::Replace(Node* old_node, Node* node) noexcept {
+    node->ring_prev = old_node->ring_prev;
+    node->ring_next = old_node->ring_next;
+    (node->ring_prev ? node->ring_prev->ring_next : head) = node;
+    (node->ring_next ? node->ring_next->ring_prev : tail) = node;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ConcurrentTinyLfu<T, U, Hash, Equal>::Table::GetMask(std::size_t capacity) noexcept {
+    std::size_t buckets = 1;
+    while (buckets < capacity) buckets <<= 1;
+    return buckets - 1;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentTinyLfu<T, U, Hash, Equal>::Table::Table(std::size_t capacity)
+    : mask(GetMask(capacity)),
+      buckets(std::make_unique<std::atomic<Node*>[]>(mask + 1)),
+      sketch(capacity) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentTinyLfu<T, U, Hash, Equal>::Table::Table(std::size_t capacity, const Table& other)
+    : mask(GetMask(capacity)),
+      buckets(std::make_unique<std::atomic<Node*>[]>(mask + 1)),
+      sketch(capacity, other.sketch) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentTinyLfu<T, U, Hash, Equal>::ConcurrentTinyLfu(
+    std::size_t ways,
+    std::size_t way_size,
+    const Hash& hash,
+    const Equal& equal
+)
+    : ways_(ways), shards_(std::make_unique<Shard[]>(ways)), hash_fn_(hash), equal_(equal) {
+    if (ways == 0) throw std::logic_error("Ways must be positive");
+
+    for (std::size_t i = 0; i < ways_; ++i) {
+        SetCapacity(shards_[i], way_size);
+        shards_[i].table.store(new Table(way_size));
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentTinyLfu<T, U, Hash, Equal>::~ConcurrentTinyLfu() {
+    for (std::size_t i = 0; i < ways_; ++i) {
+        auto& shard = shards_[i];
+        for (auto* ring : {&shard.window, &shard.main}) {
+            for (auto* node = ring->head; node;) {
+                delete std::exchange(node, node->ring_next);
+            }
+        }
+        delete shard.table.load();
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Put(const T& key, U value) {
+    const auto hash = MixHash(hash_fn_(key));
+    auto& shard = GetShard(hash);
+    auto node = std::make_unique<Node>(key, std::move(value), hash);
+    {
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        if (auto* link = FindLink(shard, key, hash)) {
+            auto* old_node = link->load(std::memory_order_relaxed);
+            node->next.store(old_node->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node->in_window = old_node->in_window;
+            (old_node->in_window ? shard.window : shard.main).Replace(old_node, node.get());
+            link->store(node.release(), std::memory_order_release);
+            shard.retired.Retire(old_node);
+        } else {
+            auto* table = shard.table.load(std::memory_order_relaxed);
+            auto& bucket = table->buckets[hash & table->mask];
+            node->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            shard.window.PushBack(node.get());
+            bucket.store(node.release(), std::memory_order_release);
+            shard.size.fetch_add(1, std::memory_order_relaxed);
+            EvictIfNeeded(shard);
+        }
+    }
+    NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Validator>
+std::optional<U> ConcurrentTinyLfu<T, U, Hash, Equal>::Get(const T& key, Validator validator) {
+    const auto hash = MixHash(hash_fn_(key));
+    auto& shard = GetShard(hash);
+
+    std::optional<U> result;
+    {
+        const impl::EpochGuard guard;
+        auto* table = shard.table.load(std::memory_order_acquire);
+        table->sketch.Increment(hash);
+
+        auto* node = table->buckets[hash & table->mask].load(std::memory_order_acquire);
+        for (; node; node = node->next.load(std::memory_order_acquire)) {
+            if (node->hash == hash && equal_(node->key, key)) {
+                if (!node->referenced.load(std::memory_order_relaxed)) {
+                    node->referenced.store(true, std::memory_order_relaxed);
+                }
+                result.emplace(node->value);
+                break;
+            }
+        }
+    }
+
+    if (result && !validator(*result)) {
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        // The value may have been replaced since the lookup
+        auto* link = FindLink(shard, key, hash);
+        if (link && !validator(link->load(std::memory_order_relaxed)->value)) {
+            Erase(shard, link->load(std::memory_order_relaxed));
+        }
+        return std::nullopt;
+    }
+    return result;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U ConcurrentTinyLfu<T, U, Hash, Equal>::GetOr(const T& key, const U& default_value) {
+    auto result = Get(key);
+    if (result) return std::move(*result);
+    return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Invalidate() {
+    for (std::size_t i = 0; i < ways_; ++i) {
+        auto& shard = shards_[i];
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        Clear(shard);
+    }
+    NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::InvalidateByKey(const T& key) {
+    const auto hash = MixHash(hash_fn_(key));
+    auto& shard = GetShard(hash);
+    {
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        if (auto* link = FindLink(shard, key, hash)) {
+            Erase(shard, link->load(std::memory_order_relaxed));
+        }
+    }
+    NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::VisitAll(Function func) const {
+    for (std::size_t i = 0; i < ways_; ++i) {
+        const auto& shard = shards_[i];
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        for (const auto* ring : {&shard.window, &shard.main}) {
+            for (const auto* node = ring->head; node; node = node->ring_next) {
+                func(node->key, node->value);
+            }
+        }
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ConcurrentTinyLfu<T, U, Hash, Equal>::GetSize() const {
+    std::size_t size{0};
+    for (std::size_t i = 0; i < ways_; ++i) {
+        size += shards_[i].size.load(std::memory_order_relaxed);
+    }
+    return size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::UpdateWaySize(std::size_t way_size) {
+    for (std::size_t i = 0; i < ways_; ++i) {
+        auto& shard = shards_[i];
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+        if (shard.capacity == way_size) continue;
+
+        SetCapacity(shard, way_size);
+        EvictIfNeeded(shard);
+        Rebuild(shard);
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::uint64_t ConcurrentTinyLfu<T, U, Hash, Equal>::MixHash(std::uint64_t hash) noexcept {
+    // fmix64 from MurmurHash3: std::hash of integers is an identity, while
+    // the shard, the bucket and the sketch all need well-distributed bits
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::SetCapacity(Shard& shard, std::size_t capacity) noexcept {
+    shard.capacity = capacity;
+    shard.window_capacity = capacity < 2 ? capacity : std::max<std::size_t>(capacity / 100, 1);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename ConcurrentTinyLfu<T, U, Hash, Equal>::Shard& ConcurrentTinyLfu<T, U, Hash, Equal>::GetShard(
+    std::uint64_t hash
+) const noexcept {
+    // The low bits select the bucket within the shard
+    return shards_[(hash >> 32) % ways_];
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::atomic<typename ConcurrentTinyLfu<T, U, Hash, Equal>::Node*>*
+ConcurrentTinyLfu<T, U, Hash, Equal>::FindLink(const Shard& shard, const T& key, std::uint64_t hash) const {
+    auto* table = shard.table.load(std::memory_order_relaxed);
+    auto* link = &table->buckets[hash & table->mask];
+    for (auto* node = link->load(std::memory_order_relaxed); node; node = link->load(std::memory_order_relaxed)) {
+        if (node->hash == hash && equal_(node->key, key)) return link;
+        link = &node->next;
+    }
+    return nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Erase(Shard& shard, Node* node) {
+    auto* table = shard.table.load(std::memory_order_relaxed);
+    auto* link = &table->buckets[node->hash & table->mask];
+    while (link->load(std::memory_order_relaxed) != node) {
+        link = &link->load(std::memory_order_relaxed)->next;
+    }
+    // The node keeps its `next`, so the readers that stand on it may go on
+    link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+
+    (node->in_window ? shard.window : shard.main).Remove(node);
+    shard.size.fetch_sub(1, std::memory_order_relaxed);
+    shard.retired.Retire(node);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Clear(Shard& shard) {
+    auto* table = shard.table.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i <= table->mask; ++i) {
+        table->buckets[i].store(nullptr, std::memory_order_release);
+    }
+
+    for (auto* ring : {&shard.window, &shard.main}) {
+        for (auto* node = ring->head; node;) {
+            shard.retired.Retire(std::exchange(node, node->ring_next));
+        }
+        *ring = Ring{};
+    }
+    shard.size.store(0, std::memory_order_relaxed);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::EvictIfNeeded(Shard& shard) {
+    const auto main_capacity = shard.capacity - shard.window_capacity;
+    const auto& sketch = shard.table.load(std::memory_order_relaxed)->sketch;
+
+    while (shard.window.size > shard.window_capacity) {
+        auto* candidate = shard.window.head;
+        if (shard.main.size < main_capacity) {
+            shard.window.Remove(candidate);
+            candidate->in_window = false;
+            shard.main.PushBack(candidate);
+            continue;
+        }
+        if (main_capacity == 0) {
+            Erase(shard, candidate);
+            continue;
+        }
+
+        // TinyLFU admission: keep the one that is accessed more often
+        auto* victim = SelectVictim(shard);
+        if (sketch.Estimate(candidate->hash) > sketch.Estimate(victim->hash)) {
+            Erase(shard, victim);
+            shard.window.Remove(candidate);
+            candidate->in_window = false;
+            shard.main.PushBack(candidate);
+        } else {
+            Erase(shard, candidate);
+        }
+    }
+
+    while (shard.main.size > main_capacity) {
+        Erase(shard, SelectVictim(shard));
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename ConcurrentTinyLfu<T, U, Hash, Equal>::Node* ConcurrentTinyLfu<T, U, Hash, Equal>::SelectVictim(Shard& shard
+) noexcept {
+    // CLOCK: the referenced entries get a second chance. The scan is bounded,
+    // as the readers may set the bits concurrently
+    auto& ring = shard.main;
+    for (std::size_t i = 0; i < ring.size; ++i) {
+        auto* node = ring.head;
+        if (!node->referenced.load(std::memory_order_relaxed)) return node;
+
+        node->referenced.store(false, std::memory_order_relaxed);
+        ring.Remove(node);
+        ring.PushBack(node);
+    }
+    return ring.head;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Rebuild(Shard& shard) {
+    // The readers may stand on any node of the old table, so the nodes are
+    // copied rather than relinked
+    auto table = std::make_unique<Table>(shard.capacity, *shard.table.load(std::memory_order_relaxed));
+    Ring window;
+    Ring main;
+    for (auto* ring : {&shard.window, &shard.main}) {
+        for (auto* old_node = ring->head; old_node; old_node = old_node->ring_next) {
+            auto node = std::make_unique<Node>(old_node->key, U{old_node->value}, old_node->hash);
+            node->in_window = old_node->in_window;
+            auto& bucket = table->buckets[node->hash & table->mask];
+            node->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            (node->in_window ? window : main).PushBack(node.get());
+            bucket.store(node.release(), std::memory_order_relaxed);
+        }
+    }
+
+    auto* old_table = shard.table.exchange(table.release(), std::memory_order_acq_rel);
+    for (auto* ring : {&shard.window, &shard.main}) {
+        for (auto* node = ring->head; node;) {
+            shard.retired.Retire(std::exchange(node, node->ring_next));
+        }
+    }
+    shard.retired.Retire(old_table);
+    shard.window = window;
+    shard.main = main;
+    // All the nodes were retired at once, do not wait for the next batch
+    shard.retired.Reclaim();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+    writer.Write(ways_);
+
+    for (std::size_t i = 0; i < ways_; ++i) {
+        const auto& shard = shards_[i];
+        std::unique_lock<engine::Mutex> lock(shard.mutex);
+
+        writer.Write(shard.window.size + shard.main.size);
+        for (const auto* ring : {&shard.window, &shard.main}) {
+            for (const auto* node = ring->head; node; node = node->ring_next) {
+                writer.Write(node->key);
+                writer.Write(node->value);
+            }
+        }
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::Read(dump::Reader& reader) {
+    Invalidate();
+
+    const auto ways = reader.Read<std::size_t>();
+    for (std::size_t i = 0; i < ways; ++i) {
+        const auto elements_in_way = reader.Read<std::size_t>();
+        for (std::size_t j = 0; j < elements_in_way; ++j) {
+            auto key = reader.Read<T>();
+            auto value = reader.Read<U>();
+            Put(std::move(key), std::move(value));
+        }
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::NotifyDumper() {
+    if (dumper_ != nullptr) {
+        dumper_->OnUpdateCompleted();
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentTinyLfu<T, U, Hash, Equal>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
+    dumper_ = std::move(dumper);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
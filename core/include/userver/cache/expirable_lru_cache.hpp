@@ -6,7 +6,9 @@
 #include <atomic>
 #include <chrono>
 #include <optional>
+#include <type_traits>
 
+#include <userver/cache/concurrent_tiny_lfu.hpp>
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
@@ -45,6 +47,12 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader, dump::To<impl::ExpirableV
         reader.Read<Value>(), reader.Read<std::chrono::system_clock::time_point>() - now + steady_now};
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+using ExpirableLruStorage = std::conditional_t<
+    Policy == CachePolicy::kConcurrentTinyLfu,
+    ConcurrentTinyLfu<Key, ExpirableValue<Value>, Hash, Equal>,
+    NWayLRU<Key, ExpirableValue<Value>, Hash, Equal>>;
+
 }  // namespace impl
 
 /// @ingroup userver_containers
@@ -54,11 +62,22 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader, dump::To<impl::ExpirableV
 /// Example usage:
 ///
 /// @snippet cache/expirable_lru_cache_test.cpp Sample ExpirableLruCache
-template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+///
+/// The storage is selected by `Policy`, see cache::CachePolicy.
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class ExpirableLruCache final {
 public:
     using UpdateValueFunc = std::function<Value(const Key&)>;
 
+    /// Returns the approximate size of an entry in bytes,
+    /// e.g. cache::EstimateByteSize of the key and the value
+    using Weigher = std::function<std::size_t(const Key&, const Value&)>;
+
     /// Cache read mode
     enum class ReadMode {
         kSkipCache,  ///< Do not cache value got from update function
@@ -75,6 +94,17 @@ public:
     /// see the cache::NWayLRU::NWayLRU constructor.
     void SetWaySize(size_t way_size);
 
+    /// @brief Enables the accounting of the entry sizes in bytes, required
+    /// for SetWayMaxBytes(). Not supported by CachePolicy::kConcurrentTinyLfu.
+    ///
+    /// This method is not thread-safe and must be called before the cache is
+    /// filled.
+    void SetWeigher(Weigher weigher);
+
+    /// For the description of `way_max_bytes`,
+    /// see the cache::NWayLRU::UpdateWayMaxBytes.
+    void SetWayMaxBytes(size_t way_max_bytes);
+
     std::chrono::milliseconds GetMaxLifetime() const noexcept;
 
     void SetMaxLifetime(std::chrono::milliseconds max_lifetime);
@@ -128,6 +158,9 @@ public:
 
     size_t GetSizeApproximate() const;
 
+    /// Returns std::nullopt if SetWeigher() was not called
+    std::optional<size_t> GetBytesApproximate() const;
+
     /// Clear cache
     void Invalidate();
 
@@ -155,7 +188,8 @@ private:
     bool ShouldUpdate(std::chrono::steady_clock::time_point update_time, std::chrono::steady_clock::time_point now)
         const;
 
-    cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
+    impl::ExpirableLruStorage<Key, Value, Hash, Equal, Policy> lru_;
+    bool has_weigher_{false};
     std::atomic<std::chrono::milliseconds> max_lifetime_{std::chrono::milliseconds(0)};
     std::atomic<BackgroundUpdateMode> background_update_mode_{BackgroundUpdateMode::kDisabled};
     impl::ExpirableLruCacheStatistics stats_;
@@ -163,8 +197,8 @@ private:
     utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::ExpirableLruCache(
     size_t ways,
     size_t way_size,
     const Hash& hash,
@@ -172,33 +206,48 @@ ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
 )
     : lru_(ways, way_size, hash, equal), mutex_set_{ways, way_size, hash, equal} {}
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::~ExpirableLruCache() {
     wait_token_storage_.WaitForAllTokens();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetWaySize(size_t way_size) {
     lru_.UpdateWaySize(way_size);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::chrono::milliseconds ExpirableLruCache<Key, Value, Hash, Equal>::GetMaxLifetime() const noexcept {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetWeigher(Weigher weigher) {
+    static_assert(Policy == CachePolicy::kLRU, "Byte size limit is only supported by CachePolicy::kLRU");
+    has_weigher_ = true;
+    lru_.SetWeigher([weigher = std::move(weigher)](const Key& key, const impl::ExpirableValue<Value>& value) {
+        return weigher(key, value.value) + sizeof(value.update_time);
+    });
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetWayMaxBytes(size_t way_max_bytes) {
+    static_assert(Policy == CachePolicy::kLRU, "Byte size limit is only supported by CachePolicy::kLRU");
+    lru_.UpdateWayMaxBytes(way_max_bytes);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::chrono::milliseconds ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetMaxLifetime() const noexcept {
     return max_lifetime_.load();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetMaxLifetime(std::chrono::milliseconds max_lifetime) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetMaxLifetime(std::chrono::milliseconds max_lifetime) {
     max_lifetime_ = max_lifetime;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(BackgroundUpdateMode background_update) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetBackgroundUpdate(BackgroundUpdateMode background_update) {
     background_update_mode_ = background_update;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+Value ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Get(
     const Key& key,
     const UpdateValueFunc& update_func,
     ReadMode read_mode
@@ -225,9 +274,9 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     return value;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
 std::optional<Value>
-ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(const Key& key, const UpdateValueFunc& update_func) {
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptional(const Key& key, const UpdateValueFunc& update_func) {
     auto now = utils::datetime::SteadyNow();
     auto old_value = lru_.Get(key);
 
@@ -249,8 +298,8 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(const Key& key, const Up
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirable(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalUnexpirable(const Key& key) {
     auto old_value = lru_.Get(key);
 
     if (old_value) {
@@ -262,8 +311,8 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnex
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirableWithUpdate(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalUnexpirableWithUpdate(
     const Key& key,
     const UpdateValueFunc& update_func
 ) {
@@ -284,8 +333,8 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnex
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalNoUpdate(const Key& key) {
     auto now = utils::datetime::SteadyNow();
     auto old_value = lru_.Get(key);
 
@@ -303,39 +352,47 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUp
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key, const Value& value) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Put(const Key& key, const Value& value) {
     lru_.Put(key, {value, utils::datetime::SteadyNow()});
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key, Value&& value) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Put(const Key& key, Value&& value) {
     lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-const impl::ExpirableLruCacheStatistics& ExpirableLruCache<Key, Value, Hash, Equal>::GetStatistics() const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+const impl::ExpirableLruCacheStatistics& ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetStatistics() const {
     return stats_;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+size_t ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetSizeApproximate() const {
     return lru_.GetSize();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<size_t> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetBytesApproximate() const {
+    if constexpr (Policy == CachePolicy::kLRU) {
+        if (has_weigher_) return lru_.GetBytes();
+    }
+    return std::nullopt;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Invalidate() {
     lru_.Invalidate();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::InvalidateByKey(const Key& key) {
     lru_.InvalidateByKey(key);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
 template <typename Predicate>
-void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKeyIf(const Key& key, Predicate pred) {
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::InvalidateByKeyIf(const Key& key, Predicate pred) {
     auto now = utils::datetime::SteadyNow();
 
     auto mutex = mutex_set_.GetMutexForKey(key);
@@ -347,8 +404,11 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKeyIf(const Key& ke
     }
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(const Key& key, UpdateValueFunc update_func) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::UpdateInBackground(
+    const Key& key,
+    UpdateValueFunc update_func
+) {
     stats_.total.background_updates++;
     stats_.recent.GetCurrentCounter().background_updates++;
 
@@ -367,8 +427,8 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(const Key& k
     }).Detach();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+bool ExpirableLruCache<Key, Value, Hash, Equal, Policy>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
     std::chrono::steady_clock::time_point now
 ) const {
@@ -376,8 +436,8 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     return max_lifetime.count() != 0 && update_time + max_lifetime < now;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+bool ExpirableLruCache<Key, Value, Hash, Equal, Policy>::ShouldUpdate(
     std::chrono::steady_clock::time_point update_time,
     std::chrono::steady_clock::time_point now
 ) const {
@@ -386,10 +446,15 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
            update_time + max_lifetime / 2 < now;
 }
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class LruCacheWrapper final {
 public:
-    using Cache = ExpirableLruCache<Key, Value, Hash, Equal>;
+    using Cache = ExpirableLruCache<Key, Value, Hash, Equal, Policy>;
     using ReadMode = typename Cache::ReadMode;
 
     LruCacheWrapper(std::shared_ptr<Cache> cache, typename Cache::UpdateValueFunc update_func)
@@ -421,26 +486,29 @@ private:
     typename Cache::UpdateValueFunc update_func_;
 };
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Write(dump::Writer& writer) const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Write(dump::Writer& writer) const {
     utils::impl::UpdateGlobalTime();
     lru_.Write(writer);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Read(dump::Reader& reader) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Read(dump::Reader& reader) {
     utils::impl::UpdateGlobalTime();
     lru_.Read(reader);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
     lru_.SetDumper(std::move(dumper));
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCache<Key, Value, Hash, Equal, Policy>& cache) {
     writer["current-documents-count"] = cache.GetSizeApproximate();
+    if (const auto bytes = cache.GetBytesApproximate()) {
+        writer["current-bytes"] = *bytes;
+    }
     writer = cache.GetStatistics();
 }
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+struct EpochRecord;
+
+/// @brief Read-side critical section of the epoch-based memory reclamation.
+///
+/// The objects that were retired to an impl::RetiredList are not freed while
+/// an EpochGuard that was created before their retirement is alive. The
+/// guards are cheap: they only write to a thread-local cache line.
+///
+/// There must be no context switches while the guard is alive. Guards may be
+/// nested.
+class EpochGuard final {
+public:
+    EpochGuard();
+
+    EpochGuard(EpochGuard&&) = delete;
+    EpochGuard& operator=(EpochGuard&&) = delete;
+    ~EpochGuard();
+
+private:
+    compiler::ThreadLocalScope<EpochRecord*> record_scope_;
+};
+
+/// @brief The objects that were unlinked from a shared structure by a single
+/// writer, but may still be in use by the readers. Not thread-safe.
+class RetiredList final {
+public:
+    using Deleter = void (*)(void*) noexcept;
+
+    RetiredList() = default;
+
+    RetiredList(RetiredList&&) = delete;
+    RetiredList& operator=(RetiredList&&) = delete;
+
+    /// Frees all the objects, the readers must be gone by this time.
+    ~RetiredList();
+
+    template <typename T>
+    void Retire(T* ptr) {
+        Retire(ptr, [](void* ptr) noexcept { delete static_cast<T*>(ptr); });
+    }
+
+    /// Frees the object once all the readers that may see it are gone.
+    void Retire(void* ptr, Deleter deleter);
+
+    /// Frees the objects that no reader may see anymore.
+    void Reclaim() noexcept;
+
+private:
+    struct Retired final {
+        void* ptr;
+        Deleter deleter;
+        std::uint64_t epoch;
+    };
+
+    std::vector<Retired> retired_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// @brief Approximate access frequencies of the keys for the TinyLFU
+/// admission: a count-min sketch with 4-bit counters that are halved
+/// periodically, so that the old accesses are forgotten.
+///
+/// Increment is thread-safe, but lossy: concurrent increments of the same
+/// counter may be lost, which is fine for the estimation. Saturated counters
+/// are not written at all, so the hot keys do not bounce the cache lines.
+class FrequencySketch final {
+public:
+    /// @param capacity the count of the keys in the cache.
+    explicit FrequencySketch(std::size_t capacity);
+
+    /// Copies the frequencies from the sketch of another capacity. Estimates
+    /// do not decrease, the same way as for the collisions of the keys.
+    FrequencySketch(std::size_t capacity, const FrequencySketch& other);
+
+    void Increment(std::uint64_t hash) noexcept;
+
+    /// Returns the estimated count of accesses in [0, 15].
+    std::uint32_t Estimate(std::uint64_t hash) const noexcept;
+
+    void Clear() noexcept;
+
+private:
+    void Age() noexcept;
+
+    std::size_t mask_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> table_;
+    std::uint64_t sample_size_;
+    std::atomic<std::uint64_t> additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <functional>
 
+#include <userver/cache/byte_size.hpp>
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/components/component_base.hpp>
@@ -46,6 +47,8 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 ///
 /// Provides facilities for creating LRU caches.
 /// You need to override LruCacheComponent::DoGetByKey to handle cache misses.
+/// Pass cache::CachePolicy::kConcurrentTinyLfu as `Policy` for the caches
+/// with hot keys, see cache::ConcurrentTinyLfu.
 ///
 /// Caching components must be configured in service config (see options below)
 /// and may be reconfigured dynamically via components::DynamicConfig.
@@ -58,6 +61,7 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
+/// max-bytes | max total size of the items in bytes, as estimated by cache::EstimateByteSize (0 is unlimited) | unlimited
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
 /// background-update | enables asynchronous updates for expiring values | false
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
@@ -73,12 +77,17 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// @snippet cache/lru_cache_component_base_test.cpp  Sample lru cache component config
 
 // clang-format on
-template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>,
+    CachePolicy Policy = CachePolicy::kLRU>
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class LruCacheComponent : public components::ComponentBase, private dump::DumpableEntity {
 public:
-    using Cache = ExpirableLruCache<Key, Value, Hash, Equal>;
-    using CacheWrapper = LruCacheWrapper<Key, Value, Hash, Equal>;
+    using Cache = ExpirableLruCache<Key, Value, Hash, Equal, Policy>;
+    using CacheWrapper = LruCacheWrapper<Key, Value, Hash, Equal, Policy>;
 
     LruCacheComponent(const components::ComponentConfig&, const components::ComponentContext&);
 
@@ -119,8 +128,8 @@ private:
     // See the comment above before adding a new field.
 };
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+LruCacheComponent<Key, Value, Hash, Equal, Policy>::LruCacheComponent(
     const components::ComponentConfig& config,
     const components::ComponentContext& context
 )
@@ -128,6 +137,17 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways, static_config_.GetWaySize())) {
+    if (static_config_.config.max_bytes) {
+        if constexpr (Policy == CachePolicy::kLRU) {
+            cache_->SetWeigher([](const Key& key, const Value& value) {
+                return EstimateByteSize(key) + EstimateByteSize(value);
+            });
+            cache_->SetWayMaxBytes(static_config_.config.GetWayMaxBytes(static_config_.ways));
+        } else {
+            throw std::runtime_error("max-bytes is only supported by CachePolicy::kLRU, cache=" + name_);
+        }
+    }
+
     if (impl::IsDumpSupportEnabled(config)) {
         dumper_ = std::make_shared<dump::Dumper>(config, context, static_cast<dump::DumpableEntity&>(*this));
         cache_->SetDumper(dumper_);
@@ -156,8 +176,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     reset_registration_ = testsuite::RegisterCache(config, context, this, &LruCacheComponent::DropCache);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-LruCacheComponent<Key, Value, Hash, Equal>::~LruCacheComponent() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+LruCacheComponent<Key, Value, Hash, Equal, Policy>::~LruCacheComponent() {
     reset_registration_.Unregister();
     statistics_holder_.Unregister();
     config_subscription_.Unsubscribe();
@@ -167,24 +187,24 @@ LruCacheComponent<Key, Value, Hash, Equal>::~LruCacheComponent() {
     }
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-typename LruCacheComponent<Key, Value, Hash, Equal>::CacheWrapper LruCacheComponent<Key, Value, Hash, Equal>::GetCache(
-) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+typename LruCacheComponent<Key, Value, Hash, Equal, Policy>::CacheWrapper
+LruCacheComponent<Key, Value, Hash, Equal, Policy>::GetCache() {
     return CacheWrapper(cache_, [this](const Key& key) { return GetByKey(key); });
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void LruCacheComponent<Key, Value, Hash, Equal>::DropCache() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void LruCacheComponent<Key, Value, Hash, Equal, Policy>::DropCache() {
     cache_->Invalidate();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-Value LruCacheComponent<Key, Value, Hash, Equal>::GetByKey(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+Value LruCacheComponent<Key, Value, Hash, Equal, Policy>::GetByKey(const Key& key) {
     return DoGetByKey(key);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void LruCacheComponent<Key, Value, Hash, Equal>::OnConfigUpdate(const dynamic_config::Snapshot& cfg) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void LruCacheComponent<Key, Value, Hash, Equal, Policy>::OnConfigUpdate(const dynamic_config::Snapshot& cfg) {
     const auto config = GetLruConfig(cfg, name_);
     if (config) {
         LOG_DEBUG() << "Using dynamic config for LRU cache";
@@ -195,20 +215,27 @@ void LruCacheComponent<Key, Value, Hash, Equal>::OnConfigUpdate(const dynamic_co
     }
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(const LruCacheConfig& config) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void LruCacheComponent<Key, Value, Hash, Equal, Policy>::UpdateConfig(const LruCacheConfig& config) {
     cache_->SetWaySize(config.GetWaySize(static_config_.ways));
+    if constexpr (Policy == CachePolicy::kLRU) {
+        // The entries are weighed only if the limit is set statically
+        if (static_config_.config.max_bytes) {
+            const auto& bytes_config = config.max_bytes ? config : static_config_.config;
+            cache_->SetWayMaxBytes(bytes_config.GetWayMaxBytes(static_config_.ways));
+        }
+    }
     cache_->SetMaxLifetime(config.lifetime);
     cache_->SetBackgroundUpdate(config.background_update);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-yaml_config::Schema LruCacheComponent<Key, Value, Hash, Equal>::GetStaticConfigSchema() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+yaml_config::Schema LruCacheComponent<Key, Value, Hash, Equal, Policy>::GetStaticConfigSchema() {
     return impl::GetLruCacheComponentBaseSchema();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void LruCacheComponent<Key, Value, Hash, Equal>::GetAndWrite(dump::Writer& writer) const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void LruCacheComponent<Key, Value, Hash, Equal, Policy>::GetAndWrite(dump::Writer& writer) const {
     if constexpr (kCacheIsDumpable) {
         cache_->Write(writer);
     } else {
@@ -216,8 +243,8 @@ void LruCacheComponent<Key, Value, Hash, Equal>::GetAndWrite(dump::Writer& write
     }
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void LruCacheComponent<Key, Value, Hash, Equal>::ReadAndSet(dump::Reader& reader) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void LruCacheComponent<Key, Value, Hash, Equal, Policy>::ReadAndSet(dump::Reader& reader) {
     if constexpr (kCacheIsDumpable) {
         cache_->Read(reader);
     } else {
@@ -19,6 +19,15 @@ enum class BackgroundUpdateMode {
     kDisabled,
 };
 
+/// Eviction policy of the cache::ExpirableLruCache storage
+enum class CachePolicy {
+    /// cache::NWayLRU: exact LRU, every access locks the way
+    kLRU,
+    /// cache::ConcurrentTinyLfu: lock-free reads and the frequency-based
+    /// admission, better for the hot keys and the scan-heavy loads
+    kConcurrentTinyLfu,
+};
+
 struct LruCacheConfig final {
     explicit LruCacheConfig(const yaml_config::YamlConfig& config);
     explicit LruCacheConfig(const components::ComponentConfig& config);
@@ -27,9 +36,13 @@ struct LruCacheConfig final {
 
     std::size_t GetWaySize(std::size_t ways) const;
 
+    /// Returns 0 if the size in bytes is unlimited
+    std::size_t GetWayMaxBytes(std::size_t ways) const;
+
     std::size_t size;
     std::chrono::milliseconds lifetime;
     BackgroundUpdateMode background_update;
+    std::optional<std::size_t> max_bytes;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value, formats::parse::To<LruCacheConfig>);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -10,6 +12,7 @@
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,6 +22,9 @@ namespace cache {
 template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
 class NWayLRU final {
 public:
+    /// Returns the approximate size of an entry in bytes
+    using Weigher = std::function<std::size_t(const T&, const U&)>;
+
     /// @param ways is the number of ways (a.k.a. shards, internal hash-maps),
     /// into which elements are distributed based on their hash. Each shard is
     /// protected by an individual mutex. Larger `ways` means more internal
@@ -59,6 +65,23 @@ public:
     /// see the cache::NWayLRU::NWayLRU constructor.
     void UpdateWaySize(size_t way_size);
 
+    /// @brief Enables the accounting of the entry sizes in bytes, see
+    /// UpdateWayMaxBytes().
+    ///
+    /// The weigher must return the same size for the same entry every time.
+    /// This method is not thread-safe and must be called before the cache is
+    /// filled.
+    void SetWeigher(Weigher weigher);
+
+    /// @brief Limits the total size of the entries of a way in bytes: the
+    /// least recently used entries are evicted until the way fits into
+    /// `way_max_bytes` (0 is unlimited). The limit on the entry count still
+    /// holds. Requires SetWeigher().
+    void UpdateWayMaxBytes(size_t way_max_bytes);
+
+    /// Returns the total size of the entries in bytes, 0 without SetWeigher()
+    size_t GetBytes() const;
+
     void Write(dump::Writer& writer) const;
     void Read(dump::Reader& reader);
 
@@ -75,14 +98,24 @@ private:
 
         mutable engine::Mutex mutex;
         LruMap<T, U, Hash, Equal> cache;
+        // Only accounted with a weigher, guarded by the mutex
+        size_t bytes{0};
     };
 
     Way& GetWay(const T& key);
 
+    // The following functions must be called with the way mutex locked
+    void PutWeighted(Way& way, const T& key, U&& value);
+    void EraseWeighted(Way& way, const T& key);
+    void EvictLeastUsed(Way& way);
+    void EvictOverweight(Way& way);
+
     void NotifyDumper();
 
     std::vector<Way> caches_;
     Hash hash_fn_;
+    Weigher weigher_;
+    std::atomic<size_t> way_max_bytes_{0};
     std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
@@ -101,7 +134,11 @@ void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
     auto& way = GetWay(key);
     {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.Put(key, std::move(value));
+        if (weigher_) {
+            PutWeighted(way, key, std::move(value));
+        } else {
+            way.cache.Put(key, std::move(value));
+        }
     }
     NotifyDumper();
 }
@@ -115,7 +152,7 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key, Validator validator)
 
     if (value) {
         if (validator(*value)) return *value;
-        way.cache.Erase(key);
+        EraseWeighted(way, key);
     }
 
     return std::nullopt;
@@ -126,7 +163,7 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
     auto& way = GetWay(key);
     {
         std::unique_lock<engine::Mutex> lock(way.mutex);
-        way.cache.Erase(key);
+        EraseWeighted(way, key);
     }
     NotifyDumper();
 }
@@ -143,6 +180,7 @@ void NWayLRU<T, U, Hash, Eq>::Invalidate() {
     for (auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
         way.cache.Clear();
+        way.bytes = 0;
     }
     NotifyDumper();
 }
@@ -170,10 +208,41 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
     for (auto& way : caches_) {
         std::unique_lock<engine::Mutex> lock(way.mutex);
+        if (weigher_) {
+            // LruMap evicts silently, do it here to account the bytes
+            while (way.cache.GetSize() > std::max<size_t>(way_size, 1)) EvictLeastUsed(way);
+        }
         way.cache.SetMaxSize(way_size);
     }
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SetWeigher(Weigher weigher) {
+    weigher_ = std::move(weigher);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdateWayMaxBytes(size_t way_max_bytes) {
+    UASSERT_MSG(weigher_ || way_max_bytes == 0, "SetWeigher() must be called to limit the size in bytes");
+    way_max_bytes_ = way_max_bytes;
+    if (!weigher_) return;
+
+    for (auto& way : caches_) {
+        std::unique_lock<engine::Mutex> lock(way.mutex);
+        EvictOverweight(way);
+    }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetBytes() const {
+    size_t bytes{0};
+    for (const auto& way : caches_) {
+        std::unique_lock<engine::Mutex> lock(way.mutex);
+        bytes += way.bytes;
+    }
+    return bytes;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T& key) {
     /// It is needed to twist hash because there is hash map in LruMap. Otherwise
@@ -186,6 +255,46 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T&
     return caches_[n];
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::PutWeighted(Way& way, const T& key, U&& value) {
+    const auto bytes = weigher_(key, value);
+    if (const auto* old_value = way.cache.Get(key)) {
+        way.bytes -= std::min(way.bytes, weigher_(key, *old_value));
+    } else if (way.cache.GetSize() >= way.cache.GetCapacity()) {
+        EvictLeastUsed(way);
+    }
+    way.cache.Put(key, std::move(value));
+    way.bytes += bytes;
+    EvictOverweight(way);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::EraseWeighted(Way& way, const T& key) {
+    if (weigher_) {
+        const auto* value = way.cache.Get(key);
+        if (!value) return;
+        way.bytes -= std::min(way.bytes, weigher_(key, *value));
+    }
+    way.cache.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::EvictLeastUsed(Way& way) {
+    const auto* key = way.cache.GetLeastUsedKey();
+    if (!key) return;
+    way.bytes -= std::min(way.bytes, weigher_(*key, *way.cache.GetLeastUsed()));
+    way.cache.Erase(*key);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::EvictOverweight(Way& way) {
+    const auto max_bytes = way_max_bytes_.load();
+    if (max_bytes == 0) return;
+
+    // A single entry that does not fit into the way is evicted as well
+    while (way.bytes > max_bytes && way.cache.GetSize() > 0) EvictLeastUsed(way);
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
     writer.Write(caches_.size());
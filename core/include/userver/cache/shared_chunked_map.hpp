@@ -0,0 +1,350 @@
+#pragma once
+
+/// @file userver/cache/shared_chunked_map.hpp
+/// @brief @copybrief cache::SharedChunkedMap
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+/// @brief Hash map with cheap copies that share the unchanged parts of the
+/// data, for the caches with large incremental updates.
+///
+/// The elements are distributed into chunks by their hash, each chunk is a
+/// separate std::unordered_map that is held by a std::shared_ptr. A copy of the
+/// map only copies the pointers to the chunks, and a modification of the copy
+/// clones the affected chunk only (copy-on-write). So an incremental update of
+/// a cache that copies the previous value, see
+/// components::CachingComponentBase::ApplyDelta, takes the time proportional
+/// to the number of the changed elements rather than to the size of the map.
+///
+/// The number of chunks doubles as the map grows, to keep the average chunk
+/// small. The elements are immutable through the map, change them with
+/// insert_or_assign. Iterators are invalidated by any modification.
+///
+/// Works as a custom `CacheContainer` of components::PostgreCache.
+///
+/// Copying a map is thread-safe with respect to modifications of other copies.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class SharedChunkedMap final {
+    using Chunk = std::unordered_map<Key, Value, Hash, Equal>;
+    using Chunks = std::vector<std::shared_ptr<Chunk>>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = typename Chunk::value_type;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+
+    class const_iterator;
+    using iterator = const_iterator;
+
+    SharedChunkedMap() = default;
+
+    explicit SharedChunkedMap(const Hash& hash, const Equal& equal = Equal()) : hash_(hash), equal_(equal) {}
+
+    SharedChunkedMap(const SharedChunkedMap&) = default;
+    SharedChunkedMap(SharedChunkedMap&&) noexcept = default;
+    SharedChunkedMap& operator=(const SharedChunkedMap&) = default;
+    SharedChunkedMap& operator=(SharedChunkedMap&&) noexcept = default;
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const_iterator begin() const { return const_iterator(&chunks_, 0); }
+    const_iterator end() const { return const_iterator(&chunks_, chunks_.size()); }
+
+    const_iterator find(const Key& key) const;
+    bool contains(const Key& key) const { return find(key) != end(); }
+    std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /// @throws std::out_of_range if there is no such key
+    const Value& at(const Key& key) const;
+
+    /// Inserts the element or replaces the value of an existing one
+    template <typename V>
+    void insert_or_assign(Key key, V&& value);
+
+    /// Does nothing if the element exists
+    bool insert(value_type value);
+
+    std::size_t erase(const Key& key);
+
+    void clear() noexcept;
+
+    /// Pre-allocates the chunks for `size` elements, cheaper than the growth
+    /// of a non-empty map
+    void reserve(std::size_t size);
+
+    /// The number of chunks, for tests and metrics
+    std::size_t GetChunksCount() const noexcept { return chunks_.size(); }
+
+private:
+    // Average number of elements in a chunk before the number of chunks
+    // doubles. A modification of a shared chunk copies that many elements.
+    static constexpr std::size_t kMaxAverageChunkSize = 256;
+
+    std::size_t ChunkIndex(const Key& key) const;
+    Chunk& MutableChunk(std::size_t index);
+    void GrowIfNeeded();
+    void Rehash(std::size_t chunks_count);
+
+    static bool IsUniqueOwner(const std::shared_ptr<Chunk>& chunk) noexcept;
+
+    Chunks chunks_;
+    std::size_t size_{0};
+    Hash hash_{};
+    Equal equal_{};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class SharedChunkedMap<Key, Value, Hash, Equal>::const_iterator final {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Chunk::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    const_iterator() = default;
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    const_iterator& operator++() {
+        ++it_;
+        SkipFinishedChunks();
+        return *this;
+    }
+
+    const_iterator operator++(int) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    bool operator==(const const_iterator& other) const {
+        return chunk_index_ == other.chunk_index_ && (IsEnd() || it_ == other.it_);
+    }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+private:
+    friend class SharedChunkedMap;
+
+    const_iterator(const Chunks* chunks, std::size_t chunk_index) : chunks_(chunks), chunk_index_(chunk_index) {
+        if (!IsEnd()) {
+            if (const auto& chunk = (*chunks_)[chunk_index_]) it_ = chunk->begin();
+            SkipFinishedChunks();
+        }
+    }
+
+    const_iterator(const Chunks* chunks, std::size_t chunk_index, typename Chunk::const_iterator it)
+        : chunks_(chunks), chunk_index_(chunk_index), it_(it) {}
+
+    bool IsEnd() const { return !chunks_ || chunk_index_ == chunks_->size(); }
+
+    void SkipFinishedChunks() {
+        while (!IsEnd()) {
+            const auto& chunk = (*chunks_)[chunk_index_];
+            if (chunk && it_ != chunk->end()) return;
+            if (++chunk_index_ == chunks_->size()) return;
+            if (const auto& next = (*chunks_)[chunk_index_]) it_ = next->begin();
+        }
+    }
+
+    const Chunks* chunks_{nullptr};
+    std::size_t chunk_index_{0};
+    typename Chunk::const_iterator it_{};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto SharedChunkedMap<Key, Value, Hash, Equal>::find(const Key& key) const -> const_iterator {
+    if (chunks_.empty()) return end();
+
+    const auto index = ChunkIndex(key);
+    const auto& chunk = chunks_[index];
+    if (!chunk) return end();
+
+    const auto it = chunk->find(key);
+    if (it == chunk->end()) return end();
+    return const_iterator(&chunks_, index, it);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value& SharedChunkedMap<Key, Value, Hash, Equal>::at(const Key& key) const {
+    const auto it = find(key);
+    if (it == end()) throw std::out_of_range("SharedChunkedMap::at");
+    return it->second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename V>
+void SharedChunkedMap<Key, Value, Hash, Equal>::insert_or_assign(Key key, V&& value) {
+    GrowIfNeeded();
+    auto& chunk = MutableChunk(ChunkIndex(key));
+    const auto old_size = chunk.size();
+    chunk.insert_or_assign(std::move(key), std::forward<V>(value));
+    size_ += chunk.size() - old_size;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool SharedChunkedMap<Key, Value, Hash, Equal>::insert(value_type value) {
+    if (contains(value.first)) return false;
+
+    GrowIfNeeded();
+    MutableChunk(ChunkIndex(value.first)).insert(std::move(value));
+    ++size_;
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t SharedChunkedMap<Key, Value, Hash, Equal>::erase(const Key& key) {
+    // Do not clone a shared chunk that does not contain the key
+    if (!contains(key)) return 0;
+
+    MutableChunk(ChunkIndex(key)).erase(key);
+    --size_;
+    return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SharedChunkedMap<Key, Value, Hash, Equal>::clear() noexcept {
+    chunks_.clear();
+    size_ = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SharedChunkedMap<Key, Value, Hash, Equal>::reserve(std::size_t size) {
+    std::size_t chunks_count = chunks_.empty() ? 1 : chunks_.size();
+    while (chunks_count * kMaxAverageChunkSize < size) chunks_count *= 2;
+    if (chunks_count != chunks_.size()) Rehash(chunks_count);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t SharedChunkedMap<Key, Value, Hash, Equal>::ChunkIndex(const Key& key) const {
+    // The chunk maps hash the same keys again, use the high bits of the mixed
+    // hash for the chunks to keep the chunk maps balanced
+    const auto mixed = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(mixed >> 32) & (chunks_.size() - 1);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto SharedChunkedMap<Key, Value, Hash, Equal>::MutableChunk(std::size_t index) -> Chunk& {
+    auto& chunk = chunks_[index];
+    if (!chunk) {
+        chunk = std::make_shared<Chunk>(0, hash_, equal_);
+    } else if (!IsUniqueOwner(chunk)) {
+        chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool SharedChunkedMap<Key, Value, Hash, Equal>::IsUniqueOwner(const std::shared_ptr<Chunk>& chunk) noexcept {
+    // Other copies can only release the chunk, so the unique owner may modify
+    // it in place. use_count() is a relaxed load, the fence orders the
+    // modifications after the reads of the copies that have released the chunk
+    // in other threads.
+    if (chunk.use_count() != 1) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SharedChunkedMap<Key, Value, Hash, Equal>::GrowIfNeeded() {
+    if (chunks_.empty()) {
+        chunks_.resize(1);
+    } else if (size_ >= chunks_.size() * kMaxAverageChunkSize) {
+        Rehash(chunks_.size() * 2);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SharedChunkedMap<Key, Value, Hash, Equal>::Rehash(std::size_t chunks_count) {
+    Chunks old_chunks = std::exchange(chunks_, Chunks(chunks_count));
+    for (auto& old_chunk : old_chunks) {
+        if (!old_chunk) continue;
+
+        const bool is_unique = IsUniqueOwner(old_chunk);
+        for (auto& [key, value] : *old_chunk) {
+            auto& chunk = MutableChunk(ChunkIndex(key));
+            if (is_unique) {
+                chunk.emplace(key, std::move(value));
+            } else {
+                chunk.emplace(key, value);
+            }
+        }
+        old_chunk.reset();
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator==(
+    const SharedChunkedMap<Key, Value, Hash, Equal>& lhs,
+    const SharedChunkedMap<Key, Value, Hash, Equal>& rhs
+) {
+    if (lhs.size() != rhs.size()) return false;
+    for (const auto& [key, value] : lhs) {
+        const auto it = rhs.find(key);
+        if (it == rhs.end() || !(it->second == value)) return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator!=(
+    const SharedChunkedMap<Key, Value, Hash, Equal>& lhs,
+    const SharedChunkedMap<Key, Value, Hash, Equal>& rhs
+) {
+    return !(lhs == rhs);
+}
+
+/// @brief cache::SharedChunkedMap serialization support for cache dumps
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<dump::kIsWritable<Key> && dump::kIsWritable<Value>>
+Write(dump::Writer& writer, const SharedChunkedMap<Key, Value, Hash, Equal>& map) {
+    writer.Write(map.size());
+    for (const auto& [key, value] : map) {
+        writer.Write(key);
+        writer.Write(value);
+    }
+}
+
+/// @brief cache::SharedChunkedMap deserialization support for cache dumps
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<dump::kIsReadable<Key> && dump::kIsReadable<Value>, SharedChunkedMap<Key, Value, Hash, Equal>>
+Read(dump::Reader& reader, dump::To<SharedChunkedMap<Key, Value, Hash, Equal>>) {
+    const auto size = reader.Read<std::size_t>();
+    SharedChunkedMap<Key, Value, Hash, Equal> map;
+    map.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto key = reader.Read<Key>();
+        map.insert_or_assign(std::move(key), reader.Read<Value>());
+    }
+    return map;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
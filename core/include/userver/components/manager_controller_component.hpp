@@ -34,8 +34,12 @@ class Manager;
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | 4000
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
 /// coro_pool.local_cache_size | local coroutine cache size per thread | 32
+/// coro_pool.idle_stack_release | give the touched pages of idle coroutine stacks back to the OS, at most once per 100ms per worker thread: 'none', 'free' (MADV_FREE) or 'dontneed' (MADV_DONTNEED) | none
+/// coro_pool.retained_stack_size | amount of bytes at the beginning of an idle stack that are never released, at least 16KiB | 16 * 1024
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | 2
 /// event_thread_pool.thread_name | set OS thread name to this value | 'event-worker'
+/// event_thread_pool.io_uring_enabled | submit socket and file I/O to per ev thread io_uring, falls back to libev if io_uring is not supported | false
+/// event_thread_pool.io_uring_entries | submission queue size of each io_uring | 256
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -55,6 +59,9 @@ class Manager;
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 1000
 /// task-processor-queue | Task queue mode for the task processor. `global-task-queue` default task queue. `work-stealing-task-queue` experimental with potentially better scalability than `global-task-queue`. | global-task-queue
+/// numa-aware | split the workers into per-NUMA-node groups, bind each group to the CPUs and memory of its node; with `work-stealing-task-queue` the workers steal from other nodes only when they run out of node-local tasks (Linux only) | false
+/// task-priorities | schedule tasks with a close deadline before the others and background tasks (e.g. periodic cache updates) after them, see also engine::current_task::SetPriority() | false
+/// urgent-deadline-threshold | with `task-priorities`, tasks that have less than this time left until their deadline are considered urgent; 0 disables the deadline-based scheduling | 20ms
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -12,12 +12,15 @@
 /// @ingroup userver_dump_read_write
 
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <userver/utils/constexpr_indices.hpp>
 #include <userver/utils/lazy_prvalue.hpp>
@@ -115,6 +118,35 @@ std::enable_if_t<kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>, T> Rea
     return result;
 }
 
+/// @brief Writes a vector of trivially copyable values as a single block
+/// @note The format differs from `writer.Write(vector)`, read the result with
+/// dump::ReadTrivialVector
+template <typename T, typename Alloc>
+void WriteTrivialVector(Writer& writer, const std::vector<T, Alloc>& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    writer.Write(value.size());
+    // TODO: endianness
+    WriteStringViewUnsafe(
+        writer, std::string_view{reinterpret_cast<const char*>(value.data()), value.size() * sizeof(T)}
+    );
+}
+
+/// @brief Reads a vector written by dump::WriteTrivialVector with a single
+/// `memcpy`, without a copy into a buffer for dump::MappedFileReader
+template <typename T>
+std::vector<T> ReadTrivialVector(Reader& reader) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto size = reader.Read<std::size_t>();
+    if (size > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw Error("Invalid size of a trivial vector in the dump");
+    }
+
+    const auto bytes = ReadStringViewUnsafe(reader, size * sizeof(T));
+    std::vector<T> result(size);
+    if (size != 0) std::memcpy(result.data(), bytes.data(), bytes.size());
+    return result;
+}
+
 /// @brief Pair serialization support (for maps)
 template <typename T, typename U>
 std::enable_if_t<kIsWritable<T> && kIsWritable<U>, void> Write(Writer& writer, const std::pair<T, U>& value) {
@@ -42,6 +42,9 @@ struct Config final {
     std::optional<std::chrono::milliseconds> max_dump_age;
     bool max_dump_age_set;
     bool dump_is_encrypted;
+    bool dump_is_mapped;
+    bool dump_is_chunked;
+    int compression_level;
 
     bool static_dumps_enabled;
     std::chrono::milliseconds static_min_dump_interval;
@@ -85,6 +85,9 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to write the dump with block checksums and read it via mmap, see dump::MappedFileReader. Incompatible with `encrypted` | `false`
+/// `chunked` | `boolean` | Whether to compress the dump in chunks by parallel tasks, see dump::ChunkedFileWriter. Incompatible with `encrypted` and `mmap` | `false`
+/// `zstd-level` | `integer` | zstd compression level of a `chunked` dump | `1`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
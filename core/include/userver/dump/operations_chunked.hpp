@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A handle to a dump file of independently compressed chunks. File
+/// operations block the thread.
+///
+/// The data is split into chunks of a few MB, which are compressed with zstd
+/// and checksummed by parallel tasks on the current task processor, while the
+/// caller keeps serializing the next chunks. The chunk index is written after
+/// the data. The format is not compatible with FileWriter.
+class ChunkedFileWriter final : public Writer {
+public:
+    /// @brief Creates a new dump file and opens it
+    /// @param compression_level zstd compression level
+    /// @throws `Error` on a filesystem error
+    ChunkedFileWriter(
+        std::string path,
+        boost::filesystem::perms perms,
+        int compression_level,
+        tracing::ScopeTime& scope
+    );
+
+    ~ChunkedFileWriter() override;
+
+    void Finish() override;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/// @brief A handle to a dump file written by ChunkedFileWriter. File operations
+/// block the thread.
+///
+/// The chunks ahead of the current one are read, verified and decompressed by
+/// parallel tasks on the current task processor.
+class ChunkedFileReader final : public Reader {
+public:
+    /// @brief Opens an existing dump file and reads its chunk index
+    /// @throws `Error` on a filesystem error or a malformed file
+    explicit ChunkedFileReader(std::string path);
+
+    ~ChunkedFileReader() override;
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    void BackUp(std::size_t size) override;
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+class ChunkedOperationsFactory final : public OperationsFactory {
+public:
+    ChunkedOperationsFactory(boost::filesystem::perms perms, int compression_level);
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const boost::filesystem::perms perms_;
+    const int compression_level_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A handle to a memory-mapped dump file. File operations block the
+/// thread.
+///
+/// The data is followed by the checksums of its fixed-size blocks, which allows
+/// MappedFileReader to verify them in parallel. The format is not compatible
+/// with FileWriter: after switching a dumper to `mmap: true` (or back) its
+/// existing dumps can not be read, bump its `format-version` along with it.
+class MappedFileWriter final : public Writer {
+public:
+    /// @brief Creates a new dump file and opens it
+    /// @throws `Error` on a filesystem error
+    MappedFileWriter(std::string path, boost::filesystem::perms perms, tracing::ScopeTime& scope);
+
+    void Finish() override;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    void WriteBlock(std::string_view block);
+
+    FileWriter file_;
+    std::string block_;
+    std::vector<std::uint64_t> checksums_;
+    std::uint64_t data_size_{0};
+};
+
+/// @brief A handle to a dump file written by MappedFileWriter, that is mapped
+/// into memory.
+///
+/// The constructor verifies the checksums of the data in parallel tasks on the
+/// current task processor. dump::Dumper reads the dumps on its
+/// `fs-task-processor`, so the count of its workers limits the parallelism.
+/// The reads do not copy the data: the views returned
+/// by ReadStringViewUnsafe point into the mapping and stay valid until the
+/// reader is destroyed, so the large trivially copyable values are populated
+/// with a single memcpy, see dump::ReadTrivialVector.
+class MappedFileReader final : public Reader {
+public:
+    /// @brief Maps an existing dump file and verifies its checksums
+    /// @throws `Error` on a filesystem error or a checksum mismatch
+    explicit MappedFileReader(std::string path);
+
+    MappedFileReader(MappedFileReader&&) = delete;
+    MappedFileReader& operator=(MappedFileReader&&) = delete;
+    ~MappedFileReader() override;
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    void BackUp(std::size_t size) override;
+
+    void ParseTrailer();
+    void VerifyChecksums(std::string_view checksums) const;
+
+    std::string path_;
+    void* mapping_{nullptr};
+    std::size_t mapping_size_{0};
+    std::string_view data_;
+    std::size_t position_{0};
+};
+
+class MappedOperationsFactory final : public OperationsFactory {
+public:
+    explicit MappedOperationsFactory(boost::filesystem::perms perms);
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,220 @@
+#pragma once
+
+/// @file userver/dump/parallel_containers.hpp
+/// @brief Dump support for large containers, serialized in parts by parallel
+/// tasks
+///
+/// @ingroup userver_dump_read_write
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/meta_containers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+/// A `Writer` that appends to a string buffer
+class StringWriter final : public Writer {
+public:
+    StringWriter();
+
+    void Finish() override;
+
+    std::string Extract() &&;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    std::string data_;
+};
+
+/// A `Reader` that reads from a string buffer
+class StringReader final : public Reader {
+public:
+    explicit StringReader(std::string data);
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    void BackUp(std::size_t size) override;
+
+    std::string data_;
+    std::size_t pos_{0};
+};
+
+/// The number of the parts that are processed concurrently
+std::size_t GetPartsInFlight();
+
+/// The number of the parts to split a container into
+std::size_t GetPartsCount(std::size_t size);
+
+/// The number of the elements in the part `part` of a container
+constexpr std::size_t GetPartSize(std::size_t size, std::size_t parts_count, std::size_t part) noexcept {
+    return size / parts_count + (part < size % parts_count ? 1 : 0);
+}
+
+/// @throws Error if `parts_count` could not be written for a container of
+/// `size` elements
+void CheckPartsCount(std::size_t size, std::size_t parts_count);
+
+/// @throws Error if a container or its part does not have the written size,
+/// e.g. the parts of a set have intersected
+void CheckReadSize(std::size_t expected_size, std::size_t actual_size);
+
+template <typename T>
+using MergeResult = decltype(std::declval<T&>().merge(std::declval<T&>()));
+
+template <typename T>
+void MergePart(T& result, T&& part) {
+    if constexpr (meta::kIsDetected<MergeResult, T>) {
+        // Moves the nodes, the keys of the maps are not copied
+        result.merge(part);
+    } else if constexpr (meta::kIsVector<T>) {
+        result.insert(result.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+    } else {
+        for (auto&& element : part) {
+            dump::Insert(result, std::move(element));
+        }
+    }
+}
+
+}  // namespace impl
+
+/// @brief Writes a large container as several parts, that are serialized by
+/// parallel tasks on the current task processor
+///
+/// The elements of large containers are serialized one by one, which may
+/// dominate the dump write time. Use with dump::ChunkedFileWriter to compress
+/// the data in parallel as well.
+///
+/// @note The format differs from `writer.Write(container)`, read the result
+/// with dump::ReadInParts
+/// @warning The container must not be modified until the function returns
+template <typename T>
+void WriteInParts(Writer& writer, const T& container) {
+    static_assert(kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>);
+    using Element = meta::RangeValueType<T>;
+
+    const std::size_t size = std::size(container);
+    const std::size_t parts_count = impl::GetPartsCount(size);
+    writer.Write(size);
+    writer.Write(parts_count);
+
+    auto& task_processor = engine::current_task::GetTaskProcessor();
+    const auto max_in_flight = impl::GetPartsInFlight();
+    std::deque<engine::TaskWithResult<std::string>> in_flight;
+
+    auto part_begin = std::begin(container);
+    for (std::size_t part = 0; part < parts_count; ++part) {
+        const std::size_t part_size = impl::GetPartSize(size, parts_count, part);
+        const auto part_end = std::next(part_begin, part_size);
+
+        if (in_flight.size() >= max_in_flight) {
+            writer.Write(in_flight.front().Get());
+            in_flight.pop_front();
+        }
+        in_flight.push_back(engine::AsyncNoSpan(task_processor, [part_begin, part_end, part_size] {
+            impl::StringWriter part_writer;
+            part_writer.Write(part_size);
+            for (auto it = part_begin; it != part_end; ++it) {
+                // explicit cast for vector<bool> shenanigans
+                part_writer.Write(static_cast<const Element&>(*it));
+            }
+            return std::move(part_writer).Extract();
+        }));
+
+        part_begin = part_end;
+    }
+
+    while (!in_flight.empty()) {
+        writer.Write(in_flight.front().Get());
+        in_flight.pop_front();
+    }
+}
+
+/// @brief Reads a container written by dump::WriteInParts, the parts are
+/// deserialized by parallel tasks on the current task processor
+/// @throws Error if the parts do not add up to the written size
+template <typename T>
+T ReadInParts(Reader& reader) {
+    static_assert(kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>);
+    using Element = meta::RangeValueType<T>;
+
+    const auto size = reader.Read<std::size_t>();
+    const auto parts_count = reader.Read<std::size_t>();
+    impl::CheckPartsCount(size, parts_count);
+
+    auto& task_processor = engine::current_task::GetTaskProcessor();
+    const auto max_in_flight = impl::GetPartsInFlight();
+    std::deque<engine::TaskWithResult<T>> in_flight;
+
+    T result{};
+    bool is_first_part = true;
+    const auto merge_front = [&] {
+        auto part = in_flight.front().Get();
+        in_flight.pop_front();
+        if (is_first_part) {
+            is_first_part = false;
+            result = std::move(part);
+            if constexpr (meta::kIsReservable<T>) {
+                // The first part has been read, so `size` is backed by the data
+                // up to the count of the parts
+                result.reserve(size);
+            }
+        } else {
+            impl::MergePart(result, std::move(part));
+        }
+    };
+
+    for (std::size_t part = 0; part < parts_count; ++part) {
+        if (in_flight.size() >= max_in_flight) merge_front();
+
+        const auto expected_part_size = impl::GetPartSize(size, parts_count, part);
+        in_flight.push_back(engine::AsyncNoSpan(
+            task_processor,
+            [data = reader.Read<std::string>(), expected_part_size]() mutable {
+                const auto data_size = data.size();
+                impl::StringReader part_reader(std::move(data));
+                const auto part_size = part_reader.Read<std::size_t>();
+                impl::CheckReadSize(expected_part_size, part_size);
+
+                T part{};
+                if constexpr (meta::kIsReservable<T>) {
+                    // Do not trust the size before the elements are read
+                    part.reserve(std::min(part_size, data_size));
+                }
+                for (std::size_t i = 0; i < part_size; ++i) {
+                    dump::Insert(part, part_reader.Read<Element>());
+                }
+                part_reader.Finish();
+                return part;
+            }
+        ));
+    }
+
+    while (!in_flight.empty()) merge_front();
+    impl::CheckReadSize(size, std::size(result));
+    return result;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
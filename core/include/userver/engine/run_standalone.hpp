@@ -20,6 +20,8 @@ struct TaskProcessorPoolsConfig final {
     std::size_t ev_threads_num = 1;
     std::string ev_thread_name = "ev";
     bool ev_default_loop_disabled = false;
+    /// Perform socket and file I/O via io_uring where supported
+    bool ev_io_uring_enabled = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
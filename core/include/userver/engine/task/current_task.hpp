@@ -3,6 +3,7 @@
 /// @file userver/engine/task/current_task.hpp
 /// @brief Utility functions that query and operate on the current task
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -29,6 +30,52 @@ TaskProcessor& GetTaskProcessor();
 /// Returns task coroutine stack size
 std::size_t GetStackSize();
 
+/// @brief Time accounting of a task, see EnableExecutionStats()
+struct ExecutionStats final {
+    /// Time the task was running on a task processor thread
+    std::chrono::nanoseconds running_time{0};
+
+    /// Time the task was ready to run, but waited in the task processor queue
+    std::chrono::nanoseconds queue_wait_time{0};
+
+    /// How many times the task was suspended to wait for something
+    std::uint64_t context_switches{0};
+};
+
+/// @brief Starts the accounting of engine::current_task::ExecutionStats for
+/// the current task.
+///
+/// The accounting takes a few clock reads per context switch, so it is off by
+/// default. It is enabled for the tasks that handle HTTP requests, which
+/// report the stats in their spans and in the handler metrics.
+void EnableExecutionStats() noexcept;
+
+/// @brief Returns the stats of the current task, accounted since
+/// EnableExecutionStats() call. The running time includes the current run.
+ExecutionStats GetExecutionStats() noexcept;
+
+/// @brief Scheduling priority of a task, takes effect if the task processor
+/// has `task-priorities` enabled, see components::ManagerControllerComponent
+enum class TaskPriority {
+    /// Run the task before the normal ones
+    kUrgent,
+    /// The task becomes urgent when its deadline is about to expire, the default
+    kNormal,
+    /// Run the task after the normal ones, e.g. periodic cache updates
+    kBackground,
+};
+
+/// @brief Sets the scheduling priority of the current task.
+///
+/// The priority is used the next time the task is scheduled, e.g. after a
+/// wake up or engine::Yield(). The lower priorities are still run now and
+/// then, so they are not starved.
+void SetPriority(TaskPriority priority);
+
+/// @brief Returns the scheduling priority of the current task, set by
+/// SetPriority()
+TaskPriority GetPriority();
+
 /// @cond
 // Returns ev thread handle, internal use only
 ev::ThreadControl& GetEventThread();
@@ -43,10 +43,12 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, one of `tskv`, `ltsv`, `json`, `json_yadeploy` | tskv
+/// format | log output format, one of `tskv`, `ltsv`, `json`, `json_yadeploy`, `binary` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
-/// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue, `sample` also drops most of the messages below warning level while the queue is more than half full | discard
+/// thread_buffer_size | size of the per-thread buffers for messages in bytes, must be a power of 2; 0 disables them, see below | 0
+/// deferred_formatting | capture the message values in the calling task and format them in the logger task, see below | false
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
 ///
@@ -58,6 +60,28 @@ namespace components {
 /// - Use `%file_name%` to write your logs in file. Use USR1 signal or `OnLogRotate` handler to reopen files after log rotation;
 /// - Use `unix:%socket_name%` to write your logs to unix socket. Socket must be created before the service starts and closed by listener after service is shut down.
 ///
+/// ### Per-thread buffers
+/// With non-zero `thread_buffer_size` each thread writes messages into its
+/// own buffer instead of the shared queue, and the logger writes the messages
+/// of all the threads to each sink at once. `overflow_behavior` applies to the
+/// per-thread buffers in that case. Messages larger than a quarter of the
+/// buffer still go through the shared queue.
+///
+/// ### Deferred formatting
+/// With `deferred_formatting: true` the calling task only copies the text
+/// parts, the numbers and the tags of a message into a compact record, and
+/// the logger task formats it in the configured format. This reduces the
+/// latency of logging for the request handlers at the expense of the logger
+/// task throughput. Values written via `operator<<` for std::ostream are still
+/// formatted by the calling task. The option has no effect on the `binary`
+/// format.
+///
+/// ### Binary format
+/// `binary` format writes compact records with interned source locations and
+/// tag keys, each of them is written once per file. Use the `log-decoder` tool
+/// from `tools/log-decoder` or logging::DecodeBinaryLogs to convert such logs
+/// into `tskv`, `ltsv` or `json`.
+///
 /// ### testsuite-capture options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
@@ -81,7 +81,10 @@ namespace components {
 /// connection.http2-session.max_concurrent_streams | max number of concurrent open streams | 100
 /// connection.http2-session.max_frame_size | max size of the HTTP/2.0 frame | 16384
 /// connection.http2-session.initial_window_size | the initial window size of the server | 65536
+/// connection.fast_http_parser | parse the common complete HTTP/1.x requests with a SIMD scanner and fall back to llhttp for the rest | false
+/// connection.request_pool_size | how many memory blocks of the finished HTTP/1.x requests to keep per connection for the next requests; 0 to allocate each request separately | 0
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// reuseport_cpu_steering | set to true to pass a new TCP connection to the shard with index equal to `cpu % shards`, where `cpu` is the CPU that received the connection (Linux only) | false
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
 /// @see @ref scripts/docs/en/userver/http_server.md
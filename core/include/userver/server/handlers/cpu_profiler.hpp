@@ -0,0 +1,93 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that controls the sampling CPU profiler.
+///
+/// The profiler samples the stacks of the threads that consume CPU time with
+/// SIGPROF at the given frequency, and attributes each sample to the HTTP
+/// handler that runs in the current task, or to the task processor, or to the
+/// thread name outside of tasks. The samples are aggregated in memory, so the
+/// profiler may run continuously in production: at 100 Hz it takes about
+/// 100 stack unwinds per second of the consumed CPU time.
+///
+/// The profiler uses ITIMER_PROF and SIGPROF of the whole process, so it
+/// can not be used together with other profilers that rely on them
+/// (gperftools, for example).
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// sampling-frequency | samples per second of the consumed CPU time | 100
+/// start-enabled | start the profiler with the service | false
+///
+/// ## Static configuration example:
+///
+/// ```yaml
+///     handler-cpu-profiler:
+///         path: /service/cpu-profiler/{command}
+///         method: POST
+///         task_processor: monitor-task-processor
+///         sampling-frequency: 100
+/// ```
+///
+/// ## Schema
+/// Set an URL path argument `command` to one of the following values:
+/// * `enable` - to start profiling
+/// * `disable` - to stop profiling
+/// * `dump` - to get the aggregated stacks in the collapsed format of FlameGraph
+///   (`tag;outermost;...;innermost count` per line), that is also accepted by
+///   `pprof` and speedscope
+/// * `reset` - to forget the aggregated stacks
+/// * `stat` - to get the profiler state and the sample counts
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+public:
+    enum class Command {
+        kEnable,
+        kDisable,
+        kDump,
+        kReset,
+        kStat,
+    };
+    static std::optional<Command> GetCommandFromString(std::string_view str);
+    static std::string ListCommands();
+
+    CpuProfiler(const components::ComponentConfig&, const components::ComponentContext&);
+    ~CpuProfiler() override;
+
+    /// @ingroup userver_component_names
+    /// @brief The default name of server::handlers::CpuProfiler
+    static constexpr std::string_view kName = "handler-cpu-profiler";
+
+    std::string HandleRequestThrow(const http::HttpRequest&, request::RequestContext&) const override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    const std::uint32_t sampling_frequency_;
+    utils::PeriodicTask collector_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> = true;
+
+USERVER_NAMESPACE_END
@@ -100,6 +100,14 @@ public:
         const std::string& response_data
     ) const;
 
+    /// @overload Takes the body set via http::HttpResponse::SetData() or
+    /// http::HttpResponse::SetSharedData()
+    std::string GetResponseDataForLoggingChecked(
+        const http::HttpRequest& request,
+        request::RequestContext& context,
+        const http::HttpResponse& response
+    ) const;
+
     /// Takes the exception and formats it into response, as specified by
     /// exception.
     void HandleCustomHandlerException(const http::HttpRequest& request, const CustomHandlerException& ex) const;
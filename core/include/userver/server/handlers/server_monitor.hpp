@@ -3,6 +3,8 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -43,18 +45,34 @@ enum class StatsFormat;
 ///   be a JSON dictionary in the form '{"label1":"value1", "label2":"value2"}'.
 /// * path - return metrics on for the following path
 /// * prefix - return metrics whose path starts from the specified prefix.
+///
+/// ## Large storages
+///
+/// With the 'prometheus-cache' option the Prometheus formats are rendered
+/// with utils::statistics::PrometheusFormatCache, that reuses the text of
+/// the previous response for the metrics that have not changed. If
+/// additionally 'response-body-stream' is enabled, the Prometheus output is
+/// sent in chunks, without holding the cache while the client receives them.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
 public:
     ServerMonitor(const components::ComponentConfig& config, const components::ComponentContext& component_context);
 
+    ~ServerMonitor() override;
+
     /// @ingroup userver_component_names
     /// @brief The default name of server::handlers::ServerMonitor
     static constexpr std::string_view kName = "handler-server-monitor";
 
     std::string HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const override;
 
+    void HandleStreamRequest(
+        http::HttpRequest& request,
+        request::RequestContext& context,
+        http::ResponseBodyStream& response_body_stream
+    ) const override;
+
     static yaml_config::Schema GetStaticConfigSchema();
 
 private:
@@ -64,11 +82,19 @@ private:
         const std::string& response_data
     ) const override;
 
+    impl::StatsFormat GetFormat(const http::HttpRequest& request) const;
+
+    utils::statistics::Request MakeStatisticsRequest(const http::HttpRequest& request, impl::StatsFormat format) const;
+
     utils::statistics::Storage& statistics_storage_;
 
     using CommonLabels = std::unordered_map<std::string, std::string>;
     const CommonLabels common_labels_;
     const std::optional<impl::StatsFormat> default_format_;
+
+    // Set if 'prometheus-cache' is enabled
+    std::unique_ptr<utils::statistics::PrometheusFormatCache> prometheus_cache_;
+    std::unique_ptr<utils::statistics::PrometheusFormatCache> prometheus_untyped_cache_;
 };
 
 }  // namespace server::handlers
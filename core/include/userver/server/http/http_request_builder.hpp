@@ -11,11 +11,17 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+namespace impl {
+class HttpRequestPool;
+}  // namespace impl
+
 /// @brief HTTP Request Builder
 class HttpRequestBuilder final {
 public:
     /// @cond
     explicit HttpRequestBuilder(request::ResponseDataAccounter& data_accounter);
+
+    HttpRequestBuilder(request::ResponseDataAccounter& data_accounter, std::shared_ptr<impl::HttpRequestPool> pool);
     /// @endcond
 
     HttpRequestBuilder();
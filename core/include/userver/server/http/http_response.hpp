@@ -4,7 +4,9 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include <userver/concurrent/queue.hpp>
@@ -64,6 +66,10 @@ public:
     void SetSendFailed(std::chrono::steady_clock::time_point failure_time) override;
     /// @endcond
 
+    /// @brief Sets the response body. A non-empty body replaces the one set via
+    /// SetSharedData().
+    void SetData(std::string data) override;
+
     /// @brief Add a new response header or rewrite an existing one.
     /// @returns true if the header was set. Returns false if headers
     /// were already sent for stream'ed response and the new header was not set.
@@ -83,7 +89,8 @@ public:
     /// @brief Add or rewrite the Content-Encoding header.
     void SetContentEncoding(std::string encoding);
 
-    /// @brief Set the HTTP response status code.
+    /// @brief Set the HTTP response status code. A status that does not allow a
+    /// body (1xx, 204, 304) drops the body set via SetSharedData().
     /// @returns true if the status was set. Returns false if headers
     /// were already sent for stream'ed response and the new status was not set.
     bool SetStatus(HttpStatus status);
@@ -99,6 +106,15 @@ public:
     /// @brief Remove all cookies from response.
     void ClearCookies();
 
+    /// @brief Sets the response body to a shared immutable buffer, e.g. to data
+    /// from fs::FsCacheClient. The buffer is sent as is, without copying it into
+    /// the response. Data set via SetData() takes precedence over it.
+    void SetSharedData(std::shared_ptr<const std::string> data);
+
+    /// @return The response body: the data set via SetData() or, if it is
+    /// empty, via SetSharedData().
+    std::string_view GetDataView() const;
+
     /// @return HTTP response status
     HttpStatus GetStatus() const { return status_; }
 
@@ -127,6 +143,13 @@ public:
     /// @cond
     // TODO: server internals. remove from public interface
     void SendResponse(engine::io::RwBase& socket) override;
+
+    // Writes the response without marking it as sent and returns its size.
+    // For the writes that complete later, e.g. coalesced pipelined responses:
+    // the caller marks the response as sent once the data reaches the socket.
+    std::size_t WriteResponse(engine::io::RwBase& socket);
+
+    using request::ResponseBase::SetSent;
     /// @endcond
 
     void SetStatusServiceUnavailable() override { SetStatus(HttpStatus::kServiceUnavailable); }
@@ -153,6 +176,13 @@ private:
     // Returns total size of the response
     std::size_t SetBodyNotStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::http::headers::HeadersString& header);
 
+    // Returns the body that is not streamed as a single string. Call
+    // ExtractSharedData() first to avoid copying the shared data
+    std::string ExtractNotStreamedBody();
+
+    // Returns the shared data if it is the body that is not streamed
+    std::shared_ptr<const std::string> ExtractSharedData();
+
     const HttpRequest& request_;
     HttpStatus status_ = HttpStatus::kOk;
     HeadersMap headers_;
@@ -162,6 +192,8 @@ private:
     std::optional<Queue::Consumer> body_stream_;
     Producer body_stream_producer_;
     bool is_stream_body_{false};
+
+    std::shared_ptr<const std::string> shared_data_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response, std::string log_reason, std::string http_header_reason);
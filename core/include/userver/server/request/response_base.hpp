@@ -81,7 +81,7 @@ public:
     ResponseBase(ResponseBase&&) = delete;
     virtual ~ResponseBase() noexcept;
 
-    void SetData(std::string data);
+    virtual void SetData(std::string data);
     const std::string& GetData() const { return data_; }
     std::string&& ExtractData() { return std::move(data_); }
 
@@ -25,6 +25,24 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | ''
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// tail-sampling.enabled | buffer the spans of a trace until its local root span finishes and write them out only if the trace is kept | false
+/// tail-sampling.latency-threshold | keep the traces with the local root span at least that long, 0 disables the check | 0ms
+/// tail-sampling.keep-errors | keep the traces with a span marked with the tracing::kErrorFlag tag | true
+/// tail-sampling.random-fraction | fraction of the rest of the traces to keep, from 0 to 1 | 0
+/// tail-sampling.max-spans-per-trace | max count of spans to buffer per trace, the rest of the spans are dropped | 1000
+///
+/// ## Tail sampling
+///
+/// With `tail-sampling.enabled` the finished spans are not written out right
+/// away. The records of the spans of a trace, including the OpenTracing ones,
+/// are captured without formatting into a per-trace buffer, which is shared by
+/// the spans created within the local root span (the span without a parent in
+/// this process). Once the local root span finishes, the whole trace is
+/// written out if any of the conditions above holds, otherwise it is dropped.
+/// The spans that finish after the local root span follow the decision.
+///
+/// The buffered records get the timestamps of the moment they are written out.
+/// The spans are still filtered by the log levels and the no-log span names.
 ///
 /// ## Static configuration example:
 ///
@@ -0,0 +1,217 @@
+#pragma once
+
+/// @file userver/utils/statistics/exponential_histogram.hpp
+/// @brief @copybrief utils::statistics::ExponentialHistogram
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <userver/utils/span.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl::exponential_histogram {
+struct CounterLine;
+}  // namespace impl::exponential_histogram
+
+class ExponentialHistogram;
+
+/// @brief Bucket layout of utils::statistics::ExponentialHistogram.
+struct ExponentialHistogramSettings final {
+    /// Bucket bounds are the powers of `2^(2^-schema)`, the schema must be
+    /// in [-4, 8]. Each increment of the schema halves the relative error and
+    /// doubles the bucket count.
+    int schema{3};
+
+    /// Values that are not greater than the threshold, including zero and
+    /// negative values, fall into the special "zero" bucket. Must be positive.
+    double zero_threshold{1e-3};
+
+    /// Values greater than the upper bound of the bucket of `max_value` fall
+    /// into the special "infinity" bucket.
+    double max_value{1e6};
+
+    /// Schema of the buckets that are written by DumpMetric, the greater
+    /// values are replaced with `schema`. See "Serialization" in
+    /// utils::statistics::ExponentialHistogram.
+    int dump_schema{0};
+};
+
+/// @brief The result of reading a utils::statistics::ExponentialHistogram.
+///
+/// Snapshots of histograms with different settings can be summed: the result
+/// uses the coarsest schema and the greatest zero threshold of the summands.
+///
+/// The bucket with index `i` contains values in `(base^(i-1), base^i]`,
+/// the same as in Prometheus native histograms. OpenTelemetry exponential
+/// histograms number the buckets from the lower bound, so their offset is
+/// `GetFirstIndex() - 1`.
+///
+/// ExponentialHistogramSnapshot can be used as the `Result` of
+/// utils::statistics::RecentPeriod with ExponentialHistogram as the `Counter`.
+class ExponentialHistogramSnapshot final {
+public:
+    /// Creates an empty snapshot that takes the settings of the first
+    /// summand.
+    ExponentialHistogramSnapshot() noexcept;
+
+    int GetSchema() const noexcept { return schema_; }
+
+    double GetZeroThreshold() const noexcept { return zero_threshold_; }
+
+    /// Returns the count of values that are not greater than the zero
+    /// threshold.
+    std::uint64_t GetZeroCount() const noexcept { return zero_count_; }
+
+    /// Returns the index of the bucket that corresponds to `GetCounts()[0]`.
+    std::int32_t GetFirstIndex() const noexcept { return first_index_; }
+
+    /// Returns the counts of the buckets in the index order, including the
+    /// empty ones.
+    utils::span<const std::uint64_t> GetCounts() const noexcept { return counts_; }
+
+    /// Returns the count of values that are greater than the largest bucket
+    /// bound.
+    std::uint64_t GetOverflowCount() const noexcept { return overflow_count_; }
+
+    /// Returns the sum of counts of all the buckets, including the special
+    /// ones.
+    std::uint64_t GetTotalCount() const noexcept;
+
+    /// Returns the upper bound of the bucket with the given index.
+    double GetUpperBound(std::int32_t index) const noexcept;
+
+    /// @brief Estimates the value at the given percent from 0 to 100.
+    ///
+    /// The relative error is at most `(base - 1) / (base + 1)`. Values from
+    /// the "zero" bucket are estimated as 0, values from the "infinity" bucket
+    /// are estimated as the largest bucket bound.
+    double GetPercentile(double percent) const noexcept;
+
+    /// Merges the buckets to get a coarser schema.
+    void Downscale(int schema);
+
+    ExponentialHistogramSnapshot& operator+=(const ExponentialHistogramSnapshot& other);
+
+    /// Adds the counts of the histogram without allocations, if its settings
+    /// match the snapshot.
+    ExponentialHistogramSnapshot& operator+=(const ExponentialHistogram& histogram);
+
+private:
+    friend class ExponentialHistogram;
+    friend void DumpMetric(Writer& writer, const ExponentialHistogramSnapshot& snapshot);
+
+    bool IsEmpty() const noexcept { return zero_threshold_ == 0; }
+    std::int32_t GetLastIndex() const noexcept;
+    void RaiseZeroThreshold(double zero_threshold);
+    void ExtendRange(std::int32_t first_index, std::int32_t last_index);
+
+    int schema_{0};
+    int dump_schema_{0};
+    double zero_threshold_{0};
+    std::uint64_t zero_count_{0};
+    std::int32_t first_index_{0};
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t overflow_count_{0};
+};
+
+/// Metric serialization support for ExponentialHistogramSnapshot.
+void DumpMetric(Writer& writer, const ExponentialHistogramSnapshot& snapshot);
+
+/// @brief A histogram with exponential buckets, which bounds the relative
+/// error of the values instead of requiring the bucket bounds upfront.
+///
+/// The buckets follow the layout of Prometheus native histograms and
+/// OpenTelemetry exponential histograms: the bounds are the powers of
+/// `base = 2^(2^-schema)`. The relative error of
+/// ExponentialHistogramSnapshot::GetPercentile is
+/// `(base - 1) / (base + 1)`:
+///
+/// schema | base   | relative error
+/// ------ | ------ | --------------
+/// 0      | 2      | 33%
+/// 2      | 1.189  | 8.6%
+/// 3      | 1.091  | 4.3%
+/// 5      | 1.022  | 1.1%
+/// 8      | 1.0027 | 0.14%
+///
+/// ## Concurrent recording
+///
+/// The counters are split into several stripes, and Account picks the stripe
+/// by the current CPU (or by the current thread, when rseq is unavailable), so
+/// that the hot metrics of the handlers do not bounce a cache line between
+/// all the CPUs. The histogram takes
+/// `8 * (bucket count + 2) * min(N_CORES, 16)` bytes, so prefer
+/// utils::statistics::Histogram for the metrics that are not hot.
+///
+/// ## Serialization
+///
+/// The text exposition formats support only the histograms with explicit
+/// bounds, so DumpMetric downscales the buckets to
+/// ExponentialHistogramSettings::dump_schema and writes them as
+/// utils::statistics::HistogramView. The lowest bound is the zero threshold.
+/// The exporters that support the native histograms can take the full
+/// resolution from ExponentialHistogramSnapshot.
+///
+/// ## Aggregation
+///
+/// Use utils::statistics::RecentPeriod to keep the recent epochs:
+/// @snippet utils/statistics/exponential_histogram_test.cpp  recent period
+class ExponentialHistogram final {
+public:
+    /// Uses the default settings.
+    ExponentialHistogram();
+
+    explicit ExponentialHistogram(const ExponentialHistogramSettings& settings);
+
+    /// Copies the counts of an existing histogram.
+    ExponentialHistogram(const ExponentialHistogram& other);
+    ExponentialHistogram& operator=(const ExponentialHistogram& other);
+    ExponentialHistogram(ExponentialHistogram&&) noexcept;
+    ExponentialHistogram& operator=(ExponentialHistogram&&) noexcept;
+    ~ExponentialHistogram();
+
+    /// Atomically increment the bucket corresponding to the given value.
+    void Account(double value, std::uint64_t count = 1) noexcept;
+
+    /// Reads the counts of all the stripes.
+    ExponentialHistogramSnapshot GetSnapshot() const;
+
+    /// Atomically reset all counters to zero, for utils::statistics::RecentPeriod.
+    void Reset() noexcept;
+
+    /// Atomically reset all counters to zero.
+    friend void ResetMetric(ExponentialHistogram& histogram) noexcept;
+
+private:
+    friend class ExponentialHistogramSnapshot;
+
+    std::atomic<std::uint64_t>& GetCounter(std::size_t stripe, std::size_t bucket) const noexcept;
+    bool IsShapeOf(const ExponentialHistogramSnapshot& snapshot) const noexcept;
+    void SetShape(ExponentialHistogramSnapshot& snapshot) const;
+    void AddCountsTo(ExponentialHistogramSnapshot& snapshot) const noexcept;
+
+    int schema_;
+    int dump_schema_;
+    double zero_threshold_;
+    // The upper bound of the last bucket, values above it overflow.
+    double max_bound_;
+    std::int32_t first_index_;
+    // The zero bucket, the normal buckets, then the infinity bucket.
+    std::size_t counters_per_stripe_;
+    std::size_t lines_per_stripe_;
+    std::size_t stripe_mask_;
+    std::unique_ptr<impl::exponential_histogram::CounterLine[]> lines_;
+};
+
+/// Metric serialization support for ExponentialHistogram.
+void DumpMetric(Writer& writer, const ExponentialHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
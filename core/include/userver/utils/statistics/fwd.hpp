@@ -22,6 +22,8 @@ class Request;
 class Entry;
 class Writer;
 
+class PrometheusFormatCache;
+
 class MetricsStorage;
 using MetricsStoragePtr = std::shared_ptr<MetricsStorage>;
 
@@ -3,8 +3,12 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 
+#include <userver/utils/function_ref.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,6 +38,51 @@ ToPrometheusFormat(const utils::statistics::Storage& statistics, const utils::st
 std::string
 ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
 
+/// @brief Outputs `statistics` in Prometheus format reusing the text of the
+/// previous output for the metrics that have not changed.
+///
+/// The output is the same as of ToPrometheusFormat or
+/// ToPrometheusFormatUntyped. For the metrics with the same path and labels
+/// as in the previous output only the changed values are formatted, which
+/// saves most of the CPU for the storages with lots of metrics. The previous
+/// output is kept in memory.
+///
+/// Thread-safe, concurrent calls are serialized.
+class PrometheusFormatCache final {
+public:
+    enum class Format {
+        kTyped,    ///< as ToPrometheusFormat
+        kUntyped,  ///< as ToPrometheusFormatUntyped
+    };
+
+    using ChunkConsumer = utils::function_ref<void(std::string_view chunk)>;
+
+    explicit PrometheusFormatCache(Format format = Format::kTyped);
+
+    PrometheusFormatCache(PrometheusFormatCache&&) = delete;
+    PrometheusFormatCache& operator=(PrometheusFormatCache&&) = delete;
+    ~PrometheusFormatCache();
+
+    /// Returns the whole output
+    std::string ToString(const utils::statistics::Storage& statistics, const Request& request = {});
+
+    /// Passes the output to `consumer` in consecutive chunks of `chunk_size`
+    /// bytes, except for the last one. The whole output is rendered first. The
+    /// chunks point into the output kept by the cache, so it is not copied.
+    /// `consumer` is called after the cache is unlocked, so a slow consumer
+    /// does not hold up the concurrent calls.
+    void WriteChunks(
+        const utils::statistics::Storage& statistics,
+        const Request& request,
+        std::size_t chunk_size,
+        ChunkConsumer consumer
+    );
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
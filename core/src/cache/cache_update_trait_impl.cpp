@@ -18,6 +18,7 @@
 
 #include <cache/cache_dependencies.hpp>
 #include <dump/dump_locator.hpp>
+#include <engine/task/task_priority.hpp>
 #include <userver/dump/factory.hpp>
 #include <userver/testsuite/testsuite_support.hpp>
 
@@ -314,6 +315,8 @@ UpdateType CacheUpdateTrait::Impl::NextUpdateType(const Config& config) {
 }
 
 void CacheUpdateTrait::Impl::DoPeriodicUpdate() {
+    // Periodic updates should not delay request handling tasks
+    const engine::impl::BackgroundTaskScope background_scope;
     const std::lock_guard lock(update_mutex_);
     const auto config = GetConfig();
 
@@ -0,0 +1,179 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/cache/concurrent_tiny_lfu.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::ConcurrentTinyLfu<int, int>;
+
+UTEST(ConcurrentTinyLfu, Ctr) {
+    UEXPECT_NO_THROW(Cache(1, 10));
+    UEXPECT_NO_THROW(Cache(10, 10));
+    UEXPECT_THROW(Cache(0, 10), std::logic_error);
+}
+
+UTEST(ConcurrentTinyLfu, Set) {
+    Cache cache(1, 1);
+    EXPECT_EQ(0, cache.GetSize());
+
+    cache.Put(1, 1);
+    EXPECT_EQ(1, cache.GetSize());
+
+    cache.Put(2, 2);
+
+    EXPECT_EQ(2, cache.Get(2));
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_FALSE(cache.Get(1).has_value());
+}
+
+UTEST(ConcurrentTinyLfu, Replace) {
+    Cache cache(1, 10);
+    cache.Put(1, 1);
+    cache.Put(1, 2);
+
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(2, cache.Get(1));
+    EXPECT_EQ(3, cache.GetOr(2, 3));
+}
+
+UTEST(ConcurrentTinyLfu, GetExpired) {
+    Cache cache(1, 2);
+    cache.Put(1, 1);
+    cache.Put(2, 2);
+
+    EXPECT_EQ(1, cache.Get(1));
+    EXPECT_EQ(2, cache.GetSize());
+
+    EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+    EXPECT_EQ(1, cache.GetSize());
+
+    EXPECT_FALSE(cache.Get(2, [](int) { return false; }).has_value());
+    EXPECT_EQ(0, cache.GetSize());
+
+    EXPECT_FALSE(cache.Get(1).has_value());
+    EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(ConcurrentTinyLfu, Invalidate) {
+    Cache cache(4, 100);
+    for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+    cache.InvalidateByKey(0);
+    EXPECT_FALSE(cache.Get(0).has_value());
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSize());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(cache.Get(i).has_value());
+    }
+}
+
+UTEST(ConcurrentTinyLfu, SizeLimit) {
+    constexpr std::size_t kWays = 4;
+    constexpr std::size_t kWaySize = 50;
+    Cache cache(kWays, kWaySize);
+    for (int i = 0; i < 10'000; ++i) cache.Put(i, i);
+
+    EXPECT_LE(cache.GetSize(), kWays * kWaySize);
+
+    std::size_t visited = 0;
+    cache.VisitAll([&visited](int key, int value) {
+        EXPECT_EQ(key, value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, cache.GetSize());
+}
+
+UTEST(ConcurrentTinyLfu, FrequentKeysSurviveScan) {
+    constexpr int kHotKeys = 50;
+    Cache cache(1, 100);
+    for (int i = 0; i < kHotKeys; ++i) cache.Put(i, i);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < kHotKeys; ++i) cache.Get(i);
+    }
+
+    // One-off keys must not wash the frequently used ones out
+    for (int i = 1000; i < 11'000; ++i) cache.Put(i, i);
+
+    int hits = 0;
+    for (int i = 0; i < kHotKeys; ++i) hits += cache.Get(i).has_value();
+    EXPECT_GE(hits, kHotKeys * 9 / 10);
+}
+
+UTEST(ConcurrentTinyLfu, FrequenciesSurviveUpdateWaySize) {
+    constexpr int kHotKeys = 50;
+    Cache cache(1, 100);
+    for (int i = 0; i < kHotKeys; ++i) cache.Put(i, i);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < kHotKeys; ++i) cache.Get(i);
+    }
+
+    cache.UpdateWaySize(200);
+
+    // Each new key is requested once before the Put, so it would win against
+    // the hot keys if their frequencies were lost on resize
+    for (int i = 1000; i < 2000; ++i) {
+        cache.Get(i);
+        cache.Put(i, i);
+    }
+
+    int hits = 0;
+    for (int i = 0; i < kHotKeys; ++i) hits += cache.Get(i).has_value();
+    EXPECT_GE(hits, kHotKeys * 9 / 10);
+}
+
+UTEST(ConcurrentTinyLfu, UpdateWaySize) {
+    Cache cache(1, 10);
+    for (int i = 0; i < 10; ++i) cache.Put(i, i);
+
+    cache.UpdateWaySize(1000);
+    EXPECT_EQ(10, cache.GetSize());
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(i, cache.Get(i));
+
+    for (int i = 10; i < 1000; ++i) cache.Put(i, i);
+    EXPECT_EQ(1000, cache.GetSize());
+
+    cache.UpdateWaySize(10);
+    EXPECT_EQ(10, cache.GetSize());
+}
+
+UTEST_MT(ConcurrentTinyLfu, ConcurrentReadsAndWrites, 4) {
+    constexpr int kKeys = 1000;
+    cache::ConcurrentTinyLfu<int, std::string> cache(4, kKeys / 8);
+    std::atomic<bool> is_running{true};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < 3; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, &is_running, i] {
+            for (int key = i; is_running; key = (key + 7) % kKeys) {
+                if (auto value = cache.Get(key)) {
+                    EXPECT_EQ(std::to_string(key), *value);
+                }
+            }
+        }));
+    }
+
+    for (int iteration = 0; iteration < 20'000; ++iteration) {
+        const int key = iteration % kKeys;
+        if (iteration % 97 == 0) {
+            cache.InvalidateByKey(key);
+        } else {
+            cache.Put(key, std::to_string(key));
+        }
+        if (iteration % 5000 == 0) {
+            cache.UpdateWaySize(kKeys / 8 + iteration / 5000);
+            engine::Yield();
+        }
+    }
+
+    is_running = false;
+    for (auto& task : tasks) task.Get();
+}
+
+USERVER_NAMESPACE_END
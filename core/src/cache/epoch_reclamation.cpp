@@ -0,0 +1,110 @@
+#include <userver/cache/impl/epoch_reclamation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+// The classic epoch-based reclamation (K. Fraser, "Practical lock-freedom"):
+// the global epoch advances only when all the active readers have observed
+// the current one, so an object retired at the epoch E is unreachable for
+// all the readers once the global epoch reaches E + 2.
+struct alignas(concurrent::impl::kDestructiveInterferenceSize) EpochRecord final {
+    static constexpr std::uint64_t kIdle = std::numeric_limits<std::uint64_t>::max();
+
+    std::atomic<std::uint64_t> epoch{kIdle};
+    // Only accessed by the owning thread
+    std::size_t depth{0};
+    EpochRecord* next{nullptr};
+};
+
+namespace {
+
+// Retirements between the attempts to advance the epoch
+constexpr std::size_t kReclaimBatch = 64;
+
+std::atomic<std::uint64_t> global_epoch{0};
+
+// The records are never freed: there are few threads and they live long
+std::atomic<EpochRecord*> records_head{nullptr};
+
+compiler::ThreadLocal local_record = [] { return static_cast<EpochRecord*>(nullptr); };
+
+EpochRecord& RegisterRecord() {
+    auto* record = new EpochRecord();
+    auto* head = records_head.load();
+    do {
+        record->next = head;
+    } while (!records_head.compare_exchange_weak(head, record));
+    return *record;
+}
+
+void TryAdvanceEpoch() noexcept {
+    auto epoch = global_epoch.load();
+    for (auto* record = records_head.load(); record; record = record->next) {
+        const auto record_epoch = record->epoch.load();
+        if (record_epoch != EpochRecord::kIdle && record_epoch != epoch) {
+            return;
+        }
+    }
+    global_epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+}  // namespace
+
+EpochGuard::EpochGuard() : record_scope_(local_record.Use()) {
+    auto& record = *record_scope_;
+    if (!record) {
+        record = &RegisterRecord();
+    }
+    if (record->depth++ == 0) {
+        record->epoch.store(global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // Pairs with the fence in RetiredList: either the writer sees this
+        // record, or the reader sees the object unlinked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+EpochGuard::~EpochGuard() {
+    auto* record = *record_scope_;
+    if (--record->depth == 0) {
+        record->epoch.store(EpochRecord::kIdle, std::memory_order_release);
+    }
+}
+
+RetiredList::~RetiredList() {
+    for (const auto& retired : retired_) {
+        retired.deleter(retired.ptr);
+    }
+}
+
+void RetiredList::Retire(void* ptr, Deleter deleter) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    retired_.push_back({ptr, deleter, global_epoch.load(std::memory_order_relaxed)});
+    if (retired_.size() % kReclaimBatch == 0) {
+        Reclaim();
+    }
+}
+
+void RetiredList::Reclaim() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    TryAdvanceEpoch();
+    const auto epoch = global_epoch.load();
+
+    const auto it = std::partition(retired_.begin(), retired_.end(), [epoch](const Retired& retired) {
+        return retired.epoch + 2 > epoch;
+    });
+    for (auto reclaimed = it; reclaimed != retired_.end(); ++reclaimed) {
+        reclaimed->deleter(reclaimed->ptr);
+    }
+    retired_.erase(it, retired_.end());
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -417,6 +417,41 @@ UTEST(ExpirableLruCache, Example) {
     /// [Sample ExpirableLruCache]
 }
 
+UTEST(ExpirableLruCache, ConcurrentTinyLfuPolicy) {
+    using Cache = cache::ExpirableLruCache<
+        SimpleCacheKey,
+        SimpleCacheValue,
+        std::hash<SimpleCacheKey>,
+        std::equal_to<SimpleCacheKey>,
+        cache::CachePolicy::kConcurrentTinyLfu>;
+    auto counter = std::make_shared<Counter>();
+
+    Cache cache(2, 10);
+    cache.SetMaxLifetime(std::chrono::seconds(2));
+    utils::datetime::MockNowSet(std::chrono::system_clock::now());
+    const SimpleCacheKey key = "my-key";
+
+    counter->Flush();
+    EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+    EXPECT_EQ(1, cache.Get(key, UpdateNever()));
+    EXPECT_EQ(Counter::One(), *counter);
+
+    dump::MockWriter writer;
+    cache.Write(writer);
+    writer.Finish();
+    cache.Invalidate();
+    EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(key));
+
+    dump::MockReader reader(std::move(writer).Extract());
+    cache.Read(reader);
+    reader.Finish();
+    EXPECT_EQ(1, cache.GetOptionalNoUpdate(key));
+
+    utils::datetime::MockSleep(std::chrono::seconds(3));
+    EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(key));
+    EXPECT_EQ(2, cache.Get(key, UpdateValue(counter, 2)));
+}
+
 UTEST(LruCacheWrapper, HitWrapper) {
     auto counter = std::make_shared<Counter>();
 
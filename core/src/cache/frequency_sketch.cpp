@@ -0,0 +1,119 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kDepth = 4;
+constexpr std::uint64_t kCounterMask = 0xF;
+// Counters are halved after 10 * capacity increments, as in the TinyLFU paper
+constexpr std::uint64_t kSampleSizeFactor = 10;
+// Clears the high bit of each 4-bit counter after the shift
+constexpr std::uint64_t kHalfMask = 0x7777777777777777ULL;
+
+constexpr std::uint64_t kSeeds[kDepth] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL,
+};
+
+// Each row picks a word and one of the 16 counters in it
+struct CounterPosition final {
+    std::size_t word;
+    unsigned shift;
+};
+
+CounterPosition GetPosition(std::uint64_t hash, std::size_t row, std::size_t mask) noexcept {
+    auto h = (hash + kSeeds[row]) * kSeeds[row];
+    h ^= h >> 32;
+    return {static_cast<std::size_t>(h) & mask, static_cast<unsigned>((h >> 60) << 2)};
+}
+
+std::uint64_t MaxCounters(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+    std::uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 4) {
+        result |= std::max(lhs & (kCounterMask << shift), rhs & (kCounterMask << shift));
+    }
+    return result;
+}
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept {
+    std::size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(std::size_t capacity)
+    : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+      table_(std::make_unique<std::atomic<std::uint64_t>[]>(mask_ + 1)),
+      sample_size_(kSampleSizeFactor * std::max<std::size_t>(capacity, 1)) {
+    Clear();
+}
+
+FrequencySketch::FrequencySketch(std::size_t capacity, const FrequencySketch& other) : FrequencySketch(capacity) {
+    // A counter keeps its shift, while its word is the hash masked by
+    // the table size, so the words of the other table fold onto ours
+    for (std::size_t i = 0; i <= std::max(mask_, other.mask_); ++i) {
+        auto& counters = table_[i & mask_];
+        const auto value = counters.load(std::memory_order_relaxed);
+        const auto other_value = other.table_[i & other.mask_].load(std::memory_order_relaxed);
+        counters.store(MaxCounters(value, other_value), std::memory_order_relaxed);
+    }
+
+    const auto additions = other.additions_.load(std::memory_order_relaxed);
+    additions_.store(std::min(additions, sample_size_ - 1), std::memory_order_relaxed);
+}
+
+void FrequencySketch::Increment(std::uint64_t hash) noexcept {
+    bool added = false;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+        const auto [word, shift] = GetPosition(hash, row, mask_);
+        auto& counters = table_[word];
+        const auto value = counters.load(std::memory_order_relaxed);
+        if (((value >> shift) & kCounterMask) != kCounterMask) {
+            // Not an RMW on purpose: a lost increment is cheaper than a locked
+            // instruction on every cache hit
+            counters.store(value + (std::uint64_t{1} << shift), std::memory_order_relaxed);
+            added = true;
+        }
+    }
+
+    if (added && additions_.fetch_add(1, std::memory_order_relaxed) + 1 == sample_size_) {
+        Age();
+    }
+}
+
+std::uint32_t FrequencySketch::Estimate(std::uint64_t hash) const noexcept {
+    auto result = kCounterMask;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+        const auto [word, shift] = GetPosition(hash, row, mask_);
+        result = std::min(result, (table_[word].load(std::memory_order_relaxed) >> shift) & kCounterMask);
+    }
+    return static_cast<std::uint32_t>(result);
+}
+
+void FrequencySketch::Clear() noexcept {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        table_[i].store(0, std::memory_order_relaxed);
+    }
+    additions_.store(0, std::memory_order_relaxed);
+}
+
+void FrequencySketch::Age() noexcept {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        const auto value = table_[i].load(std::memory_order_relaxed);
+        table_[i].store((value >> 1) & kHalfMask, std::memory_order_relaxed);
+    }
+    additions_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
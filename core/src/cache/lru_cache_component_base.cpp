@@ -59,6 +59,10 @@ properties:
         type: string
         description: TTL for cache entries (0 is unlimited)
         defaultDescription: 0
+    max-bytes:
+        type: integer
+        description: max total size of the items in bytes, as estimated by cache::EstimateByteSize (0 is unlimited)
+        defaultDescription: unlimited
     background-update:
         type: boolean
         description: enables asynchronous updates for expiring values
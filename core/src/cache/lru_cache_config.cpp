@@ -1,5 +1,6 @@
 #include <userver/cache/lru_cache_config.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <userver/components/component_config.hpp>
@@ -18,6 +19,7 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kMaxBytes = "max-bytes";
 
 }  // namespace
 
@@ -28,7 +30,8 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(
           config[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      ),
+      max_bytes(config[kMaxBytes].As<std::optional<std::size_t>>()) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +43,8 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(
           value[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      ),
+      max_bytes(value[kMaxBytes].As<std::optional<std::size_t>>()) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -49,6 +53,11 @@ std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
     return way_size == 0 ? 1 : way_size;
 }
 
+std::size_t LruCacheConfig::GetWayMaxBytes(std::size_t ways) const {
+    if (!max_bytes || *max_bytes == 0) return 0;
+    return std::max<std::size_t>(*max_bytes / ways, 1);
+}
+
 LruCacheConfig Parse(const formats::json::Value& value, formats::parse::To<LruCacheConfig>) {
     return LruCacheConfig{value};
 }
@@ -1,5 +1,10 @@
 #include <userver/utest/utest.hpp>
 
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/byte_size.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -64,4 +69,61 @@ UTEST(NWayLRU, HashCombine) {
     }
 }
 
+UTEST(NWayLRU, MaxBytes) {
+    cache::NWayLRU<int, std::string> cache(1, 100);
+    cache.SetWeigher([](int, const std::string& value) { return value.size(); });
+    cache.UpdateWayMaxBytes(100);
+
+    cache.Put(1, std::string(40, 'a'));
+    cache.Put(2, std::string(40, 'b'));
+    EXPECT_EQ(80, cache.GetBytes());
+
+    EXPECT_TRUE(cache.Get(1).has_value());
+    cache.Put(3, std::string(40, 'c'));
+    EXPECT_EQ(80, cache.GetBytes());
+    EXPECT_EQ(2, cache.GetSize());
+    EXPECT_FALSE(cache.Get(2).has_value());
+
+    cache.Put(1, std::string(10, 'a'));
+    EXPECT_EQ(50, cache.GetBytes());
+
+    cache.InvalidateByKey(3);
+    EXPECT_EQ(10, cache.GetBytes());
+
+    // Too big to fit at all
+    cache.Put(4, std::string(200, 'd'));
+    EXPECT_FALSE(cache.Get(4).has_value());
+    EXPECT_EQ(0, cache.GetBytes());
+}
+
+UTEST(NWayLRU, MaxBytesUpdate) {
+    cache::NWayLRU<int, std::string> cache(1, 3);
+    cache.SetWeigher([](int, const std::string& value) { return value.size(); });
+
+    for (int i = 0; i < 5; ++i) cache.Put(i, std::string(10, 'a'));
+    EXPECT_EQ(3, cache.GetSize());
+    EXPECT_EQ(30, cache.GetBytes());
+
+    cache.UpdateWaySize(2);
+    EXPECT_EQ(20, cache.GetBytes());
+
+    cache.UpdateWayMaxBytes(10);
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(10, cache.GetBytes());
+    EXPECT_TRUE(cache.Get(4).has_value());
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetBytes());
+}
+
+UTEST(NWayLRU, EstimateByteSize) {
+    EXPECT_EQ(sizeof(int), cache::EstimateByteSize(1));
+    EXPECT_EQ(sizeof(std::string), cache::EstimateByteSize(std::string{}));
+    EXPECT_GE(cache::EstimateByteSize(std::string(1000, 'a')), sizeof(std::string) + 1000);
+
+    const std::vector<std::string> strings(10, std::string(1000, 'a'));
+    EXPECT_GE(cache::EstimateByteSize(strings), 10 * (sizeof(std::string) + 1000));
+    EXPECT_EQ(sizeof(std::optional<int>), cache::EstimateByteSize(std::optional<int>{}));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,137 @@
+#include <userver/cache/shared_chunked_map.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::SharedChunkedMap<int, std::string>;
+
+Map MakeMap(int size) {
+    Map map;
+    for (int i = 0; i < size; ++i) map.insert_or_assign(i, std::to_string(i));
+    return map;
+}
+
+// Not default constructible, so the map has to keep the passed one
+class SeededHash final {
+public:
+    explicit SeededHash(std::size_t seed) : seed_(seed) {}
+
+    std::size_t operator()(int key) const { return std::hash<int>{}(key) ^ seed_; }
+
+    std::size_t GetSeed() const { return seed_; }
+
+private:
+    std::size_t seed_;
+};
+
+}  // namespace
+
+TEST(SharedChunkedMap, Basic) {
+    Map map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.erase(1), 0);
+
+    map.insert_or_assign(1, "a");
+    EXPECT_TRUE(map.insert({2, "b"}));
+    EXPECT_FALSE(map.insert({2, "c"}));
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(2), "b");
+
+    map.insert_or_assign(2, "c");
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(2), "c");
+
+    EXPECT_EQ(map.erase(1), 1);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_THROW(map.at(1), std::out_of_range);
+    EXPECT_EQ(map.size(), 1);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(SharedChunkedMap, Grow) {
+    constexpr int kSize = 10'000;
+    const auto map = MakeMap(kSize);
+    EXPECT_EQ(map.size(), kSize);
+    EXPECT_GT(map.GetChunksCount(), 1);
+
+    std::unordered_map<int, std::string> visited;
+    for (const auto& [key, value] : map) {
+        EXPECT_TRUE(visited.emplace(key, value).second);
+    }
+    EXPECT_EQ(visited.size(), kSize);
+    for (int i = 0; i < kSize; ++i) EXPECT_EQ(map.at(i), std::to_string(i));
+}
+
+TEST(SharedChunkedMap, CopyOnWrite) {
+    const auto original = MakeMap(10'000);
+
+    auto copy = original;
+    copy.insert_or_assign(1, "changed");
+    copy.insert_or_assign(-1, "new");
+    copy.erase(2);
+    copy.erase(-2);
+
+    EXPECT_EQ(original.size(), 10'000);
+    EXPECT_EQ(original.at(1), "1");
+    EXPECT_FALSE(original.contains(-1));
+    EXPECT_EQ(original.at(2), "2");
+
+    EXPECT_EQ(copy.size(), 10'000);
+    EXPECT_EQ(copy.at(1), "changed");
+    EXPECT_EQ(copy.at(-1), "new");
+    EXPECT_FALSE(copy.contains(2));
+    EXPECT_EQ(copy.at(3), "3");
+    EXPECT_NE(copy, original);
+
+    copy.insert_or_assign(1, "1");
+    copy.insert_or_assign(2, "2");
+    copy.erase(-1);
+    EXPECT_EQ(copy, original);
+}
+
+TEST(SharedChunkedMap, GrowShared) {
+    const auto original = MakeMap(1'000);
+
+    auto copy = original;
+    for (int i = 1'000; i < 10'000; ++i) copy.insert_or_assign(i, std::to_string(i));
+
+    EXPECT_EQ(original.size(), 1'000);
+    EXPECT_EQ(original.at(999), "999");
+    EXPECT_FALSE(original.contains(1'000));
+    EXPECT_EQ(copy, MakeMap(10'000));
+}
+
+TEST(SharedChunkedMap, StatefulHash) {
+    cache::SharedChunkedMap<int, int, SeededHash> map{SeededHash{42}};
+    for (int i = 0; i < 10'000; ++i) map.insert_or_assign(i, i);
+    EXPECT_GT(map.GetChunksCount(), 1);
+    EXPECT_EQ(map.hash_function().GetSeed(), 42);
+
+    auto copy = map;
+    copy.erase(1);
+    EXPECT_EQ(copy.hash_function().GetSeed(), 42);
+    EXPECT_FALSE(copy.contains(1));
+    EXPECT_EQ(map.at(1), 1);
+    for (int i = 2; i < 10'000; ++i) EXPECT_EQ(copy.at(i), i);
+}
+
+TEST(SharedChunkedMap, Dump) {
+    dump::TestWriteReadCycle(Map{});
+    dump::TestWriteReadCycle(MakeMap(1'000));
+}
+
+USERVER_NAMESPACE_END
@@ -111,6 +111,26 @@ properties:
                     lead to inaccuracy in coro pool size estimation.
                     local_cache_size=0 disables local cache.
                 defaultDescription: 8
+            idle_stack_release:
+                type: string
+                description: |
+                    Give the memory of idle coroutine stacks back to the OS
+                    when they leave the worker thread local cache, at most
+                    once per 100ms per worker thread: 'free' uses MADV_FREE
+                    (lazy reclaim), 'dontneed' uses MADV_DONTNEED (RSS drops
+                    immediately), 'none' keeps the touched stack pages
+                    resident.
+                defaultDescription: none
+                enum:
+                  - none
+                  - free
+                  - dontneed
+            retained_stack_size:
+                type: integer
+                description: |
+                    amount of bytes at the beginning of an idle stack that are
+                    never released, at least 16KiB
+                defaultDescription: 16 * 1024
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -121,6 +141,17 @@ properties:
                 description: >
                     number of threads to process low level IO system calls
                     (number of ev loops to start in libev)
+            io_uring_enabled:
+                type: boolean
+                description: >
+                    submit socket and file I/O to per ev thread io_uring instead
+                    of waiting for readiness via libev; falls back to libev if
+                    io_uring is not supported by the kernel
+                defaultDescription: false
+            io_uring_entries:
+                type: integer
+                description: submission queue size of each io_uring
+                defaultDescription: 256
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -173,6 +204,29 @@ properties:
                     enum:
                       - global-task-queue
                       - work-stealing-task-queue
+                numa-aware:
+                    type: boolean
+                    description: |
+                        split the workers into per-NUMA-node groups, bind each
+                        group to the CPUs and memory of its node; with
+                        `work-stealing-task-queue` the workers steal from other
+                        nodes only when they run out of node-local tasks
+                    defaultDescription: false
+                task-priorities:
+                    type: boolean
+                    description: |
+                        schedule tasks with a close deadline before the others
+                        and background tasks (e.g. periodic cache updates)
+                        after them; a task may set its own priority with
+                        engine::current_task::SetPriority
+                    defaultDescription: false
+                urgent-deadline-threshold:
+                    type: string
+                    description: |
+                        with `task-priorities`, tasks that have less than this
+                        time left until their deadline are considered urgent;
+                        0 disables the deadline-based scheduling
+                    defaultDescription: 20ms
                 task-trace:
                     type: object
                     description: .
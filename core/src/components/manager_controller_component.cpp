@@ -47,6 +47,7 @@ void DumpMetric(utils::statistics::Writer& writer, const engine::TaskProcessor&
     }
 
     writer["worker-threads"] = task_processor.GetWorkerCount();
+    writer["active-worker-threads"] = task_processor.GetActiveWorkerCount();
 }
 
 }  // namespace engine
@@ -103,6 +104,10 @@ void ManagerControllerComponent::WriteStatistics(utils::statistics::Writer& writ
             stack_usage_stats["max-usage-percent"] = stats.max_stack_usage_pct;
             stack_usage_stats["is-monitor-active"] = stats.is_stack_usage_monitor_active;
         }
+        if (auto stack_memory_stats = coro_pool["stack-memory"]) {
+            stack_memory_stats["address-space-bytes"] = stats.stack_address_space_bytes;
+            stack_memory_stats["advised-bytes"] = stats.stack_advised_bytes;
+        }
     }
 
     // misc
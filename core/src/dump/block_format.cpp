@@ -0,0 +1,32 @@
+#include <dump/block_format.hpp>
+
+#include <userver/dump/unsafe.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+void WriteBlockIndex(FileWriter& file, std::string_view index, const BlockTrailer& trailer) {
+    WriteStringViewUnsafe(file, index);
+    WriteStringViewUnsafe(file, AsBytes(&trailer, 1));
+}
+
+bool IsValidBlockTrailer(
+    const BlockTrailer& trailer,
+    std::uint64_t magic,
+    std::uint64_t file_size,
+    std::size_t index_entry_size
+) noexcept {
+    UASSERT(index_entry_size > 0);
+    if (trailer.magic != magic || trailer.block_size != kBlockSize || file_size < sizeof(BlockTrailer)) {
+        return false;
+    }
+
+    const auto payload_size = file_size - sizeof(BlockTrailer);
+    return trailer.data_size <= payload_size && trailer.blocks_count <= payload_size / index_entry_size &&
+           trailer.data_size + trailer.blocks_count * index_entry_size == payload_size;
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <userver/dump/operations_file.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// Size of the blocks of the dump files that are processed by parallel tasks,
+/// see MappedFileWriter and ChunkedFileWriter. Large enough to amortize the
+/// task overhead and for a good compression ratio, small enough to load all
+/// the workers for the dumps of a few hundred MB.
+inline constexpr std::size_t kBlockSize = 4 * 1024 * 1024;
+
+inline constexpr std::uint64_t kMappedDumpMagic = 0x9a3b'5f1d'7e24'c6a1;
+inline constexpr std::uint64_t kChunkedDumpMagic = 0x3c1e'92d4'a7b5'f068;
+
+/// The end of a dump file of blocks. The file is `data, block index, trailer`,
+/// the format of the block index entries depends on the magic. Must not change
+/// between releases, otherwise the existing dumps are rejected.
+// TODO: endianness, as in dump::impl::WriteTrivial
+struct BlockTrailer final {
+    std::uint64_t blocks_count{0};
+    /// The size of the data preceding the block index
+    std::uint64_t data_size{0};
+    std::uint64_t block_size{0};
+    std::uint64_t magic{0};
+};
+
+static_assert(sizeof(BlockTrailer) == 4 * sizeof(std::uint64_t));
+
+template <typename T>
+std::string_view AsBytes(const T* data, std::size_t count) noexcept {
+    return {reinterpret_cast<const char*>(data), count * sizeof(T)};
+}
+
+// TODO: endianness, as in dump::impl::ReadTrivial
+template <typename T>
+T LoadTrivial(std::string_view data, std::size_t offset) noexcept {
+    UASSERT(offset <= data.size() && sizeof(T) <= data.size() - offset);
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+/// Writes the block index followed by the trailer
+void WriteBlockIndex(FileWriter& file, std::string_view index, const BlockTrailer& trailer);
+
+/// Checks that the trailer with the `magic` fits a file of `file_size` bytes,
+/// which block index entries are `index_entry_size` bytes each
+bool IsValidBlockTrailer(
+    const BlockTrailer& trailer,
+    std::uint64_t magic,
+    std::uint64_t file_size,
+    std::size_t index_entry_size
+) noexcept;
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
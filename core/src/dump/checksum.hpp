@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <utils/impl/byte_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// Checksum of a block of a dump file. Must not change between releases,
+/// otherwise the existing dumps are rejected.
+inline std::uint64_t Checksum(std::string_view block) noexcept {
+    static const utils::impl::SipHasher hasher{0x6475'6d70'6d61'7070, 0x7573'6572'7665'7221};
+    return hasher(block);
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
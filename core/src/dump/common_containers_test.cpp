@@ -203,4 +203,17 @@ TEST(DumpCommonContainers, MultiIndexWithoutReserve) {
     TestWriteReadCycle(dummies);
 }
 
+TEST(DumpCommonContainers, TrivialVector) {
+    const std::vector<double> original{1.5, -2.5, 3.5};
+
+    dump::MockWriter writer;
+    dump::WriteTrivialVector(writer, original);
+    dump::WriteTrivialVector(writer, std::vector<int>{});
+    dump::MockReader reader(std::move(writer).Extract());
+
+    EXPECT_EQ(dump::ReadTrivialVector<double>(reader), original);
+    EXPECT_EQ(dump::ReadTrivialVector<int>(reader), std::vector<int>{});
+    reader.Finish();
+}
+
 USERVER_NAMESPACE_END
@@ -18,9 +18,13 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMmap = "mmap";
+constexpr std::string_view kChunked = "chunked";
+constexpr std::string_view kZstdLevel = "zstd-level";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
+constexpr auto kDefaultCompressionLevel = 1;
 
 }  // namespace
 
@@ -61,6 +65,9 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config, std::str
       max_dump_age(config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      dump_is_mapped(config[kMmap].As<bool>(false)),
+      dump_is_chunked(config[kChunked].As<bool>(false)),
+      compression_level(config[kZstdLevel].As<int>(kDefaultCompressionLevel)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
     if (max_dump_age && *max_dump_age <= std::chrono::milliseconds::zero()) {
@@ -69,6 +76,14 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config, std::str
     if (max_dump_count == 0) {
         throw std::logic_error(fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
     }
+    if (dump_is_encrypted && dump_is_mapped) {
+        throw std::logic_error(fmt::format("{}: {} and {} can not be used together", this->name, kEncrypted, kMmap));
+    }
+    if (dump_is_chunked && (dump_is_encrypted || dump_is_mapped)) {
+        throw std::logic_error(fmt::format(
+            "{}: {} can not be used together with {} or {}", this->name, kChunked, kEncrypted, kMmap
+        ));
+    }
 }
 
 DynamicConfig::DynamicConfig(const Config& config, ConfigPatch&& patch)
@@ -564,6 +564,20 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: |
+                    Whether to write the dump with block checksums and read it via mmap, incompatible with `encrypted`.
+                    Changes the dump format, so bump `format-version` along with it
+                defaultDescription: false
+            chunked:
+                type: boolean
+                description: Whether to compress the dump in chunks by parallel tasks, incompatible with `encrypted` and `mmap`
+                defaultDescription: false
+            zstd-level:
+                type: integer
+                description: zstd compression level of a `chunked` dump
+                defaultDescription: 1
 )");
 }
 
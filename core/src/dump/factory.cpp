@@ -1,8 +1,10 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_chunked.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mapped.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,12 +32,18 @@ CreateOperationsFactory(const Config& config, const components::ComponentContext
         auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
         return std::make_unique<dump::EncryptedOperationsFactory>(std::move(secret_key), dump_perms);
     } else {
-        return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+        return CreateDefaultOperationsFactory(config);
     }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(const Config& config) {
     auto dump_perms = GetPerms(config);
+    if (config.dump_is_mapped) {
+        return std::make_unique<dump::MappedOperationsFactory>(dump_perms);
+    }
+    if (config.dump_is_chunked) {
+        return std::make_unique<dump::ChunkedOperationsFactory>(dump_perms, config.compression_level);
+    }
     return std::make_unique<dump::FileOperationsFactory>(dump_perms);
 }
 
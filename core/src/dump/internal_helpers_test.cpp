@@ -11,6 +11,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) { return dir.GetPath() + "/dump"; }
+
 dump::Config ConfigFromYaml(
     const std::string& yaml_string,
     const fs::blocking::TempDirectory& dump_root,
@@ -5,6 +5,8 @@
 #include <string_view>
 #include <vector>
 
+#include <boost/filesystem/operations.hpp>
+
 #include <userver/dump/config.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/utest/utest.hpp>
@@ -15,6 +17,11 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+inline constexpr auto kDumpFilePerms = boost::filesystem::perms::owner_read | boost::filesystem::perms::owner_write;
+
+/// Path of a dump file inside `dir`, for the tests of the file operations
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir);
+
 Config ConfigFromYaml(
     const std::string& yaml_string,
     const fs::blocking::TempDirectory& dump_root,
@@ -0,0 +1,319 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <dump/block_format.hpp>
+#include <dump/checksum.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/compression/zstd.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// TODO: endianness, as in dump::impl::WriteTrivial
+struct ChunkInfo final {
+    std::uint64_t compressed_size;
+    std::uint64_t size;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(ChunkInfo) == 3 * sizeof(std::uint64_t));
+
+struct CompressedChunk final {
+    std::string data;
+    ChunkInfo info;
+};
+
+std::size_t GetParallelism() {
+    return std::max<std::size_t>(engine::current_task::GetTaskProcessor().GetWorkerCount(), 1);
+}
+
+CompressedChunk CompressChunk(const std::string& chunk, int compression_level) {
+    auto compressed = compression::zstd::Compress(chunk, compression_level);
+    const ChunkInfo info{compressed.size(), chunk.size(), impl::Checksum(compressed)};
+    return {std::move(compressed), info};
+}
+
+void ReadAt(int fd, char* data, std::size_t size, std::uint64_t offset) {
+    while (size > 0) {
+        const auto bytes_read = ::pread(fd, data, size, static_cast<off_t>(offset));
+        if (bytes_read < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "pread");
+        }
+        if (bytes_read == 0) throw std::runtime_error("unexpected end of file");
+
+        data += bytes_read;
+        size -= bytes_read;
+        offset += bytes_read;
+    }
+}
+
+}  // namespace
+
+struct ChunkedFileWriter::Impl {
+    Impl(std::string&& path, boost::filesystem::perms perms, int compression_level, tracing::ScopeTime& scope)
+        : file(std::move(path), perms, scope), compression_level(compression_level), max_in_flight(GetParallelism()) {
+        buffer.reserve(impl::kBlockSize);
+    }
+
+    void SubmitChunk() {
+        if (in_flight.size() >= max_in_flight) WriteCompletedChunk();
+
+        auto chunk = std::exchange(buffer, std::string{});
+        buffer.reserve(impl::kBlockSize);
+        in_flight.push_back(engine::AsyncNoSpan(
+            engine::current_task::GetTaskProcessor(),
+            [chunk = std::move(chunk), level = compression_level] { return CompressChunk(chunk, level); }
+        ));
+    }
+
+    void WriteCompletedChunk() {
+        UASSERT(!in_flight.empty());
+        const auto chunk = in_flight.front().Get();
+        in_flight.pop_front();
+
+        WriteStringViewUnsafe(file, chunk.data);
+        index.push_back(chunk.info);
+        data_size += chunk.data.size();
+    }
+
+    FileWriter file;
+    const int compression_level;
+    const std::size_t max_in_flight;
+    std::string buffer;
+    std::vector<ChunkInfo> index;
+    std::uint64_t data_size{0};
+    // Must go after all the fields it uses.
+    std::deque<engine::TaskWithResult<CompressedChunk>> in_flight;
+};
+
+ChunkedFileWriter::ChunkedFileWriter(
+    std::string path,
+    boost::filesystem::perms perms,
+    int compression_level,
+    tracing::ScopeTime& scope
+)
+    : impl_(std::make_unique<Impl>(std::move(path), perms, compression_level, scope)) {}
+
+ChunkedFileWriter::~ChunkedFileWriter() = default;
+
+void ChunkedFileWriter::WriteRaw(std::string_view data) {
+    while (!data.empty()) {
+        const auto part_size = std::min(data.size(), impl::kBlockSize - impl_->buffer.size());
+        impl_->buffer.append(data.substr(0, part_size));
+        data.remove_prefix(part_size);
+
+        if (impl_->buffer.size() == impl::kBlockSize) impl_->SubmitChunk();
+    }
+}
+
+void ChunkedFileWriter::Finish() {
+    if (!impl_->buffer.empty()) impl_->SubmitChunk();
+    while (!impl_->in_flight.empty()) impl_->WriteCompletedChunk();
+
+    impl::WriteBlockIndex(
+        impl_->file,
+        impl::AsBytes(impl_->index.data(), impl_->index.size()),
+        {impl_->index.size(), impl_->data_size, impl::kBlockSize, impl::kChunkedDumpMagic}
+    );
+    impl_->file.Finish();
+}
+
+struct ChunkedFileReader::Impl {
+    explicit Impl(std::string&& file_path) : path(std::move(file_path)), file(OpenFile(path)) {}
+
+    static fs::blocking::FileDescriptor OpenFile(const std::string& path) {
+        try {
+            return fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+        } catch (const std::exception& ex) {
+            throw Error(fmt::format("Failed to open the dump file for reading \"{}\". Reason: {}", path, ex.what()));
+        }
+    }
+
+    void ReadIndex() {
+        const auto file_size = file.GetSize();
+        impl::BlockTrailer trailer{};
+        if (file_size >= sizeof(trailer)) {
+            ReadAt(file.GetNative(), reinterpret_cast<char*>(&trailer), sizeof(trailer), file_size - sizeof(trailer));
+        }
+
+        if (!impl::IsValidBlockTrailer(trailer, impl::kChunkedDumpMagic, file_size, sizeof(ChunkInfo))) {
+            throw Error(fmt::format(
+                "The dump file \"{}\" is not a chunked dump or is truncated: file-size={}", path, file_size
+            ));
+        }
+
+        index.resize(trailer.blocks_count);
+        ReadAt(
+            file.GetNative(), reinterpret_cast<char*>(index.data()), index.size() * sizeof(ChunkInfo), trailer.data_size
+        );
+
+        offsets.reserve(index.size());
+        std::uint64_t offset = 0;
+        for (const auto& chunk : index) {
+            if (chunk.size > impl::kBlockSize || chunk.compressed_size > trailer.data_size - offset) {
+                throw Error(fmt::format("Malformed chunk index in the dump file \"{}\"", path));
+            }
+            offsets.push_back(offset);
+            offset += chunk.compressed_size;
+        }
+        if (offset != trailer.data_size) {
+            throw Error(fmt::format("Malformed chunk index in the dump file \"{}\"", path));
+        }
+    }
+
+    std::string LoadChunk(std::size_t chunk_index) const {
+        const auto& info = index[chunk_index];
+        std::string compressed(info.compressed_size, '\0');
+        try {
+            ReadAt(file.GetNative(), compressed.data(), compressed.size(), offsets[chunk_index]);
+        } catch (const std::exception& ex) {
+            throw Error(fmt::format("Failed to read from the dump file \"{}\": {}", path, ex.what()));
+        }
+
+        if (impl::Checksum(compressed) != info.checksum) {
+            throw Error(fmt::format("Checksum mismatch in the dump file \"{}\": chunk={}", path, chunk_index));
+        }
+
+        std::string data;
+        try {
+            data = compression::zstd::Decompress(compressed, info.size);
+        } catch (const std::exception& ex) {
+            throw Error(fmt::format(
+                "Failed to decompress the dump file \"{}\": chunk={}. Reason: {}", path, chunk_index, ex.what()
+            ));
+        }
+        if (data.size() != info.size) {
+            throw Error(fmt::format("Unexpected chunk size in the dump file \"{}\": chunk={}", path, chunk_index));
+        }
+        return data;
+    }
+
+    void ScheduleChunks() {
+        while (next_to_schedule < index.size() && in_flight.size() < max_in_flight) {
+            in_flight.push_back(engine::AsyncNoSpan(
+                engine::current_task::GetTaskProcessor(),
+                [this, chunk_index = next_to_schedule] { return LoadChunk(chunk_index); }
+            ));
+            ++next_to_schedule;
+        }
+    }
+
+    bool HasMoreChunks() const { return next_to_take < index.size(); }
+
+    std::string TakeNextChunk() {
+        UASSERT(HasMoreChunks());
+        ScheduleChunks();
+        auto data = in_flight.front().Get();
+        in_flight.pop_front();
+        ++next_to_take;
+        ScheduleChunks();
+        return data;
+    }
+
+    std::uint64_t GetUnreadSize() const {
+        std::uint64_t result = current.size() - position;
+        for (auto i = next_to_take; i < index.size(); ++i) result += index[i].size;
+        return result;
+    }
+
+    const std::string path;
+    const fs::blocking::FileDescriptor file;
+    const std::size_t max_in_flight{GetParallelism()};
+    std::vector<ChunkInfo> index;
+    std::vector<std::uint64_t> offsets;
+    std::size_t next_to_schedule{0};
+    std::size_t next_to_take{0};
+    // The current chunk, with the unread tail of the previous chunks if a read
+    // spans several of them
+    std::string current;
+    std::size_t position{0};
+    // Must go after all the fields it uses.
+    std::deque<engine::TaskWithResult<std::string>> in_flight;
+};
+
+ChunkedFileReader::ChunkedFileReader(std::string path) : impl_(std::make_unique<Impl>(std::move(path))) {
+    try {
+        impl_->ReadIndex();
+    } catch (const Error&) {
+        throw;
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to read from the dump file \"{}\": {}", impl_->path, ex.what()));
+    }
+    impl_->ScheduleChunks();
+}
+
+ChunkedFileReader::~ChunkedFileReader() = default;
+
+std::string_view ChunkedFileReader::ReadRaw(std::size_t max_size) {
+    auto& impl = *impl_;
+
+    if (impl.current.size() - impl.position < max_size && impl.HasMoreChunks()) {
+        // Keep the unread tail, so that BackUp may return into it
+        std::string merged = impl.current.substr(impl.position);
+        impl.position = 0;
+        while (merged.size() < max_size && impl.HasMoreChunks()) {
+            if (merged.empty()) {
+                merged = impl.TakeNextChunk();
+            } else {
+                merged += impl.TakeNextChunk();
+            }
+        }
+        impl.current = std::move(merged);
+    }
+
+    const auto result = std::string_view{impl.current}.substr(impl.position, max_size);
+    impl.position += result.size();
+    return result;
+}
+
+void ChunkedFileReader::BackUp(std::size_t size) {
+    UASSERT(size <= impl_->position);
+    impl_->position -= size;
+}
+
+void ChunkedFileReader::Finish() {
+    const auto unread_size = impl_->GetUnreadSize();
+    if (unread_size != 0) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the dump file \"{}\": unread-size={}", impl_->path, unread_size
+        ));
+    }
+}
+
+ChunkedOperationsFactory::ChunkedOperationsFactory(boost::filesystem::perms perms, int compression_level)
+    : perms_(perms), compression_level_(compression_level) {}
+
+std::unique_ptr<Reader> ChunkedOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<ChunkedFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> ChunkedOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<ChunkedFileWriter>(std::move(full_path), perms_, compression_level_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
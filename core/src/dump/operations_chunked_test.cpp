@@ -0,0 +1,127 @@
+#include <userver/dump/operations_chunked.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <dump/internal_helpers_test.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kCompressionLevel = 1;
+
+std::string MakeData(std::size_t size) {
+    std::string result(size, '\0');
+    std::uint32_t state = 42;
+    for (auto& c : result) {
+        state = state * 1'103'515'245 + 12'345;
+        c = static_cast<char>('a' + (state >> 16) % 16);
+    }
+    return result;
+}
+
+}  // namespace
+
+UTEST(DumpOperationsChunked, WriteRead) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::ChunkedFileWriter writer(path, dump::kDumpFilePerms, kCompressionLevel, scope_time);
+    writer.Write(42);
+    writer.Write(std::string{"abc"});
+    writer.Finish();
+
+    dump::ChunkedFileReader reader(path);
+    EXPECT_EQ(reader.Read<int>(), 42);
+    EXPECT_EQ(reader.Read<std::string>(), "abc");
+    reader.Finish();
+}
+
+UTEST(DumpOperationsChunked, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::ChunkedFileWriter writer(path, dump::kDumpFilePerms, kCompressionLevel, scope_time);
+    writer.Finish();
+
+    dump::ChunkedFileReader reader(path);
+    reader.Finish();
+}
+
+UTEST_MT(DumpOperationsChunked, ManyChunks, 4) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    std::vector<std::uint64_t> values(3'000'000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = i * i;
+    const auto data = MakeData(20'000'000);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::ChunkedFileWriter writer(path, dump::kDumpFilePerms, kCompressionLevel, scope_time);
+    writer.Write(std::string(100, 'a'));
+    dump::WriteTrivialVector(writer, values);
+    WriteStringViewUnsafe(writer, data);
+    writer.Write(std::string{"end"});
+    writer.Finish();
+
+    EXPECT_LT(fs::blocking::ReadFileContents(path).size(), data.size());
+
+    // The reads span the chunk boundaries
+    dump::ChunkedFileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), std::string(100, 'a'));
+    EXPECT_EQ(dump::ReadTrivialVector<std::uint64_t>(reader), values);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, data.size()), data);
+    EXPECT_EQ(reader.Read<std::string>(), "end");
+    reader.Finish();
+}
+
+UTEST_MT(DumpOperationsChunked, Corrupted, 4) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+    const auto data = MakeData(10'000'000);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::ChunkedFileWriter writer(path, dump::kDumpFilePerms, kCompressionLevel, scope_time);
+    WriteStringViewUnsafe(writer, data);
+    writer.Finish();
+
+    auto contents = fs::blocking::ReadFileContents(path);
+    contents[contents.size() / 2] ^= 1;
+    fs::blocking::RewriteFileContents(path, contents);
+    {
+        dump::ChunkedFileReader reader(path);
+        UEXPECT_THROW_MSG(ReadStringViewUnsafe(reader, data.size()), dump::Error, "Checksum mismatch");
+    }
+
+    contents.resize(contents.size() - 1);
+    fs::blocking::RewriteFileContents(path, contents);
+    UEXPECT_THROW_MSG(dump::ChunkedFileReader{path}, dump::Error, "not a chunked dump");
+}
+
+UTEST(DumpOperationsChunked, UnreadData) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::ChunkedFileWriter writer(path, dump::kDumpFilePerms, kCompressionLevel, scope_time);
+    writer.Write(1);
+    writer.Write(2);
+    writer.Finish();
+
+    dump::ChunkedFileReader reader(path);
+    EXPECT_EQ(reader.Read<int>(), 1);
+    UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+USERVER_NAMESPACE_END
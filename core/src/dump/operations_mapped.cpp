@@ -0,0 +1,185 @@
+#include <userver/dump/operations_mapped.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <dump/block_format.hpp>
+#include <dump/checksum.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+MappedFileWriter::MappedFileWriter(std::string path, boost::filesystem::perms perms, tracing::ScopeTime& scope)
+    : file_(std::move(path), perms, scope) {}
+
+void MappedFileWriter::WriteRaw(std::string_view data) {
+    data_size_ += data.size();
+
+    while (!data.empty()) {
+        if (block_.empty() && data.size() >= impl::kBlockSize) {
+            // Avoid copying large writes into the buffer
+            WriteBlock(data.substr(0, impl::kBlockSize));
+            data.remove_prefix(impl::kBlockSize);
+            continue;
+        }
+
+        const auto part_size = std::min(data.size(), impl::kBlockSize - block_.size());
+        block_.append(data.substr(0, part_size));
+        data.remove_prefix(part_size);
+
+        if (block_.size() == impl::kBlockSize) {
+            WriteBlock(block_);
+            block_.clear();
+        }
+    }
+}
+
+void MappedFileWriter::WriteBlock(std::string_view block) {
+    checksums_.push_back(impl::Checksum(block));
+    WriteStringViewUnsafe(file_, block);
+}
+
+void MappedFileWriter::Finish() {
+    if (!block_.empty()) {
+        WriteBlock(block_);
+        block_.clear();
+    }
+
+    impl::WriteBlockIndex(
+        file_,
+        impl::AsBytes(checksums_.data(), checksums_.size()),
+        {checksums_.size(), data_size_, impl::kBlockSize, impl::kMappedDumpMagic}
+    );
+
+    file_.Finish();
+}
+
+MappedFileReader::MappedFileReader(std::string path) : path_(std::move(path)) {
+    try {
+        auto fd = fs::blocking::FileDescriptor::Open(path_, fs::blocking::OpenFlag::kRead);
+        const auto file_size = fd.GetSize();
+        if (file_size < sizeof(impl::BlockTrailer)) {
+            throw Error(fmt::format("the file is too small to be a mapped dump: size={}", file_size));
+        }
+
+        void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd.GetNative(), 0);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        mapping_ = mapping;
+        mapping_size_ = file_size;
+        // The file is read as a whole, start the readahead before the
+        // checksum tasks fault in the pages
+        ::madvise(mapping_, mapping_size_, MADV_WILLNEED);
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to map the dump file \"{}\". Reason: {}", path_, ex.what()));
+    }
+
+    try {
+        ParseTrailer();
+    } catch (...) {
+        ::munmap(mapping_, mapping_size_);
+        throw;
+    }
+}
+
+void MappedFileReader::ParseTrailer() {
+    const std::string_view file{static_cast<const char*>(mapping_), mapping_size_};
+    const auto trailer = impl::LoadTrivial<impl::BlockTrailer>(file, file.size() - sizeof(impl::BlockTrailer));
+
+    if (!impl::IsValidBlockTrailer(trailer, impl::kMappedDumpMagic, file.size(), sizeof(std::uint64_t)) ||
+        trailer.blocks_count != (trailer.data_size + impl::kBlockSize - 1) / impl::kBlockSize) {
+        throw Error(fmt::format(
+            "The dump file \"{}\" is not a mapped dump or is truncated: file-size={}, data-size={}, blocks={}",
+            path_,
+            file.size(),
+            trailer.data_size,
+            trailer.blocks_count
+        ));
+    }
+
+    data_ = file.substr(0, trailer.data_size);
+    VerifyChecksums(file.substr(trailer.data_size, trailer.blocks_count * sizeof(std::uint64_t)));
+}
+
+MappedFileReader::~MappedFileReader() {
+    if (mapping_) ::munmap(mapping_, mapping_size_);
+}
+
+void MappedFileReader::VerifyChecksums(std::string_view checksums) const {
+    const std::size_t blocks_count = checksums.size() / sizeof(std::uint64_t);
+    if (blocks_count == 0) return;
+
+    auto& task_processor = engine::current_task::GetTaskProcessor();
+    const auto tasks_count = std::min(blocks_count, std::max<std::size_t>(task_processor.GetWorkerCount(), 1));
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(tasks_count);
+    for (std::size_t task_index = 0; task_index < tasks_count; ++task_index) {
+        tasks.push_back(engine::AsyncNoSpan(task_processor, [&, task_index] {
+            for (std::size_t block = task_index; block < blocks_count; block += tasks_count) {
+                const auto offset = block * impl::kBlockSize;
+                const auto actual = impl::Checksum(data_.substr(offset, impl::kBlockSize));
+                if (actual != impl::LoadTrivial<std::uint64_t>(checksums, block * sizeof(std::uint64_t))) {
+                    throw Error(fmt::format(
+                        "Checksum mismatch in the dump file \"{}\": block={}, offset={}", path_, block, offset
+                    ));
+                }
+            }
+        }));
+    }
+    engine::GetAll(tasks);
+}
+
+std::string_view MappedFileReader::ReadRaw(std::size_t max_size) {
+    const auto result = data_.substr(position_, max_size);
+    position_ += result.size();
+    return result;
+}
+
+void MappedFileReader::BackUp(std::size_t size) {
+    UASSERT(size <= position_);
+    position_ -= size;
+}
+
+void MappedFileReader::Finish() {
+    if (position_ != data_.size()) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the dump file \"{}\": "
+            "file-size={}, position={}, unread-size={}",
+            path_,
+            data_.size(),
+            position_,
+            data_.size() - position_
+        ));
+    }
+}
+
+MappedOperationsFactory::MappedOperationsFactory(boost::filesystem::perms perms) : perms_(perms) {}
+
+std::unique_ptr<Reader> MappedOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<MappedFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MappedOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<MappedFileWriter>(std::move(full_path), perms_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <userver/dump/operations_mapped.hpp>
+
+#include <string>
+#include <vector>
+
+#include <dump/internal_helpers_test.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(DumpOperationsMapped, WriteRead) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, dump::kDumpFilePerms, scope_time);
+    writer.Write(42);
+    writer.Write(std::string{"abc"});
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(reader.Read<int>(), 42);
+    EXPECT_EQ(reader.Read<std::string>(), "abc");
+    reader.Finish();
+}
+
+UTEST(DumpOperationsMapped, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, dump::kDumpFilePerms, scope_time);
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    reader.Finish();
+}
+
+UTEST_MT(DumpOperationsMapped, ManyBlocks, 4) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    std::vector<std::uint64_t> values(3'000'000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = i * i;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, dump::kDumpFilePerms, scope_time);
+    writer.Write(std::string(100, 'a'));
+    dump::WriteTrivialVector(writer, values);
+    WriteStringViewUnsafe(writer, std::string(5'000'000, 'b'));
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), std::string(100, 'a'));
+    EXPECT_EQ(dump::ReadTrivialVector<std::uint64_t>(reader), values);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 5'000'000), std::string(5'000'000, 'b'));
+    reader.Finish();
+}
+
+UTEST_MT(DumpOperationsMapped, Corrupted, 4) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, dump::kDumpFilePerms, scope_time);
+    WriteStringViewUnsafe(writer, std::string(10'000'000, 'a'));
+    writer.Finish();
+
+    auto contents = fs::blocking::ReadFileContents(path);
+    contents[9'000'000] = 'b';
+    fs::blocking::RewriteFileContents(path, contents);
+    UEXPECT_THROW_MSG(dump::MappedFileReader{path}, dump::Error, "Checksum mismatch");
+
+    contents.resize(contents.size() - 1);
+    fs::blocking::RewriteFileContents(path, contents);
+    UEXPECT_THROW_MSG(dump::MappedFileReader{path}, dump::Error, "not a mapped dump");
+}
+
+UTEST(DumpOperationsMapped, UnreadData) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dump::DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, dump::kDumpFilePerms, scope_time);
+    writer.Write(1);
+    writer.Write(2);
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(reader.Read<int>(), 1);
+    UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#include <userver/dump/parallel_containers.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <engine/task/task_processor.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// Small parts balance the load between the workers, large parts amortize the
+// task overhead
+constexpr std::size_t kMinPartSize = 10'000;
+constexpr std::size_t kPartsPerWorker = 4;
+
+// Bounds the memory that a corrupted dump makes the reader reserve
+constexpr std::size_t kMaxPartsCount = 1024;
+
+std::size_t GetMaxPartsCount(std::size_t size) {
+    return std::min(kMaxPartsCount, (size + kMinPartSize - 1) / kMinPartSize);
+}
+
+}  // namespace
+
+StringWriter::StringWriter() = default;
+
+void StringWriter::WriteRaw(std::string_view data) { data_.append(data); }
+
+void StringWriter::Finish() {
+    // nothing to do
+}
+
+std::string StringWriter::Extract() && { return std::move(data_); }
+
+StringReader::StringReader(std::string data) : data_(std::move(data)) {}
+
+std::string_view StringReader::ReadRaw(std::size_t max_size) {
+    UASSERT(pos_ <= data_.size());
+    const auto result = std::string_view{data_}.substr(pos_, max_size);
+    pos_ += result.size();
+    return result;
+}
+
+void StringReader::BackUp(std::size_t size) {
+    UASSERT_MSG(size <= pos_, "Trying to BackUp more bytes than returned by the last ReadRaw");
+    pos_ -= size;
+}
+
+void StringReader::Finish() {
+    if (pos_ != data_.size()) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of a container part: part-size={}, position={}", data_.size(), pos_
+        ));
+    }
+}
+
+std::size_t GetPartsInFlight() {
+    return std::max<std::size_t>(engine::current_task::GetTaskProcessor().GetWorkerCount(), 1);
+}
+
+std::size_t GetPartsCount(std::size_t size) {
+    return std::min(GetPartsInFlight() * kPartsPerWorker, GetMaxPartsCount(size));
+}
+
+void CheckPartsCount(std::size_t size, std::size_t parts_count) {
+    if ((size == 0) != (parts_count == 0) || parts_count > GetMaxPartsCount(size)) {
+        throw Error(fmt::format("Malformed container written in parts: size={}, parts-count={}", size, parts_count));
+    }
+}
+
+void CheckReadSize(std::size_t expected_size, std::size_t actual_size) {
+    if (expected_size != actual_size) {
+        throw Error(fmt::format(
+            "Unexpected size of a container written in parts: expected-size={}, actual-size={}",
+            expected_size,
+            actual_size
+        ));
+    }
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,81 @@
+#include <userver/dump/parallel_containers.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+void TestWriteReadInParts(const T& original) {
+    dump::MockWriter writer;
+    dump::WriteInParts(writer, original);
+    writer.Write(std::string{"end"});
+    dump::MockReader reader(std::move(writer).Extract());
+
+    EXPECT_EQ(dump::ReadInParts<T>(reader), original);
+    EXPECT_EQ(reader.Read<std::string>(), "end");
+    reader.Finish();
+}
+
+template <typename T>
+std::string MakePart(std::size_t part_size, const std::vector<T>& elements) {
+    dump::impl::StringWriter part_writer;
+    part_writer.Write(part_size);
+    for (const auto& element : elements) part_writer.Write(element);
+    return std::move(part_writer).Extract();
+}
+
+}  // namespace
+
+UTEST(DumpParallelContainers, Empty) {
+    TestWriteReadInParts(std::vector<int>{});
+    TestWriteReadInParts(std::unordered_map<int, std::string>{});
+}
+
+UTEST_MT(DumpParallelContainers, Vector, 4) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 100'000; ++i) values.push_back(std::to_string(i));
+    TestWriteReadInParts(values);
+}
+
+UTEST_MT(DumpParallelContainers, Maps, 4) {
+    std::map<int, std::string> map;
+    std::unordered_map<std::string, int> unordered_map;
+    for (int i = 0; i < 100'000; ++i) {
+        map.emplace(i, std::to_string(i));
+        unordered_map.emplace(std::to_string(i), i);
+    }
+    TestWriteReadInParts(map);
+    TestWriteReadInParts(unordered_map);
+}
+
+UTEST(DumpParallelContainers, Malformed) {
+    const auto read_written = [](std::size_t size, std::size_t parts_count, const std::vector<std::string>& parts) {
+        dump::MockWriter writer;
+        writer.Write(size);
+        writer.Write(parts_count);
+        for (const auto& part : parts) writer.Write(part);
+        dump::MockReader reader(std::move(writer).Extract());
+        return dump::ReadInParts<std::set<int>>(reader);
+    };
+
+    EXPECT_EQ(read_written(2, 1, {MakePart<int>(2, {1, 2})}), (std::set<int>{1, 2}));
+
+    // A huge size must not be reserved
+    EXPECT_THROW(read_written(std::size_t{1} << 60, 1, {MakePart<int>(1, {1})}), dump::Error);
+    EXPECT_THROW(read_written(1, 0, {}), dump::Error);
+    EXPECT_THROW(read_written(1, 2, {MakePart<int>(1, {1}), MakePart<int>(0, {})}), dump::Error);
+    // The elements of a set are lost
+    EXPECT_THROW(read_written(2, 1, {MakePart<int>(2, {1, 1})}), dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,13 @@
 #include <engine/coro/pool.hpp>
 
 #include <algorithm>  // for std::max/std::min
+#include <chrono>
 #include <iterator>
 #include <optional>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
 
 #include <utils/sys_info.hpp>
 
@@ -13,11 +15,21 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+namespace {
+
+constexpr std::size_t kMinRetainedStackSize = 16 * 1024;
+
+// mincore and madvise are system calls, so they are not done on every
+// coroutine return
+constexpr std::chrono::milliseconds kIdleStackReleasePeriod{100};
+
+}  // namespace
+
 Pool::Pool(PoolConfig config, Executor executor)
     : config_(FixupConfig(std::move(config))),
       executor_(executor),
       local_coroutine_move_size_((config_.local_cache_size + 1) / 2),
-      stack_allocator_(config_.stack_size),
+      stack_allocator_(config_.stack_size, config_.idle_stack_release != StackReleaseMode::kNone),
       stack_usage_monitor_(config_.stack_size),
       initial_coroutines_(config_.initial_size),
       used_coroutines_(config_.max_size),
@@ -65,6 +77,7 @@ typename Pool::CoroutinePtr Pool::GetCoroutine() {
 
 void Pool::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
     if (config_.local_cache_size == 0) {
+        ReleaseIdleStacks(&coroutine_ptr.Get(), 1);
         const bool ok =
             // We only ever return coroutines into our 'working set'.
             used_coroutines_.enqueue(GetUsedPoolToken<moodycamel::ProducerToken>(), std::move(coroutine_ptr.Get()));
@@ -88,6 +101,9 @@ PoolStats Pool::GetStats() const {
     stats.total_coroutines = std::max(total_coroutines_num_.load(), stats.active_coroutines);
     stats.max_stack_usage_pct = stack_usage_monitor_.GetMaxStackUsagePct();
     stats.is_stack_usage_monitor_active = stack_usage_monitor_.IsActive();
+    // Each stack has a guard page
+    stats.stack_address_space_bytes = stats.total_coroutines * (config_.stack_size + utils::sys_info::GetPageSize());
+    stats.stack_advised_bytes = advised_stack_bytes_.load();
     return stats;
 }
 
@@ -101,6 +117,7 @@ void Pool::ClearLocalCache() {
         return_to_pool_from_local_cache_num =
             std::min(config_.max_size - current_idle_coroutines_num, local_coro_buffer_.size());
 
+        ReleaseIdleStacks(local_coro_buffer_.data(), return_to_pool_from_local_cache_num);
         const bool ok = used_coroutines_.enqueue_bulk(
             GetUsedPoolToken<moodycamel::ProducerToken>(),
             std::make_move_iterator(local_coro_buffer_.begin()),
@@ -168,6 +185,10 @@ void Pool::DepopulateLocalCache() {
         return_to_pool_from_local_cache_num =
             std::min(config_.max_size - current_idle_coroutines_num, local_coroutine_move_size_);
 
+        ReleaseIdleStacks(
+            local_coro_buffer_.data() + local_coro_buffer_.size() - return_to_pool_from_local_cache_num,
+            return_to_pool_from_local_cache_num
+        );
         const bool ok = used_coroutines_.enqueue_bulk(
             GetUsedPoolToken<moodycamel::ProducerToken>(),
             std::make_move_iterator(local_coro_buffer_.end() - return_to_pool_from_local_cache_num),
@@ -184,11 +205,34 @@ void Pool::DepopulateLocalCache() {
     local_coro_buffer_.erase(local_coro_buffer_.end() - local_coroutine_move_size_, local_coro_buffer_.end());
 }
 
+void Pool::ReleaseIdleStacks(Coroutine* begin, std::size_t count) noexcept {
+    if (config_.idle_stack_release == StackReleaseMode::kNone || count == 0) return;
+
+    // Pool is always used outside of any coroutine, so thread_local is OK.
+    thread_local utils::datetime::SteadyCoarseClock::time_point next_release{};
+    const auto now = utils::datetime::SteadyCoarseClock::now();
+    if (now < next_release) return;
+    next_release = now + kIdleStackReleasePeriod;
+
+    std::size_t released_bytes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        released_bytes += ReleaseIdleStack(
+            GetCoroCbPtr(begin[i]), config_.stack_size, config_.retained_stack_size, config_.idle_stack_release
+        );
+    }
+    if (released_bytes != 0) {
+        advised_stack_bytes_.fetch_add(released_bytes, std::memory_order_relaxed);
+    }
+}
+
 std::size_t Pool::GetStackSize() const { return config_.stack_size; }
 
 PoolConfig Pool::FixupConfig(PoolConfig&& config) {
     const auto page_size = utils::sys_info::GetPageSize();
     config.stack_size = (config.stack_size + page_size - 1) & ~(page_size - 1);
+    // The frames of an idle coroutine waiting for the next task must never be
+    // released, they are much smaller than this
+    config.retained_stack_size = std::max(config.retained_stack_size, kMinRetainedStackSize);
 
     return std::move(config);
 }
@@ -7,6 +7,7 @@
 
 #include <engine/coro/pool_config.hpp>
 #include <engine/coro/pool_stats.hpp>
+#include <engine/coro/stack_allocator.hpp>
 #include <engine/coro/stack_usage_monitor.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -44,6 +45,11 @@ private:
     bool TryPopulateLocalCache();
     void DepopulateLocalCache();
 
+    // Called for coroutines that leave the thread local cache for the shared
+    // idle pool, i.e. are unlikely to be reused soon. Rate limited per thread,
+    // the skipped stacks are released the next time they leave a cache.
+    void ReleaseIdleStacks(Coroutine* begin, std::size_t count) noexcept;
+
     template <typename Token>
     Token& GetUsedPoolToken();
 
@@ -60,10 +66,9 @@ private:
     // outside of any coroutine.
     static inline thread_local std::vector<Coroutine> local_coro_buffer_;
 
-    boost::coroutines2::protected_fixedsize_stack stack_allocator_;
+    StackAllocator stack_allocator_;
     // Some pointers arithmetic in StackUsageMonitor depends on this.
     // If you change the allocator, adjust the math there accordingly.
-    static_assert(std::is_same_v<decltype(stack_allocator_), boost::coroutines2::protected_fixedsize_stack>);
     StackUsageMonitor stack_usage_monitor_;
 
     // We aim to reuse coroutines as much as possible,
@@ -77,6 +82,7 @@ private:
 
     std::atomic<std::size_t> idle_coroutines_num_;
     std::atomic<std::size_t> total_coroutines_num_;
+    std::atomic<std::size_t> advised_stack_bytes_{0};
 };
 
 class Pool::CoroutinePtr final {
@@ -1,15 +1,30 @@
 #include "pool_config.hpp"
 
+#include <userver/utils/trivial_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+StackReleaseMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<StackReleaseMode>) {
+    static constexpr utils::TrivialBiMap kMap([](auto selector) {
+        return selector()
+            .Case(StackReleaseMode::kNone, "none")
+            .Case(StackReleaseMode::kFree, "free")
+            .Case(StackReleaseMode::kDontNeed, "dontneed");
+    });
+
+    return utils::ParseFromValueString(value, kMap);
+}
+
 PoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<PoolConfig>) {
     PoolConfig config;
     config.initial_size = value["initial_size"].As<size_t>(config.initial_size);
     config.max_size = value["max_size"].As<size_t>(config.max_size);
     config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
     config.local_cache_size = value["local_cache_size"].As<size_t>(config.local_cache_size);
+    config.idle_stack_release = value["idle_stack_release"].As<StackReleaseMode>(config.idle_stack_release);
+    config.retained_stack_size = value["retained_stack_size"].As<size_t>(config.retained_stack_size);
     return config;
 }
 
@@ -9,11 +9,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+/// How the memory of idle coroutine stacks is returned to the OS
+enum class StackReleaseMode {
+    kNone,
+    /// MADV_FREE, the pages are reclaimed lazily under memory pressure
+    kFree,
+    /// MADV_DONTNEED, the pages are dropped from RSS immediately
+    kDontNeed,
+};
+
+StackReleaseMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<StackReleaseMode>);
+
 struct PoolConfig {
     std::size_t initial_size = 1000;
     std::size_t max_size = 4000;
     std::size_t stack_size = 256 * 1024ULL;
     std::size_t local_cache_size = 8;
+    StackReleaseMode idle_stack_release = StackReleaseMode::kNone;
+    std::size_t retained_stack_size = 16 * 1024ULL;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<PoolConfig>);
@@ -12,6 +12,12 @@ struct PoolStats {
     size_t total_coroutines = 0;
     std::uint16_t max_stack_usage_pct = 0;
     bool is_stack_usage_monitor_active = false;
+    // Address space of all the coroutine stacks including the guard pages,
+    // only a part of it is resident
+    size_t stack_address_space_bytes = 0;
+    // Resident bytes of the idle stacks passed to madvise since start. With
+    // MADV_FREE the kernel reclaims them only under memory pressure.
+    size_t stack_advised_bytes = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
@@ -21,6 +27,8 @@ inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
         lhs.max_stack_usage_pct = rhs.max_stack_usage_pct;
     }
     lhs.is_stack_usage_monitor_active |= rhs.is_stack_usage_monitor_active;
+    lhs.stack_address_space_bytes += rhs.stack_address_space_bytes;
+    lhs.stack_advised_bytes += rhs.stack_advised_bytes;
     return lhs;
 }
 
@@ -0,0 +1,138 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+#include <utils/sys_info.hpp>
+
+#if defined(BOOST_USE_VALGRIND)
+#include <valgrind/valgrind.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+const auto kPageSize = utils::sys_info::GetPageSize();
+
+std::uintptr_t RoundUpToPageSize(std::uintptr_t address) noexcept {
+    return (address + kPageSize - 1) & ~(kPageSize - 1);
+}
+
+int ToMadvise(StackReleaseMode mode) noexcept {
+    switch (mode) {
+        case StackReleaseMode::kFree:
+#ifdef MADV_FREE
+            return MADV_FREE;
+#else
+            return MADV_DONTNEED;
+#endif
+        case StackReleaseMode::kDontNeed:
+        case StackReleaseMode::kNone:
+            break;
+    }
+    return MADV_DONTNEED;
+}
+
+}  // namespace
+
+StackAllocator::StackAllocator(std::size_t stack_size, bool no_reserve) noexcept
+    : stack_size_(RoundUpToPageSize(stack_size)), no_reserve_(no_reserve) {}
+
+boost::context::stack_context StackAllocator::allocate() {
+    // one more page at the bottom is used as a guard page
+    const std::size_t mapping_size = stack_size_ + kPageSize;
+
+    // The released stacks are touched again and again, do not reserve swap
+    // space for them
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | (no_reserve_ ? MAP_NORESERVE : 0);
+    void* vp = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (vp == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    [[maybe_unused]] const int result = ::mprotect(vp, kPageSize, PROT_NONE);
+    UASSERT(result == 0);
+
+    boost::context::stack_context sctx;
+    sctx.size = mapping_size;
+    sctx.sp = static_cast<char*>(vp) + sctx.size;
+#if defined(BOOST_USE_VALGRIND)
+    sctx.valgrind_stack_id = VALGRIND_STACK_REGISTER(sctx.sp, vp);
+#endif
+    return sctx;
+}
+
+void StackAllocator::deallocate(boost::context::stack_context& sctx) noexcept {
+    UASSERT(sctx.sp);
+
+#if defined(BOOST_USE_VALGRIND)
+    VALGRIND_STACK_DEREGISTER(sctx.valgrind_stack_id);
+#endif
+
+    void* vp = static_cast<char*>(sctx.sp) - sctx.size;
+    ::munmap(vp, sctx.size);
+}
+
+std::size_t ReleaseIdleStack(
+    const void* stack_begin,
+    std::size_t stack_size,
+    std::size_t retained_size,
+    StackReleaseMode mode
+) noexcept {
+    if (mode == StackReleaseMode::kNone || retained_size >= stack_size) {
+        return 0;
+    }
+
+    // The coroutine control block resides at the very beginning of the stack,
+    // the stack grows downwards from there
+    const auto begin = RoundUpToPageSize(reinterpret_cast<std::uintptr_t>(stack_begin));
+    const auto bottom = begin - stack_size;
+    const auto end = begin - RoundUpToPageSize(retained_size);
+    const auto pages_count = (end - bottom) / kPageSize;
+
+    // Find the deepest resident page. The pages above it up to `end` were
+    // touched by the coroutine since the previous release.
+    // Pool is always used outside of any coroutine, so thread_local is OK.
+    thread_local std::vector<unsigned char> residency;
+    residency.resize(pages_count);
+    if (::mincore(reinterpret_cast<void*>(bottom), end - bottom, residency.data()) == -1) {
+        return 0;
+    }
+
+    std::size_t deepest_resident = 0;
+    while (deepest_resident < pages_count && !(residency[deepest_resident] & 1)) {
+        ++deepest_resident;
+    }
+    if (deepest_resident == pages_count) {
+        return 0;
+    }
+
+    std::size_t resident_count = 0;
+    for (std::size_t i = deepest_resident; i < pages_count; ++i) {
+        resident_count += residency[i] & 1;
+    }
+
+    const auto release_begin = bottom + deepest_resident * kPageSize;
+    if (::madvise(reinterpret_cast<void*>(release_begin), end - release_begin, ToMadvise(mode)) == -1) {
+        // MADV_FREE is not supported by kernels older than 4.5
+        if (errno != EINVAL ||
+            ::madvise(reinterpret_cast<void*>(release_begin), end - release_begin, MADV_DONTNEED) == -1) {
+            return 0;
+        }
+    }
+
+    return resident_count * kPageSize;
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <coroutines/coroutine.hpp>
+
+#include <engine/coro/pool_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// @brief Coroutine stack allocator with the same memory layout as
+/// boost::coroutines2::protected_fixedsize_stack: a guard page at the bottom
+/// and the stack growing downwards from the end of the mapping.
+///
+/// If the stacks are released back to the OS with ReleaseIdleStack while the
+/// coroutine is idle, the mapping is made with MAP_NORESERVE.
+///
+/// StackUsageMonitor depends on the layout, see
+/// `CoroStackAllocator.SameLayoutAsProtectedFixedsizeStack` test.
+class StackAllocator final {
+public:
+    StackAllocator(std::size_t stack_size, bool no_reserve) noexcept;
+
+    boost::context::stack_context allocate();
+
+    void deallocate(boost::context::stack_context& sctx) noexcept;
+
+private:
+    std::size_t stack_size_;
+    bool no_reserve_;
+};
+
+/// @brief Releases the pages of an idle coroutine stack, that are deeper than
+/// `retained_size` from the stack begin. Only the range from the deepest
+/// resident page up to the retained part is advised.
+/// @returns the amount of resident bytes in the released range
+std::size_t ReleaseIdleStack(
+    const void* stack_begin,
+    std::size_t stack_size,
+    std::size_t retained_size,
+    StackReleaseMode mode
+) noexcept;
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
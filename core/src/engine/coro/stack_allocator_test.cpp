@@ -0,0 +1,78 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <utils/sys_info.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStackSize = 256 * 1024;
+constexpr std::size_t kRetainedSize = 16 * 1024;
+
+}  // namespace
+
+TEST(CoroStackAllocator, Layout) {
+    engine::coro::StackAllocator allocator{kStackSize, /*no_reserve=*/true};
+    auto sctx = allocator.allocate();
+    EXPECT_EQ(sctx.size, kStackSize + utils::sys_info::GetPageSize());
+
+    // the whole stack is writable
+    auto* stack_bottom = static_cast<char*>(sctx.sp) - kStackSize;
+    std::memset(stack_bottom, 1, kStackSize);
+
+    allocator.deallocate(sctx);
+}
+
+TEST(CoroStackAllocator, SameLayoutAsProtectedFixedsizeStack) {
+    engine::coro::StackAllocator allocator{kStackSize, /*no_reserve=*/true};
+    boost::coroutines2::protected_fixedsize_stack boost_allocator{kStackSize};
+
+    auto sctx = allocator.allocate();
+    auto boost_sctx = boost_allocator.allocate();
+
+    // StackUsageMonitor computes the guard page and the stack bounds from the
+    // stack begin and the size
+    EXPECT_EQ(sctx.size, boost_sctx.size);
+    const auto page_size = utils::sys_info::GetPageSize();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sctx.sp) % page_size, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(boost_sctx.sp) % page_size, 0);
+
+    boost_allocator.deallocate(boost_sctx);
+    allocator.deallocate(sctx);
+}
+
+TEST(CoroStackAllocator, ReleaseIdleStack) {
+    engine::coro::StackAllocator allocator{kStackSize, /*no_reserve=*/true};
+    auto sctx = allocator.allocate();
+    auto* stack_begin = static_cast<char*>(sctx.sp);
+
+    using engine::coro::StackReleaseMode;
+    // nothing is touched yet
+    EXPECT_EQ(engine::coro::ReleaseIdleStack(stack_begin, kStackSize, kRetainedSize, StackReleaseMode::kDontNeed), 0);
+
+    // touch 64KiB of the stack
+    constexpr std::size_t kUsedSize = 64 * 1024;
+    std::memset(stack_begin - kUsedSize, 1, kUsedSize);
+
+    EXPECT_EQ(engine::coro::ReleaseIdleStack(stack_begin, kStackSize, kRetainedSize, StackReleaseMode::kNone), 0);
+    EXPECT_EQ(
+        engine::coro::ReleaseIdleStack(stack_begin, kStackSize, kRetainedSize, StackReleaseMode::kDontNeed),
+        kUsedSize - kRetainedSize
+    );
+    EXPECT_EQ(engine::coro::ReleaseIdleStack(stack_begin, kStackSize, kRetainedSize, StackReleaseMode::kDontNeed), 0);
+
+    // released pages are zeroed, retained ones are intact
+    EXPECT_EQ(*(stack_begin - kUsedSize), 0);
+    EXPECT_EQ(*(stack_begin - kRetainedSize - 1), 0);
+    EXPECT_EQ(*(stack_begin - kRetainedSize), 1);
+    EXPECT_EQ(*(stack_begin - 1), 1);
+
+    allocator.deallocate(sctx);
+}
+
+USERVER_NAMESPACE_END
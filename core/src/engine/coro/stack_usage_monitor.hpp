@@ -42,6 +42,9 @@ private:
 
 std::size_t GetCurrentTaskStackUsageBytes() noexcept;
 
+/// Returns a pointer to the beginning of the coroutine stack
+const void* GetCoroCbPtr(const boost::coroutines2::coroutine<impl::TaskContext*>::push_type& coro) noexcept;
+
 }  // namespace engine::coro
 
 USERVER_NAMESPACE_END
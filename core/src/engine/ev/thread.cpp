@@ -10,6 +10,7 @@
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
 #include <userver/utils/thread_name.hpp>
 
+#include <engine/io/sys_linux/io_uring.hpp>
 #include <utils/check_syscall.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
@@ -27,14 +28,18 @@ const auto kCpuStatsThrottle = static_cast<std::size_t>(kCpuStatsCollectInterval
 
 }  // namespace
 
-Thread::Thread(const std::string& thread_name) : Thread(thread_name, EventLoop::EvLoopType::kNewLoop) {}
+Thread::Thread(const std::string& thread_name, std::uint32_t io_uring_entries)
+    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop, io_uring_entries) {}
 
-Thread::Thread(const std::string& thread_name, UseDefaultEvLoop)
-    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop) {}
+Thread::Thread(const std::string& thread_name, UseDefaultEvLoop, std::uint32_t io_uring_entries)
+    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop, io_uring_entries) {}
 
-Thread::Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type)
+Thread::Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type, std::uint32_t io_uring_entries)
     : event_loop_(ev_loop_type), name_{thread_name}, cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle} {
     UASSERT_MSG(kDeferredInterval > std::chrono::milliseconds{4}, "Timer events would happen too often");
+    if (io_uring_entries != 0) {
+        io_uring_ = io::sys_linux::IoUring::TryCreate(io_uring_entries);
+    }
     Start();
 }
 
@@ -109,6 +114,12 @@ void Thread::Start() {
     ev_timer_init(&defer_timer_, UpdateTimersWatcher, 0.0, defer_duration.count());
     ev_timer_start(loop, &defer_timer_);
 
+    if (io_uring_) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->GetEventFd(), EV_READ);
+        ev_io_start(loop, &watch_io_uring_);
+    }
+
     is_running_ = true;
     thread_ = std::thread([this] {
         utils::SetCurrentThreadName(name_);
@@ -137,6 +148,9 @@ void Thread::RunEvLoop() {
     ev_async_stop(GetEvLoop(), &watch_update_);
     ev_async_stop(GetEvLoop(), &watch_break_);
     ev_timer_stop(GetEvLoop(), &defer_timer_);
+    if (io_uring_) {
+        ev_io_stop(GetEvLoop(), &watch_io_uring_);
+    }
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -174,6 +188,13 @@ void Thread::BreakLoopWatcherImpl() {
     ev_break(GetEvLoop(), EVBREAK_ALL);
 }
 
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+    auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+    UASSERT(ev_thread != nullptr);
+    UASSERT(ev_thread->io_uring_);
+    ev_thread->io_uring_->ProcessCompletions();
+}
+
 void Thread::Acquire(struct ev_loop* loop) noexcept {
     auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
     UASSERT(ev_thread != nullptr);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -17,6 +18,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io::sys_linux {
+class IoUring;
+}  // namespace engine::io::sys_linux
+
 namespace engine::ev {
 
 // Avoid ev_async_send on timers that have bigger timeouts
@@ -27,8 +32,9 @@ public:
     struct UseDefaultEvLoop {};
     static constexpr UseDefaultEvLoop kUseDefaultEvLoop{};
 
-    explicit Thread(const std::string& thread_name);
-    Thread(const std::string& thread_name, UseDefaultEvLoop);
+    // io_uring_entries == 0 disables io_uring
+    explicit Thread(const std::string& thread_name, std::uint32_t io_uring_entries = 0);
+    Thread(const std::string& thread_name, UseDefaultEvLoop, std::uint32_t io_uring_entries = 0);
 
     ~Thread();
 
@@ -45,11 +51,14 @@ public:
 
     bool IsInEvThread() const;
 
+    // nullptr if io_uring is disabled or is not supported
+    io::sys_linux::IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
     std::uint8_t GetCurrentLoadPercent() const;
     const std::string& GetName() const;
 
 private:
-    Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type);
+    Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type, std::uint32_t io_uring_entries);
 
     void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -62,6 +71,7 @@ private:
     static void UpdateTimersWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
     void UpdateLoopWatcherImpl();
     static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
+    static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
     void BreakLoopWatcherImpl();
 
     static void Acquire(struct ev_loop* loop) noexcept;
@@ -81,6 +91,9 @@ private:
     ev_async watch_update_{};
     ev_async watch_break_{};
 
+    std::unique_ptr<io::sys_linux::IoUring> io_uring_;
+    ev_io watch_io_uring_{};
+
     const std::string name_;
     utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
     bool is_running_{false};
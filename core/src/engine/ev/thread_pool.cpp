@@ -17,10 +17,11 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, UseDefaultEvLoop)
     : ThreadPool(std::move(config), !config.ev_default_loop_disabled) {}
 
 ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop) : use_ev_default_loop_(use_ev_default_loop) {
+    const std::uint32_t io_uring_entries = config.io_uring_enabled ? config.io_uring_entries : 0;
     threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
         const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
-        return (use_ev_default_loop && index == 0) ? Thread(thread_name, Thread::kUseDefaultEvLoop)
-                                                   : Thread(thread_name);
+        return (use_ev_default_loop && index == 0) ? Thread(thread_name, Thread::kUseDefaultEvLoop, io_uring_entries)
+                                                   : Thread(thread_name, io_uring_entries);
     });
 
     default_controls_.controls = utils::GenerateFixedArray(threads_.size(), [this](std::size_t index) {
@@ -8,6 +8,8 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<
     ThreadPoolConfig config;
     config.threads = value["threads"].As<std::size_t>(config.threads);
     config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
+    config.io_uring_enabled = value["io_uring_enabled"].As<bool>(config.io_uring_enabled);
+    config.io_uring_entries = value["io_uring_entries"].As<std::uint32_t>(config.io_uring_entries);
     return config;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include <userver/formats/yaml.hpp>
@@ -13,6 +14,8 @@ struct ThreadPoolConfig {
     std::size_t threads = 2;
     std::string thread_name = "event-worker";
     bool ev_default_loop_disabled = false;
+    bool io_uring_enabled = false;
+    std::uint32_t io_uring_entries = 256;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ThreadPoolConfig>);
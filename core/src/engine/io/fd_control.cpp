@@ -10,6 +10,7 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
@@ -53,6 +54,34 @@ int ReduceSigpipe(int fd) {
 
 void FdControlDeleter::operator()(FdControl* ptr) const noexcept { std::default_delete<FdControl>{}(ptr); }
 
+Direction::Direction(const ev::ThreadControl& control) : poller_(control), io_uring_(control.GetIoUring()) {}
+
+void Direction::WakeupWaiters() {
+    {
+        const std::lock_guard lock(uring_op_mutex_);
+        if (uring_op_in_flight_) {
+            // close(2) does not interrupt io_uring operations on the fd
+            io_uring_->Cancel(*uring_op_in_flight_);
+        }
+    }
+    poller_.WakeupWaiters();
+}
+
+std::int32_t Direction::AwaitUring(sys_linux::IoUring::Operation& op, Deadline deadline, bool& interrupted) {
+    UASSERT(HasIoUring());
+    op.fd = Fd();
+    {
+        const std::lock_guard lock(uring_op_mutex_);
+        uring_op_in_flight_ = &op;
+    }
+    // The operation has completed by the time AwaitCompletion returns
+    utils::FastScopeGuard in_flight_guard([this]() noexcept {
+        const std::lock_guard lock(uring_op_mutex_);
+        uring_op_in_flight_ = nullptr;
+    });
+    return sys_linux::AwaitCompletion(*io_uring_, op, deadline, interrupted);
+}
+
 #ifndef NDEBUG
 Direction::SingleUserGuard::SingleUserGuard(Direction& dir) : dir_(dir) { dir_.poller_.SwitchStateToInUse(); }
 
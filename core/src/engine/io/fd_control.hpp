@@ -1,8 +1,11 @@
 #pragma once
 
 #include <sys/uio.h>
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
+#include <cstdint>
+#include <mutex>
 
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/fd_control_holder.hpp>
@@ -12,6 +15,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/io/sys_linux/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -41,6 +45,14 @@ enum class ErrorMode {
     kFatal,      ///< break execute operation
 };
 
+inline bool IsWouldBlock(int error_code) noexcept {
+    return error_code == EWOULDBLOCK
+#if EWOULDBLOCK != EAGAIN
+           || error_code == EAGAIN
+#endif
+        ;
+}
+
 class FdControl;
 
 class Direction final {
@@ -99,15 +111,51 @@ public:
         const Context&... context
     );
 
+    /// Whether the transfers could be performed via PerformUringIo
+    bool HasIoUring() const noexcept { return io_uring_ != nullptr; }
+
+    // Same as PerformIo, but when `io_func` would block, the transfer is
+    // submitted to io_uring of the ev thread as `opcode` instead of waiting for
+    // the fd readiness. TransferMode::kPartial is not supported.
+    template <typename IoFunc, typename... Context>
+    size_t PerformUringIo(
+        SingleUserGuard& guard,
+        IoFunc&& io_func,
+        sys_linux::IoUring::Opcode opcode,
+        std::uint32_t op_flags,
+        void* buf,
+        size_t len,
+        TransferMode mode,
+        Deadline deadline,
+        const Context&... context
+    );
+
+    // Same as PerformIoV, but falls back to Opcode::kWritev or Opcode::kReadv
+    // instead of waiting
+    template <typename IoFunc, typename... Context>
+    size_t PerformUringIoV(
+        SingleUserGuard& guard,
+        IoFunc&& io_func,
+        sys_linux::IoUring::Opcode opcode,
+        struct iovec* list,
+        std::size_t list_size,
+        TransferMode mode,
+        Deadline deadline,
+        const Context&... context
+    );
+
+    // Performs a single io_uring operation on Fd(), returns its result
+    std::int32_t AwaitUring(sys_linux::IoUring::Operation& op, Deadline deadline, bool& interrupted);
+
     engine::impl::ContextAccessor* TryGetContextAccessor() noexcept { return poller_.TryGetContextAccessor(); }
 
 private:
     friend class FdControl;
-    explicit Direction(const ev::ThreadControl& control) : poller_(control) {}
+    explicit Direction(const ev::ThreadControl& control);
 
     void Reset(int fd, Kind kind) { poller_.Reset(fd, kind); }
 
-    void WakeupWaiters() { poller_.WakeupWaiters(); }
+    void WakeupWaiters();
 
     // does not notify
     void Invalidate() { poller_.Invalidate(); }
@@ -116,7 +164,22 @@ private:
     ErrorMode
     TryHandleError(int error_code, size_t processed_bytes, TransferMode mode, Deadline deadline, Context&... context);
 
+    template <typename... Context>
+    ErrorMode TryHandleUringError(
+        std::int32_t result,
+        bool interrupted,
+        size_t processed_bytes,
+        TransferMode mode,
+        Deadline deadline,
+        Context&... context
+    );
+
     FdPoller poller_;
+    sys_linux::IoUring* const io_uring_;
+    // Guards the operation from completing and going away while it is being
+    // cancelled. The critical sections never switch the coroutine
+    std::mutex uring_op_mutex_;
+    sys_linux::IoUring::Operation* uring_op_in_flight_{nullptr};
 };
 
 class FdControl final {
@@ -201,6 +264,36 @@ ErrorMode Direction::TryHandleError(
     return ErrorMode::kProcessed;
 }
 
+template <typename... Context>
+ErrorMode Direction::TryHandleUringError(
+    std::int32_t result,
+    bool interrupted,
+    size_t processed_bytes,
+    TransferMode mode,
+    Deadline deadline,
+    Context&... context
+) {
+    UASSERT(result < 0);
+    if (result == -ECANCELED) {
+        if (!IsValid()) {
+            throw((IoException() << "Fd closed during ") << ... << context);
+        }
+        if (interrupted) {
+            if (processed_bytes != 0 && mode != TransferMode::kWhole) {
+                return ErrorMode::kFatal;
+            }
+            if (current_task::ShouldCancel()) {
+                throw(IoCancelled(/*bytes_transferred =*/processed_bytes) << ... << context);
+            } else {
+                throw(IoTimeout(/*bytes_transferred =*/processed_bytes) << ... << context);
+            }
+        }
+    }
+    // EAGAIN is possible on old kernels for nonblocking fds, in that case
+    // we fall back to waiting via poller.
+    return TryHandleError(-result, processed_bytes, mode, deadline, context...);
+}
+
 template <typename IoFunc, typename... Context>
 size_t Direction::PerformIoV(
     SingleUserGuard&,
@@ -273,6 +366,124 @@ size_t Direction::PerformIo(
     return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformUringIo(
+    SingleUserGuard&,
+    IoFunc&& io_func,
+    sys_linux::IoUring::Opcode opcode,
+    std::uint32_t op_flags,
+    void* buf,
+    size_t len,
+    TransferMode mode,
+    Deadline deadline,
+    const Context&... context
+) {
+    UASSERT(HasIoUring());
+    UASSERT(mode != TransferMode::kPartial);
+    char* const begin = static_cast<char*>(buf);
+    char* const end = begin + len;
+
+    char* pos = begin;
+
+    while (pos < end) {
+        // The data or the buffer space is usually available right away, so
+        // the plain syscall goes first and the ring replaces only the waiting
+        auto chunk_size = io_func(Fd(), pos, end - pos);
+        if (chunk_size < 0 && IsWouldBlock(errno)) {
+            sys_linux::IoUring::Operation op;
+            op.opcode = opcode;
+            op.op_flags = op_flags;
+            op.addr = reinterpret_cast<std::uintptr_t>(pos);
+            op.len = static_cast<std::uint32_t>(std::min<std::size_t>(end - pos, INT32_MAX));
+
+            bool interrupted = false;
+            const auto result = AwaitUring(op, deadline, interrupted);
+            if (result < 0) {
+                if (TryHandleUringError(result, interrupted, pos - begin, mode, deadline, context...) ==
+                    ErrorMode::kFatal) {
+                    break;
+                }
+                continue;
+            }
+            chunk_size = result;
+        }
+
+        if (chunk_size > 0) {
+            pos += chunk_size;
+            if (mode == TransferMode::kOnce) {
+                break;
+            }
+        } else if (!chunk_size || TryHandleError(errno, pos - begin, mode, deadline, context...) == ErrorMode::kFatal) {
+            break;
+        }
+    }
+    return pos - begin;
+}
+
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformUringIoV(
+    SingleUserGuard&,
+    IoFunc&& io_func,
+    sys_linux::IoUring::Opcode opcode,
+    struct iovec* list,
+    std::size_t list_size,
+    TransferMode mode,
+    Deadline deadline,
+    const Context&... context
+) {
+    UASSERT(HasIoUring());
+    UASSERT(mode != TransferMode::kPartial);
+    UASSERT(list_size > 0);
+    UASSERT(list_size <= IOV_MAX);
+    std::size_t processed_bytes = 0;
+    do {
+        auto chunk_size = io_func(Fd(), list, list_size);
+        if (chunk_size < 0 && IsWouldBlock(errno)) {
+            sys_linux::IoUring::Operation op;
+            op.opcode = opcode;
+            op.addr = reinterpret_cast<std::uintptr_t>(list);
+            op.len = static_cast<std::uint32_t>(list_size);
+            // files are written at the current position, sockets ignore the offset
+            op.offset = static_cast<std::uint64_t>(-1);
+
+            bool interrupted = false;
+            const auto result = AwaitUring(op, deadline, interrupted);
+            if (result < 0) {
+                if (TryHandleUringError(result, interrupted, processed_bytes, mode, deadline, context...) ==
+                    ErrorMode::kFatal) {
+                    break;
+                }
+                continue;
+            }
+            chunk_size = result;
+        }
+
+        if (chunk_size > 0) {
+            processed_bytes += chunk_size;
+            if (mode == TransferMode::kOnce) {
+                break;
+            }
+            std::size_t offset = chunk_size;
+            while (list_size > 0) {
+                const std::size_t len = list->iov_len;
+                if (offset >= len) {
+                    ++list;
+                    offset -= len;
+                    --list_size;
+                    UASSERT(list_size != 0 || offset == 0);
+                } else {
+                    list->iov_len -= offset;
+                    list->iov_base = static_cast<char*>(list->iov_base) + offset;
+                    break;
+                }
+            }
+        } else if (!chunk_size || TryHandleError(errno, processed_bytes, mode, deadline, context...) == ErrorMode::kFatal) {
+            break;
+        }
+    } while (list_size != 0);
+    return processed_bytes;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
@@ -2,6 +2,8 @@
 
 #include <unistd.h>
 
+#include <array>
+
 #include <userver/engine/run_standalone.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -29,6 +31,37 @@ private:
 namespace io = engine::io;
 using Deadline = engine::Deadline;
 using FdControl = io::impl::FdControl;
+using UringOpcode = io::sys_linux::IoUring::Opcode;
+
+void DoPipeTransfer(benchmark::State& state, bool io_uring) {
+    engine::TaskProcessorPoolsConfig config;
+    config.ev_io_uring_enabled = io_uring;
+    engine::RunStandalone(1, config, [&] {
+        Pipe pipe;
+        auto read_control = FdControl::Adopt(pipe.ExtractIn());
+        auto write_control = FdControl::Adopt(pipe.ExtractOut());
+        auto& read_dir = read_control->Read();
+        auto& write_dir = write_control->Write();
+        std::array<char, 16> buf{};
+        const auto mode = io::impl::TransferMode::kWhole;
+
+        for ([[maybe_unused]] auto _ : state) {
+            io::impl::Direction::SingleUserGuard write_guard(write_dir);
+            io::impl::Direction::SingleUserGuard read_guard(read_dir);
+            if (read_dir.HasIoUring()) {
+                write_dir.PerformUringIo(
+                    write_guard, &::write, UringOpcode::kWrite, 0, buf.data(), buf.size(), mode, {}, "writing"
+                );
+                read_dir.PerformUringIo(
+                    read_guard, &::read, UringOpcode::kRead, 0, buf.data(), buf.size(), mode, {}, "reading"
+                );
+            } else {
+                write_dir.PerformIo(write_guard, &::write, buf.data(), buf.size(), mode, {}, "writing");
+                read_dir.PerformIo(read_guard, &::read, buf.data(), buf.size(), mode, {}, "reading");
+            }
+        }
+    });
+}
 
 }  // namespace
 
@@ -94,4 +127,10 @@ void fd_control_construct_wait_destroy(benchmark::State& state) {
 }
 BENCHMARK(fd_control_construct_wait_destroy);
 
+void fd_control_pipe_transfer(benchmark::State& state) { DoPipeTransfer(state, false); }
+BENCHMARK(fd_control_pipe_transfer);
+
+void fd_control_pipe_transfer_io_uring(benchmark::State& state) { DoPipeTransfer(state, true); }
+BENCHMARK(fd_control_pipe_transfer_io_uring);
+
 USERVER_NAMESPACE_END
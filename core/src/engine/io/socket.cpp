@@ -25,6 +25,12 @@ namespace {
 
 constexpr size_t kMaxStackSizeVector = 32;
 
+#ifdef __linux__
+constexpr std::uint32_t kUringSendFlags = MSG_NOSIGNAL;
+
+using UringOpcode = sys_linux::IoUring::Opcode;
+#endif
+
 // MAC_COMPAT: does not accept flags in type
 impl::FdControlHolder MakeSocket(AddrDomain domain, SocketType type) {
     return impl::FdControl::Adopt(utils::CheckSyscallCustomException<IoSystemError>(
@@ -117,6 +123,30 @@ private:
     const Sockaddr& dest_addr_;
 };
 
+#ifdef __linux__
+// Same contract as accept4(2): returns fd or -1 with errno set
+int UringAccept(impl::Direction& dir, Sockaddr& addr, socklen_t& len, Deadline deadline) {
+    sys_linux::IoUring::Operation op;
+    op.opcode = UringOpcode::kAccept;
+    op.addr = reinterpret_cast<std::uintptr_t>(addr.Data());
+    op.addr2 = reinterpret_cast<std::uintptr_t>(&len);
+    op.op_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+
+    bool interrupted = false;
+    const auto result = dir.AwaitUring(op, deadline, interrupted);
+    if (result >= 0) return result;
+
+    if (interrupted && result == -ECANCELED) {
+        if (current_task::ShouldCancel()) {
+            throw IoCancelled() << "Accept";
+        }
+        throw IoTimeout() << "Accept";
+    }
+    errno = -result;
+    return -1;
+}
+#endif
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
     UASSERT(data);
     UASSERT(count > 0);
@@ -240,6 +270,22 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
     auto& dir = fd_control_->Read();
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
+#ifdef __linux__
+    if (dir.HasIoUring()) {
+        return dir.PerformUringIo(
+            guard,
+            &RecvWrapper,
+            UringOpcode::kRecv,
+            0,
+            buf,
+            len,
+            impl::TransferMode::kOnce,
+            deadline,
+            "RecvSome from ",
+            peername_
+        );
+    }
+#endif
     return dir.PerformIo(
         guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce, deadline, "RecvSome from ", peername_
     );
@@ -252,6 +298,22 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
     auto& dir = fd_control_->Read();
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
+#ifdef __linux__
+    if (dir.HasIoUring()) {
+        return dir.PerformUringIo(
+            guard,
+            &RecvWrapper,
+            UringOpcode::kRecv,
+            0,
+            buf,
+            len,
+            impl::TransferMode::kWhole,
+            deadline,
+            "RecvAll from ",
+            peername_
+        );
+    }
+#endif
     return dir.PerformIo(
         guard, &RecvWrapper, buf, len, impl::TransferMode::kWhole, deadline, "RecvAll from ", peername_
     );
@@ -307,6 +369,21 @@ size_t Socket::SendAll(const struct iovec* list, std::size_t list_size, Deadline
     auto& dir = fd_control_->Write();
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
+#ifdef __linux__
+    if (dir.HasIoUring()) {
+        return dir.PerformUringIoV(
+            guard,
+            &writev,
+            UringOpcode::kWritev,
+            const_cast<struct iovec*>(list),  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+            list_size,
+            impl::TransferMode::kWhole,
+            deadline,
+            "SendAll to ",
+            peername_
+        );
+    }
+#endif
     return dir.PerformIoV(
         guard,
         &writev,
@@ -326,6 +403,22 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
     auto& dir = fd_control_->Write();
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
+#ifdef __linux__
+    if (dir.HasIoUring()) {
+        return dir.PerformUringIo(
+            guard,
+            &SendWrapper,
+            UringOpcode::kSend,
+            kUringSendFlags,
+            const_cast<void*>(buf),  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+            len,
+            impl::TransferMode::kWhole,
+            deadline,
+            "SendAll to ",
+            peername_
+        );
+    }
+#endif
     return dir.PerformIo(
         guard,
         &SendWrapper,
@@ -396,6 +489,14 @@ Socket Socket::Accept(Deadline deadline) {
 // MAC_COMPAT: no accept4
 #ifdef HAVE_ACCEPT4
         int fd = ::accept4(dir.Fd(), buf.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#ifdef __linux__
+        // Pending connections are drained with plain syscalls in a batch,
+        // io_uring is only used to wait for the next one
+        if (fd == -1 && (errno == EAGAIN || errno == EWOULDBLOCK) && dir.HasIoUring()) {
+            len = buf.Capacity();
+            fd = UringAccept(dir, buf, len, deadline);
+        }
+#endif
 #else
         int fd = ::accept(dir.Fd(), buf.Data(), &len);
 #endif
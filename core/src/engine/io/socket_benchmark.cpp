@@ -23,10 +23,8 @@ namespace {
 
 constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
 
-}  // namespace
-
-void socket_send_all(benchmark::State& state) {
-    engine::RunStandalone([&]() {
+void DoSocketSendAll(benchmark::State& state, const engine::TaskProcessorPoolsConfig& config) {
+    engine::RunStandalone(1, config, [&]() {
         const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
         internal::net::TcpListener listener;
         auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -49,10 +47,9 @@ void socket_send_all(benchmark::State& state) {
         task_reader.Get();
     });
 }
-BENCHMARK(socket_send_all);
 
-void socket_send_all_v(benchmark::State& state) {
-    engine::RunStandalone([&]() {
+void DoSocketSendAllV(benchmark::State& state, const engine::TaskProcessorPoolsConfig& config) {
+    engine::RunStandalone(1, config, [&]() {
         const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
         internal::net::TcpListener listener;
         auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -73,8 +70,60 @@ void socket_send_all_v(benchmark::State& state) {
         task_reader.Get();
     });
 }
+
+// Request-response over a keep-alive connection, every iteration waits for
+// the socket to become readable.
+void DoSocketPingPong(benchmark::State& state, const engine::TaskProcessorPoolsConfig& config) {
+    engine::RunStandalone(2, config, [&]() {
+        const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+        internal::net::TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+        auto task_echo = engine::AsyncNoSpan(
+            [test_deadline](auto&& server) {
+                std::array<char, 128> buf = {};
+                while (const auto size = server.RecvSome(buf.data(), buf.size(), test_deadline)) {
+                    [[maybe_unused]] const auto sent = server.SendAll(buf.data(), size, test_deadline);
+                }
+            },
+            std::move(server)
+        );
+        std::array<char, 16> buf = {};
+        for ([[maybe_unused]] auto _ : state) {
+            [[maybe_unused]] const auto sent = client.SendAll("ping", 4, test_deadline);
+            const auto received = client.RecvAll(buf.data(), 4, test_deadline);
+            benchmark::DoNotOptimize(received);
+        }
+        client.Close();
+        task_echo.Get();
+    });
+}
+
+engine::TaskProcessorPoolsConfig MakeIoUringConfig() {
+    engine::TaskProcessorPoolsConfig config;
+    config.ev_io_uring_enabled = true;
+    return config;
+}
+
+}  // namespace
+
+void socket_send_all(benchmark::State& state) { DoSocketSendAll(state, {}); }
+BENCHMARK(socket_send_all);
+
+void socket_send_all_io_uring(benchmark::State& state) { DoSocketSendAll(state, MakeIoUringConfig()); }
+BENCHMARK(socket_send_all_io_uring);
+
+void socket_send_all_v(benchmark::State& state) { DoSocketSendAllV(state, {}); }
 BENCHMARK(socket_send_all_v);
 
+void socket_send_all_v_io_uring(benchmark::State& state) { DoSocketSendAllV(state, MakeIoUringConfig()); }
+BENCHMARK(socket_send_all_v_io_uring);
+
+void socket_ping_pong(benchmark::State& state) { DoSocketPingPong(state, {}); }
+BENCHMARK(socket_ping_pong);
+
+void socket_ping_pong_io_uring(benchmark::State& state) { DoSocketPingPong(state, MakeIoUringConfig()); }
+BENCHMARK(socket_ping_pong_io_uring);
+
 [[maybe_unused]] void socket_send_all_v_range(benchmark::State& state) {
     engine::RunStandalone(2, [&]() {
         const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
@@ -7,14 +7,17 @@
 
 #include <array>
 #include <cerrno>
+#include <cstdint>
 #include <cstdlib>
 #include <string_view>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/wait_any.hpp>
@@ -145,6 +148,57 @@ UTEST(Socket, ListenConnect) {
     listen_task.Get();
 }
 
+namespace {
+
+void CheckAcceptPendingConnections() {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    constexpr std::size_t kClients = 8;
+
+    TcpListener listener;
+
+    // The connections are established by the kernel before they are accepted,
+    // Accept takes them from the backlog without waiting
+    std::vector<io::Socket> clients;
+    std::vector<std::uint16_t> client_ports;
+    for (std::size_t i = 0; i < kClients; ++i) {
+        auto& client = clients.emplace_back(listener.addr.Domain(), TcpListener::kType);
+        client.Connect(listener.addr, test_deadline);
+        client_ports.push_back(client.Getsockname().Port());
+    }
+    for (std::size_t i = 0; i < kClients; ++i) {
+        auto peer = listener.socket.Accept(test_deadline);
+        ASSERT_TRUE(peer.IsValid());
+        EXPECT_EQ(client_ports[i], peer.Getpeername().Port());
+    }
+
+    UEXPECT_THROW(
+        [[maybe_unused]] auto socket = listener.socket.Accept(Deadline::FromDuration(std::chrono::milliseconds(10))),
+        io::IoTimeout
+    );
+
+    // A connection that arrives while Accept waits for it
+    auto accept_task = engine::AsyncNoSpan([&] { return listener.socket.Accept(test_deadline); });
+    engine::SleepFor(std::chrono::milliseconds(10));
+    io::Socket late_client{listener.addr.Domain(), TcpListener::kType};
+    late_client.Connect(listener.addr, test_deadline);
+
+    auto late_peer = accept_task.Get();
+    ASSERT_TRUE(late_peer.IsValid());
+    EXPECT_EQ(late_client.Getsockname().Port(), late_peer.Getpeername().Port());
+    EXPECT_EQ("::1", late_peer.Getpeername().PrimaryAddressString());
+}
+
+}  // namespace
+
+UTEST(Socket, AcceptPendingConnections) { CheckAcceptPendingConnections(); }
+
+TEST(Socket, AcceptPendingConnectionsIoUring) {
+    engine::TaskProcessorPoolsConfig config;
+    // Falls back to the default poller if io_uring is unavailable
+    config.ev_io_uring_enabled = true;
+    engine::RunStandalone(2, config, [] { CheckAcceptPendingConnections(); });
+}
+
 UTEST(Socket, ReleaseReuse) {
     const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -0,0 +1,384 @@
+#include <engine/io/sys_linux/io_uring.hpp>
+
+#include <userver/engine/single_use_event.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include <userver/utils/strerror.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::sys_linux {
+
+namespace {
+
+// Operations that are required by the engine::io users
+constexpr std::array kRequiredOps = {
+    IORING_OP_RECV,
+    IORING_OP_SEND,
+    IORING_OP_READV,
+    IORING_OP_WRITEV,
+    IORING_OP_ACCEPT,
+    IORING_OP_READ,
+    IORING_OP_WRITE,
+    IORING_OP_OPENAT,
+    IORING_OP_CLOSE,
+    IORING_OP_ASYNC_CANCEL,
+};
+
+// CQ is larger than SQ as the number of in-flight operations is limited by the
+// number of tasks rather than by the SQ size.
+constexpr std::uint32_t kCqEntriesMultiplier = 8;
+
+// Completions of the cancellation requests are not reported to anyone
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+// Submitters wait for each other only while an SQ entry is being filled
+constexpr unsigned kSpinsBeforeYield = 64;
+
+int IoUringSetup(unsigned entries, io_uring_params& params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, std::size_t{0})
+    );
+}
+
+int IoUringRegister(int ring_fd, unsigned opcode, const void* arg, unsigned nr_args) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+bool AreRequiredOpsSupported(int ring_fd) {
+    constexpr std::size_t kProbeOps = IORING_OP_LAST;
+    const std::size_t probe_size = sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op);
+    auto probe_storage = std::make_unique<char[]>(probe_size);
+    std::memset(probe_storage.get(), 0, probe_size);
+    auto* probe = reinterpret_cast<io_uring_probe*>(probe_storage.get());
+
+    if (IoUringRegister(ring_fd, IORING_REGISTER_PROBE, probe, kProbeOps) == -1) {
+        return false;
+    }
+
+    return std::all_of(kRequiredOps.begin(), kRequiredOps.end(), [probe](auto op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    });
+}
+
+std::uint8_t ToNativeOpcode(IoUring::Opcode opcode) {
+    switch (opcode) {
+        case IoUring::Opcode::kNop:
+            return IORING_OP_NOP;
+        case IoUring::Opcode::kRecv:
+            return IORING_OP_RECV;
+        case IoUring::Opcode::kSend:
+            return IORING_OP_SEND;
+        case IoUring::Opcode::kReadv:
+            return IORING_OP_READV;
+        case IoUring::Opcode::kWritev:
+            return IORING_OP_WRITEV;
+        case IoUring::Opcode::kAccept:
+            return IORING_OP_ACCEPT;
+        case IoUring::Opcode::kRead:
+            return IORING_OP_READ;
+        case IoUring::Opcode::kWrite:
+            return IORING_OP_WRITE;
+        case IoUring::Opcode::kOpenAt:
+            return IORING_OP_OPENAT;
+        case IoUring::Opcode::kClose:
+            return IORING_OP_CLOSE;
+        case IoUring::Opcode::kAsyncCancel:
+            return IORING_OP_ASYNC_CANCEL;
+    }
+    UINVARIANT(false, "Unexpected io_uring opcode");
+}
+
+template <typename T>
+T* Offset(void* base, std::uint32_t offset) noexcept {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+void* MapRing(int ring_fd, std::size_t size, off_t offset) {
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+    if (ptr == MAP_FAILED) {
+        throw std::system_error(errno, std::system_category(), "Error while mapping io_uring queues");
+    }
+    return ptr;
+}
+
+}  // namespace
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::uint32_t entries) {
+    std::unique_ptr<IoUring> ring{new IoUring()};
+    try {
+        ring->Init(entries);
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "io_uring is not available, falling back to epoll: " << ex;
+        return nullptr;
+    }
+    return ring;
+}
+
+void IoUring::Init(std::uint32_t entries) {
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * kCqEntriesMultiplier;
+    ring_fd_ = utils::CheckSyscall(IoUringSetup(entries, params), "setting up io_uring with {} entries", entries);
+
+    // Without NODROP the kernel silently loses completions on CQ overflow and
+    // the waiting tasks would hang forever.
+    if (!(params.features & IORING_FEAT_NODROP)) {
+        throw std::runtime_error("io_uring lacks IORING_FEAT_NODROP support, kernel is too old");
+    }
+    if (!AreRequiredOpsSupported(ring_fd_)) {
+        throw std::runtime_error("io_uring does not support some of the required operations");
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES);
+
+    sq_head_ = Offset<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = Offset<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_flags_ = Offset<unsigned>(sq_ring_, params.sq_off.flags);
+    sq_array_ = Offset<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *Offset<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+
+    cq_head_ = Offset<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = Offset<unsigned>(cq_ring_, params.cq_off.tail);
+    cqes_ = Offset<void>(cq_ring_, params.cq_off.cqes);
+    cq_mask_ = *Offset<unsigned>(cq_ring_, params.cq_off.ring_mask);
+
+    sq_reserved_ = *sq_tail_;
+
+    event_fd_ = utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC), "creating eventfd for io_uring");
+    // Not IORING_REGISTER_EVENTFD_ASYNC: the completions of the poll-driven
+    // socket operations come from task_work rather than io-wq, and nobody
+    // would reap them
+    utils::CheckSyscall(
+        IoUringRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1), "registering eventfd in io_uring"
+    );
+}
+
+IoUring::~IoUring() {
+    if (sqes_) ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+    if (event_fd_ != -1) ::close(event_fd_);
+    if (ring_fd_ != -1) ::close(ring_fd_);
+}
+
+void IoUring::Submit(Operation& op) noexcept {
+    UASSERT(op.on_complete);
+    SubmitSqe(op, reinterpret_cast<std::uint64_t>(&op));
+    submitted_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IoUring::Cancel(Operation& op) noexcept {
+    Operation cancel;
+    cancel.opcode = Opcode::kAsyncCancel;
+    cancel.addr = reinterpret_cast<std::uint64_t>(&op);
+    SubmitSqe(cancel, kIgnoredUserData);
+}
+
+void IoUring::SubmitSqe(const Operation& op, std::uint64_t user_data) noexcept {
+    // Reserve a slot. It is free once the kernel has consumed the entry that
+    // used it the previous time.
+    unsigned ticket = sq_reserved_.load(std::memory_order_relaxed);
+    for (;;) {
+        const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (ticket - head >= sq_entries_) {
+            // Help to pass the published entries to the kernel, the rest are
+            // still being filled
+            Enter(sq_entries_, 0);
+            std::this_thread::yield();
+            ticket = sq_reserved_.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (sq_reserved_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) break;
+    }
+
+    const unsigned index = ticket & sq_mask_;
+    auto& sqe = static_cast<io_uring_sqe*>(sqes_)[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = ToNativeOpcode(op.opcode);
+    sqe.fd = op.fd;
+    sqe.addr = op.addr;
+    sqe.addr2 = op.addr2;
+    sqe.len = op.len;
+    sqe.off = op.offset;
+    sqe.rw_flags = static_cast<__kernel_rwf_t>(op.op_flags);
+    sqe.user_data = user_data;
+    sq_array_[index] = index;
+
+    // The kernel consumes the entries up to the tail, so they are published
+    // in the reservation order
+    for (unsigned spins = 0; __atomic_load_n(sq_tail_, __ATOMIC_ACQUIRE) != ticket; ++spins) {
+        if (spins >= kSpinsBeforeYield) std::this_thread::yield();
+    }
+    __atomic_store_n(sq_tail_, ticket + 1, __ATOMIC_RELEASE);
+
+    // May submit the entries of the other threads as well, or none if they
+    // have already submitted ours
+    Enter(1, 0);
+    // Operations that complete inline, e.g. the cancelled ones, are posted to
+    // the CQ during the submission
+    ReapCompletions();
+}
+
+void IoUring::Enter(unsigned to_submit, unsigned flags) noexcept {
+    for (;;) {
+        if (IoUringEnter(ring_fd_, to_submit, 0, flags) != -1) return;
+
+        const int error_code = errno;
+        if (error_code == EINTR) continue;
+        if (error_code == EBUSY || error_code == EAGAIN || error_code == EBADR) {
+            // CQ overflow or temporary lack of kernel resources, make some room
+            ReapCompletions();
+            std::this_thread::yield();
+            continue;
+        }
+
+        // No SQPOLL, but the entry is already visible to the other submitters
+        // and could not be taken back
+        utils::impl::AbortWithStacktrace(fmt::format(
+            "Error while submitting io_uring operations: {} (errno={})", utils::strerror(error_code), error_code
+        ));
+    }
+}
+
+void IoUring::ProcessCompletions() noexcept {
+    // Reset eventfd before draining, so completions arriving after the drain
+    // make it readable again.
+    std::uint64_t counter = 0;
+    [[maybe_unused]] const auto ignore = ::read(event_fd_, &counter, sizeof(counter));
+
+    ReapCompletions();
+}
+
+void IoUring::ReapCompletions() noexcept {
+    // A thread that finds the CQ busy leaves its completions to the current
+    // reaper, which re-checks the CQ after giving up the role
+    while (HasCompletions()) {
+        if (cq_reaping_.exchange(true)) return;
+        DrainCompletions();
+        cq_reaping_.store(false);
+    }
+}
+
+bool IoUring::HasCompletions() const noexcept {
+    return __atomic_load_n(cq_head_, __ATOMIC_SEQ_CST) != __atomic_load_n(cq_tail_, __ATOMIC_SEQ_CST) ||
+           (__atomic_load_n(sq_flags_, __ATOMIC_SEQ_CST) & IORING_SQ_CQ_OVERFLOW);
+}
+
+void IoUring::DrainCompletions() noexcept {
+    if (__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) & IORING_SQ_CQ_OVERFLOW) {
+        // Flush overflown completions into the CQ
+        IoUringEnter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+    }
+
+    unsigned head = *cq_head_;
+    for (;;) {
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        if (head == tail) break;
+
+        const auto& cqe = static_cast<const io_uring_cqe*>(cqes_)[head & cq_mask_];
+        const auto user_data = cqe.user_data;
+        const auto result = cqe.res;
+        ++head;
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+        if (user_data == kIgnoredUserData) continue;
+
+        auto* op = reinterpret_cast<Operation*>(user_data);
+        op->result = result;
+        op->on_complete(*op);
+    }
+}
+
+std::int32_t AwaitCompletion(IoUring& ring, IoUring::Operation& op, Deadline deadline, bool& interrupted) {
+    engine::SingleUseEvent event;
+    op.data = &event;
+    op.on_complete = [](IoUring::Operation& op) noexcept { static_cast<engine::SingleUseEvent*>(op.data)->Send(); };
+
+    // Operations that finished inline are completed right on the submitting
+    // side, without a round trip through the ev thread
+    ring.Submit(op);
+
+    if (event.WaitUntil(deadline) != FutureStatus::kReady) {
+        interrupted = true;
+        ring.Cancel(op);
+        // The kernel may still be using the buffers
+        event.WaitNonCancellable();
+    }
+    return op.result;
+}
+
+}  // namespace engine::io::sys_linux
+
+USERVER_NAMESPACE_END
+
+#else
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::sys_linux {
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::uint32_t) {
+    LOG_WARNING() << "io_uring is not supported on this platform, falling back to the default poller";
+    return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::Submit(Operation&) noexcept {
+    utils::impl::AbortWithStacktrace("io_uring is not supported on this platform");
+}
+
+void IoUring::Cancel(Operation&) noexcept {}
+
+void IoUring::ProcessCompletions() noexcept {}
+
+void IoUring::ReapCompletions() noexcept {}
+
+std::int32_t AwaitCompletion(IoUring&, IoUring::Operation&, Deadline, bool&) {
+    UINVARIANT(false, "io_uring is not supported on this platform");
+}
+
+}  // namespace engine::io::sys_linux
+
+USERVER_NAMESPACE_END
+
+#endif
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::sys_linux {
+
+/// @brief Minimal io_uring instance built on top of raw syscalls.
+///
+/// Submissions are thread-safe and lock-free: submitters reserve SQ slots
+/// with an atomic counter and pass the entries to the kernel right away.
+/// Operations that complete inline are reaped by the submitting thread, all
+/// the completions are also reported via an eventfd that is polled by the
+/// owning ev thread.
+class IoUring final {
+public:
+    /// Subset of io_uring opcodes used by the engine, mirrors IORING_OP_*
+    enum class Opcode : std::uint8_t {
+        kNop,
+        kRecv,
+        kSend,
+        kReadv,
+        kWritev,
+        kAccept,
+        kRead,
+        kWrite,
+        kOpenAt,
+        kClose,
+        kAsyncCancel,
+    };
+
+    /// A single in-flight operation, must outlive its completion.
+    struct Operation {
+        using Callback = void (*)(Operation&) noexcept;
+
+        Opcode opcode{Opcode::kNop};
+        int fd{-1};
+        std::uint64_t addr{0};
+        std::uint64_t addr2{0};
+        std::uint32_t len{0};
+        std::uint64_t offset{0};
+        // msg_flags, accept_flags, open_flags or rw_flags depending on opcode
+        std::uint32_t op_flags{0};
+
+        // Transferred bytes, a new fd or -errno
+        std::int32_t result{0};
+
+        Callback on_complete{nullptr};
+        void* data{nullptr};
+    };
+
+    /// @returns nullptr if io_uring or some of the required operations are not
+    /// supported by the running kernel or are forbidden by seccomp.
+    static std::unique_ptr<IoUring> TryCreate(std::uint32_t entries);
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    ~IoUring();
+
+    /// Descriptor that becomes readable when there are completions to process
+    int GetEventFd() const noexcept { return event_fd_; }
+
+    /// @brief Passes the operation to the kernel. Thread-safe.
+    ///
+    /// `on_complete` is always called, errors of the operation are reported
+    /// via Operation::result. The completions that are already available,
+    /// including this operation's, are processed before return. Aborts if the ring itself is broken, as the
+    /// entry could not be taken back from the SQ.
+    void Submit(Operation& op) noexcept;
+
+    /// Requests cancellation of an in-flight operation. Thread-safe. The
+    /// operation still completes, usually with -ECANCELED, and is reaped before
+    /// return if it was cancelled right away.
+    void Cancel(Operation& op) noexcept;
+
+    /// Resets the eventfd and invokes `on_complete` for all the completed
+    /// operations. Thread-safe.
+    void ProcessCompletions() noexcept;
+
+    /// Invokes `on_complete` for all the completed operations, unless another
+    /// thread is already doing that. Thread-safe, does not block.
+    void ReapCompletions() noexcept;
+
+    /// Count of the operations passed to the kernel, for tests and diagnostics
+    std::uint64_t GetSubmittedCount() const noexcept { return submitted_count_.load(std::memory_order_relaxed); }
+
+private:
+    IoUring() = default;
+
+    void Init(std::uint32_t entries);
+    void SubmitSqe(const Operation& op, std::uint64_t user_data) noexcept;
+    void Enter(unsigned to_submit, unsigned flags) noexcept;
+    bool HasCompletions() const noexcept;
+    void DrainCompletions() noexcept;
+
+    int ring_fd_{-1};
+    int event_fd_{-1};
+
+    void* sq_ring_{nullptr};
+    std::size_t sq_ring_size_{0};
+    void* cq_ring_{nullptr};
+    std::size_t cq_ring_size_{0};
+    void* sqes_{nullptr};
+    std::size_t sqes_size_{0};
+
+    unsigned* sq_head_{nullptr};
+    unsigned* sq_tail_{nullptr};
+    unsigned* sq_flags_{nullptr};
+    unsigned* sq_array_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned sq_entries_{0};
+
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    void* cqes_{nullptr};
+    unsigned cq_mask_{0};
+
+    // SQ slots handed out to the submitters, runs ahead of *sq_tail_ by the
+    // count of the entries that are being filled
+    std::atomic<unsigned> sq_reserved_{0};
+    // Set while some thread drains the CQ
+    std::atomic<bool> cq_reaping_{false};
+    std::atomic<std::uint64_t> submitted_count_{0};
+};
+
+/// @brief Submits the operation and suspends the current task until it
+/// completes. An operation that completes inline is reaped by the calling
+/// thread and the task is not suspended.
+///
+/// If the deadline expires or the task is cancelled, the operation is
+/// cancelled in the kernel and the function still waits for its completion,
+/// so the buffers referenced by `op` are never accessed after return.
+///
+/// @param interrupted is set to `true` if the wait was interrupted
+/// @returns the result of the operation: non-negative value or -errno
+std::int32_t AwaitCompletion(IoUring& ring, IoUring::Operation& op, Deadline deadline, bool& interrupted);
+
+}  // namespace engine::io::sys_linux
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,197 @@
+#ifdef __linux__
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/future_status.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <engine/ev/thread_control.hpp>
+#include <engine/io/sys_linux/io_uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace io = engine::io;
+using Deadline = engine::Deadline;
+using TcpListener = internal::net::TcpListener;
+
+engine::TaskProcessorPoolsConfig MakeIoUringConfig() {
+    engine::TaskProcessorPoolsConfig config;
+    config.ev_io_uring_enabled = true;
+    // A single ring, so that its counters cover all the operations
+    config.ev_threads_num = 1;
+    return config;
+}
+
+// nullptr if io_uring is unavailable in the test environment
+io::sys_linux::IoUring* GetIoUring() { return engine::current_task::GetEventThread().GetIoUring(); }
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define SKIP_WITHOUT_IO_URING()                                                   \
+    if (!GetIoUring()) {                                                          \
+        GTEST_SKIP() << "io_uring is not available, the default poller is used"; \
+    }
+
+}  // namespace
+
+TEST(IoUring, SendRecv) {
+    engine::RunStandalone(2, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        const std::string data = "the quick brown fox";
+        EXPECT_EQ(data.size(), client.SendAll(data.data(), data.size(), test_deadline));
+        EXPECT_EQ(data.size(), client.SendAll({{data.data(), 4}, {data.data() + 4, data.size() - 4}}, test_deadline));
+
+        std::string received(data.size() * 2, '\0');
+        EXPECT_EQ(received.size(), server.RecvAll(received.data(), received.size(), test_deadline));
+        EXPECT_EQ(data + data, received);
+    });
+}
+
+TEST(IoUring, DisabledUsesPoller) {
+    engine::RunStandalone(1, engine::TaskProcessorPoolsConfig{}, [] {
+        ASSERT_EQ(GetIoUring(), nullptr);
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        std::array<char, 4> buf{};
+        EXPECT_EQ(4, client.SendAll("ping", 4, test_deadline));
+        EXPECT_EQ(4, server.RecvAll(buf.data(), buf.size(), test_deadline));
+    });
+}
+
+TEST(IoUring, RecvWaitsForData) {
+    engine::RunStandalone(2, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        auto sender = engine::AsyncNoSpan([&client = client, test_deadline] {
+            engine::SleepFor(std::chrono::milliseconds{50});
+            return client.SendAll("ping", 4, test_deadline);
+        });
+
+        const auto submitted_before = GetIoUring()->GetSubmittedCount();
+        std::array<char, 16> buf{};
+        EXPECT_EQ(4, server.RecvSome(buf.data(), buf.size(), test_deadline));
+        EXPECT_EQ("ping", std::string(buf.data(), 4));
+        EXPECT_EQ(4, sender.Get());
+        // No data at first, so the recv went through the ring
+        EXPECT_GT(GetIoUring()->GetSubmittedCount(), submitted_before);
+
+        client.Close();
+        EXPECT_EQ(0, server.RecvSome(buf.data(), buf.size(), test_deadline));
+    });
+}
+
+TEST(IoUring, RecvTimeout) {
+    engine::RunStandalone(1, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        const auto submitted_before = GetIoUring()->GetSubmittedCount();
+        std::array<char, 16> buf{};
+        EXPECT_THROW(
+            [[maybe_unused]] auto size =
+                server.RecvSome(buf.data(), buf.size(), Deadline::FromDuration(std::chrono::milliseconds{10})),
+            io::IoTimeout
+        );
+        // The recv and its cancellation
+        EXPECT_GE(GetIoUring()->GetSubmittedCount(), submitted_before + 2);
+
+        // The socket is still usable after the cancelled operation
+        EXPECT_EQ(4, client.SendAll("pong", 4, test_deadline));
+        EXPECT_EQ(4, server.RecvAll(buf.data(), 4, test_deadline));
+    });
+}
+
+TEST(IoUring, RecvTimeoutOnIdleSocket) {
+    engine::RunStandalone(2, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        // The peer never sends anything, so only the completions of the
+        // cancelled recvs may wake the reader up
+        auto reader = engine::AsyncNoSpan([&server = server] {
+            std::array<char, 16> buf{};
+            for (int i = 0; i < 10; ++i) {
+                EXPECT_THROW(
+                    [[maybe_unused]] auto size =
+                        server.RecvSome(buf.data(), buf.size(), Deadline::FromDuration(std::chrono::milliseconds{5})),
+                    io::IoTimeout
+                );
+            }
+        });
+        ASSERT_EQ(reader.WaitNothrowUntil(test_deadline), engine::FutureStatus::kReady) << "recv timeout hangs";
+        reader.Get();
+    });
+}
+
+TEST(IoUring, RecvCancel) {
+    engine::RunStandalone(1, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        auto reader = engine::AsyncNoSpan([&server = server, test_deadline] {
+            std::array<char, 16> buf{};
+            return server.RecvSome(buf.data(), buf.size(), test_deadline);
+        });
+        engine::Yield();
+        reader.RequestCancel();
+        EXPECT_THROW(reader.Get(), io::IoCancelled);
+    });
+}
+
+TEST(IoUring, ReadFileContents) {
+    engine::RunStandalone(1, MakeIoUringConfig(), [] {
+        SKIP_WITHOUT_IO_URING();
+        const auto file = fs::blocking::TempFile::Create();
+        const std::string contents(200 * 1024, 'x');
+        fs::blocking::RewriteFileContents(file.GetPath(), contents);
+
+        const auto submitted_before = GetIoUring()->GetSubmittedCount();
+        EXPECT_EQ(contents, fs::ReadFileContents(engine::current_task::GetTaskProcessor(), file.GetPath()));
+        // open, reads and close
+        EXPECT_GE(GetIoUring()->GetSubmittedCount(), submitted_before + 3);
+
+        try {
+            fs::ReadFileContents(engine::current_task::GetTaskProcessor(), file.GetPath() + "-missing");
+            ADD_FAILURE() << "Missing file was read";
+        } catch (const std::system_error& ex) {
+            EXPECT_EQ(ex.code().value(), ENOENT) << ex.what();
+        }
+    });
+}
+
+USERVER_NAMESPACE_END
+
+#endif  // __linux__
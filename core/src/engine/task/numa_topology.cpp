@@ -0,0 +1,110 @@
+#include <engine/task/numa_topology.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <climits>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/strerror.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+#ifdef __linux__
+// from <linux/mempolicy.h>, which conflicts with libnuma headers
+constexpr int kMpolPreferred = 1;
+
+std::vector<NumaNode> ReadNumaNodes() {
+    std::vector<NumaNode> nodes;
+    try {
+        const auto online = utils::text::Trim(fs::blocking::ReadFileContents("/sys/devices/system/node/online"));
+        for (const auto id : ParseCpuList(online)) {
+            auto cpus = ParseCpuList(utils::text::Trim(
+                fs::blocking::ReadFileContents(fmt::format("/sys/devices/system/node/node{}/cpulist", id))
+            ));
+            // memory-only nodes are of no use for the workers
+            if (!cpus.empty()) nodes.push_back({id, std::move(cpus)});
+        }
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "Failed to read NUMA topology: " << ex;
+        return {};
+    }
+    return nodes;
+}
+#else
+std::vector<NumaNode> ReadNumaNodes() { return {}; }
+#endif
+
+}  // namespace
+
+std::vector<std::size_t> ParseCpuList(std::string_view list) {
+    std::vector<std::size_t> result;
+    while (!list.empty()) {
+        const auto comma_pos = list.find(',');
+        const auto range = list.substr(0, comma_pos);
+        list.remove_prefix(comma_pos == std::string_view::npos ? list.size() : comma_pos + 1);
+        if (range.empty()) continue;
+
+        const auto dash_pos = range.find('-');
+        const auto first = utils::FromString<std::size_t>(range.substr(0, dash_pos));
+        const auto last =
+            dash_pos == std::string_view::npos ? first : utils::FromString<std::size_t>(range.substr(dash_pos + 1));
+        if (last < first) {
+            throw std::runtime_error(fmt::format("Invalid range '{}' in CPU list", range));
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+    }
+    return result;
+}
+
+const std::vector<NumaNode>& GetNumaNodes() {
+    static const auto nodes = ReadNumaNodes();
+    return nodes;
+}
+
+std::size_t GetWorkerNumaGroup(std::size_t worker_index, std::size_t workers_count, std::size_t nodes_count) noexcept {
+    if (workers_count == 0 || nodes_count == 0) return 0;
+    return worker_index * nodes_count / workers_count;
+}
+
+void BindCurrentThreadToNumaNode(const NumaNode& node) noexcept {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const auto cpu : node.cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpus);
+    }
+    if (const int err = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus)) {
+        LOG_WARNING() << "Failed to bind thread to the CPUs of NUMA node " << node.id << ": " << utils::strerror(err);
+        return;
+    }
+
+    constexpr std::size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> node_mask(node.id / kBitsPerWord + 1, 0);
+    node_mask[node.id / kBitsPerWord] = 1UL << (node.id % kBitsPerWord);
+    if (::syscall(SYS_set_mempolicy, kMpolPreferred, node_mask.data(), node_mask.size() * kBitsPerWord + 1) == -1) {
+        LOG_WARNING() << "Failed to prefer memory of NUMA node " << node.id << ": " << utils::strerror(errno);
+    }
+#else
+    LOG_WARNING() << "NUMA binding is not supported on this platform, node " << node.id << " is ignored";
+#endif
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
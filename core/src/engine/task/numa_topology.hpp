@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+struct NumaNode final {
+    std::size_t id{0};
+    std::vector<std::size_t> cpus;
+};
+
+/// Parses the Linux CPU/node list format, e.g. "0-3,8,10-11"
+std::vector<std::size_t> ParseCpuList(std::string_view list);
+
+/// @returns online NUMA nodes with CPUs, read once from sysfs; empty if the
+/// topology is unknown
+const std::vector<NumaNode>& GetNumaNodes();
+
+/// Workers are split into contiguous groups of almost equal size, one per node
+std::size_t GetWorkerNumaGroup(std::size_t worker_index, std::size_t workers_count, std::size_t nodes_count) noexcept;
+
+/// Restricts the current thread to the CPUs of the node and makes the node
+/// preferred for its memory allocations. Failures are logged and ignored.
+void BindCurrentThreadToNumaNode(const NumaNode& node) noexcept;
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,31 @@
+#include <engine/task/numa_topology.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(NumaTopology, ParseCpuList) {
+    using Cpus = std::vector<std::size_t>;
+    EXPECT_EQ(engine::impl::ParseCpuList(""), Cpus{});
+    EXPECT_EQ(engine::impl::ParseCpuList("0"), Cpus{0});
+    EXPECT_EQ(engine::impl::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+    EXPECT_EQ(engine::impl::ParseCpuList("0-1,8,10-11"), (Cpus{0, 1, 8, 10, 11}));
+
+    EXPECT_ANY_THROW(engine::impl::ParseCpuList("3-1"));
+    EXPECT_ANY_THROW(engine::impl::ParseCpuList("a"));
+}
+
+TEST(NumaTopology, WorkerGroups) {
+    // no NUMA
+    EXPECT_EQ(engine::impl::GetWorkerNumaGroup(5, 6, 0), 0);
+    EXPECT_EQ(engine::impl::GetWorkerNumaGroup(5, 6, 1), 0);
+
+    std::vector<std::size_t> groups;
+    for (std::size_t i = 0; i < 5; ++i) groups.push_back(engine::impl::GetWorkerNumaGroup(i, 5, 2));
+    EXPECT_EQ(groups, (std::vector<std::size_t>{0, 0, 0, 1, 1}));
+
+    // more nodes than workers
+    EXPECT_EQ(engine::impl::GetWorkerNumaGroup(1, 2, 4), 2);
+}
+
+USERVER_NAMESPACE_END
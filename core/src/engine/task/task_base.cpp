@@ -153,6 +153,14 @@ std::size_t GetStackSize() { return GetTaskProcessor().GetTaskProcessorPools()->
 
 ev::ThreadControl& GetEventThread() { return GetTaskProcessor().EventThreadPool().NextThread(); }
 
+void EnableExecutionStats() noexcept { GetCurrentTaskContext().EnableExecutionStats(); }
+
+ExecutionStats GetExecutionStats() noexcept { return GetCurrentTaskContext().GetExecutionStats(); }
+
+void SetPriority(TaskPriority priority) { GetCurrentTaskContext().SetPriority(priority); }
+
+TaskPriority GetPriority() { return GetCurrentTaskContext().GetPriority(); }
+
 }  // namespace current_task
 
 namespace impl {
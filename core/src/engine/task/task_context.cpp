@@ -26,6 +26,7 @@
 #include <engine/task/coro_unwinder.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
 #include <engine/task/task_processor.hpp>
+#include <utils/cpu_profiler.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -208,8 +209,11 @@ void TaskContext::DoStep() {
             SetState(Task::State::kRunning);
             auto& coro_ref = *coro_;
             TsanAcquireBarrier();
+            utils::cpu_profiler::BeginContextSwitch();
             coro_ref(this);
+            utils::cpu_profiler::EndContextSwitch();
         } catch (...) {
+            utils::cpu_profiler::EndContextSwitch();
             uncaught = std::current_exception();
         }
         TsanReleaseBarrier();
@@ -282,6 +286,12 @@ void TaskContext::SetBackground(bool is_background) {
     is_background_ = is_background;
 }
 
+void TaskContext::SetPriority(current_task::TaskPriority priority) {
+    UASSERT(IsCurrent());
+    UASSERT(state_ == Task::State::kRunning);
+    priority_ = priority;
+}
+
 TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy, Deadline deadline) {
     UASSERT(IsCurrent());
     UASSERT(state_ == Task::State::kRunning);
@@ -315,13 +325,17 @@ TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy, Deadli
     UASSERT(task_pipe_);
     TraceStateTransition(Task::State::kSuspended);
     ProfilerStopExecution();
+    AccountExecutionStop();
 
     auto& task_pipe_ref = *task_pipe_;
     TsanAcquireBarrier();
+    utils::cpu_profiler::BeginContextSwitch();
     [[maybe_unused]] TaskContext* context = task_pipe_ref().get();
+    utils::cpu_profiler::EndContextSwitch();
     TsanReleaseBarrier();
 
     ProfilerStartExecution();
+    AccountExecutionStart();
     TraceStateTransition(Task::State::kRunning);
     UASSERT(context == this);
     UASSERT(state_ == Task::State::kRunning);
@@ -456,12 +470,14 @@ private:
 
 void TaskContext::CoroFunc(TaskPipe& task_pipe) {
     for (TaskContext* context : task_pipe) {
+        utils::cpu_profiler::EndContextSwitch();
         UASSERT(context);
         context->TsanReleaseBarrier();
         context->yield_reason_ = YieldReason::kNone;
         context->task_pipe_ = &task_pipe;
 
         context->ProfilerStartExecution();
+        context->AccountExecutionStart();
 
         // We only let tasks ran with CriticalAsync enter function body, others
         // get terminated ASAP.
@@ -497,9 +513,11 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
         }
 
         context->ProfilerStopExecution();
+        context->AccountExecutionStop();
 
         context->task_pipe_ = nullptr;
         context->TsanAcquireBarrier();
+        utils::cpu_profiler::BeginContextSwitch();
     }
 }
 
@@ -573,6 +591,9 @@ void TaskContext::Schedule() {
     UASSERT(state_ != Task::State::kQueued);
     SetState(Task::State::kQueued);
     TraceStateTransition(Task::State::kQueued);
+    if (execution_stats_enabled_) {
+        execution_stats_queued_timepoint_ = std::chrono::steady_clock::now();
+    }
     task_processor_.Schedule(this);
     // NOTE: may be executed at this point
 }
@@ -610,6 +631,37 @@ void TaskContext::ProfilerStopExecution() {
     }
 }
 
+void TaskContext::AccountExecutionStart() noexcept {
+    if (!execution_stats_enabled_) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    execution_stats_.queue_wait_time += now - execution_stats_queued_timepoint_;
+    execution_stats_started_timepoint_ = now;
+}
+
+void TaskContext::AccountExecutionStop() noexcept {
+    if (!execution_stats_enabled_) return;
+
+    execution_stats_.running_time += std::chrono::steady_clock::now() - execution_stats_started_timepoint_;
+    ++execution_stats_.context_switches;
+}
+
+void TaskContext::EnableExecutionStats() noexcept {
+    UASSERT(IsCurrent());
+    if (std::exchange(execution_stats_enabled_, true)) return;
+
+    execution_stats_started_timepoint_ = std::chrono::steady_clock::now();
+}
+
+current_task::ExecutionStats TaskContext::GetExecutionStats() const noexcept {
+    UASSERT(IsCurrent());
+    auto stats = execution_stats_;
+    if (execution_stats_enabled_) {
+        stats.running_time += std::chrono::steady_clock::now() - execution_stats_started_timepoint_;
+    }
+    return stats;
+}
+
 void TaskContext::TraceStateTransition(Task::State state) {
     if (trace_csw_left_ == 0) return;
     --trace_csw_left_;
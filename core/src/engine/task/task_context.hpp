@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <ev.h>
@@ -23,6 +25,7 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/current_task.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
@@ -134,6 +137,9 @@ public:
     void SetBackground(bool);
     bool IsBackground() const noexcept { return is_background_; };
 
+    void SetPriority(current_task::TaskPriority priority);
+    current_task::TaskPriority GetPriority() const noexcept { return priority_; }
+
     // causes this to yield and wait for wakeup
     // must only be called from this context
     // "spurious wakeups" may be caused by wakeup queueing
@@ -160,10 +166,21 @@ public:
     void SetQueueWaitTimepoint(std::chrono::steady_clock::time_point tp) { task_queue_wait_timepoint_ = tp; }
 
     void SetCancelDeadline(Deadline deadline);
+    Deadline GetCancelDeadline() const noexcept { return cancel_deadline_; }
 
     bool HasLocalStorage() const noexcept;
     task_local::Storage& GetLocalStorage() noexcept;
 
+    // See utils::cpu_profiler::TagScope
+    const std::string* GetCpuProfilerTag() const noexcept { return cpu_profiler_tag_.load(std::memory_order_relaxed); }
+    void SetCpuProfilerTag(const std::string* tag) noexcept {
+        cpu_profiler_tag_.store(tag, std::memory_order_relaxed);
+    }
+
+    // See current_task::EnableExecutionStats
+    void EnableExecutionStats() noexcept;
+    current_task::ExecutionStats GetExecutionStats() const noexcept;
+
     // ContextAccessor implementation
     bool IsReady() const noexcept override;
     EarlyWakeup TryAppendWaiter(TaskContext& waiter) override;
@@ -198,6 +215,9 @@ private:
     void ProfilerStartExecution();
     void ProfilerStopExecution();
 
+    void AccountExecutionStart() noexcept;
+    void AccountExecutionStop() noexcept;
+
     void TraceStateTransition(Task::State state);
 
     void TsanAcquireBarrier() noexcept;
@@ -209,6 +229,7 @@ private:
     const bool is_critical_;
     bool is_cancellable_{true};
     bool is_background_{false};
+    current_task::TaskPriority priority_{current_task::TaskPriority::kNormal};
     bool within_sleep_{false};
     EhGlobals eh_globals_;
 
@@ -229,6 +250,12 @@ private:
 
     std::size_t trace_csw_left_;
 
+    // Written by the waker in Schedule(), read when the task starts running
+    std::chrono::steady_clock::time_point execution_stats_queued_timepoint_;
+    std::chrono::steady_clock::time_point execution_stats_started_timepoint_;
+    current_task::ExecutionStats execution_stats_;
+    bool execution_stats_enabled_{false};
+
     AtomicSleepState sleep_state_{SleepState{SleepFlags::kSleeping, SleepState::Epoch{0}}};
     WakeupSource wakeup_source_{WakeupSource::kNone};
 
@@ -238,6 +265,9 @@ private:
 
     std::optional<task_local::Storage> local_storage_{};
 
+    // Read by a signal handler in the same thread, hence atomic
+    std::atomic<const std::string*> cpu_profiler_tag_{nullptr};
+
     // refcounter for task abandoning (cancellation) in engine::SharedTask
     std::atomic<std::size_t> shared_task_usages_{1};
 
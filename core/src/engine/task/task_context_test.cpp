@@ -88,4 +88,26 @@ UTEST(TaskContext, WaitListWakeupRace) {
     EXPECT_EQ(context.Sleep(wait_manager, engine::Deadline{}), engine::impl::TaskContext::WakeupSource::kWaitList);
 }
 
+UTEST(TaskContext, ExecutionStats) {
+    constexpr std::chrono::milliseconds kBusyTime{5};
+    constexpr std::chrono::milliseconds kSleepTime{100};
+
+    auto task = engine::AsyncNoSpan([&] {
+        EXPECT_EQ(engine::current_task::GetExecutionStats().running_time.count(), 0);
+
+        engine::current_task::EnableExecutionStats();
+        const auto busy_deadline = std::chrono::steady_clock::now() + kBusyTime;
+        while (std::chrono::steady_clock::now() < busy_deadline) {
+        }
+        engine::SleepFor(kSleepTime);
+
+        const auto stats = engine::current_task::GetExecutionStats();
+        EXPECT_GE(stats.running_time, kBusyTime);
+        // The sleep is neither running, nor waiting in the queue
+        EXPECT_LT(stats.running_time + stats.queue_wait_time, kSleepTime);
+        EXPECT_GE(stats.context_switches, 1);
+    });
+    task.Get();
+}
+
 USERVER_NAMESPACE_END
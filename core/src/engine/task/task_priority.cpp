@@ -0,0 +1,48 @@
+#include <engine/task/task_priority.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+TaskPriority GetTaskPriority(const TaskContext& context, std::chrono::steady_clock::duration urgent_deadline_threshold)
+    noexcept {
+    const auto priority = context.GetPriority();
+    if (priority == TaskPriority::kUrgent) {
+        return priority;
+    }
+    if (priority == TaskPriority::kBackground || context.IsBackground()) {
+        return TaskPriority::kBackground;
+    }
+
+    if (urgent_deadline_threshold.count() > 0) {
+        const auto deadline = context.GetCancelDeadline();
+        if (deadline.IsReachable() && deadline.TimeLeftApprox() < urgent_deadline_threshold) {
+            return TaskPriority::kUrgent;
+        }
+    }
+    return TaskPriority::kNormal;
+}
+
+BackgroundTaskScope::BackgroundTaskScope() {
+    auto& context = current_task::GetCurrentTaskContext();
+    if (!context.GetTaskProcessor().HasTaskPriorities()) {
+        return;
+    }
+
+    context_ = &context;
+    previous_priority_ = context.GetPriority();
+    context.SetPriority(TaskPriority::kBackground);
+}
+
+BackgroundTaskScope::~BackgroundTaskScope() {
+    if (context_) {
+        context_->SetPriority(previous_priority_);
+    }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+#include <userver/engine/task/current_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+
+using current_task::TaskPriority;
+
+/// Scheduling class of a ready task, used by the task queues when
+/// `task-priorities` are enabled for the task processor. A task with the
+/// normal priority is urgent if its deadline is about to expire.
+TaskPriority GetTaskPriority(const TaskContext& context, std::chrono::steady_clock::duration urgent_deadline_threshold)
+    noexcept;
+
+/// @brief Marks the current task as a background one while in scope, if its
+/// task processor uses task priorities
+class BackgroundTaskScope final {
+public:
+    BackgroundTaskScope();
+    ~BackgroundTaskScope();
+
+    BackgroundTaskScope(BackgroundTaskScope&&) = delete;
+    BackgroundTaskScope& operator=(BackgroundTaskScope&&) = delete;
+
+private:
+    TaskContext* context_{nullptr};
+    TaskPriority previous_priority_{TaskPriority::kNormal};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,14 @@
 #include "task_processor.hpp"
 
 #include <sys/types.h>
+#include <algorithm>
+#include <cmath>
 #include <csignal>
 
 #include <fmt/format.h>
 
 #include <concurrent/impl/latch.hpp>
+#include <userver/hostinfo/cpu_limit.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/impl/static_registration.hpp>
@@ -16,6 +19,7 @@
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
+#include <engine/task/numa_topology.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
 
@@ -42,6 +46,21 @@ constexpr OverloadActionAndValue<OverloadBitAndValue> GetOverloadActionAndValue(
     }
 }
 
+// Minimal interval between two changes of the active workers count, so that a
+// single spike does not park or unpark all the workers at once
+constexpr std::chrono::milliseconds kMinScalingInterval{10};
+
+// How often the autoscaler looks for the idle workers
+constexpr std::chrono::milliseconds kAutoscalerCheckInterval{50};
+
+std::size_t GetCpuLimitWorkers(std::size_t worker_threads) {
+    const auto cpu_limit = hostinfo::CpuLimit();
+    if (!cpu_limit || *cpu_limit <= 0) {
+        return worker_threads;
+    }
+    return std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(*cpu_limit)), 1, worker_threads);
+}
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
     static constexpr std::size_t kTaskTimestampInterval = 4;
     thread_local std::size_t task_count = 0;
@@ -99,18 +118,22 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config, std::shared_ptr<impl::T
     : task_queue_(MakeTaskQueue(config)),
       task_counter_(config.worker_threads),
       config_(std::move(config)),
-      pools_(std::move(pools)) {
+      pools_(std::move(pools)),
+      active_workers_(config_.worker_threads),
+      cpu_limit_workers_(GetCpuLimitWorkers(config_.worker_threads)),
+      worker_wait_epochs_(config_.worker_threads, 0) {
     utils::impl::FinishStaticRegistration();
     try {
         LOG_INFO() << "creating task_processor " << Name() << " "
-                   << "worker_threads=" << config_.worker_threads << " thread_name=" << config_.thread_name;
+                   << "worker_threads=" << config_.worker_threads << " thread_name=" << config_.thread_name
+                   << " numa_nodes=" << (config_.numa_aware ? impl::GetNumaNodes().size() : 0);
         concurrent::impl::Latch workers_left{static_cast<std::ptrdiff_t>(config_.worker_threads)};
         workers_.reserve(config_.worker_threads);
         for (std::size_t i = 0; i < config_.worker_threads; ++i) {
             workers_.emplace_back([this, i, &workers_left] {
                 PrepareWorkerThread(i);
                 workers_left.count_down();
-                ProcessTasks();
+                ProcessTasks(i);
                 FinalizeWorkerThread();
             });
         }
@@ -127,6 +150,11 @@ TaskProcessor::~TaskProcessor() { Cleanup(); }
 
 void TaskProcessor::Cleanup() noexcept {
     InitiateShutdown();
+    StopAutoscaler();
+
+    // Parked workers have to see the stop signal
+    autoscaling_enabled_ = false;
+    SetActiveWorkerCount(config_.worker_threads);
 
     // Some tasks may be bound but not scheduled yet
     task_counter_.WaitForExhaustionBlocking();
@@ -230,6 +258,8 @@ void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
         }
     }
     profiler_force_stacktrace_.store(settings.profiler_force_stacktrace);
+
+    SetAutoscalingSettings(settings);
 }
 
 std::chrono::microseconds TaskProcessor::GetProfilerThreshold() const { return task_profiler_threshold_.load(); }
@@ -284,6 +314,17 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
             break;
     }
 
+    if (config_.numa_aware) {
+        // Bind before anything is allocated by the worker, so that its
+        // coroutine stacks cache and queues are node-local
+        const auto& nodes = impl::GetNumaNodes();
+        if (nodes.size() > 1) {
+            impl::BindCurrentThreadToNumaNode(
+                nodes[impl::GetWorkerNumaGroup(index, config_.worker_threads, nodes.size())]
+            );
+        }
+    }
+
     std::visit([index](auto& obj) { obj.PrepareWorker(index); }, task_queue_);
 
     pools_->GetCoroPool().PrepareLocalCache();
@@ -299,9 +340,14 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
 
 void TaskProcessor::FinalizeWorkerThread() noexcept { pools_->GetCoroPool().ClearLocalCache(); }
 
-void TaskProcessor::ProcessTasks() noexcept {
+void TaskProcessor::ProcessTasks(std::size_t index) noexcept {
     while (true) {
+        ParkWorkerIfInactive(index);
+
+        auto& wait_epoch = *worker_wait_epochs_[index];
+        wait_epoch.store(wait_epoch.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         auto context = std::visit([](auto&& arg) { return arg.PopBlocking(); }, task_queue_);
+        wait_epoch.store(wait_epoch.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         if (!context) break;
 
         CheckWaitTime(*context);
@@ -327,7 +373,9 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     const auto [action, max_wait_time] = GetOverloadActionAndValue(action_bit_and_max_task_queue_wait_time_);
     const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
 
-    if (max_wait_time.count() == 0 && sensor_wait_time.count() == 0) {
+    const bool autoscaling = autoscaling_enabled_.load(std::memory_order_relaxed);
+
+    if (max_wait_time.count() == 0 && sensor_wait_time.count() == 0 && !autoscaling) {
         SetTaskQueueWaitTimeOverloaded(false);
         return;
     }
@@ -340,6 +388,10 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
 
         SetTaskQueueWaitTimeOverloaded(max_wait_time.count() && wait_time >= max_wait_time);
 
+        if (autoscaling && wait_time >= scale_up_wait_time_.load()) {
+            TryScaleWorkers(/*scale_up=*/true);
+        }
+
         if (sensor_wait_time.count() && wait_time >= sensor_wait_time) {
             GetTaskCounter().AccountTaskOverloadSensor();
         } else {
@@ -356,6 +408,136 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     }
 }
 
+void TaskProcessor::SetAutoscalingSettings(const TaskProcessorSettings& settings) {
+    if (!settings.autoscaling_enabled) {
+        if (autoscaling_enabled_.exchange(false)) {
+            LOG_INFO() << "Worker autoscaling is disabled for task processor " << Name();
+            SetActiveWorkerCount(config_.worker_threads);
+        }
+        return;
+    }
+
+    auto max_workers = settings.max_active_workers ? settings.max_active_workers : config_.worker_threads;
+    max_workers = std::min({max_workers, config_.worker_threads, cpu_limit_workers_});
+    const auto min_workers = std::clamp<std::size_t>(settings.min_active_workers, 1, max_workers);
+
+    scale_up_wait_time_ = settings.scale_up_wait_time;
+    scale_down_idle_time_ = settings.scale_down_idle_time;
+    min_active_workers_ = min_workers;
+    max_active_workers_ = max_workers;
+    if (!autoscaling_enabled_.exchange(true)) {
+        LOG_INFO() << "Worker autoscaling is enabled for task processor " << Name() << " min_workers=" << min_workers
+                   << " max_workers=" << max_workers;
+        StartAutoscaler();
+    }
+    SetActiveWorkerCount(std::clamp(active_workers_.load(), min_workers, max_workers));
+}
+
+void TaskProcessor::StartAutoscaler() {
+    const std::lock_guard lock(autoscaler_mutex_);
+    if (autoscaler_.joinable()) {
+        // The autoscaler sleeps while autoscaling is disabled
+        autoscaler_cv_.notify_all();
+        return;
+    }
+
+    autoscaler_ = std::thread([this] {
+        utils::SetCurrentThreadName(fmt::format("{}_scale", config_.thread_name));
+        RunAutoscaler();
+    });
+}
+
+void TaskProcessor::StopAutoscaler() noexcept {
+    UASSERT(is_shutting_down_);
+    {
+        const std::lock_guard lock(autoscaler_mutex_);
+    }
+    autoscaler_cv_.notify_all();
+    if (autoscaler_.joinable()) autoscaler_.join();
+}
+
+void TaskProcessor::RunAutoscaler() noexcept {
+    std::vector<IdleWorkerState> idle_states(config_.worker_threads);
+
+    std::unique_lock lock(autoscaler_mutex_);
+    while (!is_shutting_down_.load()) {
+        if (!autoscaling_enabled_.load()) {
+            autoscaler_cv_.wait(lock, [this] { return autoscaling_enabled_.load() || is_shutting_down_.load(); });
+            continue;
+        }
+
+        autoscaler_cv_.wait_for(lock, kAutoscalerCheckInterval, [this] { return is_shutting_down_.load(); });
+        if (autoscaling_enabled_.load() && HasIdleActiveWorker(idle_states)) {
+            TryScaleWorkers(/*scale_up=*/false);
+        }
+    }
+}
+
+bool TaskProcessor::HasIdleActiveWorker(std::vector<IdleWorkerState>& idle_states) const noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    const auto scale_down_idle_time = scale_down_idle_time_.load();
+    const auto active_workers = active_workers_.load();
+
+    bool has_idle = false;
+    for (std::size_t i = 0; i < idle_states.size(); ++i) {
+        auto& state = idle_states[i];
+        const auto wait_epoch = worker_wait_epochs_[i]->load(std::memory_order_relaxed);
+        if (wait_epoch != state.wait_epoch) {
+            // The worker has taken a task or has started to wait since the last check
+            state.wait_epoch = wait_epoch;
+            state.idle_since = now;
+            continue;
+        }
+
+        const bool is_waiting = wait_epoch % 2 == 1;
+        if (is_waiting && i < active_workers && now - state.idle_since >= scale_down_idle_time) {
+            has_idle = true;
+        }
+    }
+    return has_idle;
+}
+
+void TaskProcessor::SetActiveWorkerCount(std::size_t count) {
+    const auto old_count = active_workers_.exchange(count);
+    if (count > old_count) {
+        {
+            // Parked workers check active_workers_ under the mutex, taking it
+            // here makes sure that none of them misses the notification
+            const std::lock_guard lock(park_mutex_);
+        }
+        park_cv_.notify_all();
+    }
+}
+
+void TaskProcessor::TryScaleWorkers(bool scale_up) noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    auto last_scaling_time = last_scaling_time_.load();
+    if (now - last_scaling_time < kMinScalingInterval ||
+        !last_scaling_time_.compare_exchange_strong(last_scaling_time, now)) {
+        return;
+    }
+
+    const auto active_workers = active_workers_.load();
+    if (scale_up && active_workers < max_active_workers_.load()) {
+        LOG_TRACE() << "Unparking a worker of task processor " << Name() << ", active_workers=" << active_workers + 1;
+        SetActiveWorkerCount(active_workers + 1);
+    } else if (!scale_up && active_workers > min_active_workers_.load()) {
+        LOG_TRACE() << "Parking a worker of task processor " << Name() << ", active_workers=" << active_workers - 1;
+        SetActiveWorkerCount(active_workers - 1);
+    }
+}
+
+void TaskProcessor::ParkWorkerIfInactive(std::size_t index) noexcept {
+    if (index < active_workers_.load(std::memory_order_relaxed) ||
+        !std::visit([index](auto& obj) { return obj.CanParkWorker(index); }, task_queue_)) {
+        return;
+    }
+
+    // Parked worker does not wake up until it is needed again
+    std::unique_lock lock(park_mutex_);
+    park_cv_.wait(lock, [this, index] { return index < active_workers_.load() || is_shutting_down_.load(); });
+}
+
 void TaskProcessor::SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept {
     auto& atomic = overloaded_cache_->overloaded_by_wait_time;
     // The check helps to reduce contention.
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <variant>
 #include <vector>
@@ -17,6 +19,7 @@
 #include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/fixed_array.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -60,6 +63,11 @@ public:
 
     std::size_t GetWorkerCount() const { return workers_.size(); }
 
+    /// Number of worker threads that are not parked by the autoscaling
+    std::size_t GetActiveWorkerCount() const noexcept { return active_workers_.load(); }
+
+    bool HasTaskPriorities() const noexcept { return config_.task_priorities; }
+
     void SetSettings(const TaskProcessorSettings& settings);
 
     std::chrono::microseconds GetProfilerThreshold() const;
@@ -85,16 +93,37 @@ private:
         std::atomic<OverloadByLength> overload_by_length{0};
     };
 
+    struct IdleWorkerState final {
+        std::uint64_t wait_epoch{0};
+        std::chrono::steady_clock::time_point idle_since;
+    };
+
     void Cleanup() noexcept;
 
     void PrepareWorkerThread(std::size_t index) noexcept;
 
     void FinalizeWorkerThread() noexcept;
 
-    void ProcessTasks() noexcept;
+    void ProcessTasks(std::size_t index) noexcept;
 
     void CheckWaitTime(impl::TaskContext& context);
 
+    void SetAutoscalingSettings(const TaskProcessorSettings& settings);
+
+    void SetActiveWorkerCount(std::size_t count);
+
+    void TryScaleWorkers(bool scale_up) noexcept;
+
+    void ParkWorkerIfInactive(std::size_t index) noexcept;
+
+    void StartAutoscaler();
+
+    void StopAutoscaler() noexcept;
+
+    void RunAutoscaler() noexcept;
+
+    bool HasIdleActiveWorker(std::vector<IdleWorkerState>& idle_states) const noexcept;
+
     void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
 
     void HandleOverload(impl::TaskContext& context, TaskProcessorSettings::OverloadAction);
@@ -125,6 +154,26 @@ private:
     std::atomic<bool> is_shutting_down_{false};
     std::atomic<bool> task_trace_logger_set_{false};
 
+    // Workers with index >= active_workers_ are parked on park_cv_
+    std::atomic<std::size_t> active_workers_{0};
+    std::atomic<bool> autoscaling_enabled_{false};
+    std::atomic<std::size_t> min_active_workers_{0};
+    std::atomic<std::size_t> max_active_workers_{0};
+    std::atomic<std::chrono::microseconds> scale_up_wait_time_{{}};
+    std::atomic<std::chrono::microseconds> scale_down_idle_time_{{}};
+    std::atomic<std::chrono::steady_clock::time_point> last_scaling_time_{{}};
+    std::size_t cpu_limit_workers_{0};
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+
+    // Incremented by a worker before and after waiting for a task, the value is
+    // odd while the worker is idle. Idle workers are looked up by autoscaler_,
+    // an idle worker does not wake up by itself to scale the workers down.
+    utils::FixedArray<concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>>> worker_wait_epochs_;
+    std::thread autoscaler_;
+    std::mutex autoscaler_mutex_;
+    std::condition_variable autoscaler_cv_;
+
     std::unique_ptr<utils::statistics::ThreadPoolCpuStatsStorage> cpu_stats_storage_{nullptr};
 };
 
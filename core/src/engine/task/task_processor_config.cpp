@@ -63,6 +63,10 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value, formats::parse::
     config.os_scheduling = value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
     config.spinning_iterations = value["spinning-iterations"].As<int>(config.spinning_iterations);
     config.task_processor_queue = value["task-processor-queue"].As<TaskQueueType>(config.task_processor_queue);
+    config.numa_aware = value["numa-aware"].As<bool>(config.numa_aware);
+    config.task_priorities = value["task-priorities"].As<bool>(config.task_priorities);
+    config.urgent_deadline_threshold =
+        value["urgent-deadline-threshold"].As<std::chrono::milliseconds>(config.urgent_deadline_threshold);
 
     const auto task_trace = value["task-trace"];
     if (!task_trace.IsMissing()) {
@@ -104,6 +108,17 @@ TaskProcessorSettings Parse(const formats::json::Value& value, formats::parse::T
         std::chrono::microseconds(overload_doc["sensor_time_limit_us"].As<std::int64_t>(3000));
     settings.overload_action = overload_doc["action"].As<OverloadAction>(OverloadAction::kIgnore);
 
+    const auto autoscaling_doc = value["worker_autoscaling"];
+    if (!autoscaling_doc.IsMissing()) {
+        settings.autoscaling_enabled = autoscaling_doc["enabled"].As<bool>(settings.autoscaling_enabled);
+        settings.min_active_workers = autoscaling_doc["min_workers"].As<std::size_t>(settings.min_active_workers);
+        settings.max_active_workers = autoscaling_doc["max_workers"].As<std::size_t>(settings.max_active_workers);
+        settings.scale_up_wait_time = std::chrono::microseconds{
+            autoscaling_doc["scale_up_wait_time_us"].As<std::int64_t>(settings.scale_up_wait_time.count())};
+        settings.scale_down_idle_time = std::chrono::microseconds{
+            autoscaling_doc["scale_down_idle_time_us"].As<std::int64_t>(settings.scale_down_idle_time.count())};
+    }
+
     return settings;
 }
 
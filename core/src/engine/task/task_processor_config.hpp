@@ -33,6 +33,9 @@ struct TaskProcessorConfig {
     OsScheduling os_scheduling{OsScheduling::kNormal};
     int spinning_iterations{1000};
     TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+    bool numa_aware{false};
+    bool task_priorities{false};
+    std::chrono::milliseconds urgent_deadline_threshold{20};
 
     std::size_t task_trace_every{1000};
     std::size_t task_trace_max_csw{0};
@@ -53,6 +56,15 @@ struct TaskProcessorSettings {
 
     std::chrono::microseconds profiler_execution_slice_threshold{0};
     bool profiler_force_stacktrace{false};
+
+    // Parks and unparks worker threads between min and max active workers
+    // depending on the task queue wait time and the workers idle time.
+    // 0 max_active_workers means 'all the worker threads'.
+    bool autoscaling_enabled{false};
+    std::size_t min_active_workers{1};
+    std::size_t max_active_workers{0};
+    std::chrono::microseconds scale_up_wait_time{2000};
+    std::chrono::microseconds scale_down_idle_time{100000};
 };
 
 TaskProcessorSettings::OverloadAction
@@ -1,9 +1,17 @@
 #include <engine/task/task_processor.hpp>
 
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <engine/task/task_priority.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_base.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/utest/utest.hpp>
@@ -74,4 +82,229 @@ UTEST_MT(TaskProcessor, MetricsAliveAndRunning, 2) {
     EXPECT_EQ(task_counter.GetRunningTasks(), 1);
 }
 
+UTEST_MT(TaskProcessor, TaskPriorities, 2) {
+    for (const auto queue_type :
+         {engine::TaskQueueType::kGlobalTaskQueue, engine::TaskQueueType::kWorkStealingTaskQueue}) {
+        engine::TaskProcessorConfig config;
+        config.name = "priorities";
+        config.thread_name = "priorities";
+        config.worker_threads = 2;
+        config.task_processor_queue = queue_type;
+        config.task_priorities = true;
+        // every task with a deadline is urgent
+        config.urgent_deadline_threshold = std::chrono::hours{2};
+        engine::TaskProcessor task_processor(
+            std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+        );
+        EXPECT_TRUE(task_processor.HasTaskPriorities());
+
+        constexpr std::size_t kTasksCount = 300;
+        std::atomic<std::size_t> completed{0};
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(kTasksCount);
+        for (std::size_t i = 0; i < kTasksCount; ++i) {
+            switch (i % 3) {
+                case 0:
+                    tasks.push_back(engine::AsyncNoSpan(
+                        task_processor,
+                        engine::Deadline::FromDuration(std::chrono::hours{1}),
+                        [&completed] {
+                            engine::Yield();
+                            ++completed;
+                        }
+                    ));
+                    break;
+                case 1:
+                    tasks.push_back(engine::AsyncNoSpan(task_processor, [&completed] {
+                        engine::Yield();
+                        ++completed;
+                    }));
+                    break;
+                default:
+                    tasks.push_back(engine::AsyncNoSpan(task_processor, [&completed] {
+                        {
+                            const engine::impl::BackgroundTaskScope background_scope;
+                            EXPECT_EQ(
+                                engine::current_task::GetPriority(), engine::current_task::TaskPriority::kBackground
+                            );
+                            engine::Yield();
+                        }
+                        EXPECT_EQ(engine::current_task::GetPriority(), engine::current_task::TaskPriority::kNormal);
+                        ++completed;
+                    }));
+                    break;
+            }
+        }
+
+        for (auto& task : tasks) {
+            task.Get();
+        }
+        EXPECT_EQ(completed.load(), kTasksCount);
+    }
+}
+
+UTEST(TaskProcessor, UrgentTasksRunFirst) {
+    using engine::current_task::TaskPriority;
+
+    for (const auto queue_type :
+         {engine::TaskQueueType::kGlobalTaskQueue, engine::TaskQueueType::kWorkStealingTaskQueue}) {
+        SCOPED_TRACE(testing::Message() << "queue_type=" << static_cast<int>(queue_type));
+        engine::TaskProcessorConfig config;
+        config.name = "urgent";
+        config.thread_name = "urgent";
+        config.worker_threads = 1;
+        config.task_processor_queue = queue_type;
+        config.task_priorities = true;
+        engine::TaskProcessor task_processor(
+            std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+        );
+
+        constexpr std::size_t kTasksCount = 100;
+        engine::Mutex mutex;
+        engine::ConditionVariable cv;
+        std::size_t waiting_count = 0;
+        bool released = false;
+        // Only the single worker of task_processor writes it
+        std::string run_order;
+
+        const auto start_task = [&](TaskPriority priority, char mark) {
+            return engine::AsyncNoSpan(task_processor, [&, priority, mark] {
+                engine::current_task::SetPriority(priority);
+                EXPECT_EQ(engine::current_task::GetPriority(), priority);
+                {
+                    std::unique_lock lock(mutex);
+                    ++waiting_count;
+                    ASSERT_TRUE(cv.Wait(lock, [&released] { return released; }));
+                }
+                run_order += mark;
+            });
+        };
+
+        // Normal tasks are woken up first, so they would run first without
+        // the priorities
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(2 * kTasksCount);
+        for (std::size_t i = 0; i < kTasksCount; ++i) {
+            tasks.push_back(start_task(TaskPriority::kNormal, 'n'));
+        }
+        for (std::size_t i = 0; i < kTasksCount; ++i) {
+            tasks.push_back(start_task(TaskPriority::kUrgent, 'u'));
+        }
+        const auto get_waiting_count = [&] {
+            const std::lock_guard lock(mutex);
+            return waiting_count;
+        };
+        while (get_waiting_count() != tasks.size()) {
+            engine::SleepFor(std::chrono::milliseconds(1));
+        }
+
+        // Occupy the worker, so that all the tasks are queued before any of
+        // them runs
+        std::atomic<bool> blocker_started{false};
+        std::atomic<bool> blocker_released{false};
+        auto blocker = engine::AsyncNoSpan(task_processor, [&] {
+            blocker_started = true;
+            while (!blocker_released) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        while (!blocker_started) {
+            engine::SleepFor(std::chrono::milliseconds(1));
+        }
+
+        {
+            const std::lock_guard lock(mutex);
+            released = true;
+        }
+        cv.NotifyAll();
+        blocker_released = true;
+
+        blocker.Get();
+        for (auto& task : tasks) {
+            task.Get();
+        }
+
+        // Lower priority queues are visited now and then, so that they are
+        // not starved
+        ASSERT_EQ(run_order.size(), tasks.size());
+        const auto last_urgent = run_order.rfind('u');
+        ASSERT_NE(last_urgent, std::string::npos);
+        const auto normal_before_last_urgent = std::count(run_order.begin(), run_order.begin() + last_urgent, 'n');
+        EXPECT_LT(normal_before_last_urgent, kTasksCount / 2) << run_order;
+    }
+}
+
+UTEST(TaskProcessor, WorkerAutoscaling) {
+    engine::TaskProcessorConfig config;
+    config.name = "autoscaling";
+    config.thread_name = "autoscaling";
+    config.worker_threads = 4;
+    engine::TaskProcessor task_processor(
+        std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+    );
+    EXPECT_EQ(task_processor.GetActiveWorkerCount(), 4);
+
+    engine::TaskProcessorSettings settings;
+    settings.autoscaling_enabled = true;
+    settings.min_active_workers = 1;
+    settings.max_active_workers = 2;
+    task_processor.SetSettings(settings);
+    EXPECT_GE(task_processor.GetActiveWorkerCount(), 1);
+    EXPECT_LE(task_processor.GetActiveWorkerCount(), 2);
+
+    const auto run_tasks = [&task_processor] {
+        std::vector<engine::TaskWithResult<void>> tasks;
+        for (std::size_t i = 0; i < 100; ++i) {
+            tasks.push_back(engine::AsyncNoSpan(task_processor, [] { engine::Yield(); }));
+        }
+        for (auto& task : tasks) {
+            task.Get();
+        }
+    };
+    run_tasks();
+
+    settings.autoscaling_enabled = false;
+    task_processor.SetSettings(settings);
+    EXPECT_EQ(task_processor.GetActiveWorkerCount(), 4);
+    run_tasks();
+
+    // Parked workers must not prevent the task processor from stopping
+    settings.autoscaling_enabled = true;
+    task_processor.SetSettings(settings);
+}
+
+UTEST(TaskProcessor, WorkerAutoscalingIdleScaleDown) {
+    engine::TaskProcessorConfig config;
+    config.name = "autoscaling";
+    config.thread_name = "autoscaling";
+    config.worker_threads = 4;
+    engine::TaskProcessor task_processor(
+        std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+    );
+
+    engine::TaskProcessorSettings settings;
+    settings.autoscaling_enabled = true;
+    settings.min_active_workers = 1;
+    settings.max_active_workers = 4;
+    settings.scale_down_idle_time = std::chrono::milliseconds{1};
+    task_processor.SetSettings(settings);
+    const auto initial_workers = task_processor.GetActiveWorkerCount();
+
+    // No tasks are scheduled, the idle workers do not wake up by themselves
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (task_processor.GetActiveWorkerCount() > 1 && !deadline.IsReached()) {
+        engine::SleepFor(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(task_processor.GetActiveWorkerCount(), 1);
+    EXPECT_LE(task_processor.GetActiveWorkerCount(), initial_workers);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < 100; ++i) {
+        tasks.push_back(engine::AsyncNoSpan(task_processor, [] { engine::Yield(); }));
+    }
+    for (auto& task : tasks) {
+        task.Get();
+    }
+}
+
 USERVER_NAMESPACE_END
@@ -8,10 +8,26 @@ namespace engine {
 
 namespace {
 constexpr std::size_t kSemaphoreInitialCount = 0;
-}
+
+// Every Nth pop looks at the lower priority queues first, so that a flood of
+// urgent or normal tasks does not starve the rest completely
+constexpr std::size_t kLowPriorityFirstPopFrequency = 16;
+}  // namespace
+
+struct TaskQueue::ConsumerTokens final {
+    explicit ConsumerTokens(TaskQueue& owner)
+        : normal(owner.queue_), urgent(owner.urgent_queue_), background(owner.background_queue_) {}
+
+    moodycamel::ConsumerToken normal;
+    moodycamel::ConsumerToken urgent;
+    moodycamel::ConsumerToken background;
+    std::size_t pops_count{0};
+};
 
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
-    : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
+    : task_priorities_(config.task_priorities),
+      urgent_deadline_threshold_(config.urgent_deadline_threshold),
+      queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
 
 void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
     UASSERT(context);
@@ -22,10 +38,10 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
     // Current thread handles only a single TaskProcessor, so it's safe to store
     // a token for the task processor in a thread-local variable.
-    thread_local moodycamel::ConsumerToken token(queue_);
+    thread_local ConsumerTokens tokens(*this);
 
     boost::intrusive_ptr<impl::TaskContext> context{
-        DoPopBlocking(token),
+        DoPopBlocking(tokens),
         /* add_ref= */ false};
 
     if (!context) {
@@ -38,24 +54,32 @@ boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
 
 void TaskQueue::StopProcessing() { DoPush(nullptr); }
 
-std::size_t TaskQueue::GetSizeApproximate() const noexcept { return queue_.size_approx(); }
+std::size_t TaskQueue::GetSizeApproximate() const noexcept {
+    return queue_.size_approx() + urgent_queue_.size_approx() + background_queue_.size_approx();
+}
 
 void TaskQueue::PrepareWorker(std::size_t) {}
 
+bool TaskQueue::CanParkWorker(std::size_t) const noexcept { return true; }
+
 void TaskQueue::DoPush(impl::TaskContext* context) {
     // This piece of code is copy-pasted from
     // moodycamel::BlockingConcurrentQueue::enqueue
-    queue_.enqueue(context);
+    GetQueue(context).enqueue(context);
     queue_semaphore_.signal();
 }
 
-impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
+impl::TaskContext* TaskQueue::DoPopBlocking(ConsumerTokens& tokens) {
     impl::TaskContext* context{};
 
     // This piece of code is copy-pasted from
     // moodycamel::BlockingConcurrentQueue::wait_dequeue
     queue_semaphore_.wait();
-    while (!queue_.try_dequeue(token, context)) {
+    if (task_priorities_) {
+        return DoPopPrioritized(tokens);
+    }
+
+    while (!queue_.try_dequeue(tokens.normal, context)) {
         // Can happen when another consumer steals our item in exchange for another
         // item in a Moodycamel sub-queue that we have already passed.
     }
@@ -63,6 +87,53 @@ impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
     return context;
 }
 
+impl::TaskContext* TaskQueue::DoPopPrioritized(ConsumerTokens& tokens) {
+    impl::TaskContext* context{};
+
+    // The semaphore guarantees that one of the queues has a task for us
+    const bool low_priority_first = ++tokens.pops_count % kLowPriorityFirstPopFrequency == 0;
+    while (true) {
+        if (low_priority_first) {
+            if (background_queue_.try_dequeue(tokens.background, context)) {
+                return context;
+            }
+            if (queue_.try_dequeue(tokens.normal, context)) {
+                return context;
+            }
+            if (urgent_queue_.try_dequeue(tokens.urgent, context)) {
+                return context;
+            }
+        } else {
+            if (urgent_queue_.try_dequeue(tokens.urgent, context)) {
+                return context;
+            }
+            if (queue_.try_dequeue(tokens.normal, context)) {
+                return context;
+            }
+            if (background_queue_.try_dequeue(tokens.background, context)) {
+                return context;
+            }
+        }
+    }
+}
+
+moodycamel::ConcurrentQueue<impl::TaskContext*>& TaskQueue::GetQueue(impl::TaskContext* context) noexcept {
+    // nullptr is the stop signal
+    if (!task_priorities_ || !context) {
+        return queue_;
+    }
+
+    switch (impl::GetTaskPriority(*context, urgent_deadline_threshold_)) {
+        case impl::TaskPriority::kUrgent:
+            return urgent_queue_;
+        case impl::TaskPriority::kNormal:
+            return queue_;
+        case impl::TaskPriority::kBackground:
+            return background_queue_;
+    }
+    return queue_;
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
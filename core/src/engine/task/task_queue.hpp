@@ -5,6 +5,7 @@
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/task_priority.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,12 +30,26 @@ public:
 
     void PrepareWorker(std::size_t index);
 
+    bool CanParkWorker(std::size_t index) const noexcept;
+
 private:
+    struct ConsumerTokens;
+
     void DoPush(impl::TaskContext* context);
 
-    impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
+    impl::TaskContext* DoPopBlocking(ConsumerTokens& tokens);
+
+    impl::TaskContext* DoPopPrioritized(ConsumerTokens& tokens);
+
+    moodycamel::ConcurrentQueue<impl::TaskContext*>& GetQueue(impl::TaskContext* context) noexcept;
+
+    const bool task_priorities_;
+    const std::chrono::steady_clock::duration urgent_deadline_threshold_;
 
+    // Normal priority tasks; all the tasks if priorities are disabled
     moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
+    moodycamel::ConcurrentQueue<impl::TaskContext*> urgent_queue_;
+    moodycamel::ConcurrentQueue<impl::TaskContext*> background_queue_;
     moodycamel::LightweightSemaphore queue_semaphore_;
 };
 
@@ -41,6 +41,9 @@ constexpr std::size_t kFrequencyGlobalQueuePop = 61;
 // frequency of visits to the background
 // queue in stealing process
 constexpr std::size_t kFrequencyStealingBackgroundQueuePop = 10;
+// frequency of visits to the background queue with task priorities,
+// to guarantee progress of background tasks under load
+constexpr std::size_t kFrequencyBackgroundQueuePop = 127;
 }  // namespace
 
 Consumer::Consumer(WorkStealingTaskQueue& owner, ConsumersManager& consumers_manager)
@@ -50,10 +53,11 @@ Consumer::Consumer(WorkStealingTaskQueue& owner, ConsumersManager& consumers_man
       rnd_(utils::Rand()),
       steps_count_(rnd_()),
       global_queue_token_(owner_.global_queue_.CreateConsumerToken()),
-      background_queue_token_(owner.background_queue_.CreateConsumerToken()) {}
+      background_queue_token_(owner.background_queue_.CreateConsumerToken()),
+      urgent_queue_token_(owner.urgent_queue_.CreateConsumerToken()) {}
 
 void Consumer::Push(impl::TaskContext* ctx) {
-    if (ctx && ctx->IsBackground()) {
+    if (owner_.IsBackground(ctx)) {
         owner_.background_queue_.Push(background_queue_token_, ctx);
         return;
     }
@@ -81,6 +85,8 @@ WorkStealingTaskQueue* Consumer::GetOwner() const noexcept { return &owner_; }
 
 void Consumer::SetIndex(std::size_t index) noexcept { inner_index_ = index; }
 
+void Consumer::SetNumaGroup(std::size_t numa_group) noexcept { numa_group_ = numa_group; }
+
 bool Consumer::IsStopped() const noexcept { return consumers_manager_.IsStopped(); }
 
 void Consumer::EmptySurplusQueue(impl::TaskContext* extra) {
@@ -100,16 +106,20 @@ void Consumer::EmptySurplusQueue(impl::TaskContext* extra) {
     }
 }
 
-impl::TaskContext*
-Consumer::StealFromAnotherConsumerOrGlobalQueue(const std::size_t attempts, std::size_t to_steal_count) {
+impl::TaskContext* Consumer::StealFromAnotherConsumerOrGlobalQueue(
+    const std::size_t attempts,
+    std::size_t to_steal_count,
+    bool allow_remote
+) {
     std::size_t stealed_size = 0;
     for (std::size_t i = 0; i < attempts && to_steal_count > 0 && stealed_size == 0; ++i) {
+        const bool is_remote_allowed = allow_remote && i + 1 == attempts;
         std::size_t start_index = rnd_() % owner_.consumers_count_;
         for (std::size_t shift = 0; shift < owner_.consumers_count_ && to_steal_count > 0 && stealed_size == 0;
              ++shift) {
             std::size_t index = (start_index + shift) % owner_.consumers_count_;
             Consumer* victim = &owner_.consumers_[index];
-            if (victim == this) {
+            if (victim == this || (victim->numa_group_ != numa_group_ && !is_remote_allowed)) {
                 continue;
             }
             const std::size_t tasks_count =
@@ -187,8 +197,19 @@ impl::TaskContext* Consumer::TryPopFromOwnerQueue(const bool is_global) {
     return context;
 }
 
+impl::TaskContext* Consumer::TryPopUrgent() {
+    if (!owner_.task_priorities_ || owner_.urgent_queue_.GetSizeApproximate() == 0) {
+        return nullptr;
+    }
+    return owner_.urgent_queue_.TryPop(urgent_queue_token_);
+}
+
 impl::TaskContext* Consumer::ProbabilisticPopFromOwnerQueues() {
-    impl::TaskContext* context = nullptr;
+    impl::TaskContext* context = TryPopUrgent();
+    if (context) {
+        return context;
+    }
+
     if (steps_count_ % kFrequencyGlobalQueuePop == 0) {
         context = owner_.global_queue_.TryPop(global_queue_token_);
         if (context) {
@@ -196,17 +217,30 @@ impl::TaskContext* Consumer::ProbabilisticPopFromOwnerQueues() {
         }
     }
 
+    if (owner_.task_priorities_ && steps_count_ % kFrequencyBackgroundQueuePop == 0) {
+        context = owner_.background_queue_.TryPop(background_queue_token_);
+        if (context) {
+            return context;
+        }
+    }
+
     return nullptr;
 }
 
 impl::TaskContext* Consumer::TryPop() {
-    impl::TaskContext* context = TryPopFromOwnerQueue(/* is_global */ true);
+    impl::TaskContext* context = TryPopUrgent();
+    if (context) {
+        return context;
+    }
+
+    context = TryPopFromOwnerQueue(/* is_global */ true);
     if (context) {
         return context;
     }
 
     if (consumers_manager_.AllowStealing()) {
-        context = StealFromAnotherConsumerOrGlobalQueue(steal_attempts_count_, kDefaultStealSize);
+        context =
+            StealFromAnotherConsumerOrGlobalQueue(steal_attempts_count_, kDefaultStealSize, /*allow_remote=*/true);
         bool last = consumers_manager_.StopStealing();
 
         // there are potentially other tasks that require a consumer
@@ -227,7 +261,14 @@ impl::TaskContext* Consumer::TryPop() {
 }
 
 impl::TaskContext* Consumer::TryPopBeforeSleep() {
-    impl::TaskContext* context = StealFromAnotherConsumerOrGlobalQueue(1, 1);
+    impl::TaskContext* context = TryPopUrgent();
+    if (context) {
+        return context;
+    }
+
+    // Remote consumers were already tried in TryPop, they run their tasks
+    // themselves
+    context = StealFromAnotherConsumerOrGlobalQueue(1, 1, /*allow_remote=*/false);
     if (context) {
         return context;
     }
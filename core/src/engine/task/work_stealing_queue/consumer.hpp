@@ -18,6 +18,7 @@ class TaskContext;
 
 class WorkStealingTaskQueue;
 class ConsumersManager;
+class WorkStealingConsumerTest;
 
 class Consumer final {
 public:
@@ -34,19 +35,27 @@ public:
 private:
     friend ConsumersManager;
     friend WorkStealingTaskQueue;
+    friend WorkStealingConsumerTest;
 
     void SetIndex(std::size_t index) noexcept;
 
+    void SetNumaGroup(std::size_t numa_group) noexcept;
+
     bool IsStopped() const noexcept;
 
     void EmptySurplusQueue(impl::TaskContext* extra);
 
-    impl::TaskContext* StealFromAnotherConsumerOrGlobalQueue(const std::size_t attempts, std::size_t to_steal);
+    // Consumers of other NUMA groups are robbed only on the last attempt and
+    // only if `allow_remote` is set
+    impl::TaskContext*
+    StealFromAnotherConsumerOrGlobalQueue(const std::size_t attempts, std::size_t to_steal, bool allow_remote);
 
     std::size_t Steal(utils::span<impl::TaskContext*> buffer);
 
     impl::TaskContext* TryPopFromOwnerQueue(const bool is_global);
 
+    impl::TaskContext* TryPopUrgent();
+
     impl::TaskContext* ProbabilisticPopFromOwnerQueues();
 
     impl::TaskContext* TryPop();
@@ -73,6 +82,8 @@ private:
     ConsumersManager& consumers_manager_;
     const std::size_t steal_attempts_count_;
     std::size_t inner_index_{0};
+    // See StealFromAnotherConsumerOrGlobalQueue
+    std::size_t numa_group_{0};
     // kConsumerStealBufferSize + 1 for extra task in push
     std::array<impl::TaskContext*, kConsumerStealBufferSize + 1> steal_buffer_{};
     std::minstd_rand rnd_;
@@ -80,6 +91,7 @@ private:
     std::atomic<std::int32_t> sleep_counter_{0};
     GlobalQueue::Token global_queue_token_;
     GlobalQueue::Token background_queue_token_;
+    GlobalQueue::Token urgent_queue_token_;
 #ifndef __linux__
     std::condition_variable cv_;
     std::mutex mutex_;
@@ -0,0 +1,74 @@
+#include <engine/task/work_stealing_queue/task_queue.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+class WorkStealingConsumerTest : public ::testing::Test {
+protected:
+    WorkStealingConsumerTest() : queue_(MakeConfig()) {
+        // The first two consumers are on one node, the third one is remote
+        GetConsumer(0).SetNumaGroup(0);
+        GetConsumer(1).SetNumaGroup(0);
+        GetConsumer(2).SetNumaGroup(1);
+    }
+
+    Consumer& GetConsumer(std::size_t index) { return queue_.consumers_[index]; }
+
+    static void PushLocal(Consumer& consumer, impl::TaskContext* context) {
+        ASSERT_TRUE(consumer.local_queue_.TryPush(context));
+    }
+
+    static impl::TaskContext* Steal(Consumer& thief, std::size_t attempts, bool allow_remote) {
+        return thief.StealFromAnotherConsumerOrGlobalQueue(attempts, 1, allow_remote);
+    }
+
+    // The queues never dereference the tasks being stolen
+    impl::TaskContext* MakeFakeTask(std::size_t index) {
+        return reinterpret_cast<impl::TaskContext*>(&fake_tasks_storage_[index]);
+    }
+
+private:
+    static TaskProcessorConfig MakeConfig() {
+        TaskProcessorConfig config;
+        config.worker_threads = 3;
+        return config;
+    }
+
+    WorkStealingTaskQueue queue_;
+    std::array<char, 2> fake_tasks_storage_{};
+};
+
+TEST_F(WorkStealingConsumerTest, SameNodeVictimIsPreferred) {
+    auto* const local_task = MakeFakeTask(0);
+    auto* const remote_task = MakeFakeTask(1);
+    PushLocal(GetConsumer(2), remote_task);
+
+    // The victims are tried from a random one
+    for (int i = 0; i < 100; ++i) {
+        PushLocal(GetConsumer(1), local_task);
+        EXPECT_EQ(Steal(GetConsumer(0), 3, /*allow_remote=*/true), local_task);
+    }
+    EXPECT_EQ(GetConsumer(2).GetLocalQueueSize(), 1);
+}
+
+TEST_F(WorkStealingConsumerTest, RemoteVictimOnlyWhenAllowed) {
+    auto* const remote_task = MakeFakeTask(1);
+    PushLocal(GetConsumer(2), remote_task);
+
+    // Pop before sleep
+    EXPECT_EQ(Steal(GetConsumer(0), 1, /*allow_remote=*/false), nullptr);
+    EXPECT_EQ(Steal(GetConsumer(0), 3, /*allow_remote=*/false), nullptr);
+    EXPECT_EQ(GetConsumer(2).GetLocalQueueSize(), 1);
+
+    // Remote consumers are robbed on the last attempt
+    EXPECT_EQ(Steal(GetConsumer(0), 3, /*allow_remote=*/true), remote_task);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/rand.hpp>
 
+#include <engine/task/numa_topology.hpp>
+#include <engine/task/task_priority.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,12 +19,17 @@ thread_local Consumer* localConsumer = nullptr;
 
 WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
     : consumers_count_(config.worker_threads),
+      task_priorities_(config.task_priorities),
+      urgent_deadline_threshold_(config.urgent_deadline_threshold),
       global_queue_(consumers_count_),
       background_queue_(consumers_count_),
+      urgent_queue_(consumers_count_),
       consumers_(config.worker_threads, *this, consumers_manager_),
       consumers_manager_(consumers_count_) {
+    const auto numa_nodes_count = config.numa_aware ? impl::GetNumaNodes().size() : 0;
     for (size_t i = 0; i < consumers_count_; ++i) {
         consumers_[i].SetIndex(i);
+        consumers_[i].SetNumaGroup(impl::GetWorkerNumaGroup(i, consumers_count_, numa_nodes_count));
     }
 }
 
@@ -51,6 +58,7 @@ std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
     }
     size += global_queue_.GetSizeApproximate();
     size += background_queue_.GetSizeApproximate();
+    size += urgent_queue_.GetSizeApproximate();
     return size;
 }
 
@@ -60,13 +68,19 @@ void WorkStealingTaskQueue::PrepareWorker(std::size_t index) {
     }
 }
 
+bool WorkStealingTaskQueue::CanParkWorker(std::size_t index) const noexcept {
+    return index >= consumers_count_ || consumers_[index].GetLocalQueueSize() == 0;
+}
+
 void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
     {
         Consumer* consumer = GetConsumer();
 
-        if (consumer != nullptr && consumer->GetOwner() == this) {
+        if (IsUrgent(context)) {
+            urgent_queue_.Push(context);
+        } else if (consumer != nullptr && consumer->GetOwner() == this) {
             consumer->Push(context);
-        } else if (context && context->IsBackground()) {
+        } else if (IsBackground(context)) {
             background_queue_.Push(context);
         } else {
             global_queue_.Push(context);
@@ -83,6 +97,18 @@ impl::TaskContext* WorkStealingTaskQueue::DoPopBlocking() {
 
 Consumer* WorkStealingTaskQueue::GetConsumer() { return localConsumer; }
 
+bool WorkStealingTaskQueue::IsUrgent(impl::TaskContext* context) const noexcept {
+    return task_priorities_ && context &&
+           impl::GetTaskPriority(*context, urgent_deadline_threshold_) == impl::TaskPriority::kUrgent;
+}
+
+bool WorkStealingTaskQueue::IsBackground(impl::TaskContext* context) const noexcept {
+    if (!context) {
+        return false;
+    }
+    return context->IsBackground() || (task_priorities_ && context->GetPriority() == impl::TaskPriority::kBackground);
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
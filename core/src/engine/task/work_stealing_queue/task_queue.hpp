@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -19,6 +20,7 @@ class TaskContext;
 
 class WorkStealingTaskQueue final {
     friend class Consumer;
+    friend class WorkStealingConsumerTest;
 
 public:
     explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
@@ -33,6 +35,9 @@ public:
 
     void PrepareWorker(std::size_t index);
 
+    // Worker may be parked only when nobody else could run its local tasks
+    bool CanParkWorker(std::size_t index) const noexcept;
+
 private:
     void DoPush(impl::TaskContext* context);
 
@@ -40,10 +45,18 @@ private:
 
     Consumer* GetConsumer();
 
+    bool IsUrgent(impl::TaskContext* context) const noexcept;
+
+    bool IsBackground(impl::TaskContext* context) const noexcept;
+
     const std::size_t consumers_count_;
+    const bool task_priorities_;
+    const std::chrono::steady_clock::duration urgent_deadline_threshold_;
 
     GlobalQueue global_queue_;
     GlobalQueue background_queue_;
+    // Only used with task priorities, checked before the local queues
+    GlobalQueue urgent_queue_;
     utils::FixedArray<Consumer> consumers_;
     ConsumersManager consumers_manager_;
 };
@@ -1,10 +1,21 @@
 #include <userver/fs/read.hpp>
 
+#include <fcntl.h>
+
+#include <system_error>
+
 #include <boost/filesystem.hpp>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/current_task.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <engine/ev/thread_control.hpp>
+#include <engine/io/sys_linux/io_uring.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,12 +23,72 @@ namespace fs {
 
 namespace {
 
+constexpr std::size_t kIoUringReadChunkSize = 64 * 1024;
+
+using IoUring = engine::io::sys_linux::IoUring;
+
 bool IsHiddenFile(const boost::filesystem::path& path) {
     auto name = path.filename().native();
     UASSERT(!name.empty());
     return name != ".." && name != "." && name[0] == '.';
 }
 
+std::int32_t Await(IoUring& io_uring, IoUring::Operation& op) {
+    bool interrupted = false;
+    const auto result = engine::io::sys_linux::AwaitCompletion(io_uring, op, {}, interrupted);
+    if (interrupted && result < 0) {
+        throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+    }
+    return result;
+}
+
+void CloseFile(IoUring& io_uring, int fd) noexcept {
+    IoUring::Operation op;
+    op.opcode = IoUring::Opcode::kClose;
+    op.fd = fd;
+    bool interrupted = false;
+    [[maybe_unused]] const auto result = engine::io::sys_linux::AwaitCompletion(io_uring, op, {}, interrupted);
+}
+
+// Reads the file without blocking the thread while the kernel does the IO
+std::string ReadFileContentsViaIoUring(IoUring& io_uring, const std::string& path) {
+    IoUring::Operation open_op;
+    open_op.opcode = IoUring::Opcode::kOpenAt;
+    open_op.fd = AT_FDCWD;
+    open_op.addr = reinterpret_cast<std::uintptr_t>(path.c_str());
+    open_op.op_flags = O_RDONLY | O_CLOEXEC;
+    bool interrupted = false;
+    const int fd = engine::io::sys_linux::AwaitCompletion(io_uring, open_op, {}, interrupted);
+    if (fd < 0) {
+        if (interrupted) {
+            throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+        }
+        throw std::system_error(-fd, std::generic_category(), "Error opening '" + path + '\'');
+    }
+    utils::FastScopeGuard close_guard([&io_uring, fd]() noexcept { CloseFile(io_uring, fd); });
+
+    std::string result;
+    for (;;) {
+        const auto old_size = result.size();
+        result.resize(old_size + kIoUringReadChunkSize);
+
+        IoUring::Operation read_op;
+        read_op.opcode = IoUring::Opcode::kRead;
+        read_op.fd = fd;
+        read_op.addr = reinterpret_cast<std::uintptr_t>(result.data() + old_size);
+        read_op.len = kIoUringReadChunkSize;
+        read_op.offset = old_size;
+        const auto bytes_read = Await(io_uring, read_op);
+        if (bytes_read < 0) {
+            throw std::system_error(-bytes_read, std::generic_category(), "Error reading '" + path + '\'');
+        }
+
+        result.resize(old_size + bytes_read);
+        if (bytes_read == 0) break;
+    }
+    return result;
+}
+
 }  // namespace
 
 std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
@@ -28,7 +99,19 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
 }
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp, const std::string& path) {
-    return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path).Get();
+    auto task = engine::AsyncNoSpan(
+        async_tp,
+        [](const std::string& path) {
+            // The task still runs on `async_tp`, but with io_uring it does not
+            // occupy its thread while the file is being read
+            if (auto* io_uring = engine::current_task::GetEventThread().GetIoUring()) {
+                return ReadFileContentsViaIoUring(*io_uring, path);
+            }
+            return fs::blocking::ReadFileContents(path);
+        },
+        path
+    );
+    return task.Get();
 }
 
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
@@ -97,7 +97,10 @@ void Logging::Init(const ComponentConfig& config, const ComponentContext& contex
         }
 
         logger->StartConsumerTask(
-            context.GetTaskProcessor(tp_name), logger_config.message_queue_size, logger_config.queue_overflow_behavior
+            context.GetTaskProcessor(tp_name),
+            logger_config.message_queue_size,
+            logger_config.queue_overflow_behavior,
+            logger_config.thread_buffer_size
         );
 
         auto insertion_result = loggers_.emplace(logger_config.logger_name, std::move(logger));
@@ -282,6 +285,7 @@ properties:
                       - raw
                       - json
                       - json_yadeploy
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -292,11 +296,20 @@ properties:
                     defaultDescription: 65536
                 overflow_behavior:
                     type: string
-                    description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue"
+                    description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue, `sample` also drops most of the messages below warning level while the queue is more than half full"
                     defaultDescription: discard
                     enum:
                       - discard
                       - block
+                      - sample
+                thread_buffer_size:
+                    type: integer
+                    description: size of the per-thread buffers for messages in bytes, must be a power of 2; 0 disables them
+                    defaultDescription: 0
+                deferred_formatting:
+                    type: boolean
+                    description: capture the message values in the calling task and format them in the logger task
+                    defaultDescription: false
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
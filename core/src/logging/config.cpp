@@ -10,7 +10,10 @@ namespace logging {
 
 QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse::To<QueueOverflowBehavior>) {
     static constexpr utils::TrivialBiMap kMap([](auto selector) {
-        return selector().Case(QueueOverflowBehavior::kDiscard, "discard").Case(QueueOverflowBehavior::kBlock, "block");
+        return selector()
+            .Case(QueueOverflowBehavior::kDiscard, "discard")
+            .Case(QueueOverflowBehavior::kBlock, "block")
+            .Case(QueueOverflowBehavior::kSample, "sample");
     });
     return utils::ParseFromValueString(value, kMap);
 }
@@ -44,6 +47,10 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Logg
     config.queue_overflow_behavior =
         value["overflow_behavior"].As<QueueOverflowBehavior>(config.queue_overflow_behavior);
 
+    config.thread_buffer_size = value["thread_buffer_size"].As<size_t>(config.thread_buffer_size);
+
+    config.deferred_formatting = value["deferred_formatting"].As<bool>(config.deferred_formatting);
+
     config.fs_task_processor = value["fs-task-processor"].As<std::optional<std::string>>();
 
     config.testsuite_capture = value["testsuite-capture"].As<std::optional<TestsuiteCaptureConfig>>();
@@ -18,7 +18,13 @@ struct TestsuiteCaptureConfig final {
 
 TestsuiteCaptureConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<TestsuiteCaptureConfig>);
 
-enum class QueueOverflowBehavior { kDiscard, kBlock };
+enum class QueueOverflowBehavior {
+    kDiscard,
+    kBlock,
+    // Once the queue is half full, only some of the records below
+    // Level::kWarning get into it
+    kSample,
+};
 
 QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse::To<QueueOverflowBehavior>);
 
@@ -38,6 +44,12 @@ struct LoggerConfig final {
     size_t message_queue_size = kDefaultMessageQueueSize;
     QueueOverflowBehavior queue_overflow_behavior = QueueOverflowBehavior::kDiscard;
 
+    // must be a power of 2, 0 disables per-thread buffers
+    size_t thread_buffer_size = 0;
+
+    // format the messages in the logger task instead of the calling one
+    bool deferred_formatting = false;
+
     std::optional<std::string> fs_task_processor;
 
     std::optional<TestsuiteCaptureConfig> testsuite_capture;
@@ -14,10 +14,28 @@ void BaseSink::Log(const LogMessage& message) {
     }
 }
 
+void BaseSink::LogBatch(utils::span<const LogMessage> messages) {
+    batch_.clear();
+    for (const auto& message : messages) {
+        if (ShouldLog(message.level)) {
+            batch_.push_back(message.payload);
+        }
+    }
+    if (!batch_.empty()) {
+        WriteBatch(batch_);
+    }
+}
+
 void BaseSink::Flush() {}
 
 void BaseSink::Reopen(ReopenMode) {}
 
+void BaseSink::WriteBatch(utils::span<const std::string_view> logs) {
+    for (const auto log : logs) {
+        Write(log);
+    }
+}
+
 void BaseSink::SetLevel(Level log_level) { level_.store(log_level); }
 
 Level BaseSink::GetLevel() const { return level_.load(); }
@@ -6,9 +6,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
-BufferedFileSink::BufferedFileSink(const std::string& filename)
+BufferedFileSink::BufferedFileSink(const std::string& filename, Format format)
     : filename_{filename}, file_(OpenFile<fs::blocking::CFile>(filename)) {
-    if (file_.GetSize() > 0) {
+    // Separates the runs of the service, binary logs are self-delimiting
+    if (format != Format::kBinary && file_.GetSize() > 0) {
         file_.Write("\n");
     }
 }
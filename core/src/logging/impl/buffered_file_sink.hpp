@@ -6,6 +6,7 @@
 
 #include <logging/impl/base_sink.hpp>
 #include <userver/fs/blocking/c_file.hpp>
+#include <userver/logging/format.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,7 +14,7 @@ namespace logging::impl {
 
 class BufferedFileSink : public BaseSink {
 public:
-    explicit BufferedFileSink(const std::string& filename);
+    explicit BufferedFileSink(const std::string& filename, Format format = Format::kTskv);
     ~BufferedFileSink() override;
 
     void Reopen(ReopenMode mode) override;
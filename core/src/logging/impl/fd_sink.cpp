@@ -1,5 +1,13 @@
 #include "fd_sink.hpp"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
@@ -8,6 +16,43 @@ FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const std::string_view> logs) {
+    constexpr std::size_t kMaxIovecs = std::min<std::size_t>(IOV_MAX, 1024);
+    std::array<::iovec, kMaxIovecs> iovecs{};
+
+    while (!logs.empty()) {
+        const auto count = std::min(logs.size(), kMaxIovecs);
+        for (std::size_t i = 0; i < count; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            iovecs[i] = {const_cast<char*>(logs[i].data()), logs[i].size()};
+        }
+
+        auto* first = iovecs.data();
+        auto* const last = iovecs.data() + count;
+        while (first != last) {
+            const auto written = ::writev(fd_.GetNative(), first, static_cast<int>(last - first));
+            if (written < 0) {
+                if (errno == EAGAIN || errno == EINTR) continue;
+
+                throw std::system_error(std::make_error_code(std::errc{errno}), "calling ::writev");
+            }
+
+            // Skip the written records, the partially written one is continued
+            auto remaining = static_cast<std::size_t>(written);
+            while (first != last && remaining >= first->iov_len) {
+                remaining -= first->iov_len;
+                ++first;
+            }
+            if (first != last) {
+                first->iov_base = static_cast<char*>(first->iov_base) + remaining;
+                first->iov_len -= remaining;
+            }
+        }
+
+        logs = logs.subspan(count);
+    }
+}
+
 void FdSink::Flush() {
     if (fd_.IsOpen()) {
         fd_.FSync();
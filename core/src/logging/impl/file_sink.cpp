@@ -6,9 +6,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
-FileSink::FileSink(const std::string& filename)
+FileSink::FileSink(const std::string& filename, Format format)
     : FdSink(OpenFile<fs::blocking::FileDescriptor>(filename)), filename_{filename} {
-    if (GetFd().GetSize() > 0) {
+    // Separates the runs of the service, binary logs are self-delimiting
+    if (format != Format::kBinary && GetFd().GetSize() > 0) {
         GetFd().Write("\n");
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <userver/logging/format.hpp>
+
 #include "fd_sink.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -8,7 +10,7 @@ namespace logging::impl {
 
 class FileSink final : public FdSink {
 public:
-    explicit FileSink(const std::string& filename);
+    explicit FileSink(const std::string& filename, Format format = Format::kTskv);
 
     void Reopen(ReopenMode mode) final;
 
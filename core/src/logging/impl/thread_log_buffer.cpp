@@ -0,0 +1,104 @@
+#include <logging/impl/thread_log_buffer.hpp>
+
+#include <cstring>
+#include <limits>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+struct RecordHeader final {
+    std::uint32_t size;
+    Level level;
+};
+
+constexpr std::size_t kHeaderSize = 8;
+static_assert(sizeof(RecordHeader) <= kHeaderSize);
+
+// Marks the unused space at the end of the buffer, the next record is at the
+// beginning of the buffer
+constexpr std::uint32_t kPaddingSize = std::numeric_limits<std::uint32_t>::max();
+
+constexpr std::size_t RecordSize(std::size_t payload_size) noexcept {
+    // Keeps all the records aligned, so that there is always space for the
+    // padding header at the end of the buffer
+    return (kHeaderSize + payload_size + kHeaderSize - 1) & ~(kHeaderSize - 1);
+}
+
+}  // namespace
+
+ThreadLogBuffer::ThreadLogBuffer(std::size_t capacity) : capacity_(capacity), data_(new char[capacity]) {
+    UINVARIANT(
+        capacity >= kHeaderSize && (capacity & (capacity - 1)) == 0, "Thread log buffer size must be a power of 2"
+    );
+}
+
+ThreadLogBuffer::~ThreadLogBuffer() = default;
+
+std::size_t ThreadLogBuffer::GetRecordSize(std::size_t payload_size) noexcept { return RecordSize(payload_size); }
+
+bool ThreadLogBuffer::TryPush(Level level, std::string_view payload) noexcept {
+    const auto record_size = RecordSize(payload.size());
+    UASSERT(payload.size() < kPaddingSize && record_size * 2 <= capacity_);
+
+    auto tail = tail_->load(std::memory_order_relaxed);
+    const auto head = head_->load(std::memory_order_acquire);
+
+    const auto offset = tail & (capacity_ - 1);
+    const auto contiguous_size = capacity_ - offset;
+    const auto skip_size = (contiguous_size < record_size) ? contiguous_size : 0;
+    if (tail + skip_size + record_size - head > capacity_) {
+        return false;
+    }
+
+    if (skip_size != 0) {
+        const RecordHeader padding{kPaddingSize, level};
+        std::memcpy(data_.get() + offset, &padding, sizeof(padding));
+        tail += skip_size;
+    }
+
+    char* const record = data_.get() + (tail & (capacity_ - 1));
+    const RecordHeader header{static_cast<std::uint32_t>(payload.size()), level};
+    std::memcpy(record, &header, sizeof(header));
+    std::memcpy(record + kHeaderSize, payload.data(), payload.size());
+
+    // seq_cst pairs with the check for a scheduled drain in TpLogger
+    tail_->store(tail + record_size);
+    return true;
+}
+
+std::size_t ThreadLogBuffer::GetUsedSize() const noexcept {
+    const auto head = head_->load(std::memory_order_acquire);
+    return tail_->load(std::memory_order_acquire) - head;
+}
+
+std::uint64_t ThreadLogBuffer::Peek(std::vector<LogMessage>& messages) const {
+    auto head = head_->load(std::memory_order_relaxed);
+    const auto tail = tail_->load();
+
+    while (head != tail) {
+        const auto offset = head & (capacity_ - 1);
+        RecordHeader header{};
+        std::memcpy(&header, data_.get() + offset, sizeof(header));
+
+        if (header.size == kPaddingSize) {
+            head += capacity_ - offset;
+            continue;
+        }
+
+        messages.push_back(LogMessage{{data_.get() + offset + kHeaderSize, header.size}, header.level});
+        head += RecordSize(header.size);
+    }
+
+    return head;
+}
+
+void ThreadLogBuffer::Release(std::uint64_t position) noexcept { head_->store(position, std::memory_order_release); }
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
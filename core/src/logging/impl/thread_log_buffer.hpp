@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <logging/impl/base_sink.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief Single-producer single-consumer ring buffer of formatted log
+/// records.
+///
+/// Records are never split across the end of the buffer, so the consumer can
+/// pass them to the sinks without copying.
+class ThreadLogBuffer final {
+public:
+    /// @param capacity size of the buffer in bytes, must be a power of 2
+    explicit ThreadLogBuffer(std::size_t capacity);
+
+    ThreadLogBuffer(ThreadLogBuffer&&) = delete;
+    ThreadLogBuffer& operator=(ThreadLogBuffer&&) = delete;
+    ~ThreadLogBuffer();
+
+    /// Space taken by a record in the buffer, including the header
+    static std::size_t GetRecordSize(std::size_t payload_size) noexcept;
+
+    /// Producer side. Returns false if there is not enough free space.
+    /// Records must not be larger than a half of the buffer.
+    bool TryPush(Level level, std::string_view payload) noexcept;
+
+    std::size_t GetUsedSize() const noexcept;
+
+    std::size_t GetCapacity() const noexcept { return capacity_; }
+
+    /// Consumer side. Appends all the pushed records to `messages` and returns
+    /// the position to Release them at after they are written. The records
+    /// stay valid until then.
+    std::uint64_t Peek(std::vector<LogMessage>& messages) const;
+
+    /// Consumer side
+    void Release(std::uint64_t position) noexcept;
+
+private:
+    const std::size_t capacity_;
+    const std::unique_ptr<char[]> data_;
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> head_{0};
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> tail_{0};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#include <logging/impl/thread_log_buffer.hpp>
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Copies the records, as they are only valid until Release
+std::vector<std::string> PeekAndRelease(logging::impl::ThreadLogBuffer& buffer) {
+    std::vector<logging::impl::LogMessage> messages;
+    const auto position = buffer.Peek(messages);
+
+    std::vector<std::string> result;
+    for (const auto& message : messages) {
+        result.emplace_back(message.payload);
+    }
+    buffer.Release(position);
+    return result;
+}
+
+}  // namespace
+
+TEST(ThreadLogBuffer, Basic) {
+    logging::impl::ThreadLogBuffer buffer{1024};
+    EXPECT_EQ(buffer.GetUsedSize(), 0);
+
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kInfo, "first"));
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kError, "second"));
+    EXPECT_GT(buffer.GetUsedSize(), 0);
+
+    std::vector<logging::impl::LogMessage> messages;
+    const auto position = buffer.Peek(messages);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].payload, "first");
+    EXPECT_EQ(messages[0].level, logging::Level::kInfo);
+    EXPECT_EQ(messages[1].payload, "second");
+    EXPECT_EQ(messages[1].level, logging::Level::kError);
+
+    buffer.Release(position);
+    EXPECT_EQ(buffer.GetUsedSize(), 0);
+    EXPECT_TRUE(PeekAndRelease(buffer).empty());
+}
+
+TEST(ThreadLogBuffer, Overflow) {
+    logging::impl::ThreadLogBuffer buffer{1024};
+    const std::string record(200, 'x');
+
+    std::size_t pushed = 0;
+    while (buffer.TryPush(logging::Level::kInfo, record)) {
+        ++pushed;
+    }
+    EXPECT_EQ(pushed, 1024 / logging::impl::ThreadLogBuffer::GetRecordSize(record.size()));
+
+    EXPECT_EQ(PeekAndRelease(buffer).size(), pushed);
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kInfo, record));
+}
+
+TEST(ThreadLogBuffer, WrapAround) {
+    logging::impl::ThreadLogBuffer buffer{1024};
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        const auto record = std::to_string(i) + std::string(i * 3, 'x');
+        ASSERT_TRUE(buffer.TryPush(logging::Level::kInfo, record));
+
+        const auto messages = PeekAndRelease(buffer);
+        ASSERT_EQ(messages.size(), 1);
+        EXPECT_EQ(messages[0], record);
+    }
+}
+
+TEST(ThreadLogBuffer, SingleProducerSingleConsumer) {
+    constexpr std::size_t kRecords = 100000;
+    logging::impl::ThreadLogBuffer buffer{4096};
+
+    std::thread producer([&buffer] {
+        for (std::size_t i = 0; i < kRecords; ++i) {
+            const auto record = std::to_string(i);
+            while (!buffer.TryPush(logging::Level::kInfo, record)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::size_t expected = 0;
+    while (expected < kRecords) {
+        for (const auto& message : PeekAndRelease(buffer)) {
+            ASSERT_EQ(message, std::to_string(expected));
+            ++expected;
+        }
+    }
+
+    producer.join();
+}
+
+USERVER_NAMESPACE_END
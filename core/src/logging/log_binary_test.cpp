@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <logging/logging_test.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/logging/binary_decoder.hpp>
+#include <userver/logging/logger.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::size_t CountOccurrences(std::string_view str, std::string_view what) {
+    std::size_t result = 0;
+    for (auto pos = str.find(what); pos != std::string_view::npos; pos = str.find(what, pos + what.size())) {
+        ++result;
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+    LOG_INFO() << "This is the text to log"
+               << logging::LogExtra{{"signed", -42}, {"unsigned", 42u}, {"double", 1.5}, {"string", "a\tb"}};
+    logging::LogFlush();
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(GetStreamString(), logging::Format::kTskv, decoded);
+
+    EXPECT_EQ(ParseLoggedText(decoded, logging::Format::kTskv), "This is the text to log");
+    EXPECT_TRUE(utils::text::StartsWith(decoded, "tskv\ttimestamp=")) << decoded;
+    EXPECT_NE(decoded.find("\tlevel=INFO\tmodule="), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("log_binary_test.cpp:"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tsigned=-42"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tunsigned=42"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tdouble=1.5"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tstring=a\\tb"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tthread_id="), std::string::npos) << decoded;
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), 1);
+}
+
+TEST_F(LoggingBinaryTest, LocationsAndKeysAreInterned) {
+    constexpr std::size_t kRecords = 100;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        LOG_INFO() << "record " << i << logging::LogExtra{{"interned_key", i}};
+    }
+    logging::LogFlush();
+
+    const auto binary = GetStreamString();
+    EXPECT_EQ(CountOccurrences(binary, "log_binary_test.cpp"), 1);
+    EXPECT_EQ(CountOccurrences(binary, "interned_key"), 1);
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(binary, logging::Format::kLtsv, decoded);
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), kRecords);
+    EXPECT_EQ(CountOccurrences(decoded, "\tinterned_key:"), kRecords);
+    EXPECT_NE(decoded.find("\ttext:record 99"), std::string::npos) << decoded;
+}
+
+TEST_F(LoggingBinaryTest, Json) {
+    LOG_WARNING() << "json text" << logging::LogExtra{{"number", 7}};
+    logging::LogFlush();
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(GetStreamString(), logging::Format::kJson, decoded);
+    EXPECT_NE(decoded.find(R"("level":"WARNING")"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find(R"("text":"json text")"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find(R"("number":7)"), std::string::npos) << decoded;
+}
+
+TEST_F(LoggingBinaryTest, TruncatedTail) {
+    LOG_INFO() << "first";
+    LOG_INFO() << "second";
+    logging::LogFlush();
+
+    auto binary = GetStreamString();
+    binary.pop_back();
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(binary, logging::Format::kTskv, decoded);
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), 1);
+    EXPECT_NE(decoded.find("\ttext=first"), std::string::npos) << decoded;
+}
+
+UTEST_F(LoggingBinaryTest, DroppedRecordKeepsDefinitions) {
+    auto logger = GetStreamLogger();
+    logger->StartConsumerTask(engine::current_task::GetTaskProcessor(), 1, logging::QueueOverflowBehavior::kDiscard, 0);
+
+    // The consumer does not run until the test yields, so the filler takes
+    // the whole queue and the first record with the definitions is dropped
+    LOG_INFO_TO(logger) << "filler";
+    const auto log = [&logger](int i) {
+        LOG_INFO_TO(logger) << "record " << i << logging::LogExtra{{"dropped_key", i}};
+    };
+    log(0);
+    logger->Flush();
+    log(1);
+    logger->StopConsumerTask();
+    EXPECT_EQ(logger->GetStatistics().dropped.Load().value, 1);
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(GetStreamString(), logging::Format::kTskv, decoded);
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), 2) << decoded;
+    EXPECT_EQ(decoded.find("\ttext=record 0"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\ttext=record 1"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\tdropped_key=1"), std::string::npos) << decoded;
+}
+
+TEST_F(LoggingBinaryTest, NewlineBetweenChunks) {
+    LOG_INFO() << "first";
+    logging::LogFlush();
+    const auto first = GetStreamString();
+    LOG_INFO() << "second";
+    logging::LogFlush();
+    const auto both = GetStreamString();
+
+    // Older file sinks separated the runs of a service with a newline
+    const auto binary = first + '\n' + both.substr(first.size());
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(binary, logging::Format::kTskv, decoded);
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), 2) << decoded;
+    EXPECT_NE(decoded.find("\ttext=second"), std::string::npos) << decoded;
+}
+
+TEST(LoggingBinaryDecoder, ReopenedFile) {
+    const auto file = fs::blocking::TempFile::Create();
+    // Each logger is a new run of the service that appends to the same file
+    for (const std::string_view text : {"before restart", "after restart"}) {
+        const auto logger = logging::MakeFileLogger("binary", file.GetPath(), logging::Format::kBinary);
+        LOG_INFO_TO(logger) << text;
+        logger->Flush();
+    }
+
+    std::string decoded;
+    logging::DecodeBinaryLogs(fs::blocking::ReadFileContents(file.GetPath()), logging::Format::kTskv, decoded);
+    EXPECT_EQ(CountOccurrences(decoded, "\n"), 2) << decoded;
+    EXPECT_NE(decoded.find("\ttext=before restart"), std::string::npos) << decoded;
+    EXPECT_NE(decoded.find("\ttext=after restart"), std::string::npos) << decoded;
+}
+
+TEST(LoggingBinaryDecoder, NotBinary) {
+    std::string decoded;
+    EXPECT_THROW(
+        logging::DecodeBinaryLogs("tskv\ttimestamp=2024-01-01T00:00:00.000000\n", logging::Format::kTskv, decoded),
+        std::runtime_error
+    );
+}
+
+USERVER_NAMESPACE_END
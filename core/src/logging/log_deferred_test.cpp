@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <regex>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Streamed final {
+    int value;
+};
+
+std::ostream& operator<<(std::ostream& os, const Streamed& streamed) { return os << "streamed " << streamed.value; }
+
+std::string WithoutTimestamps(const std::string& logs) {
+    static const std::regex kTimestamp{R"("?@?timestamp"?[=:]"?[0-9T:.-]+"?)"};
+    return std::regex_replace(logs, kTimestamp, "");
+}
+
+// Writes the same records with the same source location to both loggers
+void LogTheSame(const StringStreamLogger& immediate, const StringStreamLogger& deferred) {
+    for (const auto* logger : {&immediate, &deferred}) {
+        LOG_INFO_TO(logger->logger) << "text " << 42 << ' ' << -7L << ' ' << 42u << ' ' << 1.5 << ' ' << 0.1f << ' '
+                                    << true << ' ' << logging::Hex{0xabcu} << ' ' << logging::Quoted{"a\"b"} << ' '
+                                    << Streamed{5} << " \t\\ escaped"
+                                    << logging::LogExtra{
+                                           {"signed", -42},
+                                           {"unsigned", 42u},
+                                           {"float", 0.1f},
+                                           {"double", 1.5},
+                                           {"string", "a\tb"},
+                                       };
+        LOG_WARNING_TO(logger->logger) << "";
+        LOG_ERROR_TO(logger->logger) << std::string(3000, 'x');
+        logger->logger->Flush();
+    }
+}
+
+}  // namespace
+
+TEST_F(LoggingDeferredTest, Basic) {
+    LOG_INFO() << "This is " << 42 << " the text to log" << logging::LogExtra{{"key", "value"}, {"number", 1.5}};
+    logging::LogFlush();
+
+    const auto logs = GetStreamString();
+    EXPECT_EQ(ParseLoggedText(logs, logging::Format::kTskv), "This is 42 the text to log");
+    EXPECT_NE(logs.find("tskv\ttimestamp="), std::string::npos) << logs;
+    EXPECT_NE(logs.find("\tlevel=INFO\tmodule="), std::string::npos) << logs;
+    EXPECT_NE(logs.find("log_deferred_test.cpp:"), std::string::npos) << logs;
+    EXPECT_NE(logs.find("\tkey=value"), std::string::npos) << logs;
+    EXPECT_NE(logs.find("\tnumber=1.5"), std::string::npos) << logs;
+    EXPECT_EQ(GetRecordsCount(), 1);
+}
+
+TEST_F(LoggingDeferredTest, SameAsImmediate) {
+    for (const auto format : {logging::Format::kTskv, logging::Format::kLtsv, logging::Format::kJson}) {
+        const auto immediate = MakeNamedStreamLogger("immediate", format);
+        const auto deferred = MakeNamedStreamLogger("deferred", format, true);
+        ASSERT_FALSE(immediate.logger->IsFormattingDeferred());
+        ASSERT_TRUE(deferred.logger->IsFormattingDeferred());
+
+        LogTheSame(immediate, deferred);
+
+        EXPECT_EQ(WithoutTimestamps(deferred.stream.str()), WithoutTimestamps(immediate.stream.str()));
+        EXPECT_NE(immediate.stream.str().find("xxx"), std::string::npos);
+    }
+}
+
+TEST_F(LoggingDeferredTest, IgnoredForBinary) {
+    const auto binary = MakeNamedStreamLogger("binary", logging::Format::kBinary, true);
+    EXPECT_FALSE(binary.logger->IsFormattingDeferred());
+}
+
+UTEST(LoggingDeferred, ThreadBuffers) {
+    const auto stream_logger = MakeNamedStreamLogger("async", logging::Format::kTskv, true);
+    const auto& logger = stream_logger.logger;
+    logger->StartConsumerTask(
+        engine::current_task::GetTaskProcessor(), 2, logging::QueueOverflowBehavior::kBlock, 4096
+    );
+
+    constexpr std::size_t kRecords = 100;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        LOG_INFO_TO(logger) << "record " << i;
+    }
+    // Large records go through the queue
+    LOG_INFO_TO(logger) << std::string(4096, 'x');
+    logger->StopConsumerTask();
+
+    const auto logs = stream_logger.stream.str();
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        EXPECT_NE(logs.find(fmt::format("\ttext=record {}\n", i)), std::string::npos) << i;
+    }
+    EXPECT_NE(logs.find(std::string(4096, 'x')), std::string::npos);
+    EXPECT_EQ(static_cast<std::size_t>(std::count(logs.begin(), logs.end(), '\n')), kRecords + 1);
+}
+
+USERVER_NAMESPACE_END
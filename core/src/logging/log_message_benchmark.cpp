@@ -5,6 +5,7 @@
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
 #include <userver/logging/logger.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -20,6 +21,17 @@ public:
     void Flush() override {}
 };
 
+// Only the part of the work done on the calling thread is measured, the
+// deferred records are never formatted
+class TskvNoopLogger final : public logging::impl::TextLogger {
+public:
+    explicit TskvNoopLogger(bool deferred_formatting) : TextLogger(logging::Format::kTskv, deferred_formatting) {
+        SetLevel(logging::Level::kInfo);
+    }
+    void Log(logging::Level, logging::impl::formatters::LoggerItemRef) override {}
+    void Flush() override {}
+};
+
 class PrependedTagLogger final : public NoopLogger {
 public:
     void PrependCommonTags(logging::impl::TagWriter writer) const override {
@@ -148,6 +160,32 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+// Arg 0 is formatting in the calling thread, arg 1 is the deferred formatting
+void LogTskvMixed(benchmark::State& state) {
+    const logging::DefaultLoggerGuard guard{std::make_shared<TskvNoopLogger>(state.range(0) != 0)};
+    const auto text = Launder(std::string(32, '*'));
+    const auto integer = Launder(123456789);
+    const auto floating = Launder(3.14159);
+
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << text << " integer=" << integer << " floating=" << floating << " flag=" << true
+                   << logging::LogExtra{{"key", integer}, {"other_key", text}};
+    }
+}
+BENCHMARK(LogTskvMixed)->Arg(0)->Arg(1);
+
+void LogTskvNumbers(benchmark::State& state) {
+    const logging::DefaultLoggerGuard guard{std::make_shared<TskvNoopLogger>(state.range(0) != 0)};
+    const auto integer = Launder(123456789L);
+    const auto floating = Launder(3.14159);
+
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << integer << ' ' << floating << ' ' << integer << ' ' << floating << ' ' << integer << ' '
+                   << floating << ' ' << integer << ' ' << floating;
+    }
+}
+BENCHMARK(LogTskvNumbers)->Arg(0)->Arg(1);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -63,7 +63,7 @@ LoggerPtr MakeStdoutLogger(const std::string& name, Format format, Level level)
 }
 
 LoggerPtr MakeFileLogger(const std::string& name, const std::string& path, Format format, Level level) {
-    return MakeSimpleLogger(name, std::make_unique<impl::BufferedFileSink>(path), level, format);
+    return MakeSimpleLogger(name, std::make_unique<impl::BufferedFileSink>(path, format), level, format);
 }
 
 namespace impl::default_ {
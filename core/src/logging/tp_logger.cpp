@@ -1,9 +1,14 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/logger.hpp>
@@ -15,6 +20,46 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+std::atomic<std::uint64_t> logger_serial{0};
+
+// With QueueOverflowBehavior::kSample, only each kSampleRate-th record below
+// Level::kWarning is kept while the queue is more than half full
+constexpr std::uint32_t kSampleRate = 16;
+
+bool IsSampling(Level level, std::uint64_t used, std::uint64_t capacity) noexcept {
+    return level < Level::kWarning && used * 2 >= capacity;
+}
+
+// Owns the buffer of a logger for the current thread
+struct ThreadBufferRef final {
+    explicit ThreadBufferRef(std::shared_ptr<async::ThreadBuffer>&& buffer) noexcept : buffer(std::move(buffer)) {}
+
+    ThreadBufferRef(ThreadBufferRef&&) noexcept = default;
+    ThreadBufferRef& operator=(ThreadBufferRef&&) = delete;
+
+    ~ThreadBufferRef() {
+        // Pairs with the acquire in TpLogger::AcquireThreadBuffer
+        if (buffer) buffer->is_owned.store(false, std::memory_order_release);
+    }
+
+    std::shared_ptr<async::ThreadBuffer> buffer;
+};
+
+struct ThreadBuffersCache final {
+    // References to buffers of destroyed loggers are never cleaned up
+    // individually, so the amount of them is limited instead. Buffers of the
+    // evicted alive loggers are reused by other threads.
+    static constexpr std::size_t kMaxLoggers = 16;
+
+    std::unordered_map<std::uint64_t, ThreadBufferRef> by_logger;
+};
+
+compiler::ThreadLocal local_thread_buffers = [] { return ThreadBuffersCache{}; };
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
     TpLogger& logger;
 
@@ -27,7 +72,16 @@ struct TpLogger::ActionVisitor final {
         // The consumer thread will check state_ later.
     }
 
+    void operator()(impl::async::Drain&& drain) const noexcept {
+        // seq_cst pairs with the tail_ update in ThreadLogBuffer::TryPush and
+        // with the has_overflow update in TpLogger::PushToOverflow
+        drain.buffer->is_drain_scheduled.store(false);
+        logger.BackendDrainThreadBuffers();
+    }
+
     void operator()(impl::async::ReopenCoro&& reopen) const noexcept {
+        // Records of the thread buffers belong to the old file
+        logger.BackendDrainThreadBuffers();
         try {
             logger.BackendReopen(reopen.reopen_mode);
             reopen.promise.set_value();
@@ -40,24 +94,31 @@ struct TpLogger::ActionVisitor final {
 
     template <class Flush>
     void operator()(Flush&& flush) const {
+        logger.BackendDrainThreadBuffers();
         logger.BackendFlush();
         flush.promise.set_value();
     }
 };
 
-TpLogger::TpLogger(Format format, std::string logger_name)
-    : impl::TextLogger(format), logger_name_(std::move(logger_name)) {
+TpLogger::TpLogger(Format format, std::string logger_name, bool deferred_formatting)
+    : impl::TextLogger(format, deferred_formatting), logger_name_(std::move(logger_name)), serial_(++logger_serial) {
     SetLevel(logging::Level::kInfo);
 }
 
 void TpLogger::StartConsumerTask(
     engine::TaskProcessor& task_processor,
     std::size_t max_queue_size,
-    QueueOverflowBehavior overflow_policy
+    QueueOverflowBehavior overflow_policy,
+    std::size_t thread_buffer_size
 ) {
     UINVARIANT(max_queue_size != 0 && max_queue_size <= (std::size_t{1} << 31), "Invalid max queue size");
+    UINVARIANT(
+        thread_buffer_size == 0 || (thread_buffer_size >= 1024 && (thread_buffer_size & (thread_buffer_size - 1)) == 0),
+        "Invalid thread buffer size, must be a power of 2 not less than 1024"
+    );
     max_queue_size_.store(max_queue_size);
     overflow_policy_.store(overflow_policy);
+    thread_buffer_size_ = thread_buffer_size;
 
     auto expected = State::kSync;
     const bool success = state_.compare_exchange_strong(expected, State::kAsync);
@@ -136,6 +197,17 @@ void TpLogger::Log(Level level, impl::formatters::LoggerItemRef item) {
         return;
     }
 
+    if (CanUseThreadBuffer() && LogToThreadBuffer(level, msg.log_line, msg.undroppable_size)) {
+        return;
+    }
+
+    if (overflow_policy_.load() == QueueOverflowBehavior::kSample &&
+        IsSampling(level, std::max<QueueSize>(produced_->load() - consumed_->load(), 0), max_queue_size_.load()) &&
+        sample_counter_.fetch_add(1, std::memory_order_relaxed) % kSampleRate != 0) {
+        DropRecord(level, msg.log_line, msg.undroppable_size, nullptr);
+        return;
+    }
+
     if (TryWaitFreeQueueCapacity()) {
         // The queue might have concurrently become full, in which case the size
         // will temporarily go over the max size. The actual number of log actions
@@ -150,7 +222,36 @@ void TpLogger::Log(Level level, impl::formatters::LoggerItemRef item) {
             throw;
         }
     } else {
-        ++stats_.dropped;
+        DropRecord(level, msg.log_line, msg.undroppable_size, nullptr);
+    }
+}
+
+void TpLogger::DropRecord(
+    Level level,
+    std::string_view payload,
+    std::size_t undroppable_size,
+    impl::async::ThreadBuffer* buffer
+) {
+    ++stats_.dropped;
+    if (undroppable_size == 0) {
+        return;
+    }
+
+    // The following records depend on this part, it is pushed regardless of
+    // the queue capacity. It is written once per stream, so the queue size is
+    // still bounded.
+    payload = payload.substr(0, undroppable_size);
+    if (buffer) {
+        PushToOverflow(*buffer, level, payload);
+        return;
+    }
+
+    produced_->fetch_add(1);
+    try {
+        Push(impl::async::Log{level, std::string{payload}});
+    } catch (const std::exception&) {
+        produced_->fetch_sub(1);
+        throw;
     }
 }
 
@@ -194,6 +295,12 @@ void TpLogger::ProcessingLoop() {
         queue_.WaitWhileEmpty(queue_consumer_);
     }
 
+    // Producers that have seen kAsync state may still be writing to the
+    // buffers. They never block while doing so.
+    while (HasThreadBufferProducers()) {
+        engine::Yield();
+    }
+    BackendDrainThreadBuffers();
     CleanUpQueue(std::move(queue_consumer_));
 }
 
@@ -226,6 +333,160 @@ bool TpLogger::TryWaitFreeQueueCapacity() {
     return true;
 }
 
+bool TpLogger::CanUseThreadBuffer() const noexcept {
+    return state_.load() == State::kAsync && thread_buffer_size_ != 0;
+}
+
+impl::async::ThreadBuffer& TpLogger::GetThreadBuffer() {
+    auto cache = local_thread_buffers.Use();
+    const auto it = cache->by_logger.find(serial_);
+    if (it != cache->by_logger.end()) {
+        return *it->second.buffer;
+    }
+
+    if (cache->by_logger.size() >= ThreadBuffersCache::kMaxLoggers) {
+        cache->by_logger.clear();
+    }
+
+    auto& ref = cache->by_logger.emplace(serial_, ThreadBufferRef{AcquireThreadBuffer()}).first->second;
+    return *ref.buffer;
+}
+
+std::shared_ptr<impl::async::ThreadBuffer> TpLogger::AcquireThreadBuffer() {
+    const std::lock_guard lock{thread_buffers_mutex_};
+    for (const auto& buffer : thread_buffers_) {
+        // The records of the previous owner may still be in the buffer, the
+        // acquire makes the new owner see its writes.
+        if (!buffer->is_owned.load(std::memory_order_acquire)) {
+            buffer->is_owned.store(true, std::memory_order_relaxed);
+            return buffer;
+        }
+    }
+
+    auto buffer = std::make_shared<impl::async::ThreadBuffer>(thread_buffer_size_);
+    buffer->is_owned.store(true, std::memory_order_relaxed);
+    thread_buffers_.push_back(buffer);
+    return buffer;
+}
+
+bool TpLogger::LogToThreadBuffer(Level level, std::string_view payload, std::size_t undroppable_size) {
+    // Large records would take too much of the buffer, they go to the overflow
+    // list instead.
+    const bool fits_buffer = ThreadLogBuffer::GetRecordSize(payload.size()) * 4 <= thread_buffer_size_;
+
+    while (true) {
+        // The task may migrate to another thread while waiting for capacity,
+        // so the buffer has to be looked up again.
+        auto& buffer = GetThreadBuffer();
+
+        // seq_cst pairs with the state_ change in StopConsumerTask: either the
+        // consumer waits for this record, or the record goes to the queue.
+        buffer.is_producing.store(true);
+        utils::FastScopeGuard producing_guard([&buffer]() noexcept { buffer.is_producing.store(false); });
+        if (state_.load() != State::kAsync) {
+            return false;
+        }
+
+        const auto overflow_policy = overflow_policy_.load();
+        const bool to_overflow = !fits_buffer || buffer.has_overflow.load();
+
+        if (to_overflow) {
+            // Overflow records are accounted as the queue ones
+            if (overflow_policy == QueueOverflowBehavior::kSample &&
+                IsSampling(
+                    level, std::max<QueueSize>(produced_->load() - consumed_->load(), 0), max_queue_size_.load()
+                ) &&
+                sample_counter_.fetch_add(1, std::memory_order_relaxed) % kSampleRate != 0) {
+                DropRecord(level, payload, undroppable_size, &buffer);
+                return true;
+            }
+
+            if (HasFreeQueueCapacity()) {
+                PushToOverflow(buffer, level, payload);
+                return true;
+            }
+        } else {
+            if (overflow_policy == QueueOverflowBehavior::kSample &&
+                IsSampling(level, buffer.records.GetUsedSize(), buffer.records.GetCapacity()) &&
+                buffer.sample_counter++ % kSampleRate != 0) {
+                DropRecord(level, payload, undroppable_size, &buffer);
+                return true;
+            }
+
+            const bool pushed = buffer.records.TryPush(level, payload);
+            ScheduleDrain(buffer);
+            if (pushed) {
+                return true;
+            }
+        }
+
+        // Do not do blocking push if we are not in a coroutine context.
+        if (overflow_policy != QueueOverflowBehavior::kBlock || !engine::current_task::IsTaskProcessorThread()) {
+            DropRecord(level, payload, undroppable_size, &buffer);
+            return true;
+        }
+
+        // The consumer does not wait for the blocked producers on stop
+        buffer.is_producing.store(false);
+        producing_guard.Release();
+
+        const engine::TaskCancellationBlocker block_cancel;
+        std::unique_lock lock{capacity_waiters_mutex_};
+        [[maybe_unused]] const bool success = capacity_waiters_cv_.Wait(lock, [this, &buffer, to_overflow] {
+            if (to_overflow) {
+                return HasFreeQueueCapacity();
+            }
+            // Records are at most a quarter of the buffer, so any of them fits
+            // into a half-empty buffer even if the end of the buffer is skipped.
+            return buffer.records.GetUsedSize() * 2 <= buffer.records.GetCapacity();
+        });
+        UASSERT(success);
+    }
+}
+
+void TpLogger::PushToOverflow(impl::async::ThreadBuffer& buffer, Level level, std::string_view payload) {
+    impl::async::Log log{level, std::string{payload}};
+
+    produced_->fetch_add(1);
+    {
+        const std::lock_guard lock{buffer.overflow_mutex};
+        try {
+            buffer.overflow.push_back(std::move(log));
+        } catch (const std::exception&) {
+            produced_->fetch_sub(1);
+            throw;
+        }
+        // seq_cst pairs with the is_drain_scheduled reset by the consumer
+        buffer.has_overflow.store(true);
+    }
+    ScheduleDrain(buffer);
+}
+
+bool TpLogger::HasThreadBufferProducers() {
+    const std::lock_guard lock{thread_buffers_mutex_};
+    return std::any_of(thread_buffers_.begin(), thread_buffers_.end(), [](const auto& buffer) {
+        return buffer->is_producing.load();
+    });
+}
+
+void TpLogger::ScheduleDrain(impl::async::ThreadBuffer& buffer) noexcept {
+    // A single drain is enough for any amount of records written before the
+    // consumer resets the flag.
+    if (buffer.is_drain_scheduled.load() || buffer.is_drain_scheduled.exchange(true)) {
+        return;
+    }
+    DoPush(buffer.drain_node);
+}
+
+void TpLogger::NotifyCapacityWaiters() noexcept {
+    {
+        // See AccountLogConsumed
+        const std::lock_guard lock{capacity_waiters_mutex_};
+    }
+    // Waiters of different thread buffers wait on the same condition variable
+    capacity_waiters_cv_.NotifyAll();
+}
+
 void TpLogger::Push(impl::async::Action&& action) {
     auto node = std::make_unique<impl::async::ActionNode>();
     node->action = std::move(action);
@@ -250,7 +511,12 @@ void TpLogger::AccountLogConsumed() noexcept {
             //    not fall asleep
             const std::lock_guard lock{capacity_waiters_mutex_};
         }
-        capacity_waiters_cv_.NotifyOne();
+        if (thread_buffer_size_ != 0) {
+            // Waiters of the thread buffers share the condition variable
+            capacity_waiters_cv_.NotifyAll();
+        } else {
+            capacity_waiters_cv_.NotifyOne();
+        }
     }
 }
 
@@ -259,6 +525,12 @@ void TpLogger::ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcep
     auto& action_node = static_cast<impl::async::ActionNode&>(node);
     if (&action_node == &stop_node_) return;
 
+    if (const auto* const drain = std::get_if<impl::async::Drain>(&action_node.action)) {
+        // The node is owned by the thread buffer and is reused.
+        BackendPerform(impl::async::Drain{*drain});
+        return;
+    }
+
     BackendPerform(std::move(action_node.action));
     delete &action_node;
 }
@@ -273,11 +545,22 @@ void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
     std::move(consumer).ConsumeAndStop([this](auto& node) noexcept { ConsumeNode(node); });
 }
 
-void TpLogger::BackendLog(impl::async::Log&& action) const {
+void TpLogger::BackendLog(impl::async::Log&& action) {
     LogMessage message;
     message.payload = action.payload;
     message.level = action.level;
 
+    if (IsFormattingDeferred()) {
+        rendered_.clear();
+        try {
+            RenderDeferred(message.payload, rendered_);
+        } catch (const std::exception& e) {
+            UASSERT_MSG(false, fmt::format("Exception while formatting a log message: {}", e.what()));
+            return;
+        }
+        message.payload = rendered_;
+    }
+
     for (const auto& sink : GetSinks()) {
         try {
             sink->Log(message);
@@ -291,6 +574,109 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
     }
 }
 
+void TpLogger::BackendDrainThreadBuffers() noexcept {
+    drained_buffers_.clear();
+    drained_positions_.clear();
+    drained_messages_.clear();
+    drained_overflow_.clear();
+
+    try {
+        {
+            const std::lock_guard lock{thread_buffers_mutex_};
+            for (const auto& buffer : thread_buffers_) {
+                drained_buffers_.push_back(buffer.get());
+            }
+        }
+        for (auto* const buffer : drained_buffers_) {
+            if (!buffer->has_overflow.load()) {
+                drained_positions_.push_back(buffer->records.Peek(drained_messages_));
+                continue;
+            }
+
+            // The thread does not write to `records` while the overflow is not
+            // empty, so the overflow goes right after the peeked records
+            const std::lock_guard lock{buffer->overflow_mutex};
+            drained_positions_.push_back(buffer->records.Peek(drained_messages_));
+            for (auto& log : buffer->overflow) {
+                const auto& drained = drained_overflow_.emplace_back(std::move(log));
+                drained_messages_.push_back(LogMessage{drained.payload, drained.level});
+            }
+            buffer->overflow.clear();
+            buffer->has_overflow.store(false);
+        }
+    } catch (const std::exception& e) {
+        // The records stay in the buffers until the next drain
+        UASSERT_MSG(false, fmt::format("Exception while draining log buffers: {}", e.what()));
+        return;
+    }
+
+    if (drained_messages_.empty()) {
+        return;
+    }
+
+    if (IsFormattingDeferred()) {
+        BackendRenderDeferred(drained_messages_);
+    }
+
+    for (const auto& sink : GetSinks()) {
+        try {
+            sink->LogBatch(drained_messages_);
+        } catch (const std::exception& e) {
+            UASSERT_MSG(false, "While writing log messages caught an exception: " + std::string(e.what()));
+        }
+    }
+
+    for (std::size_t i = 0; i < drained_positions_.size(); ++i) {
+        drained_buffers_[i]->records.Release(drained_positions_[i]);
+    }
+    if (!drained_overflow_.empty()) {
+        // See AccountLogConsumed
+        const auto consumed = consumed_->load(std::memory_order_relaxed);
+        consumed_->store(consumed + static_cast<QueueSize>(drained_overflow_.size()), std::memory_order_relaxed);
+    }
+
+    if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
+        NotifyCapacityWaiters();
+    }
+
+    const bool should_flush = std::any_of(
+        drained_messages_.begin(),
+        drained_messages_.end(),
+        [this](const LogMessage& message) { return ShouldFlush(message.level); }
+    );
+    if (should_flush) {
+        BackendFlush();
+    }
+}
+
+void TpLogger::BackendRenderDeferred(std::vector<LogMessage>& messages) noexcept {
+    rendered_.clear();
+    rendered_offsets_.clear();
+
+    // Payloads are pointed into rendered_ after all the messages are formatted,
+    // because rendered_ may reallocate
+    std::size_t kept = 0;
+    for (const auto& message : messages) {
+        const auto offset = rendered_.size();
+        try {
+            RenderDeferred(message.payload, rendered_);
+        } catch (const std::exception& e) {
+            UASSERT_MSG(false, fmt::format("Exception while formatting a log message: {}", e.what()));
+            rendered_.resize(offset);
+            continue;
+        }
+        rendered_offsets_.push_back(offset);
+        messages[kept++].level = message.level;
+    }
+    messages.resize(kept);
+    rendered_offsets_.push_back(rendered_.size());
+
+    const std::string_view rendered = rendered_;
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        messages[i].payload = rendered.substr(rendered_offsets_[i], rendered_offsets_[i + 1] - rendered_offsets_[i]);
+    }
+}
+
 void TpLogger::BackendFlush() const {
     for (const auto& sink : GetSinks()) {
         try {
@@ -313,6 +699,9 @@ void TpLogger::BackendReopen(ReopenMode reopen_mode) const {
                         << "': " << e;
         }
     }
+    // Reopened files are new streams for the binary format
+    StartNewBinaryStream();
+
     if (!result_messages.empty()) {
         stats_.has_reopening_error.store(true);
         throw std::runtime_error("BackendReopen errors: " + result_messages);
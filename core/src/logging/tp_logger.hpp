@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -20,6 +22,7 @@
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
 #include <logging/impl/reopen_mode.hpp>
+#include <logging/impl/thread_log_buffer.hpp>
 #include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/logging/impl/log_stats.hpp>
@@ -53,24 +56,54 @@ struct ReopenCoro {
 
 struct Stop {};
 
-using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
+struct ThreadBuffer;
+
+struct Drain {
+    ThreadBuffer* buffer;
+};
+
+using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro, Drain>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
     Action action{Stop{}};
 };
 
+/// Records of a single thread, drained by the logger all at once
+struct ThreadBuffer final {
+    explicit ThreadBuffer(std::size_t capacity) : records(capacity) { drain_node.action = Drain{this}; }
+
+    ThreadLogBuffer records;
+    // Records that are written after all the `records`, e.g. the ones that are
+    // too large for the buffer. While it is not empty, the following records of
+    // the thread go here as well to keep the order.
+    std::mutex overflow_mutex;
+    std::vector<Log> overflow;
+    std::atomic<bool> has_overflow{false};
+    // Is in the queue while is_drain_scheduled is set
+    ActionNode drain_node;
+    std::atomic<bool> is_drain_scheduled{false};
+    // Set while the owning thread writes a record, see TpLogger::ProcessingLoop
+    std::atomic<bool> is_producing{false};
+    // Set while a thread uses the buffer, the buffer of an exited thread is
+    // reused by another one
+    std::atomic<bool> is_owned{false};
+    // Used by the owning thread only
+    std::uint32_t sample_counter{0};
+};
+
 }  // namespace async
 
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
 class TpLogger final : public TextLogger {
 public:
-    TpLogger(Format format, std::string logger_name);
+    TpLogger(Format format, std::string logger_name, bool deferred_formatting = false);
     ~TpLogger() override;
 
     void StartConsumerTask(
         engine::TaskProcessor& task_processor,
         std::size_t max_queue_size,
-        QueueOverflowBehavior overflow_policy
+        QueueOverflowBehavior overflow_policy,
+        std::size_t thread_buffer_size
     );
 
     void StopConsumerTask();
@@ -105,6 +138,23 @@ private:
     void ProcessingLoop();
     bool HasFreeQueueCapacity() noexcept;
     bool TryWaitFreeQueueCapacity();
+    bool CanUseThreadBuffer() const noexcept;
+    impl::async::ThreadBuffer& GetThreadBuffer();
+    std::shared_ptr<impl::async::ThreadBuffer> AcquireThreadBuffer();
+    // Returns false if the logger is not in async mode anymore
+    bool LogToThreadBuffer(Level level, std::string_view payload, std::size_t undroppable_size);
+    void PushToOverflow(impl::async::ThreadBuffer& buffer, Level level, std::string_view payload);
+    // Accounts the dropped record and writes its undroppable part, if any, to
+    // the thread buffer or to the queue if `buffer` is nullptr
+    void DropRecord(
+        Level level,
+        std::string_view payload,
+        std::size_t undroppable_size,
+        impl::async::ThreadBuffer* buffer
+    );
+    bool HasThreadBufferProducers();
+    void ScheduleDrain(impl::async::ThreadBuffer& buffer) noexcept;
+    void NotifyCapacityWaiters() noexcept;
     void Push(impl::async::Action&& action);
     void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
@@ -112,11 +162,14 @@ private:
     void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
     void AccountLogConsumed() noexcept;
     void BackendPerform(impl::async::Action&& action) noexcept;
-    void BackendLog(impl::async::Log&& action) const;
+    void BackendLog(impl::async::Log&& action);
+    void BackendDrainThreadBuffers() noexcept;
+    void BackendRenderDeferred(std::vector<LogMessage>& messages) noexcept;
     void BackendFlush() const;
     void BackendReopen(ReopenMode reopen_mode) const;
 
     const std::string logger_name_;
+    const std::uint64_t serial_;
     std::vector<impl::SinkPtr> sinks_;
     mutable impl::LogStatistics stats_{};
 
@@ -134,6 +187,23 @@ private:
     Queue queue_;
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
+    std::atomic<std::uint32_t> sample_counter_{0};
+
+    // Set before switching to kAsync, 0 if thread buffers are disabled.
+    std::size_t thread_buffer_size_{0};
+    std::mutex thread_buffers_mutex_;
+    // Buffers are shared with the thread-local caches of the threads
+    std::vector<std::shared_ptr<impl::async::ThreadBuffer>> thread_buffers_;
+    // Used by the consumer only, to avoid allocations on each drain.
+    std::vector<impl::async::ThreadBuffer*> drained_buffers_;
+    std::vector<std::uint64_t> drained_positions_;
+    std::vector<LogMessage> drained_messages_;
+    // Keeps the payloads of drained_messages_ in place
+    std::deque<impl::async::Log> drained_overflow_;
+    // Formatted records of a logger with IsFormattingDeferred(), used by the
+    // consumer only.
+    std::string rendered_;
+    std::vector<std::size_t> rendered_offsets_;
 };
 
 }  // namespace logging::impl
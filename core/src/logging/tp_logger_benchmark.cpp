@@ -3,6 +3,7 @@
 #include <benchmark/benchmark.h>
 
 #include <logging/impl/null_sink.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
@@ -31,9 +32,12 @@ protected:
 
     void TearDown(const benchmark::State&) override { guard_.reset(); }
 
-    auto StartAsyncLoggerScope() {
+    auto StartAsyncLoggerScope(std::size_t thread_buffer_size = 0) {
         tp_logger_->StartConsumerTask(
-            engine::current_task::GetTaskProcessor(), 1 << 30, logging::QueueOverflowBehavior::kDiscard
+            engine::current_task::GetTaskProcessor(),
+            1 << 30,
+            logging::QueueOverflowBehavior::kDiscard,
+            thread_buffer_size
         );
         return utils::FastScopeGuard([this]() noexcept { tp_logger_->StopConsumerTask(); });
     }
@@ -58,6 +62,34 @@ BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogString)(benchmark::State& state) {
 // Run benchmarks to output string of sizes of 8 bytes to 8 kilobytes
 BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)->RangeMultiplier(2)->Range(8, 8 << 10)->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogMultiProducer)(benchmark::State& state) {
+    constexpr std::size_t kBatchSize = 1000;
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto thread_buffer_size = static_cast<std::size_t>(state.range(1));
+
+    engine::RunStandalone(producers + 1, [&] {
+        auto scope = StartAsyncLoggerScope(thread_buffer_size);
+        const auto msg = Launder(std::string(64, '*'));
+        std::vector<engine::TaskWithResult<void>> tasks(producers);
+        for ([[maybe_unused]] auto _ : state) {
+            for (auto& task : tasks) {
+                task = engine::AsyncNoSpan([&msg] {
+                    for (std::size_t i = 0; i < kBatchSize; ++i) {
+                        LOG_INFO() << msg;
+                    }
+                });
+            }
+            for (auto& task : tasks) {
+                task.Get();
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * producers * kBatchSize);
+    });
+}
+BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogMultiProducer)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1 << 16}})
+    ->ArgNames({"producers", "thread_buffer_size"});
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
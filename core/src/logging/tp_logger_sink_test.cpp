@@ -97,7 +97,7 @@ UTEST_MT(TpLogger, SerializesSinkOperations, 4) {
 
     engine::SleepFor(std::chrono::milliseconds{100});
     logger.StartConsumerTask(
-        engine::current_task::GetTaskProcessor(), 1 << 8, logging::QueueOverflowBehavior::kDiscard
+        engine::current_task::GetTaskProcessor(), 1 << 8, logging::QueueOverflowBehavior::kDiscard, 0
     );
 
     engine::SleepFor(std::chrono::milliseconds{100});
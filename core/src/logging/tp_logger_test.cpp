@@ -8,6 +8,7 @@
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/utils/statistics/testing.hpp>
 
+#include <logging/impl/reopen_mode.hpp>
 #include <logging/logging_test.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -44,7 +45,8 @@ public:
 
     std::shared_ptr<logging::impl::TpLogger> StartAsyncLogger(
         std::size_t queue_size_max = 10,
-        QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard
+        QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard,
+        std::size_t thread_buffer_size = 0
     ) {
         UASSERT_MSG(
             engine::current_task::IsTaskProcessorThread(), "Misconfigured test. Should be run in coroutine environment"
@@ -56,7 +58,9 @@ public:
             writer = logger->GetStatistics();
         });
 
-        logger->StartConsumerTask(engine::current_task::GetTaskProcessor(), queue_size_max, on_overflow);
+        logger->StartConsumerTask(
+            engine::current_task::GetTaskProcessor(), queue_size_max, on_overflow, thread_buffer_size
+        );
 
         // Tracing should not break the TpLogger
         logger->SetLevel(logging::Level::kTrace);
@@ -742,4 +746,181 @@ UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleStdThreadFlushSyncCancelMT, 4) {
     EXPECT_EQ(GetRecordsCount(), message_count);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffers) {
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kDiscard, 1 << 16);
+
+    LOG_INFO_TO(logger) << "1";
+    LOG_INFO_TO(logger) << "2";
+    logger->Flush();
+    EXPECT_EQ(GetRecordsCount(), 2);
+
+    LOG_INFO_TO(logger) << "3";
+    // Large records go to the overflow list of the buffer
+    LOG_INFO_TO(logger) << std::string(1 << 15, 'x');
+    logger->StopConsumerTask();
+
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=3"));
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr(std::string(1 << 15, 'x')));
+    EXPECT_EQ(GetRecordsCount(), 4);
+    EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersBlocking) {
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kBlock, 4096);
+
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << i;
+    }
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        EXPECT_THAT(logs, testing::HasSubstr(fmt::format("text={}", i)));
+    }
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersSample) {
+    constexpr std::size_t kInfoRecords = 100;
+    constexpr std::size_t kWarningRecords = 5;
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kSample, 8192);
+
+    // The consumer does not get a chance to run, so the buffer fills up
+    for (std::size_t i = 0; i < kInfoRecords; ++i) {
+        LOG_INFO_TO(logger) << "info " << i;
+    }
+    for (std::size_t i = 0; i < kWarningRecords; ++i) {
+        LOG_WARNING_TO(logger) << "warning " << i;
+    }
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    for (std::size_t i = 0; i < kWarningRecords; ++i) {
+        EXPECT_THAT(logs, testing::HasSubstr(fmt::format("text=warning {}", i)));
+    }
+    EXPECT_GT(GetMetric("dropped"), 0);
+    EXPECT_LT(GetRecordsCount(), kInfoRecords + kWarningRecords);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersOrder) {
+    auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 4096);
+
+    // The drain is scheduled by the first record, the following ones must not
+    // overtake the large record
+    LOG_INFO_TO(logger) << "before";
+    LOG_INFO_TO(logger) << std::string(2048, 'x');
+    LOG_INFO_TO(logger) << "after";
+    logger->Flush();
+    LOG_INFO_TO(logger) << "after flush";
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    const auto before_pos = logs.find("text=before");
+    const auto large_pos = logs.find(std::string(2048, 'x'));
+    const auto after_pos = logs.find("text=after");
+    const auto after_flush_pos = logs.find("text=after flush");
+    ASSERT_NE(after_flush_pos, std::string::npos) << logs;
+    EXPECT_LT(before_pos, large_pos);
+    EXPECT_LT(large_pos, after_pos);
+    EXPECT_LT(after_pos, after_flush_pos);
+    EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersReopen) {
+    class ReopenMarkingSink final : public logging::impl::BaseSink {
+    public:
+        explicit ReopenMarkingSink(std::string& output) : output_(output) {}
+
+        void Reopen(logging::impl::ReopenMode) override { output_ += "<reopen>\n"; }
+
+    protected:
+        void Write(std::string_view log) override { output_ += log; }
+
+    private:
+        std::string& output_;
+    };
+
+    std::string output;
+    auto logger =
+        MakeLoggerFromSink("reopen-logger", std::make_unique<ReopenMarkingSink>(output), logging::Format::kTskv);
+    logger->StartConsumerTask(engine::current_task::GetTaskProcessor(), 10, QueueOverflowBehavior::kDiscard, 4096);
+
+    LOG_INFO_TO(logger) << "before";
+    logger->Reopen(logging::impl::ReopenMode::kAppend);
+    LOG_INFO_TO(logger) << "after";
+    logger->StopConsumerTask();
+
+    const auto before_pos = output.find("text=before");
+    const auto reopen_pos = output.find("<reopen>");
+    const auto after_pos = output.find("text=after");
+    ASSERT_NE(after_pos, std::string::npos) << output;
+    EXPECT_LT(before_pos, reopen_pos);
+    EXPECT_LT(reopen_pos, after_pos);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersSampleLarge) {
+    constexpr std::size_t kRecords = 100;
+    auto logger = StartAsyncLogger(64, QueueOverflowBehavior::kSample, 4096);
+
+    // The consumer does not get a chance to run, large records are sampled
+    // once the queue is half full
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        LOG_INFO_TO(logger) << i << std::string(2048, 'x');
+    }
+    LOG_WARNING_TO(logger) << "warning";
+    logger->StopConsumerTask();
+
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=warning"));
+    EXPECT_GT(GetMetric("dropped"), 0);
+    EXPECT_LT(GetRecordsCount(), kRecords + 1);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersManyLoggers) {
+    // More loggers than the thread caches buffers for
+    constexpr std::size_t kLoggers = 20;
+    constexpr std::size_t kRounds = 3;
+
+    std::vector<StringStreamLogger> loggers;
+    loggers.reserve(kLoggers);
+    for (std::size_t i = 0; i < kLoggers; ++i) {
+        loggers.push_back(MakeNamedStreamLogger(fmt::format("logger-{}", i), logging::Format::kTskv));
+        loggers.back().logger->StartConsumerTask(
+            engine::current_task::GetTaskProcessor(), 10, QueueOverflowBehavior::kDiscard, 4096
+        );
+    }
+
+    for (std::size_t round = 0; round < kRounds; ++round) {
+        for (auto& logger : loggers) {
+            LOG_INFO_TO(logger.logger) << "round " << round;
+        }
+        // Buffers of the exited threads are reused
+        std::thread([&loggers, round] {
+            for (auto& logger : loggers) {
+                LOG_INFO_TO(logger.logger) << "thread round " << round;
+            }
+        }).join();
+    }
+
+    for (auto& logger : loggers) {
+        logger.logger->StopConsumerTask();
+        const auto logs = logger.stream.str();
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            EXPECT_THAT(logs, testing::HasSubstr(fmt::format("text=round {}", round)));
+            EXPECT_THAT(logs, testing::HasSubstr(fmt::format("text=thread round {}", round)));
+        }
+    }
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerThreadBuffersMT, 4) {
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kBlock, 1 << 16);
+    LogTestMT(logger, GetThreadCount(), kTestLogging);
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations * (GetThreadCount() - 1));
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerThreadBuffersFlushMT, 4) {
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kBlock, 1 << 16);
+    LogTestMT(logger, GetThreadCount(), kTestLogFlush);
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations * GetThreadCount());
+}
+
 USERVER_NAMESPACE_END
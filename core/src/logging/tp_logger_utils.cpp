@@ -36,12 +36,12 @@ void CreateLogDirectory(const std::string& logger_name, const std::string& file_
     }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const std::string& file_path, Format format) {
     if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
         // Use Unix-socket sink
         return std::make_unique<UnixSocketSink>(file_path.substr(kUnixSocketPrefix.size()));
     } else {
-        return std::make_unique<BufferedFileSink>(file_path);
+        return std::make_unique<BufferedFileSink>(file_path, format);
     }
 }
 
@@ -54,7 +54,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
         return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
     } else {
         CreateLogDirectory(config.logger_name, config.file_path);
-        return GetSinkFromFilename(config.file_path);
+        return GetSinkFromFilename(config.file_path, config.format);
     }
 }
 
@@ -66,7 +66,7 @@ auto MakeTestsuiteSink(const TestsuiteCaptureConfig& config) {
 }  // namespace
 
 std::shared_ptr<TpLogger> MakeTpLogger(const LoggerConfig& config) {
-    auto logger = std::make_shared<TpLogger>(config.format, config.logger_name);
+    auto logger = std::make_shared<TpLogger>(config.format, config.logger_name, config.deferred_formatting);
     logger->SetLevel(config.level);
     logger->SetFlushOn(config.flush_level);
 
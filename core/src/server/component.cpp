@@ -231,9 +231,22 @@ properties:
                                 type: integer
                                 description: the initial window size of the server
                                 defaultDescription: 65536
+                    fast_http_parser:
+                        type: boolean
+                        description: parse the common complete HTTP/1.x requests with a SIMD scanner and fall back to llhttp for the rest
+                        defaultDescription: false
+                    request_pool_size:
+                        type: integer
+                        description: how many memory blocks of the finished HTTP/1.x requests to keep per connection for the next requests; 0 to allocate each request separately
+                        defaultDescription: 0
+                        minimum: 0
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+            reuseport_cpu_steering:
+                type: boolean
+                description: set to true to pass a new TCP connection to the shard with index equal to `cpu % shards`, where `cpu` is the CPU that received the connection (Linux only); the steering is off if another process listens on the same port
+                defaultDescription: false
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -0,0 +1,115 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <chrono>
+
+#include <userver/components/component_config.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/trivial_map.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/schema.hpp>
+#include <utils/cpu_profiler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+// The sample buffer holds ~8k samples, drain it well before it overflows
+constexpr std::chrono::milliseconds kCollectPeriod{200};
+
+std::string HandleRc(const http::HttpRequest& request, std::error_code ec) {
+    if (ec) {
+        request.SetResponseStatus(server::http::HttpStatus::kInternalServerError);
+        return "CPU profiler returned error: " + ec.message() + "\n";
+    }
+    return "OK\n";
+}
+
+constexpr utils::TrivialBiMap kStrToCommand = [](auto selector) {
+    using Command = CpuProfiler::Command;
+    return selector()
+        .Case("enable", Command::kEnable)
+        .Case("disable", Command::kDisable)
+        .Case("dump", Command::kDump)
+        .Case("reset", Command::kReset)
+        .Case("stat", Command::kStat);
+};
+
+}  // namespace
+
+std::optional<CpuProfiler::Command> CpuProfiler::GetCommandFromString(std::string_view str) {
+    return kStrToCommand.TryFind(str);
+}
+
+std::string CpuProfiler::ListCommands() { return kStrToCommand.DescribeFirst(); }
+
+CpuProfiler::CpuProfiler(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context
+)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      sampling_frequency_(config["sampling-frequency"].As<std::uint32_t>(100)) {
+    utils::PeriodicTask::Settings settings{kCollectPeriod};
+    settings.span_level = logging::Level::kNone;
+    collector_.Start("cpu-profiler-collector", settings, [] { utils::cpu_profiler::Collect(); });
+
+    if (config["start-enabled"].As<bool>(false)) {
+        if (const auto ec = utils::cpu_profiler::Start(sampling_frequency_)) {
+            LOG_ERROR() << "Failed to start the CPU profiler: " << ec.message();
+        }
+    }
+}
+
+CpuProfiler::~CpuProfiler() {
+    collector_.Stop();
+    if (const auto ec = utils::cpu_profiler::Stop()) {
+        LOG_ERROR() << "Failed to stop the CPU profiler: " << ec.message();
+    }
+}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
+    const auto opt_command = GetCommandFromString(request.GetPathArg("command"));
+    if (!opt_command) {
+        request.SetResponseStatus(server::http::HttpStatus::kNotFound);
+        return fmt::format("Unsupported command. Supported commands are: {}\n", ListCommands());
+    }
+    switch (*opt_command) {
+        case Command::kEnable:
+            return HandleRc(request, utils::cpu_profiler::Start(sampling_frequency_));
+        case Command::kDisable:
+            return HandleRc(request, utils::cpu_profiler::Stop());
+        case Command::kDump:
+            return utils::cpu_profiler::DumpCollapsed();
+        case Command::kReset:
+            utils::cpu_profiler::Reset();
+            return "OK\n";
+        case Command::kStat:
+            return utils::cpu_profiler::Stats();
+    }
+
+    UINVARIANT(false, "Unsupported command");
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cpu-profiler config
+additionalProperties: false
+properties:
+    sampling-frequency:
+        type: integer
+        description: samples per second of the consumed CPU time
+        defaultDescription: 100
+        minimum: 1
+    start-enabled:
+        type: boolean
+        description: start the profiler with the service
+        defaultDescription: false
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
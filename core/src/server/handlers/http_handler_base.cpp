@@ -8,6 +8,7 @@
 #include <server/middlewares/handler_adapter.hpp>
 #include <server/request/internal_request_context.hpp>
 #include <server/server_config.hpp>
+#include <utils/cpu_profiler.hpp>
 #include <userver/server/http/http_request.hpp>
 
 #include <userver/components/component.hpp>
@@ -259,6 +260,7 @@ void HttpHandlerBase::HandleHttpRequest(http::HttpRequest& http_request, request
 
 void HttpHandlerBase::PrepareAndHandleRequest(http::HttpRequest& http_request, request::RequestContext& context) const {
     auto& response = http_request.GetHttpResponse();
+    const utils::cpu_profiler::TagScope cpu_profiler_tag_scope{HandlerName()};
 
     context.GetInternalContext().SetConfigSnapshot(config_source_.GetSnapshot());
     try {
@@ -397,6 +399,19 @@ std::string HttpHandlerBase::GetResponseDataForLoggingChecked(
     }
 }
 
+std::string HttpHandlerBase::GetResponseDataForLoggingChecked(
+    const http::HttpRequest& request,
+    request::RequestContext& context,
+    const http::HttpResponse& response
+) const {
+    const auto& data = response.GetData();
+    if (!data.empty() || response.GetDataView().empty()) {
+        return GetResponseDataForLoggingChecked(request, context, data);
+    }
+    // The shared data is copied for logging only
+    return GetResponseDataForLoggingChecked(request, context, std::string{response.GetDataView()});
+}
+
 void HttpHandlerBase::HandleCustomHandlerException(const http::HttpRequest& request, const CustomHandlerException& ex)
     const {
     auto http_status = http::GetHttpStatus(ex);
@@ -23,9 +23,22 @@ void DumpMetric(utils::statistics::Writer& writer, HttpHandlerStatisticsHelper h
     writer["rate-limit-reached"] = stats.rate_limit_reached;
     writer["deadline-received"] = stats.deadline_received;
     writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
+    writer["running-time-us"] = stats.running_time_us;
+    writer["queue-wait-time-us"] = stats.queue_wait_time_us;
+    writer["context-switches"] = stats.context_switches;
     writer["timings"] = stats.timings;
 }
 
+utils::statistics::Rate ToMicroseconds(std::chrono::nanoseconds duration) noexcept {
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    return utils::statistics::Rate{static_cast<utils::statistics::Rate::ValueType>(us)};
+}
+
+engine::current_task::ExecutionStats StartExecutionStats() noexcept {
+    engine::current_task::EnableExecutionStats();
+    return engine::current_task::GetExecutionStats();
+}
+
 }  // namespace
 
 void HttpHandlerMethodStatistics::Account(const HttpHandlerStatisticsEntry& stats) noexcept {
@@ -33,6 +46,11 @@ void HttpHandlerMethodStatistics::Account(const HttpHandlerStatisticsEntry& stat
     timings_.GetCurrentCounter().Account(stats.timing.count());
     if (stats.deadline.IsReachable()) ++deadline_received_;
     if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
+
+    const auto& execution_stats = stats.execution_stats;
+    running_time_us_.Add(ToMicroseconds(execution_stats.running_time));
+    queue_wait_time_us_.Add(ToMicroseconds(execution_stats.queue_wait_time));
+    context_switches_.Add(utils::statistics::Rate{execution_stats.context_switches});
 }
 
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
@@ -53,7 +71,10 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(const HttpHandlerMe
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      running_time_us(stats.running_time_us_.Load()),
+      queue_wait_time_us(stats.queue_wait_time_us_.Load()),
+      context_switches(stats.context_switches_.Load()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& other) {
     timings.Add(other.timings);
@@ -64,6 +85,9 @@ void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& oth
     rate_limit_reached += other.rate_limit_reached;
     deadline_received += other.deadline_received;
     cancelled_by_deadline += other.cancelled_by_deadline;
+    running_time_us += other.running_time_us;
+    queue_wait_time_us += other.queue_wait_time_us;
+    context_switches += other.context_switches;
 }
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats) {
@@ -88,7 +112,11 @@ HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
     http::HttpMethod method,
     server::http::HttpResponse& response
 )
-    : stats_(stats), method_(method), start_time_(std::chrono::steady_clock::now()), response_(response) {
+    : stats_(stats),
+      method_(method),
+      start_time_(std::chrono::steady_clock::now()),
+      start_execution_stats_(StartExecutionStats()),
+      response_(response) {
     stats_.ForMethod(method).IncrementInFlight();
 }
 
@@ -101,6 +129,12 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
     stats.timing = std::chrono::duration_cast<std::chrono::milliseconds>(finish_time - start_time_);
     stats.deadline = data ? data->deadline : engine::Deadline{};
     stats.cancelled_by_deadline = cancelled_by_deadline_;
+
+    const auto execution_stats = engine::current_task::GetExecutionStats();
+    stats.execution_stats.running_time = execution_stats.running_time - start_execution_stats_.running_time;
+    stats.execution_stats.queue_wait_time = execution_stats.queue_wait_time - start_execution_stats_.queue_wait_time;
+    stats.execution_stats.context_switches =
+        execution_stats.context_switches - start_execution_stats_.context_switches;
     stats_.ForMethod(method_).Account(stats);
     stats_.ForMethod(method_).DecrementInFlight();
 }
@@ -7,6 +7,7 @@
 
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/task/current_task.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/statistics/percentile.hpp>
@@ -25,6 +26,7 @@ struct HttpHandlerStatisticsEntry final {
     std::chrono::milliseconds timing{};
     engine::Deadline deadline{};
     bool cancelled_by_deadline{false};
+    engine::current_task::ExecutionStats execution_stats{};
 };
 
 struct HttpHandlerStatisticsSnapshot;
@@ -59,6 +61,9 @@ private:
     utils::statistics::RateCounter rate_limit_reached_;
     utils::statistics::RateCounter deadline_received_;
     utils::statistics::RateCounter cancelled_by_deadline_;
+    utils::statistics::RateCounter running_time_us_;
+    utils::statistics::RateCounter queue_wait_time_us_;
+    utils::statistics::RateCounter context_switches_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerMethodStatistics& stats);
@@ -78,6 +83,9 @@ struct HttpHandlerStatisticsSnapshot final {
     utils::statistics::Rate rate_limit_reached;
     utils::statistics::Rate deadline_received;
     utils::statistics::Rate cancelled_by_deadline;
+    utils::statistics::Rate running_time_us;
+    utils::statistics::Rate queue_wait_time_us;
+    utils::statistics::Rate context_switches;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats);
@@ -143,6 +151,7 @@ private:
     HttpHandlerStatistics& stats_;
     const http::HttpMethod method_;
     const std::chrono::steady_clock::time_point start_time_;
+    const engine::current_task::ExecutionStats start_execution_stats_;
     server::http::HttpResponse& response_;
     bool cancelled_by_deadline_{false};
 };
@@ -50,8 +50,11 @@ std::string HttpHandlerStatic::HandleRequestThrow(const http::HttpRequest& reque
     const auto file = storage_.TryGetFile(request.GetRequestPath());
     if (file) {
         const auto config = config_.GetSnapshot();
-        request.GetHttpResponse().SetContentType(config[kContentTypeMap][file->extension]);
-        return file->data;
+        auto& response = request.GetHttpResponse();
+        response.SetContentType(config[kContentTypeMap][file->extension]);
+        // Reference the cached contents instead of copying them into the response
+        response.SetSharedData(std::shared_ptr<const std::string>{file, &file->data});
+        return {};
     }
     request.GetHttpResponse().SetStatusNotFound();
     return "File not found";
@@ -4,6 +4,7 @@
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -34,6 +35,9 @@ namespace {
 
 using impl::StatsFormat;
 
+// Chunks of the streamed Prometheus output
+constexpr std::size_t kStreamChunkSize = 64 * 1024;
+
 std::optional<StatsFormat> ParseFormat(std::string_view format) {
     if (format.empty()) return {};
 
@@ -69,37 +73,19 @@ ServerMonitor::ServerMonitor(
     : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
       statistics_storage_(component_context.FindComponent<components::StatisticsStorage>().GetStorage()),
       common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
-
-std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
-    const auto& prefix = request.GetArg("prefix");
-    const auto& path = request.GetArg("path");
-    if (!path.empty() && !prefix.empty() && path != prefix) {
-        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
-    }
-
-    std::vector<utils::statistics::Label> labels;
-    const auto& labels_json = request.GetArg("labels");
-    if (!labels_json.empty()) {
-        auto json = formats::json::FromString(labels_json);
-        for (auto [key, value] : Items(json)) {
-            labels.emplace_back(std::move(key), value.As<std::string>());
-        }
-    }
-
-    const auto arg_format = ParseFormat(request.GetArg("format"));
-
-    if (!default_format_.has_value() && !arg_format.has_value()) {
-        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
+      default_format_{ParseFormat(config["format"].As<std::string>({}))} {
+    if (config["prometheus-cache"].As<bool>(false)) {
+        using utils::statistics::PrometheusFormatCache;
+        prometheus_cache_ = std::make_unique<PrometheusFormatCache>(PrometheusFormatCache::Format::kTyped);
+        prometheus_untyped_cache_ = std::make_unique<PrometheusFormatCache>(PrometheusFormatCache::Format::kUntyped);
     }
+}
 
-    const auto format = arg_format.has_value() ? arg_format.value() : default_format_.value();
+ServerMonitor::~ServerMonitor() = default;
 
-    using utils::statistics::Request;
-    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-    const auto statistics_request =
-        (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
-                      : Request::MakeWithPath(path, std::move(common_labels), std::move(labels)));
+std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
+    const auto format = GetFormat(request);
+    const auto statistics_request = MakeStatisticsRequest(request, format);
 
     request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
     switch (format) {
@@ -107,9 +93,15 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
             return utils::statistics::ToGraphiteFormat(statistics_storage_, statistics_request);
 
         case StatsFormat::kPrometheus:
+            if (prometheus_cache_) {
+                return prometheus_cache_->ToString(statistics_storage_, statistics_request);
+            }
             return utils::statistics::ToPrometheusFormat(statistics_storage_, statistics_request);
 
         case StatsFormat::kPrometheusUntyped:
+            if (prometheus_untyped_cache_) {
+                return prometheus_untyped_cache_->ToString(statistics_storage_, statistics_request);
+            }
             return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_, statistics_request);
 
         case StatsFormat::kJson:
@@ -133,6 +125,73 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
     UINVARIANT(false, "Unexpected 'format' value");
 }
 
+void ServerMonitor::HandleStreamRequest(
+    http::HttpRequest& request,
+    request::RequestContext& context,
+    http::ResponseBodyStream& response_body_stream
+) const {
+    const auto format = GetFormat(request);
+    utils::statistics::PrometheusFormatCache* cache = nullptr;
+    if (format == StatsFormat::kPrometheus) {
+        cache = prometheus_cache_.get();
+    } else if (format == StatsFormat::kPrometheusUntyped) {
+        cache = prometheus_untyped_cache_.get();
+    }
+    if (!cache) {
+        auto body = HandleRequestThrow(request, context);
+        response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+        response_body_stream.SetEndOfHeaders();
+        response_body_stream.PushBodyChunk(std::move(body), engine::Deadline{});
+        return;
+    }
+
+    const auto statistics_request = MakeStatisticsRequest(request, format);
+    request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
+    response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+    response_body_stream.SetEndOfHeaders();
+    cache->WriteChunks(
+        statistics_storage_,
+        statistics_request,
+        kStreamChunkSize,
+        [&response_body_stream](std::string_view chunk) {
+            response_body_stream.PushBodyChunk(std::string{chunk}, engine::Deadline{});
+        }
+    );
+}
+
+StatsFormat ServerMonitor::GetFormat(const http::HttpRequest& request) const {
+    const auto arg_format = ParseFormat(request.GetArg("format"));
+
+    if (!default_format_.has_value() && !arg_format.has_value()) {
+        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
+    }
+
+    return arg_format.has_value() ? arg_format.value() : default_format_.value();
+}
+
+utils::statistics::Request
+ServerMonitor::MakeStatisticsRequest(const http::HttpRequest& request, StatsFormat format) const {
+    const auto& prefix = request.GetArg("prefix");
+    const auto& path = request.GetArg("path");
+    if (!path.empty() && !prefix.empty() && path != prefix) {
+        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
+    }
+
+    std::vector<utils::statistics::Label> labels;
+    const auto& labels_json = request.GetArg("labels");
+    if (!labels_json.empty()) {
+        auto json = formats::json::FromString(labels_json);
+        for (auto [key, value] : Items(json)) {
+            labels.emplace_back(std::move(key), value.As<std::string>());
+        }
+    }
+
+    using utils::statistics::Request;
+    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
+    return path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
+                        : Request::MakeWithPath(path, std::move(common_labels), std::move(labels));
+}
+
 std::string
 ServerMonitor::GetResponseDataForLogging(const http::HttpRequest&, request::RequestContext&, const std::string&) const {
     // Useless data for logs, no need to duplicate metrics in logs
@@ -163,6 +222,12 @@ properties:
           - pretty
           - solomon
           - internal
+    prometheus-cache:
+        type: boolean
+        description: |
+            Reuse the text of the previous response for the metrics that
+            have not changed in Prometheus formats
+        defaultDescription: false
   )");
 }
 
@@ -18,7 +18,8 @@ namespace server {
 
 inline std::shared_ptr<request::RequestParser> CreateTestParser(
     server::http::HttpRequestParser::OnNewRequestCb&& cb,
-    USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11
+    USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11,
+    bool fast_parsing = false
 ) {
     static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
     static const server::request::HttpRequestConfig kTestRequestConfig{
@@ -49,7 +50,13 @@ inline std::shared_ptr<request::RequestParser> CreateTestParser(
         );
     } else {
         return std::make_shared<server::http::HttpRequestParser>(
-            kTestHandlerInfoIndex, kTestRequestConfig, std::move(cb), test_stats, test_accounter, engine::io::Sockaddr{}
+            kTestHandlerInfoIndex,
+            kTestRequestConfig,
+            std::move(cb),
+            test_stats,
+            test_accounter,
+            engine::io::Sockaddr{},
+            fast_parsing
         );
     }
 }
@@ -67,7 +67,12 @@ bool Stream::CheckUrlComplete() {
 
 void Stream::PushChunk(std::string&& chunk) {
     if (chunk.empty()) return;
-    chunks_.push_back(std::move(chunk));
+    chunks_.emplace_back(std::move(chunk));
+}
+
+void Stream::PushChunk(std::shared_ptr<const std::string> chunk) {
+    if (!chunk || chunk->empty()) return;
+    chunks_.emplace_back(std::move(chunk));
 }
 
 ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
@@ -78,7 +83,7 @@ ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
     }
     const std::size_t total =
         std::accumulate(chunks_.begin(), chunks_.end(), std::size_t{0}, [](std::size_t size, const auto& str) {
-            return size + str.size();
+            return size + str.View().size();
         });
     if (total == 0 && stream.is_streaming_ && !stream.is_end_) {
         stream.is_deferred_ = true;
@@ -86,10 +91,11 @@ ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
     }
     if (!stream.is_streaming_) {
         UASSERT(chunks_.size() == 1);
-        if (pos_in_first_chunk_ + max_len >= chunks_[0].size()) {
+        const auto first_chunk_size = chunks_[0].View().size();
+        if (pos_in_first_chunk_ + max_len >= first_chunk_size) {
             *flags |= NGHTTP2_DATA_FLAG_EOF;
         }
-        return std::min(max_len, chunks_[0].size() - pos_in_first_chunk_);
+        return std::min(max_len, first_chunk_size - pos_in_first_chunk_);
     }
     UASSERT(total >= pos_in_first_chunk_);
     const auto remaining = total - pos_in_first_chunk_;
@@ -104,13 +110,13 @@ void Stream::Send(engine::io::Socket& socket, std::string_view data_frame_header
     boost::container::small_vector<engine::io::IoData, 16> parts{};
     parts.push_back({data_frame_header.data(), data_frame_header.size()});
     auto budget = max_len;
-    for (const auto& chunk : chunks_) {
+    for (const auto& chunk_data : chunks_) {
         if (budget == 0) {
             break;
         }
+        const auto chunk = chunk_data.View();
         UASSERT(chunk.size() > pos_in_first_chunk_);
-        const auto part =
-            std::string_view{chunk}.substr(pos_in_first_chunk_, std::min(chunk.size() - pos_in_first_chunk_, budget));
+        const auto part = chunk.substr(pos_in_first_chunk_, std::min(chunk.size() - pos_in_first_chunk_, budget));
         parts.push_back({part.data(), part.size()});
         pos_in_first_chunk_ += part.size();
         if (pos_in_first_chunk_ >= chunk.size()) {
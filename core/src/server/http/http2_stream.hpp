@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include <nghttp2/nghttp2.h>
 #include <boost/container/small_vector.hpp>
 
@@ -42,17 +46,32 @@ public:
 
     bool CheckUrlComplete();
     void PushChunk(std::string&& chunk);
+    // The shared buffer is sent without copying it
+    void PushChunk(std::shared_ptr<const std::string> chunk);
     ssize_t GetMaxSize(std::size_t max_len, std::uint32_t* flags);
     void Send(engine::io::Socket& socket, std::string_view data_frame_header, std::size_t max_len);
     nghttp2_data_provider* GetNativeProvider() { return &nghttp2_provider_; }
 
 private:
+    // Either owns the data or references a shared immutable buffer
+    class Chunk final {
+    public:
+        explicit Chunk(std::string&& data) : owned_(std::move(data)) {}
+        explicit Chunk(std::shared_ptr<const std::string>&& data) : shared_(std::move(data)) {}
+
+        std::string_view View() const { return shared_ ? std::string_view{*shared_} : std::string_view{owned_}; }
+
+    private:
+        std::string owned_;
+        std::shared_ptr<const std::string> shared_;
+    };
+
     bool url_complete_{false};
     HttpRequestConstructor constructor_;
     const Id id_;
     // Body sending
     nghttp2_data_provider nghttp2_provider_{};
-    boost::container::small_vector<std::string, 16> chunks_{};
+    boost::container::small_vector<Chunk, 16> chunks_{};
     std::size_t pos_in_first_chunk_{0};
     // for the streaming API
     bool is_streaming_{false};
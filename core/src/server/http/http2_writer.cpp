@@ -101,12 +101,15 @@ public:
     Http2ResponseWriter(HttpResponse& response, Http2Session& session) : response_(response), http2_session_(session) {}
 
     void WriteHttpResponse() {
-        auto data = response_.ExtractData();
+        // The shared data is sent without copying it
+        auto shared_data = response_.ExtractSharedData();
+        auto data = response_.ExtractNotStreamedBody();
+        const std::string_view body = shared_data ? std::string_view{*shared_data} : std::string_view{data};
 
         auto headers = GetHeaders();
         const bool is_body_forbidden = IsBodyForbiddenForStatus(response_.status_);
 
-        if (is_body_forbidden && !data.empty()) {
+        if (is_body_forbidden && !body.empty()) {
             LOG_LIMITED_WARNING() << "Non-empty body provided for response with HTTP2 code "
                                   << static_cast<int>(response_.status_)
                                   << " which does not allow one, it will be dropped";
@@ -114,14 +117,18 @@ public:
 
         const auto stream_id = response_.GetStreamId().value();
         auto& stream = http2_session_.GetStreamChecked(Stream::Id{stream_id});
-        stream.SetStreaming(response_.IsBodyStreamed() && data.empty());
+        stream.SetStreaming(response_.IsBodyStreamed() && body.empty());
 
         std::size_t bytes = headers.GetSize();
         nghttp2_data_provider* provider{nullptr};
         if (response_.request_.GetMethod() != HttpMethod::kHead && !is_body_forbidden) {
             if (!stream.IsStreaming()) {
-                bytes += data.size();
-                stream.PushChunk(std::move(data));
+                bytes += body.size();
+                if (shared_data) {
+                    stream.PushChunk(std::move(shared_data));
+                } else {
+                    stream.PushChunk(std::move(data));
+                }
             }
             provider = stream.GetNativeProvider();
         }
@@ -1,6 +1,7 @@
 #include <userver/server/http/http_request_builder.hpp>
 
 #include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_pool.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
 
@@ -22,6 +23,19 @@ request::ResponseDataAccounter default_data_accounter;
 HttpRequestBuilder::HttpRequestBuilder(request::ResponseDataAccounter& data_accounter)
     : request_(std::make_shared<HttpRequest>(data_accounter, utils::impl::InternalTag{})) {}
 
+HttpRequestBuilder::HttpRequestBuilder(
+    request::ResponseDataAccounter& data_accounter,
+    std::shared_ptr<impl::HttpRequestPool> pool
+)
+    : request_(
+          pool ? std::allocate_shared<HttpRequest>(
+                     impl::HttpRequestPoolAllocator<HttpRequest>{std::move(pool)},
+                     data_accounter,
+                     utils::impl::InternalTag{}
+                 )
+               : std::make_shared<HttpRequest>(data_accounter, utils::impl::InternalTag{})
+      ) {}
+
 HttpRequestBuilder::HttpRequestBuilder() : HttpRequestBuilder(default_data_accounter) {}
 
 HttpRequestBuilder& HttpRequestBuilder::SetRemoteAddress(engine::io::Sockaddr remote_address) {
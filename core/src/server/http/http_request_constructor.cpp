@@ -46,9 +46,10 @@ HttpRequestConstructor::HttpRequestConstructor(
     Config config,
     const HandlerInfoIndex& handler_info_index,
     request::ResponseDataAccounter& data_accounter,
-    engine::io::Sockaddr remote_address
+    engine::io::Sockaddr remote_address,
+    std::shared_ptr<impl::HttpRequestPool> request_pool
 )
-    : config_(config), handler_info_index_(handler_info_index), builder_(data_accounter) {
+    : config_(config), handler_info_index_(handler_info_index), builder_(data_accounter, std::move(request_pool)) {
     builder_.SetRemoteAddress(std::move(remote_address));
 }
 
@@ -9,6 +9,7 @@
 #include <userver/server/request/request_config.hpp>
 
 #include "handler_info_index.hpp"
+#include "http_request_pool.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,7 +37,8 @@ public:
         Config config,
         const HandlerInfoIndex& handler_info_index,
         request::ResponseDataAccounter& data_accounter,
-        engine::io::Sockaddr remote_address
+        engine::io::Sockaddr remote_address,
+        std::shared_ptr<impl::HttpRequestPool> request_pool = {}
     );
 
     ~HttpRequestConstructor();
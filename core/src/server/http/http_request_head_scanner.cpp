@@ -0,0 +1,249 @@
+#include "http_request_head_scanner.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::string_view kVersionPrefix = "HTTP/1.";
+constexpr std::size_t kMaxMethodSize = 7;  // "OPTIONS"
+constexpr std::size_t kMaxContentLengthDigits = 18;
+
+constexpr std::array<bool, 256> kTokenChars = [] {
+    std::array<bool, 256> result{};
+    for (unsigned char c = '0'; c <= '9'; ++c) result[c] = true;
+    for (unsigned char c = 'a'; c <= 'z'; ++c) result[c] = true;
+    for (unsigned char c = 'A'; c <= 'Z'; ++c) result[c] = true;
+    for (const unsigned char c : std::string_view{"!#$%&'*+-.^_`|~"}) result[c] = true;
+    return result;
+}();
+
+// Returns the first char that may not appear in a URL without escaping:
+// a control char, space, DEL or a non-ASCII char.
+const char* FindUrlEnd(const char* pos, const char* end) noexcept {
+#if defined(__AVX2__)
+    for (; end - pos >= 32; pos += 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        // signed comparison also matches the chars >= 0x80
+        const auto mask = _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(' ' + 1), block), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x7f))
+        ));
+        if (mask != 0) return pos + __builtin_ctz(static_cast<std::uint32_t>(mask));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; end - pos >= 16; pos += 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const auto mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpgt_epi8(_mm_set1_epi8(' ' + 1), block), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x7f)))
+        );
+        if (mask != 0) return pos + __builtin_ctz(static_cast<std::uint32_t>(mask));
+    }
+#endif
+    for (; pos != end; ++pos) {
+        const auto c = static_cast<unsigned char>(*pos);
+        if (c <= ' ' || c >= 0x7f) return pos;
+    }
+    return end;
+}
+
+// Returns the first control char (including HTAB and CR) or DEL.
+const char* FindControlChar(const char* pos, const char* end) noexcept {
+#if defined(__AVX2__)
+    for (; end - pos >= 32; pos += 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        // unsigned 'c < 0x20' is 'min(c, 0x1f) == c'
+        const auto mask = _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(0x1f)), block),
+            _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x7f))
+        ));
+        if (mask != 0) return pos + __builtin_ctz(static_cast<std::uint32_t>(mask));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; end - pos >= 16; pos += 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const auto mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1f)), block), _mm_cmpeq_epi8(block, _mm_set1_epi8(0x7f))
+        ));
+        if (mask != 0) return pos + __builtin_ctz(static_cast<std::uint32_t>(mask));
+    }
+#endif
+    for (; pos != end; ++pos) {
+        const auto c = static_cast<unsigned char>(*pos);
+        if (c < 0x20 || c == 0x7f) return pos;
+    }
+    return end;
+}
+
+HttpMethod ParseMethod(std::string_view method) noexcept {
+    switch (method.size()) {
+        case 3:
+            if (method == "GET") return HttpMethod::kGet;
+            if (method == "PUT") return HttpMethod::kPut;
+            break;
+        case 4:
+            if (method == "POST") return HttpMethod::kPost;
+            if (method == "HEAD") return HttpMethod::kHead;
+            break;
+        case 5:
+            if (method == "PATCH") return HttpMethod::kPatch;
+            break;
+        case 6:
+            if (method == "DELETE") return HttpMethod::kDelete;
+            break;
+        case 7:
+            if (method == "OPTIONS") return HttpMethod::kOptions;
+            break;
+        default:
+            break;
+    }
+    return HttpMethod::kUnknown;
+}
+
+bool ParseContentLength(std::string_view value, std::size_t& result) noexcept {
+    if (value.empty() || value.size() > kMaxContentLengthDigits) return false;
+
+    std::size_t length = 0;
+    for (const char c : value) {
+        if (c < '0' || c > '9') return false;
+        length = length * 10 + static_cast<std::size_t>(c - '0');
+    }
+    result = length;
+    return true;
+}
+
+struct ConnectionInfo final {
+    bool has_content_length{false};
+    std::size_t content_length{0};
+    bool close{false};
+    bool keep_alive{false};
+};
+
+// Returns false if the header requires the full parser
+bool ProcessSpecialHeader(const ScannedRequest::Header& header, ConnectionInfo& info) noexcept {
+    const utils::StrIcaseEqual equal{};
+    switch (header.name.size()) {
+        case 7:
+            return !equal(header.name, "Upgrade");
+        case 10:
+            if (!equal(header.name, "Connection")) return true;
+            for (std::string_view tokens = header.value; !tokens.empty();) {
+                const auto comma_pos = tokens.find(',');
+                auto token = tokens.substr(0, comma_pos);
+                tokens.remove_prefix(comma_pos == std::string_view::npos ? tokens.size() : comma_pos + 1);
+
+                while (!token.empty() && (token.front() == ' ' || token.front() == '\t')) token.remove_prefix(1);
+                while (!token.empty() && (token.back() == ' ' || token.back() == '\t')) token.remove_suffix(1);
+
+                if (equal(token, "close")) {
+                    info.close = true;
+                } else if (equal(token, "keep-alive")) {
+                    info.keep_alive = true;
+                } else if (equal(token, "upgrade")) {
+                    return false;
+                }
+            }
+            return true;
+        case 14: {
+            if (!equal(header.name, "Content-Length")) return true;
+            std::size_t length = 0;
+            if (!ParseContentLength(header.value, length)) return false;
+            if (info.has_content_length && info.content_length != length) return false;
+            info.has_content_length = true;
+            info.content_length = length;
+            return true;
+        }
+        case 17:
+            return !equal(header.name, "Transfer-Encoding");
+        default:
+            return true;
+    }
+}
+
+}  // namespace
+
+std::size_t ScanSimpleRequest(std::string_view data, ScannedRequest& request) noexcept {
+    const char* pos = data.data();
+    const char* const end = pos + data.size();
+
+    // Request line
+    const auto* method_end =
+        static_cast<const char*>(std::memchr(pos, ' ', std::min<std::size_t>(data.size(), kMaxMethodSize + 1)));
+    if (!method_end) return 0;
+    request.method = ParseMethod({pos, static_cast<std::size_t>(method_end - pos)});
+    if (request.method == HttpMethod::kUnknown) return 0;
+    pos = method_end + 1;
+
+    const char* url_end = FindUrlEnd(pos, end);
+    if (url_end == end || *url_end != ' ' || url_end == pos || *pos != '/') return 0;
+    request.url = {pos, static_cast<std::size_t>(url_end - pos)};
+    pos = url_end + 1;
+
+    if (static_cast<std::size_t>(end - pos) < kVersionPrefix.size() + 3) return 0;
+    if (std::string_view{pos, kVersionPrefix.size()} != kVersionPrefix) return 0;
+    pos += kVersionPrefix.size();
+    if (*pos != '0' && *pos != '1') return 0;
+    request.http_minor = *pos - '0';
+    if (pos[1] != '\r' || pos[2] != '\n') return 0;
+    pos += 3;
+
+    // Headers
+    ConnectionInfo info;
+    request.headers_count = 0;
+    for (;;) {
+        if (end - pos < 2) return 0;
+        if (*pos == '\r') {
+            if (pos[1] != '\n') return 0;
+            pos += 2;
+            break;
+        }
+
+        // obs-fold and whitespace before colon are left to the full parser
+        const char* name_begin = pos;
+        while (pos != end && kTokenChars[static_cast<unsigned char>(*pos)]) ++pos;
+        if (pos == end || *pos != ':' || pos == name_begin) return 0;
+        const std::string_view name{name_begin, static_cast<std::size_t>(pos - name_begin)};
+        ++pos;
+
+        while (pos != end && (*pos == ' ' || *pos == '\t')) ++pos;
+        const char* value_begin = pos;
+        for (pos = FindControlChar(pos, end); pos != end && *pos == '\t'; pos = FindControlChar(pos + 1, end)) {
+        }
+        if (end - pos < 2 || pos[0] != '\r' || pos[1] != '\n') return 0;
+
+        const char* value_end = pos;
+        while (value_end != value_begin && (value_end[-1] == ' ' || value_end[-1] == '\t')) --value_end;
+        pos += 2;
+
+        if (request.headers_count == ScannedRequest::kMaxHeaders) return 0;
+        auto& header = request.headers[request.headers_count++];
+        header.name = name;
+        header.value = {value_begin, static_cast<std::size_t>(value_end - value_begin)};
+        if (!ProcessSpecialHeader(header, info)) return 0;
+    }
+
+    // Body
+    if (static_cast<std::size_t>(end - pos) < info.content_length) return 0;
+    request.body = {pos, info.content_length};
+    pos += info.content_length;
+
+    request.keep_alive = request.http_minor == 1 ? !info.close : info.keep_alive;
+    return static_cast<std::size_t>(pos - data.data());
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include <userver/server/http/http_method.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// A complete HTTP/1.x request that was found in a buffer by
+/// ScanSimpleRequest(). All the views point into the scanned buffer.
+struct ScannedRequest final {
+    struct Header final {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    static constexpr std::size_t kMaxHeaders = 64;
+
+    HttpMethod method{HttpMethod::kUnknown};
+    std::string_view url;
+    unsigned short http_minor{1};
+
+    std::array<Header, kMaxHeaders> headers{};
+    std::size_t headers_count{0};
+
+    std::string_view body;
+    bool keep_alive{true};
+};
+
+/// @brief Scans a complete request at the beginning of `data` using SIMD
+/// instructions if available.
+///
+/// Only the common requests are handled: a known method except CONNECT, an
+/// origin-form URL, HTTP/1.0 or HTTP/1.1, at most ScannedRequest::kMaxHeaders
+/// headers, a body with Content-Length and no Upgrade or Transfer-Encoding.
+/// @returns the size of the request in `data` or 0 if the request is
+/// incomplete, malformed or unusual and must be processed by the full parser.
+std::size_t ScanSimpleRequest(std::string_view data, ScannedRequest& request) noexcept;
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
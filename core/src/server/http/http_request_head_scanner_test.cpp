@@ -0,0 +1,98 @@
+#include <server/http/http_request_head_scanner.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpMethod;
+using server::http::impl::ScannedRequest;
+using server::http::impl::ScanSimpleRequest;
+
+}  // namespace
+
+TEST(HttpRequestHeadScanner, Simple) {
+    // the URL is long enough to go through the vectorized loops
+    constexpr std::string_view kRequest =
+        "POST /some/long/path/to/the/handler?with=arguments&and=more HTTP/1.0\r\n"
+        "Host: localhost\r\n"
+        "X-Header:\tvalue with\ttabs and spaces that is longer than a vector register \r\n"
+        "Connection: Keep-Alive\r\n"
+        "Content-Length: 4\r\n\r\n"
+        "bodyGET / HTTP/1.1\r\n\r\n";
+
+    ScannedRequest request;
+    const auto size = ScanSimpleRequest(kRequest, request);
+    ASSERT_EQ(size, kRequest.find("GET"));
+
+    EXPECT_EQ(request.method, HttpMethod::kPost);
+    EXPECT_EQ(request.url, "/some/long/path/to/the/handler?with=arguments&and=more");
+    EXPECT_EQ(request.http_minor, 0);
+    ASSERT_EQ(request.headers_count, 4);
+    EXPECT_EQ(request.headers[0].name, "Host");
+    EXPECT_EQ(request.headers[0].value, "localhost");
+    EXPECT_EQ(request.headers[1].value, "value with\ttabs and spaces that is longer than a vector register");
+    EXPECT_EQ(request.body, "body");
+    EXPECT_TRUE(request.keep_alive);
+
+    EXPECT_EQ(ScanSimpleRequest(kRequest.substr(size), request), kRequest.size() - size);
+    EXPECT_EQ(request.method, HttpMethod::kGet);
+    EXPECT_EQ(request.headers_count, 0);
+    EXPECT_TRUE(request.body.empty());
+}
+
+TEST(HttpRequestHeadScanner, KeepAlive) {
+    ScannedRequest request;
+    ASSERT_NE(ScanSimpleRequest("GET / HTTP/1.0\r\n\r\n", request), 0);
+    EXPECT_FALSE(request.keep_alive);
+
+    ASSERT_NE(ScanSimpleRequest("GET / HTTP/1.1\r\nconnection: te, close\r\n\r\n", request), 0);
+    EXPECT_FALSE(request.keep_alive);
+}
+
+TEST(HttpRequestHeadScanner, Incomplete) {
+    constexpr std::string_view kRequest = "PUT /path HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789";
+
+    ScannedRequest request;
+    for (std::size_t size = 0; size < kRequest.size(); ++size) {
+        EXPECT_EQ(ScanSimpleRequest(kRequest.substr(0, size), request), 0) << size;
+    }
+    EXPECT_EQ(ScanSimpleRequest(kRequest, request), kRequest.size());
+}
+
+TEST(HttpRequestHeadScanner, Unsupported) {
+    for (const std::string_view data : {
+             "get / HTTP/1.1\r\n\r\n",
+             "CONNECT example.org:443 HTTP/1.1\r\n\r\n",
+             "GET http://example.org/ HTTP/1.1\r\n\r\n",
+             "GET /caf\xc3\xa9 HTTP/1.1\r\n\r\n",
+             "GET / HTTP/2.0\r\n\r\n",
+             "GET / HTTP/1.1\n\r\n",
+             "GET / HTTP/1.1\r\nHost : localhost\r\n\r\n",
+             "GET / HTTP/1.1\r\nHost: local\x01host\r\n\r\n",
+             "GET / HTTP/1.1\r\nX-Header: a\r\n b\r\n\r\n",
+             "GET / HTTP/1.1\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n",
+             "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n",
+             "POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n",
+             "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\nab",
+         }) {
+        ScannedRequest request;
+        EXPECT_EQ(ScanSimpleRequest(data, request), 0) << data;
+    }
+}
+
+TEST(HttpRequestHeadScanner, TooManyHeaders) {
+    std::string data = "GET / HTTP/1.1\r\n";
+    for (std::size_t i = 0; i <= ScannedRequest::kMaxHeaders; ++i) {
+        data += "Header: value\r\n";
+    }
+    data += "\r\n";
+
+    ScannedRequest request;
+    EXPECT_EQ(ScanSimpleRequest(data, request), 0);
+}
+
+USERVER_NAMESPACE_END
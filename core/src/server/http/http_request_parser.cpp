@@ -87,10 +87,14 @@ HttpRequestParser::HttpRequestParser(
     OnNewRequestCb&& on_new_request_cb,
     net::ParserStats& stats,
     request::ResponseDataAccounter& data_accounter,
-    engine::io::Sockaddr remote_address
+    engine::io::Sockaddr remote_address,
+    bool fast_parsing,
+    std::shared_ptr<impl::HttpRequestPool> request_pool
 )
     : handler_info_index_(handler_info_index),
       request_constructor_config_{request_config},
+      fast_parsing_(fast_parsing),
+      request_pool_(std::move(request_pool)),
       on_new_request_cb_(std::move(on_new_request_cb)),
       stats_(stats),
       data_accounter_(data_accounter),
@@ -100,6 +104,22 @@ HttpRequestParser::HttpRequestParser(
 }
 
 bool HttpRequestParser::Parse(std::string_view req) {
+    while (fast_parsing_ && !is_closed_ && !is_llhttp_message_in_progress_ && !req.empty()) {
+        const auto size = impl::ScanSimpleRequest(req, scanned_request_);
+        if (size == 0) break;
+
+        if (!ProcessScannedRequest(scanned_request_)) return false;
+        is_closed_ = !scanned_request_.keep_alive;
+        req.remove_prefix(size);
+    }
+    if (req.empty()) return true;
+
+    if (is_closed_) {
+        LOG_WARNING() << "parsed=0 size=" << req.size()
+                      << " error_description=" << llhttp_errno_name(HPE_CLOSED_CONNECTION);
+        return false;
+    }
+
     const auto err = llhttp_execute(&parser_, req.data(), req.size());
     if (parser_.upgrade && err == HPE_PAUSED_UPGRADE) {
         FinalizeRequest();
@@ -160,6 +180,7 @@ int HttpRequestParser::OnBody(llhttp_t* p, const char* data, size_t size) {
 
 int HttpRequestParser::OnMessageBeginImpl(llhttp_t*) {
     LOG_TRACE() << "message begin";
+    is_llhttp_message_in_progress_ = true;
     CreateRequestConstructor();
     return 0;
 }
@@ -234,6 +255,7 @@ int HttpRequestParser::OnMessageCompleteImpl(llhttp_t* p) {
     if (p->upgrade) {
         return 0;
     }
+    is_llhttp_message_in_progress_ = false;
     request_constructor_->SetIsFinal(!llhttp_should_keep_alive(p));
     if (!CheckUrlComplete(p)) return -1;
     LOG_TRACE() << "message complete";
@@ -243,16 +265,22 @@ int HttpRequestParser::OnMessageCompleteImpl(llhttp_t* p) {
 
 void HttpRequestParser::CreateRequestConstructor() {
     stats_.parsing_request_count.Add(1);
-    request_constructor_.emplace(request_constructor_config_, handler_info_index_, data_accounter_, remote_address_);
+    request_constructor_.emplace(
+        request_constructor_config_, handler_info_index_, data_accounter_, remote_address_, request_pool_
+    );
     url_complete_ = false;
 }
 
 bool HttpRequestParser::CheckUrlComplete(llhttp_t* p) {
+    return CheckUrlComplete(ConvertHttpMethod(static_cast<llhttp_method>(p->method)), p->http_major, p->http_minor);
+}
+
+bool HttpRequestParser::CheckUrlComplete(HttpMethod method, unsigned short http_major, unsigned short http_minor) {
     if (url_complete_) return true;
     url_complete_ = true;
-    request_constructor_->SetMethod(ConvertHttpMethod(static_cast<llhttp_method>(p->method)));
-    request_constructor_->SetHttpMajor(p->http_major);
-    request_constructor_->SetHttpMinor(p->http_minor);
+    request_constructor_->SetMethod(method);
+    request_constructor_->SetHttpMajor(http_major);
+    request_constructor_->SetHttpMinor(http_minor);
     try {
         request_constructor_->ParseUrl();
     } catch (const std::exception& ex) {
@@ -262,6 +290,34 @@ bool HttpRequestParser::CheckUrlComplete(llhttp_t* p) {
     return true;
 }
 
+bool HttpRequestParser::ProcessScannedRequest(const impl::ScannedRequest& scanned) {
+    CreateRequestConstructor();
+    request_constructor_->SetMethod(scanned.method);
+    try {
+        request_constructor_->AppendUrl(scanned.url.data(), scanned.url.size());
+        if (!CheckUrlComplete(scanned.method, 1, scanned.http_minor)) {
+            FinalizeRequest();
+            return false;
+        }
+
+        for (std::size_t i = 0; i < scanned.headers_count; ++i) {
+            const auto& header = scanned.headers[i];
+            request_constructor_->AppendHeaderField(header.name.data(), header.name.size());
+            request_constructor_->AppendHeaderValue(header.value.data(), header.value.size());
+        }
+        request_constructor_->AppendHeaderField("", 0);
+
+        if (!scanned.body.empty()) request_constructor_->AppendBody(scanned.body.data(), scanned.body.size());
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't process request: " << ex;
+        FinalizeRequest();
+        return false;
+    }
+
+    request_constructor_->SetIsFinal(!scanned.keep_alive);
+    return FinalizeRequest();
+}
+
 bool HttpRequestParser::FinalizeRequest() {
     bool res = FinalizeRequestImpl();
     stats_.parsing_request_count.Subtract(1);
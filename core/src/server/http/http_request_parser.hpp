@@ -14,6 +14,7 @@
 #include <userver/server/request/request_config.hpp>
 
 #include "http_request_constructor.hpp"
+#include "http_request_head_scanner.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,7 +30,9 @@ public:
         OnNewRequestCb&& on_new_request_cb,
         net::ParserStats& stats,
         request::ResponseDataAccounter& data_accounter,
-        engine::io::Sockaddr remote_address
+        engine::io::Sockaddr remote_address,
+        bool fast_parsing = false,
+        std::shared_ptr<impl::HttpRequestPool> request_pool = {}
     );
 
     HttpRequestParser(HttpRequestParser&&) = delete;
@@ -57,6 +60,10 @@ private:
     void CreateRequestConstructor();
 
     bool CheckUrlComplete(llhttp_t* p);
+    bool CheckUrlComplete(HttpMethod method, unsigned short http_major, unsigned short http_minor);
+
+    // Returns false if the request is malformed
+    bool ProcessScannedRequest(const impl::ScannedRequest& scanned);
 
     bool FinalizeRequest();
     bool FinalizeRequestImpl();
@@ -66,6 +73,16 @@ private:
 
     bool url_complete_ = false;
 
+    // Complete simple requests are processed by impl::ScanSimpleRequest()
+    // while llhttp is between the messages
+    const bool fast_parsing_;
+    const std::shared_ptr<impl::HttpRequestPool> request_pool_;
+    bool is_llhttp_message_in_progress_ = false;
+    // Set after a fast parsed request without keep-alive. Any data after it is
+    // an error, the same as HPE_CLOSED_CONNECTION in llhttp.
+    bool is_closed_ = false;
+    impl::ScannedRequest scanned_request_;
+
     OnNewRequestCb on_new_request_cb_;
 
     llhttp_t parser_{};
@@ -19,7 +19,8 @@ constexpr std::string_view kHttpRequestDataMiddle =
 
 constexpr size_t kEntryCount = 1024;
 
-inline server::http::HttpRequestParser CreateBenchmarkParser(server::http::HttpRequestParser::OnNewRequestCb&& cb) {
+inline server::http::HttpRequestParser
+CreateBenchmarkParser(server::http::HttpRequestParser::OnNewRequestCb&& cb, bool fast_parsing) {
     static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
     static server::request::HttpRequestConfig kTestRequestConfig{
         /*.max_url_size = */ 8192,
@@ -37,14 +38,21 @@ inline server::http::HttpRequestParser CreateBenchmarkParser(server::http::HttpR
     static server::net::ParserStats test_stats;
     static server::request::ResponseDataAccounter test_accounter;
     return server::http::HttpRequestParser(
-        kTestHandlerInfoIndex, kTestRequestConfig, std::move(cb), test_stats, test_accounter, engine::io::Sockaddr{}
+        kTestHandlerInfoIndex,
+        kTestRequestConfig,
+        std::move(cb),
+        test_stats,
+        test_accounter,
+        engine::io::Sockaddr{},
+        fast_parsing
     );
 }
 
 }  // namespace
 
 void http_request_parser_parse_benchmark_small(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    // state.range(0) enables the SIMD scanner for the simple requests
+    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {}, state.range(0));
 
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(kHttpRequestDataSmall);
@@ -52,7 +60,7 @@ void http_request_parser_parse_benchmark_small(benchmark::State& state) {
 }
 
 void http_request_parser_parse_benchmark_middle(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {}, state.range(0));
 
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(kHttpRequestDataMiddle);
@@ -60,7 +68,7 @@ void http_request_parser_parse_benchmark_middle(benchmark::State& state) {
 }
 
 void http_request_parser_parse_benchmark_large_url(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {}, state.range(0));
 
     std::string large_url;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -74,7 +82,7 @@ void http_request_parser_parse_benchmark_large_url(benchmark::State& state) {
 }
 
 void http_request_parser_parse_benchmark_large_body(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {}, state.range(0));
 
     std::string large_body;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -93,7 +101,7 @@ void http_request_parser_parse_benchmark_large_body(benchmark::State& state) {
 }
 
 void http_request_parser_parse_benchmark_many_headers(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {}, state.range(0));
 
     std::string headers;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -110,10 +118,10 @@ void http_request_parser_parse_benchmark_many_headers(benchmark::State& state) {
     }
 }
 
-BENCHMARK(http_request_parser_parse_benchmark_small);
-BENCHMARK(http_request_parser_parse_benchmark_middle);
-BENCHMARK(http_request_parser_parse_benchmark_large_url);
-BENCHMARK(http_request_parser_parse_benchmark_large_body);
-BENCHMARK(http_request_parser_parse_benchmark_many_headers);
+BENCHMARK(http_request_parser_parse_benchmark_small)->Arg(false)->Arg(true);
+BENCHMARK(http_request_parser_parse_benchmark_middle)->Arg(false)->Arg(true);
+BENCHMARK(http_request_parser_parse_benchmark_large_url)->Arg(false)->Arg(true);
+BENCHMARK(http_request_parser_parse_benchmark_large_body)->Arg(false)->Arg(true);
+BENCHMARK(http_request_parser_parse_benchmark_many_headers)->Arg(false)->Arg(true);
 
 USERVER_NAMESPACE_END
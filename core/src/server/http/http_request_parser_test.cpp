@@ -1,5 +1,8 @@
 #include <server/http/http_request_parser.hpp>
 
+#include <string>
+#include <vector>
+
 #include <server/http/create_parser_test.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -264,4 +267,84 @@ UTEST(HttpRequestParserParser, BodyContentLengthTooLong) {
     EXPECT_EQ(parsed, false);
 }
 
+// fast parsing
+
+namespace {
+
+constexpr std::string_view kHttpRequestsPipelined =
+    "GET /first HTTP/1.1\r\n"
+    "Host: localhost:11235\r\nHeader1:  Value1 \r\n\r\n"
+    "POST /second HTTP/1.1\r\n"
+    "Content-Length: 4\r\nConnection: close\r\n\r\n"
+    "body";
+
+constexpr std::string_view kHttpRequestChunked =
+    "POST / HTTP/1.1\r\n"
+    "Transfer-Encoding: chunked\r\n\r\n"
+    "4\r\nbody\r\n0\r\n\r\n";
+
+}  // namespace
+
+UTEST(HttpRequestParserParser, FastParsingPipelined) {
+    std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+    auto parser = server::CreateTestParser(
+        [&requests](std::shared_ptr<server::http::HttpRequest>&& request) { requests.push_back(std::move(request)); },
+        USERVER_NAMESPACE::http::HttpVersion::k11,
+        /*fast_parsing=*/true
+    );
+
+    EXPECT_TRUE(parser->Parse(kHttpRequestsPipelined));
+    ASSERT_EQ(requests.size(), 2);
+
+    EXPECT_EQ(requests[0]->GetMethod(), server::http::HttpMethod::kGet);
+    EXPECT_EQ(requests[0]->GetUrl(), "/first");
+    EXPECT_EQ(requests[0]->GetHeader("host"), "localhost:11235");
+    EXPECT_EQ(requests[0]->GetHeader("Header1"), "Value1");
+    EXPECT_FALSE(requests[0]->IsFinal());
+
+    EXPECT_EQ(requests[1]->GetMethod(), server::http::HttpMethod::kPost);
+    EXPECT_EQ(requests[1]->GetUrl(), "/second");
+    EXPECT_EQ(requests[1]->RequestBody(), "body");
+    EXPECT_TRUE(requests[1]->IsFinal());
+}
+
+UTEST(HttpRequestParserParser, FastParsingDataAfterClose) {
+    std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+    auto parser = server::CreateTestParser(
+        [&requests](std::shared_ptr<server::http::HttpRequest>&& request) { requests.push_back(std::move(request)); },
+        USERVER_NAMESPACE::http::HttpVersion::k11,
+        /*fast_parsing=*/true
+    );
+
+    EXPECT_FALSE(parser->Parse(std::string{kHttpRequestsPipelined}.append(kHttpRequestsPipelined)));
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_TRUE(requests[1]->IsFinal());
+
+    EXPECT_FALSE(parser->Parse(kHttpRequestsPipelined));
+    EXPECT_EQ(requests.size(), 2);
+}
+
+UTEST(HttpRequestParserParser, FastParsingFallback) {
+    std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+    auto parser = server::CreateTestParser(
+        [&requests](std::shared_ptr<server::http::HttpRequest>&& request) { requests.push_back(std::move(request)); },
+        USERVER_NAMESPACE::http::HttpVersion::k11,
+        /*fast_parsing=*/true
+    );
+
+    // incomplete requests continue in llhttp
+    EXPECT_TRUE(parser->Parse(kHttpRequestBodySimple.substr(0, 20)));
+    EXPECT_TRUE(parser->Parse(kHttpRequestBodySimple.substr(20)));
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0]->RequestBody(), "body");
+
+    EXPECT_TRUE(parser->Parse(kHttpRequestChunked));
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[1]->RequestBody(), "body");
+
+    EXPECT_TRUE(parser->Parse(kHttpRequestSmall));
+    ASSERT_EQ(requests.size(), 3);
+    EXPECT_EQ(requests[2]->GetUrl(), "/");
+}
+
 USERVER_NAMESPACE_END
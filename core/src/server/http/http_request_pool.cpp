@@ -0,0 +1,36 @@
+#include <server/http/http_request_pool.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+HttpRequestPool::HttpRequestPool(std::size_t max_free_blocks) : max_free_blocks_(max_free_blocks) {}
+
+HttpRequestPool::~HttpRequestPool() {
+    free_blocks_.DisposeUnsafe([](FreeBlock& block) {
+        block.~FreeBlock();
+        ::operator delete(&block, std::align_val_t{kBlockAlignment});
+    });
+}
+
+void* HttpRequestPool::Allocate() {
+    if (auto* block = free_blocks_.TryPop()) {
+        free_blocks_count_.fetch_sub(1, std::memory_order_relaxed);
+        block->~FreeBlock();
+        return block;
+    }
+    return ::operator new(kBlockSize, std::align_val_t{kBlockAlignment});
+}
+
+void HttpRequestPool::Deallocate(void* block) noexcept {
+    if (free_blocks_count_.fetch_add(1, std::memory_order_relaxed) >= max_free_blocks_) {
+        free_blocks_count_.fetch_sub(1, std::memory_order_relaxed);
+        ::operator delete(block, std::align_val_t{kBlockAlignment});
+        return;
+    }
+    free_blocks_.Push(*new (block) FreeBlock());
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
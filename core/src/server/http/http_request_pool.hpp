@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <userver/concurrent/impl/intrusive_hooks.hpp>
+#include <userver/concurrent/impl/intrusive_stack.hpp>
+#include <userver/server/http/http_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// @brief Per-connection cache of memory blocks for HttpRequest objects
+///
+/// A request together with its shared_ptr control block is placed into a
+/// single block. Blocks of the finished requests are kept for the next
+/// requests of the same connection instead of going back to the allocator.
+/// Requests may outlive the connection and may be destroyed on any thread,
+/// so the pool is shared by all the allocated requests and is thread-safe.
+class HttpRequestPool final {
+public:
+    static constexpr std::size_t kBlockSize = sizeof(HttpRequest) + 64;
+    static constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+    explicit HttpRequestPool(std::size_t max_free_blocks);
+    ~HttpRequestPool();
+
+    HttpRequestPool(HttpRequestPool&&) = delete;
+    HttpRequestPool& operator=(HttpRequestPool&&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* block) noexcept;
+
+private:
+    struct FreeBlock final {
+        concurrent::impl::SinglyLinkedHook<FreeBlock> hook;
+    };
+
+    using FreeBlocks = concurrent::impl::IntrusiveStack<FreeBlock, concurrent::impl::MemberHook<&FreeBlock::hook>>;
+
+    static_assert(sizeof(FreeBlock) <= kBlockSize);
+
+    const std::size_t max_free_blocks_;
+    FreeBlocks free_blocks_;
+    std::atomic<std::size_t> free_blocks_count_{0};
+};
+
+/// Allocator that takes the HttpRequest-sized allocations from HttpRequestPool
+template <typename T>
+class HttpRequestPoolAllocator final {
+public:
+    using value_type = T;
+
+    explicit HttpRequestPoolAllocator(std::shared_ptr<HttpRequestPool> pool) noexcept : pool_(std::move(pool)) {}
+
+    template <typename U>
+    HttpRequestPoolAllocator(const HttpRequestPoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+    T* allocate(std::size_t n) {
+        if (IsPooled(n)) return static_cast<T*>(pool_->Allocate());
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (IsPooled(n)) {
+            pool_->Deallocate(p);
+        } else {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const HttpRequestPoolAllocator<U>& other) const noexcept {
+        return pool_ == other.pool_;
+    }
+
+    template <typename U>
+    bool operator!=(const HttpRequestPoolAllocator<U>& other) const noexcept {
+        return pool_ != other.pool_;
+    }
+
+private:
+    template <typename U>
+    friend class HttpRequestPoolAllocator;
+
+    static constexpr bool IsPooled(std::size_t n) noexcept {
+        return n == 1 && sizeof(T) <= HttpRequestPool::kBlockSize && alignof(T) <= HttpRequestPool::kBlockAlignment;
+    }
+
+    std::shared_ptr<HttpRequestPool> pool_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#include <server/http/http_request_pool.hpp>
+
+#include <userver/server/http/http_request_builder.hpp>
+#include <userver/server/request/response_base.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::shared_ptr<server::http::HttpRequest> MakeRequest(
+    server::request::ResponseDataAccounter& accounter,
+    std::shared_ptr<server::http::impl::HttpRequestPool> pool
+) {
+    return server::http::HttpRequestBuilder{accounter, std::move(pool)}.SetUrl("/ping").Build();
+}
+
+}  // namespace
+
+UTEST(HttpRequestPool, ReusesMemory) {
+    server::request::ResponseDataAccounter accounter;
+    auto pool = std::make_shared<server::http::impl::HttpRequestPool>(1);
+
+    auto first = MakeRequest(accounter, pool);
+    auto second = MakeRequest(accounter, pool);
+    EXPECT_EQ(first->GetUrl(), "/ping");
+    const auto* first_address = first.get();
+    const auto* second_address = second.get();
+    EXPECT_NE(first_address, second_address);
+
+    // only one block is kept
+    first.reset();
+    second.reset();
+
+    auto third = MakeRequest(accounter, pool);
+    EXPECT_EQ(third.get(), first_address);
+    EXPECT_EQ(third->GetUrl(), "/ping");
+}
+
+UTEST(HttpRequestPool, OutlivesConnection) {
+    server::request::ResponseDataAccounter accounter;
+    auto pool = std::make_shared<server::http::impl::HttpRequestPool>(4);
+
+    auto request = MakeRequest(accounter, pool);
+    pool.reset();
+
+    auto other = request;
+    request.reset();
+    EXPECT_EQ(other->GetUrl(), "/ping");
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/server/http/http_response.hpp>
 
 #include <array>
+#include <utility>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
@@ -175,6 +176,11 @@ bool HttpResponse::SetStatus(HttpStatus status) {
         return false;
     }
 
+    if (shared_data_ && IsBodyForbiddenForStatus(status)) {
+        LOG_LIMITED_WARNING() << "Shared body provided for response with HTTP code " << static_cast<int>(status)
+                              << " which does not allow one, it will be dropped";
+        shared_data_.reset();
+    }
     status_ = status;
     return true;
 }
@@ -231,11 +237,32 @@ HttpResponse::CookiesMapKeys HttpResponse::GetCookieNames() const { return HttpR
 
 const Cookie& HttpResponse::GetCookie(std::string_view cookie_name) const { return cookies_.at(cookie_name.data()); }
 
+void HttpResponse::SetData(std::string data) {
+    if (!data.empty()) shared_data_.reset();
+    request::ResponseBase::SetData(std::move(data));
+}
+
+void HttpResponse::SetSharedData(std::shared_ptr<const std::string> data) {
+    UASSERT(data);
+    shared_data_ = std::move(data);
+}
+
+std::string_view HttpResponse::GetDataView() const {
+    const auto& data = GetData();
+    if (data.empty() && shared_data_) return *shared_data_;
+    return data;
+}
+
 void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
 void HttpResponse::SendResponse(engine::io::RwBase& socket) {
+    const auto sent_bytes = WriteResponse(socket);
+    SetSent(sent_bytes, std::chrono::steady_clock::now());
+}
+
+std::size_t HttpResponse::WriteResponse(engine::io::RwBase& socket) {
     utils::SmallString<USERVER_NAMESPACE::http::headers::kTypicalHeadersSize> header;
 
     header.resize_and_overwrite(USERVER_NAMESPACE::http::headers::kTypicalHeadersSize, [&](char* data, std::size_t) {
@@ -289,25 +316,26 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
 
     std::size_t sent_bytes{};
 
-    if (IsBodyStreamed() && GetData().empty()) {
+    if (IsBodyStreamed() && GetDataView().empty()) {
         sent_bytes = SetBodyStreamed(socket, header);
     } else {
         // e.g. a CustomHandlerException
         sent_bytes = SetBodyNotStreamed(socket, header);
     }
 
-    SetSent(sent_bytes, std::chrono::steady_clock::now());
+    return sent_bytes;
 }
 
 std::size_t
 HttpResponse::SetBodyNotStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::http::headers::HeadersString& header) {
     const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
     const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
-    const auto& data = GetData();
+
+    const std::string_view data = GetDataView();
 
     if (!is_body_forbidden) {
         impl::OutputHeader(
-            header, USERVER_NAMESPACE::http::headers::kContentLength, fmt::format(FMT_COMPILE("{}"), data.size())
+            header, USERVER_NAMESPACE::http::headers::kContentLength, fmt::format_int{data.size()}.c_str()
         );
     }
     header.append(kCrlf);
@@ -317,13 +345,14 @@ HttpResponse::SetBodyNotStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::
                               << " which does not allow one, it will be dropped";
     }
 
-    ssize_t sent_bytes = 0;
-    if (!is_head_request && !is_body_forbidden) {
-        sent_bytes = socket.WriteAll({{header.data(), header.size()}, {data.data(), data.size()}}, engine::Deadline{});
-    } else {
+    std::size_t sent_bytes = 0;
+    if (is_head_request || is_body_forbidden) {
         sent_bytes = socket.WriteAll(header.data(), header.size(), engine::Deadline{});
+    } else {
+        sent_bytes = socket.WriteAll({{header.data(), header.size()}, {data.data(), data.size()}}, engine::Deadline{});
     }
 
+    shared_data_.reset();
     return sent_bytes;
 }
 
@@ -356,8 +385,12 @@ HttpResponse::SetBodyStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::htt
             continue;
         }
 
-        auto size = first_chunk_processed ? fmt::format("\r\n{:x}\r\n", body_part.size())
-                                          : fmt::format("{:x}\r\n", body_part.size());
+        // CRLF + 16 hex digits + CRLF fit in the buffer, avoid a heap allocation
+        std::array<char, 24> size_buffer{};
+        const auto* size_end =
+            first_chunk_processed ? fmt::format_to(size_buffer.data(), FMT_COMPILE("\r\n{:x}\r\n"), body_part.size())
+                                  : fmt::format_to(size_buffer.data(), FMT_COMPILE("{:x}\r\n"), body_part.size());
+        const std::string_view size{size_buffer.data(), static_cast<std::size_t>(size_end - size_buffer.data())};
         sent_bytes +=
             socket.WriteAll({{size.data(), size.size()}, {body_part.data(), body_part.size()}}, engine::Deadline{});
 
@@ -374,6 +407,19 @@ HttpResponse::SetBodyStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::htt
     return sent_bytes;
 }
 
+std::shared_ptr<const std::string> HttpResponse::ExtractSharedData() {
+    if (!GetData().empty()) return {};
+    return std::move(shared_data_);
+}
+
+std::string HttpResponse::ExtractNotStreamedBody() {
+    std::string data = ExtractData();
+    if (data.empty() && shared_data_) data = *shared_data_;
+
+    shared_data_.reset();
+    return data;
+}
+
 void SetThrottleReason(http::HttpResponse& http_response, std::string log_reason, std::string http_header_reason) {
     http_response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaTaxiRatelimitedBy, kHostname);
     http_response.SetHeader(USERVER_NAMESPACE::http::headers::kXYaTaxiRatelimitReason, std::move(http_header_reason));
@@ -1,9 +1,18 @@
 #include <benchmark/benchmark.h>
 
 #include <fmt/compile.h>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <vector>
 
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/http/common_headers.hpp>
+#include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/small_string.hpp>
@@ -11,6 +20,8 @@
 #include <userver/server/http/http_request_builder.hpp>
 #include <userver/server/request/response_base.hpp>
 
+#include <server/net/pipelined_response_writer.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -135,11 +146,71 @@ void HttpResponseSetHeaderBenchmark(benchmark::State& state) {
     }
 }
 
+constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
+
+// Measures the time until a batch of pipelined responses reaches the peer
+template <bool Pipelined>
+void HttpResponseSendBenchmark(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const auto batch_size = static_cast<std::size_t>(state.range(0));
+        const std::string body(state.range(1), 'x');
+        const auto deadline = engine::Deadline::FromDuration(kDeadlineMaxTime);
+
+        auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(deadline);
+        std::atomic<std::size_t> received{0};
+        auto reader = engine::AsyncNoSpan([&received, &client = client, deadline] {
+            std::array<char, 16 * 1024> buf{};
+            while (const auto size = client.RecvSome(buf.data(), buf.size(), deadline)) received += size;
+        });
+
+        server::request::ResponseDataAccounter accounter{};
+        std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+        requests.reserve(batch_size);
+        std::string buffer;
+        std::size_t sent = 0;
+
+        for ([[maybe_unused]] auto _ : state) {
+            state.PauseTiming();
+            requests.clear();
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                auto request = server::http::HttpRequestBuilder{accounter}.Build();
+                request->GetHttpResponse().SetData(body);
+                for (const auto& [name, value] : kHeaders) request->GetHttpResponse().SetHeader(name, value);
+                requests.push_back(std::move(request));
+            }
+            state.ResumeTiming();
+
+            if (Pipelined) {
+                server::net::PipelinedResponseWriter writer{server, buffer};
+                for (const auto& request : requests) sent += request->GetHttpResponse().WriteResponse(writer);
+                writer.Flush();
+            } else {
+                for (const auto& request : requests) {
+                    auto& response = request->GetHttpResponse();
+                    response.SendResponse(server);
+                    sent += response.BytesSent();
+                }
+            }
+
+            while (received.load() < sent) engine::Yield();
+        }
+
+        server.Close();
+        reader.Get();
+    });
+}
+
+void http_response_send_direct(benchmark::State& state) { HttpResponseSendBenchmark<false>(state); }
+
+void http_response_send_pipelined(benchmark::State& state) { HttpResponseSendBenchmark<true>(state); }
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_inplace);
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
 BENCHMARK(HttpResponseSetHeaderBenchmark);
+BENCHMARK(http_response_send_direct)->ArgsProduct({{1, 4, 16}, {64, 4096}});
+BENCHMARK(http_response_send_pipelined)->ArgsProduct({{1, 4, 16}, {64, 4096}});
 
 USERVER_NAMESPACE_END
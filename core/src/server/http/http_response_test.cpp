@@ -104,6 +104,57 @@ UTEST_P(HttpResponseBody, ForbiddenBody) {
 
 INSTANTIATE_UTEST_SUITE_P(HttpResponseForbiddenBody, HttpResponseBody, testing::Values(100, 101, 150, 199, 304, 204));
 
+UTEST(HttpResponse, SharedData) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    server::request::ResponseDataAccounter accounter;
+    auto request = server::http::HttpRequestBuilder{accounter}.Build();
+    server::http::HttpResponse response{*request, accounter};
+
+    const auto body = std::make_shared<const std::string>("shared test data");
+    response.SetSharedData(body);
+    EXPECT_EQ(response.GetDataView(), *body);
+    EXPECT_TRUE(response.GetData().empty());
+
+    auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+    auto send_task = engine::AsyncNoSpan(
+        [](auto&& response, auto&& socket) { response.SendResponse(socket); }, std::ref(response), std::move(server)
+    );
+
+    std::string buffer(4096, '\0');
+    const auto reply_size = client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+    buffer.resize(reply_size);
+    send_task.Get();
+
+    const auto expected_content_length = fmt::format("\r\n{}: {}\r\n", http::headers::kContentLength, body->size());
+    EXPECT_THAT(buffer, testing::HasSubstr(expected_content_length));
+    EXPECT_THAT(buffer, testing::EndsWith(fmt::format("\r\n\r\n{}", *body)));
+    EXPECT_TRUE(response.IsSent());
+    EXPECT_EQ(response.BytesSent(), reply_size);
+}
+
+TEST(HttpResponse, SharedDataDroppedForForbiddenBody) {
+    server::request::ResponseDataAccounter accounter;
+    auto request = server::http::HttpRequestBuilder{accounter}.Build();
+    server::http::HttpResponse response{*request, accounter};
+
+    response.SetSharedData(std::make_shared<const std::string>("shared test data"));
+    response.SetStatus(server::http::HttpStatus::kOk);
+    EXPECT_EQ(response.GetDataView(), "shared test data");
+
+    response.SetStatus(server::http::HttpStatus::kNotFound);
+    EXPECT_EQ(response.GetDataView(), "shared test data");
+
+    response.SetStatus(server::http::HttpStatus::kNotModified);
+    EXPECT_TRUE(response.GetDataView().empty());
+
+    response.SetSharedData(std::make_shared<const std::string>("shared test data"));
+    response.SetData("error");
+    EXPECT_EQ(response.GetDataView(), "error");
+    response.SetData({});
+    EXPECT_TRUE(response.GetDataView().empty());
+}
+
 TEST(HttpResponse, GetHeaderDoesntThrow) {
     server::request::ResponseDataAccounter accounter{};
     auto request = server::http::HttpRequestBuilder{accounter}.Build();
@@ -1,11 +1,14 @@
 #include <server/middlewares/tracing.hpp>
 
+#include <chrono>
+
 #include <server/handlers/http_server_settings.hpp>
 #include <server/middlewares/misc.hpp>
 #include <server/request/internal_request_context.hpp>
 
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/task/current_task.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/server/handlers/handler_config.hpp>
@@ -26,6 +29,11 @@ namespace {
 const std::string kTracingTypeResponse = "response";
 const std::string kTracingBody = "body";
 const std::string kTracingUri = "uri";
+const std::string kTracingRunningTime = "running_time";
+const std::string kTracingQueueWaitTime = "queue_wait_time";
+const std::string kTracingContextSwitches = "context_switches";
+
+using RealMilliseconds = std::chrono::duration<double, std::milli>;
 
 std::string GetHeadersLogString(const http::HttpResponse& response) {
     formats::json::ValueBuilder json_headers(formats::json::Type::kObject);
@@ -141,10 +149,21 @@ void Tracing::EnrichLogs(
                 span.AddNonInheritableTag("response_headers", GetHeadersLogString(response));
             }
             span.AddNonInheritableTag(
-                kTracingBody, handler_.GetResponseDataForLoggingChecked(request, context, response.GetData())
+                kTracingBody, handler_.GetResponseDataForLoggingChecked(request, context, response)
             );
         }
         span.AddNonInheritableTag(kTracingUri, request.GetUrl());
+
+        // Accounted for the request task since the HandlerMetrics middleware
+        const auto execution_stats = engine::current_task::GetExecutionStats();
+        span.AddNonInheritableTag(
+            kTracingRunningTime, std::chrono::duration_cast<RealMilliseconds>(execution_stats.running_time).count()
+        );
+        span.AddNonInheritableTag(
+            kTracingQueueWaitTime,
+            std::chrono::duration_cast<RealMilliseconds>(execution_stats.queue_wait_time).count()
+        );
+        span.AddNonInheritableTag(kTracingContextSwitches, execution_stats.context_switches);
     } catch (const std::exception& ex) {
         LOG_ERROR() << "can't finalize request processing: " << ex;
     }
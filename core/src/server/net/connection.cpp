@@ -9,6 +9,7 @@
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/listener_config.hpp>
+#include <server/net/pipelined_response_writer.hpp>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
@@ -47,6 +48,9 @@ Connection::Connection(
       request_handler_(request_handler),
       stats_(std::move(stats)),
       data_accounter_(data_accounter),
+      request_pool_(
+          config.request_pool_size ? std::make_shared<http::impl::HttpRequestPool>(config.request_pool_size) : nullptr
+      ),
       remote_address_(remote_address),
       peer_name_(remote_address_.PrimaryAddressString()) {
     LOG_DEBUG() << "Incoming connection from " << Getpeername() << ", fd " << Fd();
@@ -55,6 +59,11 @@ Connection::Connection(
     ++stats_->connections_created;
 }
 
+Connection::~Connection() {
+    // Normally flushed at the end of processing, no I/O here
+    FinishBufferedResponses(/*is_sent=*/false);
+}
+
 void Connection::Process() {
     LOG_TRACE() << "Starting socket listener for fd " << Fd();
 
@@ -78,6 +87,7 @@ void Connection::Shutdown() noexcept {
                    "requests) for fd "
                 << Fd();
 
+    FlushBufferedResponses();
     peer_socket_.reset();
 
     --stats_->active_connections;
@@ -124,10 +134,7 @@ void Connection::ListenForRequests() noexcept {
             }
             pending_data_size_ = 0;
 
-            for (auto&& request : pending_requests_) {
-                ProcessRequest(std::move(request));
-            }
-            pending_requests_.resize(0);
+            ProcessPendingRequests();
             if (should_stop_accepting_requests) is_accepting_requests_ = false;
         }
 
@@ -203,17 +210,51 @@ bool Connection::WaitOnSocket(engine::Deadline deadline) {
     return true;
 }
 
-void Connection::ProcessRequest(std::shared_ptr<http::HttpRequest>&& request_ptr) {
+void Connection::ProcessPendingRequests() {
+    engine::TaskWithResult<void> task;
+    for (std::size_t i = 0; i < pending_requests_.size(); ++i) {
+        if (!task.IsValid()) task = StartRequest(pending_requests_[i]);
+        const HttpRequestPtr* next_request = i + 1 < pending_requests_.size() ? &pending_requests_[i + 1] : nullptr;
+        task = ProcessRequest(pending_requests_[i], task, next_request);
+    }
+
+    FlushBufferedResponses();
+    pending_requests_.clear();
+}
+
+bool Connection::CanStartNextRequest(const http::HttpRequest& request) const {
+    // The handler of a streamed response may still be running
+    return config_.http_version != USERVER_NAMESPACE::http::HttpVersion::k2 && !request.IsUpgradeWebsocket() &&
+           !request.GetHttpResponse().IsBodyStreamed();
+}
+
+engine::TaskWithResult<void> Connection::StartRequest(const HttpRequestPtr& request) noexcept {
+    stats_->active_request_count.Add(1);
+    return request_handler_.StartRequestTask(request);
+}
+
+engine::TaskWithResult<void> Connection::ProcessRequest(
+    const HttpRequestPtr& request_ptr,
+    engine::TaskWithResult<void>& task,
+    const HttpRequestPtr* next_request
+) {
     if (request_ptr->IsFinal()) {
         is_accepting_requests_ = false;
     }
 
-    stats_->active_request_count.Add(1);
+    HandleQueueItem(request_ptr, task);
 
-    auto task = HandleQueueItem(request_ptr);
-    SendResponse(*request_ptr);
+    // Handlers still run one at a time in the order of the requests, but the
+    // next one starts before this response is written. If it is ready by then,
+    // this response is kept in buffer and both are sent in a single syscall.
+    engine::TaskWithResult<void> next_task;
+    if (next_request && is_response_chain_valid_ && CanStartNextRequest(*request_ptr)) {
+        next_task = StartRequest(*next_request);
+    }
+    SendResponse(request_ptr, next_task.IsValid() && next_task.IsFinished());
 
     if (request_ptr->IsUpgradeWebsocket()) request_ptr->DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
+    return next_task;
 }
 
 bool Connection::ReadSome() {
@@ -239,18 +280,19 @@ bool Connection::ReadSome() {
     return true;
 }
 
-engine::TaskWithResult<void> Connection::HandleQueueItem(const std::shared_ptr<http::HttpRequest>& request) noexcept {
-    auto request_task = request_handler_.StartRequestTask(request);
-
+void Connection::HandleQueueItem(const HttpRequestPtr& request, engine::TaskWithResult<void>& request_task) noexcept {
     if (engine::current_task::IsCancelRequested()) {
         // We could've packed all remaining requests into a vector and cancel them
         // in parallel. But pipelining is almost never used so why bother.
         request_task.SyncCancel();
         LOG_DEBUG() << "Request processing interrupted";
         is_response_chain_valid_ = false;
-        return request_task;  // avoids throwing and catching exception down below
+        return;  // avoids throwing and catching exception down below
     }
 
+    // Do not delay the already ready responses while waiting for the handler
+    if (!request_task.IsFinished()) FlushBufferedResponses();
+
     try {
         auto& response = request->GetHttpResponse();
         if (response.IsBodyStreamed()) {
@@ -303,10 +345,10 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(const std::shared_ptr<h
         LOG_WARNING() << "Request failed with unhandled exception: " << e;
         request->MarkAsInternalServerError();
     }
-    return request_task;
 }
 
-void Connection::SendResponse(http::HttpRequest& request) {
+void Connection::SendResponse(const HttpRequestPtr& request_ptr, bool is_next_ready) {
+    auto& request = *request_ptr;
     auto& response = request.GetHttpResponse();
     UASSERT(!response.IsSent());
     request.SetStartSendResponseTime();
@@ -314,6 +356,7 @@ void Connection::SendResponse(http::HttpRequest& request) {
         try {
             // Might be a stream reading or a fully constructed response
             if (config_.http_version == USERVER_NAMESPACE::http::HttpVersion::k2) {
+                FlushBufferedResponses();
                 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
                 auto& http_response = static_cast<http::HttpResponse&>(response);
                 if (const auto& h = request.GetHeader(USERVER_NAMESPACE::http::headers::k2::kHttp2SettingsHeader);
@@ -337,7 +380,7 @@ void Connection::SendResponse(http::HttpRequest& request) {
                     http::WriteHttp2ResponseToSocket(http_response, *http2_session);
                     parser_ = std::move(parser);
                 } else if (request.GetHttpMajor() == 1) {
-                    response.SendResponse(*peer_socket_);
+                    if (!SendHttp1Response(request_ptr, is_next_ready)) return;
                 } else {
                     UASSERT(dynamic_cast<http::Http2Session*>(parser_.get()));
                     auto http2_session =
@@ -346,7 +389,7 @@ void Connection::SendResponse(http::HttpRequest& request) {
                     http::WriteHttp2ResponseToSocket(http_response, *http2_session);
                 }
             } else {
-                response.SendResponse(*peer_socket_);
+                if (!SendHttp1Response(request_ptr, is_next_ready)) return;
             }
         } catch (const engine::io::IoSystemError& ex) {
             // working with raw values because std::errc compares error_category
@@ -360,8 +403,47 @@ void Connection::SendResponse(http::HttpRequest& request) {
             response.SetSendFailed(std::chrono::steady_clock::now());
         }
     } else {
+        FlushBufferedResponses();
         response.SetSendFailed(std::chrono::steady_clock::now());
     }
+    FinishSendResponse(request);
+}
+
+bool Connection::SendHttp1Response(const HttpRequestPtr& request_ptr, bool is_next_ready) {
+    auto& response = request_ptr->GetHttpResponse();
+    if (response.IsBodyStreamed() || (!is_next_ready && buffered_responses_.empty())) {
+        // Streamed bodies go directly to the socket, the handler may still be
+        // producing the body
+        FlushBufferedResponses();
+        response.SendResponse(*peer_socket_);
+        return true;
+    }
+
+    // The next response is already ready: keep this one in buffer to send
+    // them in a single syscall. The response is marked as sent only after its
+    // data reaches the socket.
+    PipelinedResponseWriter writer{*peer_socket_, pipelined_buffer_};
+    std::size_t size = 0;
+    try {
+        size = response.WriteResponse(writer);
+        if (is_next_ready && !writer.HasWritten()) {
+            buffered_responses_.push_back({request_ptr, size});
+            return false;
+        }
+        writer.Flush();
+    } catch (const std::exception&) {
+        // The buffer may hold a part of this response, do not send it
+        pipelined_buffer_.clear();
+        FinishBufferedResponses(false);
+        throw;
+    }
+
+    FinishBufferedResponses(true);
+    response.SetSent(size, std::chrono::steady_clock::now());
+    return true;
+}
+
+void Connection::FinishSendResponse(http::HttpRequest& request) {
     request.SetFinishSendResponseTime();
     stats_->active_request_count.Subtract(1);
     stats_->requests_processed_count.Add(1);
@@ -369,6 +451,37 @@ void Connection::SendResponse(http::HttpRequest& request) {
     request.WriteAccessLogs(request_handler_.LoggerAccess(), request_handler_.LoggerAccessTskv(), peer_name_);
 }
 
+void Connection::FlushBufferedResponses() noexcept {
+    if (buffered_responses_.empty()) return;
+
+    bool is_sent = false;
+    if (peer_socket_) {
+        try {
+            PipelinedResponseWriter writer{*peer_socket_, pipelined_buffer_};
+            writer.Flush();
+            is_sent = true;
+        } catch (const std::exception& ex) {
+            LOG_WARNING() << "Error while sending pipelined responses to " << Getpeername() << ": " << ex;
+        }
+    }
+    pipelined_buffer_.clear();
+    FinishBufferedResponses(is_sent);
+}
+
+void Connection::FinishBufferedResponses(bool is_sent) noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& [request, size] : buffered_responses_) {
+        auto& response = request->GetHttpResponse();
+        if (is_sent) {
+            response.SetSent(size, now);
+        } else {
+            response.SetSendFailed(now);
+        }
+        FinishSendResponse(*request);
+    }
+    buffered_responses_.clear();
+}
+
 std::string Connection::Getpeername() const { return peer_name_; }
 
 std::unique_ptr<request::RequestParser> Connection::MakeParser(USERVER_NAMESPACE::http::HttpVersion ver) {
@@ -393,7 +506,9 @@ std::unique_ptr<request::RequestParser> Connection::MakeParser(USERVER_NAMESPACE
         on_req_cb,
         stats_->parser_stats,
         data_accounter_,
-        remote_address_
+        remote_address_,
+        config_.fast_http_parser,
+        request_pool_
     );
 }
 
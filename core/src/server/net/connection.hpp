@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
@@ -35,6 +36,8 @@ public:
         request::ResponseDataAccounter& data_accounter
     );
 
+    ~Connection();
+
     void Process();
 
     int Fd() const;
@@ -44,12 +47,30 @@ private:
 
     bool IsRequestTasksEmpty() const noexcept;
 
+    using HttpRequestPtr = std::shared_ptr<http::HttpRequest>;
+
     void ListenForRequests() noexcept;
-    void ProcessRequest(std::shared_ptr<http::HttpRequest>&& request_ptr);
+    void ProcessPendingRequests();
+    bool CanStartNextRequest(const http::HttpRequest& request) const;
+    engine::TaskWithResult<void> StartRequest(const HttpRequestPtr& request) noexcept;
+    // Returns the task of the next request if it was started
+    engine::TaskWithResult<void> ProcessRequest(
+        const HttpRequestPtr& request_ptr,
+        engine::TaskWithResult<void>& task,
+        const HttpRequestPtr* next_request
+    );
     bool WaitOnSocket(engine::Deadline deadline);
 
-    engine::TaskWithResult<void> HandleQueueItem(const std::shared_ptr<http::HttpRequest>& request) noexcept;
-    void SendResponse(http::HttpRequest& request);
+    void HandleQueueItem(const HttpRequestPtr& request, engine::TaskWithResult<void>& request_task) noexcept;
+    void SendResponse(const HttpRequestPtr& request_ptr, bool is_next_ready);
+    // Returns false if the response was kept in buffer to be sent later
+    bool SendHttp1Response(const HttpRequestPtr& request_ptr, bool is_next_ready);
+    void FinishSendResponse(http::HttpRequest& request);
+
+    // Sends the coalesced responses, marks them as sent or failed and writes
+    // their access logs
+    void FlushBufferedResponses() noexcept;
+    void FinishBufferedResponses(bool is_sent) noexcept;
 
     std::string Getpeername() const;
 
@@ -63,12 +84,22 @@ private:
     const http::RequestHandlerBase& request_handler_;
     const std::shared_ptr<Stats> stats_;
     request::ResponseDataAccounter& data_accounter_;
+    // Memory of the finished HTTP/1.1 requests for the next ones, may be null
+    const std::shared_ptr<http::impl::HttpRequestPool> request_pool_;
     std::unique_ptr<request::RequestParser> parser_{nullptr};
     bool is_http2_parser_{false};
 
-    using HttpRequestPtr = std::shared_ptr<http::HttpRequest>;
     std::vector<HttpRequestPtr> pending_requests_;
 
+    // Ready pipelined HTTP/1.1 responses that were written into
+    // pipelined_buffer_, but have not reached the socket yet
+    struct BufferedResponse {
+        HttpRequestPtr request;
+        std::size_t size{0};
+    };
+    std::string pipelined_buffer_;
+    std::vector<BufferedResponse> buffered_responses_;
+
     engine::io::Sockaddr remote_address_;
     std::string peer_name_;
 
@@ -30,6 +30,9 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<
 
     config.http2_session_config = value["http2-session"].As<Http2SessionConfig>(config.http2_session_config);
 
+    config.fast_http_parser = value["fast_http_parser"].As<bool>(config.fast_http_parser);
+    config.request_pool_size = value["request_pool_size"].As<size_t>(config.request_pool_size);
+
     return config;
 }
 
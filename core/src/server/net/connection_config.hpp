@@ -31,6 +31,8 @@ struct ConnectionConfig {
     std::chrono::milliseconds abort_check_delay{kDefaultAbortCheckDelay};
     USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11;
     Http2SessionConfig http2_session_config;
+    bool fast_http_parser = false;
+    size_t request_pool_size = 0;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ConnectionConfig>);
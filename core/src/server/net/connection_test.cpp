@@ -7,6 +7,7 @@
 #include <server/net/create_socket.hpp>
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/server/http/http_request.hpp>
 
@@ -59,6 +60,51 @@ private:
     server::http::HandlerInfoIndex handler_info_index_;
 };
 
+// Holds the handler of the second request until released
+class PipelinedHttpRequestHandler final : public server::http::RequestHandlerBase {
+public:
+    engine::TaskWithResult<void> StartRequestTask(std::shared_ptr<server::http::HttpRequest> http_request
+    ) const override {
+        UASSERT(http_request);
+        const auto index = requests_started++;
+        return engine::AsyncNoSpan([this, index] {
+            const auto running = ++requests_running;
+            if (running > max_requests_running) max_requests_running = running;
+            if (index == 1) {
+                [[maybe_unused]] const auto released = release_event.WaitForEvent();
+            }
+            engine::SleepFor(std::chrono::milliseconds{1});
+            --requests_running;
+        });
+    }
+
+    const server::http::HandlerInfoIndex& GetHandlerInfoIndex() const override { return handler_info_index_; }
+
+    const logging::TextLoggerPtr& LoggerAccess() const noexcept override { return no_logger_; };
+    const logging::TextLoggerPtr& LoggerAccessTskv() const noexcept override { return no_logger_; };
+
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    mutable std::atomic<std::size_t> requests_started{0};
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    mutable std::atomic<std::size_t> requests_running{0};
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    mutable std::atomic<std::size_t> max_requests_running{0};
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    mutable engine::SingleConsumerEvent release_event;
+
+private:
+    logging::TextLoggerPtr no_logger_;
+    server::http::HandlerInfoIndex handler_info_index_;
+};
+
+std::size_t CountResponses(std::string_view data) {
+    std::size_t result = 0;
+    for (auto pos = data.find("HTTP/1.1 "); pos != std::string_view::npos; pos = data.find("HTTP/1.1 ", pos + 1)) {
+        ++result;
+    }
+    return result;
+}
+
 std::string HttpConnectionUriFromSocket(engine::io::Socket& sock) {
     return fmt::format("http://localhost:{}", sock.Getsockname().Port());
 }
@@ -300,6 +346,116 @@ UTEST_P(ServerNetConnection, KeepAlive) {
     EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+UTEST(ServerNetConnectionPipelining, ResponseIsNotDelayed) {
+    net::ListenerConfig config = CreateConfig();
+    auto request_socket = net::CreateSocket(config, config.ports[0]);
+
+    auto addr = engine::io::Sockaddr::MakeLoopbackAddress();
+    addr.SetPort(request_socket.Getsockname().Port());
+    engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+    client.Connect(addr, Deadline::FromDuration(kAcceptTimeout));
+
+    auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+    ASSERT_TRUE(peer.IsValid());
+    auto stats = std::make_shared<net::Stats>();
+    server::request::ResponseDataAccounter data_accounter;
+    PipelinedHttpRequestHandler handler;
+
+    auto task = engine::AsyncNoSpan([&] {
+        net::Connection connection(
+            config.connection_config,
+            config.handler_defaults,
+            std::make_unique<engine::io::Socket>(std::move(peer)),
+            {},
+            handler,
+            stats,
+            data_accounter
+        );
+
+        connection.Process();
+    });
+
+    constexpr std::string_view kRequests =
+        "GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"
+        "GET /second HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    const auto deadline = Deadline::FromDuration(kAcceptTimeout);
+    ASSERT_EQ(client.SendAll(kRequests.data(), kRequests.size(), deadline), kRequests.size());
+
+    // The first response must not wait for the handler of the second request
+    std::string received(4096, '\0');
+    const auto size = client.RecvSome(received.data(), received.size(), deadline);
+    ASSERT_GT(size, 0);
+    EXPECT_EQ(CountResponses(std::string_view{received.data(), size}), 1);
+
+    handler.release_event.Send();
+    std::string rest(4096, '\0');
+    const auto rest_size = client.RecvSome(rest.data(), rest.size(), deadline);
+    ASSERT_GT(rest_size, 0);
+    EXPECT_EQ(CountResponses(std::string_view{rest.data(), rest_size}), 1);
+    EXPECT_EQ(handler.requests_started, 2);
+    EXPECT_EQ(handler.max_requests_running, 1);
+
+    client.Close();
+    task.WaitFor(utest::kMaxTestWaitTime);
+    EXPECT_TRUE(task.IsFinished());
+}
+
+UTEST(ServerNetConnectionPipelining, HandlersRunOneAtATime) {
+    net::ListenerConfig config = CreateConfig();
+    auto request_socket = net::CreateSocket(config, config.ports[0]);
+
+    auto addr = engine::io::Sockaddr::MakeLoopbackAddress();
+    addr.SetPort(request_socket.Getsockname().Port());
+    engine::io::Socket client{addr.Domain(), engine::io::SocketType::kStream};
+    client.Connect(addr, Deadline::FromDuration(kAcceptTimeout));
+
+    auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+    ASSERT_TRUE(peer.IsValid());
+    auto stats = std::make_shared<net::Stats>();
+    server::request::ResponseDataAccounter data_accounter;
+    PipelinedHttpRequestHandler handler;
+    handler.release_event.Send();
+
+    auto task = engine::AsyncNoSpan([&] {
+        net::Connection connection(
+            config.connection_config,
+            config.handler_defaults,
+            std::make_unique<engine::io::Socket>(std::move(peer)),
+            {},
+            handler,
+            stats,
+            data_accounter
+        );
+
+        connection.Process();
+    });
+
+    constexpr std::size_t kRequestsCount = 3;
+    constexpr std::string_view kRequests =
+        "GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"
+        "GET /second HTTP/1.1\r\nHost: localhost\r\n\r\n"
+        "GET /third HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    const auto deadline = Deadline::FromDuration(kAcceptTimeout);
+    ASSERT_EQ(client.SendAll(kRequests.data(), kRequests.size(), deadline), kRequests.size());
+
+    std::string received;
+    while (CountResponses(received) < kRequestsCount) {
+        std::string buffer(4096, '\0');
+        const auto size = client.RecvSome(buffer.data(), buffer.size(), deadline);
+        ASSERT_GT(size, 0);
+        received.append(buffer.data(), size);
+    }
+    EXPECT_EQ(CountResponses(received), kRequestsCount);
+
+    // Pipelined requests are handled in order, without overlapping handlers
+    EXPECT_EQ(handler.requests_started, kRequestsCount);
+    EXPECT_EQ(handler.max_requests_running, 1);
+
+    client.Close();
+    task.WaitFor(utest::kMaxTestWaitTime);
+    EXPECT_TRUE(task.IsFinished());
+}
+
 UTEST_P(ServerNetConnection, CancelMultipleInFlight) {
     constexpr std::size_t kInFlightRequests = 10;
     constexpr std::size_t kMaxAttempts = 10;
@@ -1,15 +1,27 @@
 #include "create_socket.hpp"
 
+#include <cstdint>
+#include <iterator>
 #include <string>
 
+#ifdef __linux__
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif
+
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <boost/filesystem/operations.hpp>
 
+#include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/net/blocking/get_addr_info.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -71,6 +83,31 @@ engine::io::Socket CreateSocket(const ListenerConfig& config, const PortConfig&
         return CreateUnixSocket(port_config.unix_socket_path, config.backlog);
 }
 
+void AttachReuseportCpuSteering(engine::io::Socket& socket, std::size_t shards) {
+    UASSERT(shards > 0);
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    // A = cpu; A %= shards; return A
+    sock_filter code[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<std::uint32_t>(shards)},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    sock_fprog program{};
+    program.len = std::size(code);
+    program.filter = code;
+
+    utils::CheckSyscallCustomException<engine::io::IoSystemError>(
+        ::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)),
+        "attaching reuseport CPU steering program, fd={}, shards={}",
+        socket.Fd(),
+        shards
+    );
+#else
+    LOG_WARNING() << "Reuseport CPU steering is not supported on this platform";
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include <server/net/listener_config.hpp>
 #include <userver/engine/io/socket.hpp>
 
@@ -9,6 +11,20 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config, const PortConfig& port_config);
 
+/// Attaches a reuseport program to the SO_REUSEPORT group of `socket` that
+/// passes a new connection to the socket with index `cpu % shards` in the
+/// group, where `cpu` is the CPU that handled the incoming packet. Must only
+/// be used for TCP sockets.
+///
+/// The kernel indexes the sockets of a group in the order they start to
+/// listen, so the index matches the shard only if the shards create their
+/// sockets one after another and the group has no other sockets. A closed
+/// socket is replaced by the last one in the group, and the sockets of another
+/// process of the same user on the same port join the group. The connections
+/// are steered to the wrong shards then, but they are not lost.
+/// Only logs a warning on platforms without SO_ATTACH_REUSEPORT_CBPF.
+void AttachReuseportCpuSteering(engine::io::Socket& socket, std::size_t shards);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
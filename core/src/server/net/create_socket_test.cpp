@@ -0,0 +1,114 @@
+#include <server/net/create_socket.hpp>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+#if defined(__linux__) && defined(SO_INCOMING_CPU)
+
+namespace {
+
+constexpr std::size_t kShards = 2;
+constexpr std::size_t kMaxCheckedCpus = 4;
+
+std::vector<int> GetAllowedCpus() {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (::sched_getaffinity(0, sizeof(cpus), &cpus) != 0) return {};
+
+    std::vector<int> result;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpus)) result.push_back(cpu);
+    }
+    return result;
+}
+
+// Returns the connected socket or -1, the client is pinned to `cpu` to make
+// the connections come from different CPUs
+int ConnectFromCpu(int cpu, const engine::io::Sockaddr& addr) {
+    int result = -1;
+    std::thread([&] {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if (::sched_setaffinity(0, sizeof(cpus), &cpus) != 0) return;
+
+        const int fd = ::socket(static_cast<int>(addr.Domain()), SOCK_STREAM, 0);
+        if (fd == -1) return;
+        if (::connect(fd, addr.Data(), addr.Size()) != 0) {
+            ::close(fd);
+            return;
+        }
+        result = fd;
+    }).join();
+    return result;
+}
+
+}  // namespace
+
+UTEST(CreateSocket, ReuseportCpuSteering) {
+    const server::net::ListenerConfig config;
+    server::net::PortConfig port_config;
+    port_config.address = "::1";
+
+    // Shards create their sockets one after another, the same way
+    std::vector<engine::io::Socket> shards;
+    shards.push_back(server::net::CreateSocket(config, port_config));
+    port_config.port = shards.front().Getsockname().Port();
+    for (std::size_t i = 1; i < kShards; ++i) {
+        shards.push_back(server::net::CreateSocket(config, port_config));
+    }
+
+    try {
+        server::net::AttachReuseportCpuSteering(shards.front(), kShards);
+    } catch (const engine::io::IoSystemError& ex) {
+        GTEST_SKIP() << "Reuseport programs are not supported: " << ex.what();
+    }
+
+    const auto addr = shards.front().Getsockname();
+    auto cpus = GetAllowedCpus();
+    if (cpus.size() > kMaxCheckedCpus) cpus.resize(kMaxCheckedCpus);
+    ASSERT_FALSE(cpus.empty());
+
+    for (const auto cpu : cpus) {
+        SCOPED_TRACE(testing::Message() << "cpu=" << cpu);
+        const int client = ConnectFromCpu(cpu, addr);
+        ASSERT_NE(client, -1);
+
+        std::size_t accepted_count = 0;
+        for (std::size_t i = 0; i < kShards; ++i) {
+            try {
+                auto peer = shards[i].Accept(engine::Deadline::FromDuration(std::chrono::milliseconds{10}));
+                ++accepted_count;
+
+                // The kernel does not guarantee that a loopback connection is
+                // handled by the CPU that sends it, so the shard is checked
+                // against the CPU that actually handled it. The index of a
+                // socket in the reuseport group is the order of its creation.
+                const auto incoming_cpu = peer.GetOption(SOL_SOCKET, SO_INCOMING_CPU);
+                EXPECT_GE(incoming_cpu, 0);
+                EXPECT_EQ(static_cast<std::size_t>(incoming_cpu) % kShards, i);
+            } catch (const engine::io::IoTimeout&) {
+            }
+        }
+        EXPECT_EQ(accepted_count, 1);
+        ::close(client);
+    }
+}
+
+#endif
+
+USERVER_NAMESPACE_END
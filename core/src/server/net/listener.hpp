@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -17,7 +18,8 @@ public:
     Listener(
         std::shared_ptr<EndpointInfo> endpoint_info,
         engine::TaskProcessor& task_processor,
-        request::ResponseDataAccounter& data_accounter
+        request::ResponseDataAccounter& data_accounter,
+        std::size_t shards
     );
     ~Listener();
 
@@ -34,6 +36,7 @@ private:
     engine::TaskProcessor* task_processor_;
     std::shared_ptr<EndpointInfo> endpoint_info_;
     request::ResponseDataAccounter* data_accounter_;
+    std::size_t shards_;
 
     std::unique_ptr<ListenerImpl> impl_;
 };
@@ -27,13 +27,23 @@ namespace server::net {
 ListenerImpl::ListenerImpl(
     engine::TaskProcessor& task_processor,
     std::shared_ptr<EndpointInfo> endpoint_info,
-    request::ResponseDataAccounter& data_accounter
+    request::ResponseDataAccounter& data_accounter,
+    std::size_t shards
 )
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
       data_accounter_(data_accounter) {
-    for (const auto& port : endpoint_info_->listener_config.ports) {
+    const auto& listener_config = endpoint_info_->listener_config;
+    for (const auto& port : listener_config.ports) {
+        auto socket = CreateSocket(listener_config, port);
+        if (listener_config.reuseport_cpu_steering && port.unix_socket_path.empty()) {
+            // PortInfo::Start starts the shards one after another, so the
+            // group index of a socket matches the shard index, see
+            // AttachReuseportCpuSteering for the cases when it does not.
+            AttachReuseportCpuSteering(socket, shards);
+        }
+
         socket_listener_tasks.push_back(engine::CriticalAsyncNoSpan(
             task_processor_,
             [this](engine::io::Socket&& request_socket) {
@@ -51,7 +61,7 @@ ListenerImpl::ListenerImpl(
                     }
                 }
             },
-            CreateSocket(endpoint_info_->listener_config, port)
+            std::move(socket)
         ));
     }
 }
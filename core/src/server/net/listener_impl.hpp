@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include <userver/concurrent/background_task_storage.hpp>
@@ -20,7 +21,8 @@ public:
     ListenerImpl(
         engine::TaskProcessor& task_processor,
         std::shared_ptr<EndpointInfo> endpoint_info,
-        request::ResponseDataAccounter& data_accounter
+        request::ResponseDataAccounter& data_accounter,
+        std::size_t shards
     );
     ~ListenerImpl();
 
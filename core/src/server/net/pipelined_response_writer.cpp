@@ -0,0 +1,110 @@
+#include <server/net/pipelined_response_writer.hpp>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/socket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+// Bigger writes are sent right away together with the buffered data
+constexpr std::size_t kMaxBufferedWriteSize = 16 * 1024;
+constexpr std::size_t kFlushThreshold = 64 * 1024;
+
+// Do not keep the memory of an occasional huge batch for the whole connection
+constexpr std::size_t kMaxRetainedCapacity = 256 * 1024;
+
+}  // namespace
+
+PipelinedResponseWriter::PipelinedResponseWriter(engine::io::RwBase& socket, std::string& buffer)
+    : socket_(socket), buffer_(buffer) {}
+
+PipelinedResponseWriter::~PipelinedResponseWriter() = default;
+
+void PipelinedResponseWriter::Flush() {
+    if (buffer_.empty()) return;
+
+    const auto size = buffer_.size();
+    has_written_ = true;
+    const auto sent = socket_.WriteAll(buffer_.data(), size, {});
+    ClearBuffer();
+
+    if (sent != size) {
+        throw engine::io::IoException() << "Connection was closed by peer while sending pipelined responses";
+    }
+}
+
+bool PipelinedResponseWriter::IsValid() const { return socket_.IsValid(); }
+
+bool PipelinedResponseWriter::WaitReadable(engine::Deadline deadline) { return socket_.WaitReadable(deadline); }
+
+size_t PipelinedResponseWriter::ReadSome(void* buf, size_t len, engine::Deadline deadline) {
+    return socket_.ReadSome(buf, len, deadline);
+}
+
+size_t PipelinedResponseWriter::ReadAll(void* buf, size_t len, engine::Deadline deadline) {
+    return socket_.ReadAll(buf, len, deadline);
+}
+
+bool PipelinedResponseWriter::WaitWriteable(engine::Deadline deadline) { return socket_.WaitWriteable(deadline); }
+
+size_t PipelinedResponseWriter::WriteAll(const void* buf, size_t len, engine::Deadline deadline) {
+    return WriteAll({{buf, len}}, deadline);
+}
+
+size_t PipelinedResponseWriter::WriteAll(std::initializer_list<engine::io::IoData> list, engine::Deadline deadline) {
+    if (has_written_) return socket_.WriteAll(list, deadline);
+
+    std::size_t total_size = 0;
+    for (const auto& io_data : list) total_size += io_data.len;
+
+    if (CanBuffer(total_size)) {
+        for (const auto& io_data : list) buffer_.append(static_cast<const char*>(io_data.data), io_data.len);
+        return total_size;
+    }
+
+    has_written_ = true;
+    if (buffer_.empty()) return socket_.WriteAll(list, deadline);
+    return SendWithBuffered(list, deadline);
+}
+
+bool PipelinedResponseWriter::CanBuffer(std::size_t len) const noexcept {
+    return len <= kMaxBufferedWriteSize && buffer_.size() + len <= kFlushThreshold;
+}
+
+void PipelinedResponseWriter::ClearBuffer() noexcept {
+    buffer_.clear();
+    if (buffer_.capacity() > kMaxRetainedCapacity) buffer_.shrink_to_fit();
+}
+
+std::size_t
+PipelinedResponseWriter::SendWithBuffered(std::initializer_list<engine::io::IoData> list, engine::Deadline deadline) {
+    const auto buffered_size = buffer_.size();
+
+    std::size_t sent = 0;
+    if (auto* socket = dynamic_cast<engine::io::Socket*>(&socket_)) {
+        boost::container::small_vector<engine::io::IoData, 4> io_data;
+        io_data.push_back({buffer_.data(), buffer_.size()});
+        io_data.insert(io_data.end(), list.begin(), list.end());
+        sent = socket->SendAll(io_data.data(), io_data.size(), deadline);
+    } else {
+        // Wrappers (e.g. TLS) copy the data anyway, so copy it once and do a
+        // single write
+        for (const auto& io_data : list) buffer_.append(static_cast<const char*>(io_data.data), io_data.len);
+        sent = socket_.WriteAll(buffer_.data(), buffer_.size(), deadline);
+    }
+    ClearBuffer();
+
+    if (sent < buffered_size) {
+        throw engine::io::IoException() << "Connection was closed by peer while sending pipelined responses";
+    }
+    return sent - buffered_size;
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
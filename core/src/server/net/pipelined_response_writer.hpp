@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <userver/engine/io/common.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// @brief Stream adapter that coalesces writes of pipelined HTTP/1.1
+/// responses into a single vectored write.
+///
+/// Writes are appended to the connection's reusable buffer. A write that does
+/// not fit is sent together with the buffered data in a single syscall, and
+/// all the following writes go directly to the socket. The adapter is
+/// short-lived, it does not outlive a single response, so it never refers to
+/// a socket that was moved out of the connection.
+class PipelinedResponseWriter final : public engine::io::RwBase {
+public:
+    PipelinedResponseWriter(engine::io::RwBase& socket, std::string& buffer);
+    ~PipelinedResponseWriter() override;
+
+    /// Sends the buffered data, if any
+    void Flush();
+
+    /// Whether anything was written to the socket, the buffer is empty then
+    bool HasWritten() const noexcept { return has_written_; }
+
+    bool IsValid() const override;
+    [[nodiscard]] bool WaitReadable(engine::Deadline deadline) override;
+    [[nodiscard]] size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override;
+    [[nodiscard]] size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override;
+
+    [[nodiscard]] bool WaitWriteable(engine::Deadline deadline) override;
+    [[nodiscard]] size_t WriteAll(const void* buf, size_t len, engine::Deadline deadline) override;
+    [[nodiscard]] size_t WriteAll(std::initializer_list<engine::io::IoData> list, engine::Deadline deadline) override;
+
+private:
+    bool CanBuffer(std::size_t len) const noexcept;
+    void ClearBuffer() noexcept;
+
+    // Sends the buffered data followed by `list`, returns the count of bytes
+    // sent from `list`
+    std::size_t SendWithBuffered(std::initializer_list<engine::io::IoData> list, engine::Deadline deadline);
+
+    engine::io::RwBase& socket_;
+    std::string& buffer_;
+    bool has_written_{false};
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
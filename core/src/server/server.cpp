@@ -63,11 +63,11 @@ void PortInfo::Init(
     endpoint_info_ = std::make_shared<net::EndpointInfo>(listener_config, *request_handler_);
 
     const auto& event_thread_pool = task_processor.EventThreadPool();
-    size_t listener_shards = listener_config.shards ? *listener_config.shards : event_thread_pool.GetSize();
+    const size_t listener_shards = listener_config.shards ? *listener_config.shards : event_thread_pool.GetSize();
 
     listeners_.reserve(listener_shards);
-    while (listener_shards--) {
-        listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_);
+    for (size_t i = 0; i < listener_shards; ++i) {
+        listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_, listener_shards);
     }
 }
 
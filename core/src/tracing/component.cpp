@@ -5,6 +5,8 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <tracing/tail_sampling.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -18,6 +20,7 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
     auto opentracing_logger = logging_component.GetLoggerOptional("opentracing");
     auto service_name = config["service-name"].As<std::string>({});
     const auto tracer_type = config["tracer"].As<std::string>(kNativeTrace);
+    const auto tail_sampling = config["tail-sampling"].As<tracing::impl::TailSamplingConfig>({});
     if (tracer_type == kNativeTrace) {
         if (service_name.empty() && opentracing_logger) {
             throw std::runtime_error(
@@ -32,6 +35,11 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
             LOG_INFO() << "Opentracing logger is not registered";
         }
 
+        if (tail_sampling.enabled) {
+            LOG_INFO() << "Tail sampling of traces enabled.";
+        }
+        tracing::impl::SetTailSamplingConfig(tail_sampling);
+
         tracing::Tracer::SetTracer(
             tracing::MakeTracer(std::move(service_name), std::move(opentracing_logger), tracer_type)
         );
@@ -54,6 +62,34 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    tail-sampling:
+        type: object
+        description: |
+            buffer the spans of a trace until its local root span finishes and
+            write them out only if the trace is interesting
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: enable the tail sampling
+                defaultDescription: false
+            latency-threshold:
+                type: string
+                description: keep the traces with the local root span at least that long, 0 disables the check
+                defaultDescription: 0ms
+            keep-errors:
+                type: boolean
+                description: keep the traces with a span marked with the 'error' tag
+                defaultDescription: true
+            random-fraction:
+                type: number
+                description: fraction of the rest of the traces to keep, from 0 to 1
+                defaultDescription: 0
+            max-spans-per-trace:
+                type: integer
+                description: max count of spans to buffer per trace, the rest of the spans are dropped
+                defaultDescription: 1000
+                minimum: 1
 )");
 }
 
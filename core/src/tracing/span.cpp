@@ -1,12 +1,18 @@
 #include <tracing/span_impl.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <variant>
+
+#include <boost/container/static_vector.hpp>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
@@ -14,7 +20,6 @@
 #include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 
@@ -60,16 +65,47 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
-std::string GenerateSpanId() {
-    std::uniform_int_distribution<std::uint64_t> dist;
-    const auto random_value = utils::WithDefaultRandom(dist);
+struct alignas(Span::Impl) ImplStorage final {
+    std::byte data[sizeof(Span::Impl)];
+};
+
+// A request usually has a few nested spans alive at a time. Having more cache
+// entries keeps the spans of concurrent tasks on the same thread cheap.
+constexpr std::size_t kMaxPooledImpls = 32;
+
+using ImplStoragePool = boost::container::static_vector<std::unique_ptr<ImplStorage>, kMaxPooledImpls>;
 
-    static_assert(sizeof(random_value) == 8);
-    return utils::encoding::ToHex(&random_value, 8);
+compiler::ThreadLocal local_impl_storage_pool = [] { return ImplStoragePool{}; };
+
+impl::SpanId GenerateSpanId() {
+    std::uniform_int_distribution<std::uint64_t> dist;
+    return impl::SpanId{utils::WithDefaultRandom(dist)};
 }
 
 }  // namespace
 
+void* Span::Impl::operator new(std::size_t size) {
+    UASSERT(size == sizeof(ImplStorage));
+    auto pool = local_impl_storage_pool.Use();
+    if (pool->empty()) {
+        return new ImplStorage;
+    }
+
+    auto* storage = pool->back().release();
+    pool->pop_back();
+    return storage;
+}
+
+// NOTE: the storage might be returned on a different thread than the one
+// it has been taken on
+void Span::Impl::operator delete(void* ptr) noexcept {
+    std::unique_ptr<ImplStorage> storage{static_cast<ImplStorage*>(ptr)};
+    auto pool = local_impl_storage_pool.Use();
+    if (pool->size() < pool->capacity()) {
+        pool->push_back(std::move(storage));
+    }
+}
+
 Span::Impl::Impl(
     std::string name,
     ReferenceType reference_type,
@@ -97,6 +133,8 @@ Span::Impl::Impl(
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
+      trace_buffer_(parent ? parent->trace_buffer_ : impl::TraceBuffer::MakeIfEnabled()),
+      is_local_root_(!parent),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
       trace_id_(parent ? parent->GetTraceId() : utils::generators::GenerateUuid()),
@@ -111,6 +149,11 @@ Span::Impl::Impl(
 }
 
 Span::Impl::~Impl() {
+    if (trace_buffer_) {
+        LogIntoTraceBuffer();
+        return;
+    }
+
     if (!ShouldLog()) {
         return;
     }
@@ -122,21 +165,47 @@ Span::Impl::~Impl() {
     }
 }
 
+void Span::Impl::LogIntoTraceBuffer() {
+    const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+
+    const bool is_error = HasErrorFlag();
+    if (!ShouldLog()) {
+        if (is_error) {
+            trace_buffer_->MarkError();
+        }
+    } else if (trace_buffer_->StartSpan(is_error, is_local_root_)) {
+        const impl::DetachLocalSpansScope ignore_local_span;
+        impl::TraceBufferLogger logger{*trace_buffer_, nullptr};
+        logging::LogHelper lh{logger, log_level_, logging::LogClass::kTrace, source_location_};
+        std::move(*this).PutIntoLogger(lh.GetTagWriter());
+    }
+
+    // The spans that finish after the local root are written out or dropped
+    // right away
+    if (is_local_root_) {
+        trace_buffer_->Finish(duration);
+    }
+}
+
+bool Span::Impl::HasErrorFlag() const {
+    const auto is_set = [](const logging::LogExtra& extra) {
+        return std::visit(
+            [](const auto& value) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+                    return value == "true" || value == "1";
+                } else {
+                    return value != 0;
+                }
+            },
+            extra.GetValue(kErrorFlag)
+        );
+    };
+    return is_set(log_extra_inheritable_) || (log_extra_local_ && is_set(*log_extra_local_));
+}
+
 void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
     const auto steady_now = std::chrono::steady_clock::now();
     const auto duration = steady_now - start_steady_time_;
-    const auto total_time_ms = std::chrono::duration_cast<RealMilliseconds>(duration).count();
-    const auto timestamp_buffer = StartTsToString(start_system_time_);
-    const auto ref_type = GetReferenceType() == ReferenceType::kChild ? kReferenceTypeChild : kReferenceTypeFollows;
-
-    tracer_->LogSpanContextTo(*this, writer);
-    writer.PutTag(kStopWatchTag, name_);
-    writer.PutTag(kTotalTimeTag, total_time_ms);
-    writer.PutTag(kReferenceType, ref_type);
-    writer.PutTag(kTimeUnitsTag, "ms");
-    writer.PutTag(kStartTimestampTag, timestamp_buffer.ToStringView());
-
-    time_storage_.MergeInto(writer);
 
     if (log_extra_local_) {
         // TODO apparently, same tags can be added both to log_extra_inheritable_
@@ -146,7 +215,37 @@ void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
     if (log_extra_inheritable_.GetValue(tracing::kSpanKind) == logging::LogExtra::Value{}) {
         log_extra_inheritable_.Extend(tracing::kSpanKind, tracing::kSpanKindInternal);
     }
-    writer.PutLogExtra(log_extra_inheritable_);
+
+    // Loggers that export spans in a structured form (e.g. OTLP) take the span
+    // as is, without formatting and parsing back its tags
+    const bool is_span_consumed = writer.PutSpan({
+        GetTraceId(),
+        GetSpanId(),
+        GetParentId(),
+        name_,
+        start_system_time_,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration),
+        log_extra_inheritable_,
+        time_storage_.GetDurations(),
+    });
+
+    if (!is_span_consumed) {
+        const auto total_time_ms = std::chrono::duration_cast<RealMilliseconds>(duration).count();
+        const auto timestamp_buffer = StartTsToString(start_system_time_);
+        const auto ref_type =
+            GetReferenceType() == ReferenceType::kChild ? kReferenceTypeChild : kReferenceTypeFollows;
+
+        tracer_->LogSpanContextTo(*this, writer);
+        writer.PutTag(kStopWatchTag, name_);
+        writer.PutTag(kTotalTimeTag, total_time_ms);
+        writer.PutTag(kReferenceType, ref_type);
+        writer.PutTag(kTimeUnitsTag, "ms");
+        writer.PutTag(kStartTimestampTag, timestamp_buffer.ToStringView());
+
+        time_storage_.MergeInto(writer);
+
+        writer.PutLogExtra(log_extra_inheritable_);
+    }
 
     LogOpenTracing();
 }
@@ -163,11 +262,11 @@ void Span::Impl::AttachToCoroStack() {
     task_local_spans->push_back(*this);
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::SpanId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
     if (!parent) return {};
 
     if (!parent->is_linked()) {
-        return parent->GetSpanId();
+        return parent->span_id_;
     }
 
     const auto* spans_ptr = task_local_spans.GetOptional();
@@ -180,8 +279,8 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
     // orphaned. It's still possible for chaining to break in case parent span
     // becomes non-loggable after child span is created, but that we can't control
     for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-        if (current->GetParentId().empty() /* won't find better candidate */ || current->ShouldLog()) {
-            return current->GetSpanId();
+        if (!current->HasParentId() /* won't find better candidate */ || current->ShouldLog()) {
+            return current->span_id_;
         }
         if (current == spans_ptr->begin()) break;
     }
@@ -248,7 +347,7 @@ Span::Span(
           Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}
       ) {
     AttachToCoroStack();
-    if (pimpl_->GetParentId().empty()) {
+    if (!pimpl_->HasParentId()) {
         SetLink(utils::generators::GenerateUuid());
     }
     pimpl_->span_ = this;
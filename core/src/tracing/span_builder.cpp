@@ -22,7 +22,7 @@ SpanBuilder::SpanBuilder(std::string name, const utils::impl::SourceLocation& lo
           Span::OptionalDeleter{Span::OptionalDeleter::ShouldDelete()}
       ) {
     pimpl_->AttachToCoroStack();
-    if (pimpl_->GetParentId().empty()) {
+    if (!pimpl_->HasParentId()) {
         AddTagFrozen(kLinkTag, utils::generators::GenerateUuid());
     }
 }
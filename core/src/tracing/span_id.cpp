@@ -0,0 +1,65 @@
+#include <tracing/span_id.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/encoding/hex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+SpanId::SpanId(const SpanId& other) : value_(other.value_) {
+    const auto state = other.WaitRendered();
+    if (state == State::kString) {
+        string_ = other.string_;
+    }
+    state_.store(state, std::memory_order_relaxed);
+}
+
+SpanId::SpanId(SpanId&& other) noexcept
+    : value_(other.value_),
+      state_(other.state_.load(std::memory_order_acquire)),
+      string_(std::move(other.string_)) {
+    UASSERT(state_.load(std::memory_order_relaxed) != State::kRendering);
+}
+
+SpanId& SpanId::operator=(SpanId&& other) noexcept {
+    UASSERT(other.state_.load(std::memory_order_relaxed) != State::kRendering);
+    value_ = other.value_;
+    state_.store(other.state_.load(std::memory_order_acquire), std::memory_order_relaxed);
+    string_ = std::move(other.string_);
+    return *this;
+}
+
+const std::string& SpanId::Get() const {
+    auto state = state_.load(std::memory_order_acquire);
+    if (state == State::kNumber && state_.compare_exchange_strong(state, State::kRendering)) {
+        string_ = utils::encoding::ToHexString(value_);
+        state_.store(State::kString, std::memory_order_release);
+        return string_;
+    }
+
+    WaitRendered();
+    return string_;
+}
+
+std::string SpanId::Release() && {
+    Get();
+    return std::move(string_);
+}
+
+bool SpanId::IsEmpty() const noexcept {
+    return state_.load(std::memory_order_acquire) == State::kString && string_.empty();
+}
+
+SpanId::State SpanId::WaitRendered() const noexcept {
+    auto state = state_.load(std::memory_order_acquire);
+    // Rendering takes a few dozen nanoseconds, there is no point in sleeping
+    while (state == State::kRendering) {
+        state = state_.load(std::memory_order_acquire);
+    }
+    return state;
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Span id that is kept as a number until its string form is needed,
+/// e.g. when the span is logged or its id is sent to another service.
+///
+/// The ids that come from other services are kept as strings. The string form
+/// is rendered once and may be requested from multiple threads concurrently.
+class SpanId final {
+public:
+    SpanId() noexcept = default;
+
+    explicit SpanId(std::uint64_t value) noexcept : value_(value), state_(State::kNumber) {}
+
+    explicit SpanId(std::string&& value) noexcept : string_(std::move(value)) {}
+
+    SpanId(const SpanId& other);
+    SpanId(SpanId&& other) noexcept;
+    SpanId& operator=(SpanId&& other) noexcept;
+    SpanId& operator=(const SpanId&) = delete;
+
+    /// 16 hex digits for the numeric ids
+    const std::string& Get() const;
+
+    std::string Release() &&;
+
+    bool IsEmpty() const noexcept;
+
+private:
+    enum class State : std::uint8_t {
+        kString,
+        kNumber,
+        kRendering,
+    };
+
+    State WaitRendered() const noexcept;
+
+    std::uint64_t value_{0};
+    mutable std::atomic<State> state_{State::kString};
+    mutable std::string string_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -18,6 +19,8 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/impl/source_location.hpp>
 
+#include <tracing/span_id.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <tracing/time_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -49,6 +52,10 @@ public:
 
     ~Impl();
 
+    // The storage is reused by the spans created on the same thread
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr) noexcept;
+
     impl::TimeStorage& GetTimeStorage() { return time_storage_; }
     const impl::TimeStorage& GetTimeStorage() const { return time_storage_; }
 
@@ -59,16 +66,18 @@ public:
     void LogTo(logging::impl::TagWriter writer);
 
     const std::string& GetTraceId() const& noexcept { return trace_id_; }
-    const std::string& GetSpanId() const& noexcept { return span_id_; }
-    const std::string& GetParentId() const& noexcept { return parent_id_; }
+    const std::string& GetSpanId() const& { return span_id_.Get(); }
+    const std::string& GetParentId() const& { return parent_id_.Get(); }
 
     std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-    std::string GetSpanId() && noexcept { return std::move(span_id_); }
-    std::string GetParentId() && noexcept { return std::move(parent_id_); }
+    std::string GetSpanId() && { return std::move(span_id_).Release(); }
+    std::string GetParentId() && { return std::move(parent_id_).Release(); }
 
     void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-    void SetSpanId(std::string&& id) noexcept { span_id_ = std::move(id); }
-    void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+    void SetSpanId(std::string&& id) noexcept { span_id_ = impl::SpanId{std::move(id)}; }
+    void SetParentId(std::string&& id) noexcept { parent_id_ = impl::SpanId{std::move(id)}; }
+
+    bool HasParentId() const noexcept { return !parent_id_.IsEmpty(); }
 
     ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
@@ -76,11 +85,14 @@ public:
     void AttachToCoroStack();
 
 private:
+    void LogIntoTraceBuffer();
+    bool HasErrorFlag() const;
+
     void LogOpenTracing() const;
     void DoLogOpenTracing(logging::impl::TagWriter writer) const;
     static void AddOpentracingTags(formats::json::StringBuilder& output, const logging::LogExtra& input);
 
-    static std::string GetParentIdForLogging(const Span::Impl* parent);
+    static impl::SpanId GetParentIdForLogging(const Span::Impl* parent);
     bool ShouldLog() const;
 
     const std::string name_;
@@ -91,6 +103,10 @@ private:
     std::shared_ptr<Tracer> tracer_;
     logging::LogExtra log_extra_inheritable_;
 
+    // Set if the tail sampling is enabled, shared by all the spans of the trace
+    std::shared_ptr<impl::TraceBuffer> trace_buffer_;
+    const bool is_local_root_;
+
     Span* span_{nullptr};
 
     std::optional<logging::LogExtra> log_extra_local_;
@@ -100,8 +116,8 @@ private:
     const std::chrono::steady_clock::time_point start_steady_time_;
 
     std::string trace_id_;
-    std::string span_id_;
-    std::string parent_id_;
+    impl::SpanId span_id_;
+    impl::SpanId parent_id_;
     const ReferenceType reference_type_;
     utils::impl::SourceLocation source_location_;
 
@@ -89,8 +89,14 @@ void Span::Impl::LogOpenTracing() const {
     auto logger = tracer_->GetOptionalLogger();
     if (logger) {
         const impl::DetachLocalSpansScope ignore_local_span;
-        logging::LogHelper lh(*logger, log_level_, logging::LogClass::kTrace);
-        DoLogOpenTracing(lh.GetTagWriter());
+        if (trace_buffer_) {
+            impl::TraceBufferLogger buffer_logger{*trace_buffer_, std::move(logger)};
+            logging::LogHelper lh(buffer_logger, log_level_, logging::LogClass::kTrace);
+            DoLogOpenTracing(lh.GetTagWriter());
+        } else {
+            logging::LogHelper lh(*logger, log_level_, logging::LogClass::kTrace);
+            DoLogOpenTracing(lh.GetTagWriter());
+        }
     }
 }
 
@@ -105,8 +111,8 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
         writer.PutTag(jaeger::kServiceName, tracer_->GetServiceName());
     }
     writer.PutTag(jaeger::kTraceId, trace_id_);
-    writer.PutTag(jaeger::kParentId, parent_id_);
-    writer.PutTag(jaeger::kSpanId, span_id_);
+    writer.PutTag(jaeger::kParentId, parent_id_.Get());
+    writer.PutTag(jaeger::kSpanId, span_id_.Get());
     writer.PutTag(jaeger::kStartTime, start_time);
     writer.PutTag(jaeger::kStartTimeMillis, start_time / 1000);
     writer.PutTag(jaeger::kDuration, duration_microseconds);
@@ -4,6 +4,7 @@
 #include <logging/log_helper_impl.hpp>
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/opentelemetry.hpp>
@@ -674,6 +675,29 @@ UTEST_F(Span, SetLogLevelDoesntBreakGenealogyMultiSkip) {
     }
 }
 
+UTEST_F(Span, SpanIds) {
+    auto root_span = tracing::Span::MakeRootSpan("root_span");
+    EXPECT_EQ(root_span.GetSpanId().size(), 16);
+    EXPECT_TRUE(utils::regex_match(root_span.GetSpanId(), utils::regex{"[0-9a-f]{16}"})) << root_span.GetSpanId();
+
+    auto child_span = root_span.CreateChild("child");
+    EXPECT_EQ(child_span.GetParentId(), root_span.GetSpanId());
+    EXPECT_NE(child_span.GetSpanId(), root_span.GetSpanId());
+}
+
+UTEST_F_MT(Span, SpanIdsConcurrently, 4) {
+    for (int i = 0; i < 100; ++i) {
+        auto span = tracing::Span::MakeRootSpan("span");
+        std::vector<engine::TaskWithResult<std::string>> tasks;
+        for (int j = 0; j < 4; ++j) {
+            tasks.push_back(engine::AsyncNoSpan([&span] { return span.GetSpanId(); }));
+        }
+        for (auto& task : tasks) {
+            EXPECT_EQ(task.Get(), span.GetSpanId());
+        }
+    }
+}
+
 UTEST_F(Span, MakeSpanWithParentIdTraceIdLink) {
     std::string trace_id = "1234567890-trace-id";
     std::string parent_id = "1234567890-parent-id";
@@ -0,0 +1,189 @@
+#include <tracing/tail_sampling.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <logging/impl/formatters/deferred.hpp>
+#include <userver/logging/impl/tag_writer.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+struct RecordHeader final {
+    std::uint8_t logger_index;
+    std::uint32_t size;
+};
+
+auto& GlobalTailSamplingConfig() {
+    static rcu::Variable<TailSamplingConfig> config{};
+    return config;
+}
+
+logging::impl::LoggerBase& GetLogger(const logging::LoggerPtr& logger) {
+    return logger ? *logger : logging::GetDefaultLogger();
+}
+
+// Called from the span destructors, must not throw
+void WriteOut(const logging::LoggerPtr& logger, std::string_view record) noexcept {
+    try {
+        logging::impl::formatters::DispatchDeferred(record, logging::LogClass::kTrace, GetLogger(logger));
+    } catch (const std::exception& e) {
+        UASSERT_MSG(false, e.what());
+    }
+}
+
+}  // namespace
+
+TailSamplingConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<TailSamplingConfig>) {
+    TailSamplingConfig config;
+    config.enabled = value["enabled"].As<bool>(config.enabled);
+    config.latency_threshold = value["latency-threshold"].As<std::chrono::milliseconds>(config.latency_threshold);
+    config.keep_errors = value["keep-errors"].As<bool>(config.keep_errors);
+    config.random_fraction = value["random-fraction"].As<double>(config.random_fraction);
+    config.max_spans_per_trace = value["max-spans-per-trace"].As<std::size_t>(config.max_spans_per_trace);
+
+    if (config.random_fraction < 0.0 || config.random_fraction > 1.0) {
+        throw std::runtime_error(
+            "Invalid 'random-fraction' value of tail sampling, expected a value in [0, 1] at " + value.GetPath()
+        );
+    }
+    return config;
+}
+
+void SetTailSamplingConfig(const TailSamplingConfig& config) { GlobalTailSamplingConfig().Assign(config); }
+
+std::shared_ptr<TraceBuffer> TraceBuffer::MakeIfEnabled() {
+    const auto config = GlobalTailSamplingConfig().Read();
+    if (!config->enabled) {
+        return nullptr;
+    }
+    return std::make_shared<TraceBuffer>(*config);
+}
+
+TraceBuffer::TraceBuffer(const TailSamplingConfig& config) : config_(config) {}
+
+TraceBuffer::~TraceBuffer() = default;
+
+bool TraceBuffer::StartSpan(bool is_error, bool is_local_root) {
+    const auto decision = GetDecision();
+    if (decision != Decision::kPending) {
+        return decision == Decision::kKeep;
+    }
+
+    const std::lock_guard lock{mutex_};
+    has_error_ = has_error_ || is_error;
+    if (spans_count_ >= config_.max_spans_per_trace && !is_local_root) {
+        return false;
+    }
+    ++spans_count_;
+    return true;
+}
+
+void TraceBuffer::MarkError() {
+    const std::lock_guard lock{mutex_};
+    has_error_ = true;
+}
+
+void TraceBuffer::Push(const logging::LoggerPtr& logger, std::string_view record) {
+    {
+        const std::lock_guard lock{mutex_};
+        if (GetDecision() == Decision::kPending) {
+            std::size_t index = 0;
+            while (index < loggers_.size() && loggers_[index] != logger) {
+                ++index;
+            }
+            if (index == loggers_.size()) {
+                UASSERT(index <= UINT8_MAX);
+                loggers_.push_back(logger);
+            }
+
+            const RecordHeader header{static_cast<std::uint8_t>(index), static_cast<std::uint32_t>(record.size())};
+            records_.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            records_.append(record);
+            return;
+        }
+    }
+
+    if (GetDecision() == Decision::kKeep) {
+        WriteOut(logger, record);
+    }
+}
+
+void TraceBuffer::Finish(std::chrono::steady_clock::duration root_duration) {
+    const bool keep = ShouldKeep(root_duration);
+
+    std::string records;
+    decltype(loggers_) loggers;
+    {
+        const std::lock_guard lock{mutex_};
+        UASSERT_MSG(GetDecision() == Decision::kPending, "The trace is finished twice");
+        decision_.store(keep ? Decision::kKeep : Decision::kDrop, std::memory_order_release);
+        records.swap(records_);
+        loggers.swap(loggers_);
+    }
+
+    if (!keep) {
+        return;
+    }
+
+    std::string_view data{records};
+    while (!data.empty()) {
+        RecordHeader header{};
+        std::memcpy(&header, data.data(), sizeof(header));
+        data.remove_prefix(sizeof(header));
+        WriteOut(loggers[header.logger_index], data.substr(0, header.size));
+        data.remove_prefix(header.size);
+    }
+}
+
+bool TraceBuffer::ShouldKeep(std::chrono::steady_clock::duration root_duration) const {
+    {
+        const std::lock_guard lock{mutex_};
+        if (config_.keep_errors && has_error_) {
+            return true;
+        }
+    }
+    if (config_.latency_threshold.count() > 0 && root_duration >= config_.latency_threshold) {
+        return true;
+    }
+    return config_.random_fraction > 0.0 && utils::RandRange(1.0) < config_.random_fraction;
+}
+
+TraceBufferLogger::TraceBufferLogger(TraceBuffer& buffer, logging::LoggerPtr logger)
+    : buffer_(buffer), logger_(std::move(logger)) {
+    SetLevel(logging::Level::kTrace);
+    EnableDeferredFormatting();
+}
+
+void TraceBufferLogger::PrependCommonTags(logging::impl::TagWriter writer) const {
+    GetLogger(logger_).PrependCommonTags(writer);
+}
+
+void TraceBufferLogger::Log(logging::Level, logging::impl::formatters::LoggerItemRef item) {
+    UASSERT(dynamic_cast<logging::impl::TextLogItem*>(&item));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    const auto& record = static_cast<const logging::impl::TextLogItem&>(item).log_line;
+    buffer_.Push(logger_, {record.data(), record.size()});
+}
+
+logging::impl::formatters::BasePtr TraceBufferLogger::MakeFormatter(
+    logging::Level level,
+    logging::LogClass,
+    const utils::impl::SourceLocation& location
+) {
+    return std::make_unique<logging::impl::formatters::Deferred>(level, location, std::chrono::system_clock::now());
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/logging/fwd.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+struct TailSamplingConfig final {
+    bool enabled{false};
+
+    // the traces with the local root span at least that long are kept,
+    // zero disables the check
+    std::chrono::milliseconds latency_threshold{0};
+
+    // the traces with a span tagged with tracing::kErrorFlag are kept
+    bool keep_errors{true};
+
+    // fraction of the rest of the traces that are kept
+    double random_fraction{0.0};
+
+    // the spans above the limit are dropped even if the trace is kept
+    std::size_t max_spans_per_trace{1000};
+};
+
+TailSamplingConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<TailSamplingConfig>);
+
+void SetTailSamplingConfig(const TailSamplingConfig& config);
+
+/// @brief Holds the records of the finished spans of a trace until the local
+/// root span of the trace finishes, then writes them out or drops them.
+///
+/// The records are captured by logging::impl::formatters::Deferred and are
+/// stored one after another in a single per-trace buffer.
+class TraceBuffer final {
+public:
+    enum class Decision {
+        kPending,
+        kKeep,
+        kDrop,
+    };
+
+    /// Returns nullptr if the tail sampling is disabled
+    static std::shared_ptr<TraceBuffer> MakeIfEnabled();
+
+    explicit TraceBuffer(const TailSamplingConfig& config);
+
+    TraceBuffer(TraceBuffer&&) = delete;
+    TraceBuffer& operator=(TraceBuffer&&) = delete;
+    ~TraceBuffer();
+
+    Decision GetDecision() const noexcept { return decision_.load(std::memory_order_acquire); }
+
+    /// Must be called for a finished span before its records are captured.
+    /// Returns false if the span should be dropped. The local root span is
+    /// not dropped because of the spans limit.
+    bool StartSpan(bool is_error, bool is_local_root);
+
+    /// Must be called for a finished span that is not logged and has the
+    /// tracing::kErrorFlag, the trace is kept because of it as well.
+    void MarkError();
+
+    /// Stores a record captured by formatters::Deferred or writes it out right
+    /// away if the trace is kept already. `logger` is nullptr for the default
+    /// logger.
+    void Push(const logging::LoggerPtr& logger, std::string_view record);
+
+    /// Decides whether the trace is kept, then writes out or drops the records.
+    /// Must be called once, by the local root span.
+    void Finish(std::chrono::steady_clock::duration root_duration);
+
+private:
+    bool ShouldKeep(std::chrono::steady_clock::duration root_duration) const;
+
+    const TailSamplingConfig config_;
+    std::atomic<Decision> decision_{Decision::kPending};
+
+    mutable std::mutex mutex_;
+    bool has_error_{false};
+    std::size_t spans_count_{0};
+    // Loggers the records are written to, nullptr is the default logger
+    boost::container::small_vector<logging::LoggerPtr, 2> loggers_;
+    // [logger index: u8][record size: u32][record]...
+    std::string records_;
+};
+
+/// Logger that captures the records of a finished span into a TraceBuffer
+class TraceBufferLogger final : public logging::impl::LoggerBase {
+public:
+    /// `logger` is the one the records are written to, nullptr for the
+    /// default logger
+    TraceBufferLogger(TraceBuffer& buffer, logging::LoggerPtr logger);
+
+    void PrependCommonTags(logging::impl::TagWriter writer) const override;
+
+    void Log(logging::Level level, logging::impl::formatters::LoggerItemRef item) override;
+
+    logging::impl::formatters::BasePtr
+    MakeFormatter(logging::Level level, logging::LogClass log_class, const utils::impl::SourceLocation& location)
+        override;
+
+private:
+    TraceBuffer& buffer_;
+    const logging::LoggerPtr logger_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
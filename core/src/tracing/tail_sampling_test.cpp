@@ -0,0 +1,180 @@
+#include <gmock/gmock.h>
+
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <logging/logging_test.hpp>
+#include <tracing/tail_sampling.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utest/utest.hpp>
+
+using testing::HasSubstr;
+using testing::Not;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+tracing::impl::TailSamplingConfig MakeConfig() {
+    tracing::impl::TailSamplingConfig config;
+    config.enabled = true;
+    config.latency_threshold = std::chrono::hours{1};
+    return config;
+}
+
+}  // namespace
+
+class TailSampling : public LoggingTest {
+protected:
+    ~TailSampling() override { tracing::impl::SetTailSamplingConfig({}); }
+
+    std::size_t GetSpansCount() {
+        logging::LogFlush();
+        const auto logs = GetStreamString();
+        std::size_t count = 0;
+        for (auto pos = logs.find("stopwatch_name="); pos != std::string::npos;
+             pos = logs.find("stopwatch_name=", pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+};
+
+UTEST_F(TailSampling, DropsFastTraces) {
+    tracing::impl::SetTailSamplingConfig(MakeConfig());
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        auto child = root.CreateChild("child");
+    }
+    EXPECT_EQ(GetSpansCount(), 0);
+}
+
+UTEST_F(TailSampling, KeepsSlowTraces) {
+    auto config = MakeConfig();
+    config.latency_threshold = std::chrono::milliseconds{1};
+    tracing::impl::SetTailSamplingConfig(config);
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        { auto child = root.CreateChild("child"); }
+        EXPECT_EQ(GetSpansCount(), 0);
+        engine::SleepFor(std::chrono::milliseconds{5});
+    }
+
+    EXPECT_EQ(GetSpansCount(), 2);
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=child"));
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=root"));
+}
+
+UTEST_F(TailSampling, KeepsErrors) {
+    tracing::impl::SetTailSamplingConfig(MakeConfig());
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        auto child = root.CreateChild("child");
+        child.AddNonInheritableTag(tracing::kErrorFlag, true);
+    }
+    EXPECT_EQ(GetSpansCount(), 2);
+
+    auto config = MakeConfig();
+    config.keep_errors = false;
+    tracing::impl::SetTailSamplingConfig(config);
+    ClearLog();
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        root.AddTag(tracing::kErrorFlag, true);
+    }
+    EXPECT_EQ(GetSpansCount(), 0);
+}
+
+UTEST_F(TailSampling, KeepsErrorsOfNotLoggedRoot) {
+    tracing::impl::SetTailSamplingConfig(MakeConfig());
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        root.SetLogLevel(logging::Level::kTrace);
+        { auto child = root.CreateChild("child"); }
+        root.AddNonInheritableTag(tracing::kErrorFlag, true);
+    }
+    EXPECT_EQ(GetSpansCount(), 1);
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=child"));
+}
+
+UTEST_F(TailSampling, RecordsKeepFinishTime) {
+    auto config = MakeConfig();
+    config.latency_threshold = std::chrono::milliseconds{1};
+    tracing::impl::SetTailSamplingConfig(config);
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        { auto child = root.CreateChild("child"); }
+        engine::SleepFor(std::chrono::milliseconds{100});
+    }
+    ASSERT_EQ(GetSpansCount(), 2);
+
+    const auto logs = GetStreamString();
+    // Seconds since the start of the day of the span record
+    const auto get_time = [&logs](std::string_view name) {
+        const auto record = logs.find(fmt::format("stopwatch_name={}", name));
+        const auto line_begin = logs.rfind('\n', record);
+        const auto timestamp = logs.find("timestamp=", line_begin == std::string::npos ? 0 : line_begin);
+        const auto time = logs.substr(logs.find('T', timestamp) + 1, 15);
+        return std::stoi(time.substr(0, 2)) * 3600 + std::stoi(time.substr(3, 2)) * 60 + std::stod(time.substr(6));
+    };
+    EXPECT_GE(get_time("root") - get_time("child"), 0.05);
+}
+
+UTEST_F(TailSampling, RandomFraction) {
+    auto config = MakeConfig();
+    config.random_fraction = 1.0;
+    tracing::impl::SetTailSamplingConfig(config);
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        auto child = root.CreateChild("child");
+    }
+    EXPECT_EQ(GetSpansCount(), 2);
+}
+
+UTEST_F(TailSampling, MaxSpansPerTrace) {
+    auto config = MakeConfig();
+    config.random_fraction = 1.0;
+    config.max_spans_per_trace = 2;
+    tracing::impl::SetTailSamplingConfig(config);
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        for (int i = 0; i < 3; ++i) {
+            auto child = root.CreateChild("child");
+        }
+    }
+    EXPECT_EQ(GetSpansCount(), 3);
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=root"));
+}
+
+UTEST_F(TailSampling, SpansFinishedAfterRoot) {
+    auto config = MakeConfig();
+    config.random_fraction = 1.0;
+    tracing::impl::SetTailSamplingConfig(config);
+
+    std::optional<tracing::Span> root = tracing::Span::MakeRootSpan("root");
+    auto late = root->CreateChild("late");
+    root.reset();
+    EXPECT_EQ(GetSpansCount(), 1);
+
+    { auto after_decision = late.CreateChild("after_decision"); }
+    EXPECT_THAT(GetStreamString(), HasSubstr("stopwatch_name=after_decision"));
+}
+
+UTEST_F(TailSampling, LevelsAreRespected) {
+    auto config = MakeConfig();
+    config.random_fraction = 1.0;
+    tracing::impl::SetTailSamplingConfig(config);
+    {
+        auto root = tracing::Span::MakeRootSpan("root");
+        auto child = root.CreateChild("child");
+        child.SetLogLevel(logging::Level::kTrace);
+    }
+    EXPECT_EQ(GetSpansCount(), 1);
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("stopwatch_name=child")));
+}
+
+USERVER_NAMESPACE_END
@@ -30,6 +30,9 @@ public:
     /// Accumulated time for a certain key. If the key is not there, returns 0
     Duration DurationTotal(const std::string& key) const;
 
+    /// Accumulated times of all the keys
+    const std::unordered_map<std::string, Duration>& GetDurations() const noexcept { return data_; }
+
     void MergeInto(logging::impl::TagWriter writer);
 
 private:
@@ -32,6 +32,31 @@ void tracing_happy_log(benchmark::State& state) {
 }
 BENCHMARK(tracing_happy_log);
 
+void tracing_child_ctr(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        auto tracer = tracing::MakeTracer("test_service", {});
+        auto root = tracer->CreateSpanWithoutParent("root");
+        root.AddTag("http.url", "http://example.com/example");
+
+        for ([[maybe_unused]] auto _ : state) benchmark::DoNotOptimize(root.CreateChild("child"));
+    });
+}
+BENCHMARK(tracing_child_ctr);
+
+void tracing_child_ctr_with_ids(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        auto tracer = tracing::MakeTracer("test_service", {});
+        auto root = tracer->CreateSpanWithoutParent("root");
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto child = root.CreateChild("child");
+            benchmark::DoNotOptimize(child.GetSpanId());
+            benchmark::DoNotOptimize(child.GetParentId());
+        }
+    });
+}
+BENCHMARK(tracing_child_ctr_with_ids);
+
 tracing::Span GetSpanWithOpentracingHttpTags(tracing::TracerPtr tracer) {
     auto span = tracer->CreateSpanWithoutParent("name");
     span.AddTag("meta_code", 200);
@@ -0,0 +1,351 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <sys/time.h>
+#include <cerrno>
+#include <csignal>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/stacktrace/frame.hpp>
+#include <boost/stacktrace/safe_dump_to.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::cpu_profiler {
+
+namespace {
+
+using FramePtr = boost::stacktrace::frame::native_frame_ptr_t;
+
+constexpr std::size_t kMaxDepth = 64;
+constexpr std::size_t kMaxTagSize = 64;
+// Enough for ~80 busy CPUs at 100 samples per second between Collect calls
+constexpr std::size_t kCapacity = 8192;
+// The signal handler itself and the signal trampoline
+constexpr std::size_t kSkippedFrames = 2;
+
+struct Sample final {
+    std::atomic<std::uint64_t> sequence{0};
+    std::uint32_t tag_size{0};
+    std::uint32_t depth{0};
+    std::array<char, kMaxTagSize> tag{};
+    std::array<FramePtr, kMaxDepth> frames{};
+};
+
+// Bounded MPSC queue of samples: the writers are signal handlers, so it must
+// be lock-free and must not allocate. A slot is free for the position `pos`
+// when its sequence is `pos`, and holds a sample when its sequence is `pos+1`.
+class SampleRing final {
+public:
+    SampleRing() {
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            samples_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Sample* TryAcquire() noexcept {
+        auto pos = write_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& sample = samples_[pos % kCapacity];
+            const auto sequence = sample.sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (write_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return &sample;
+                }
+            } else if (sequence < pos) {
+                return nullptr;
+            } else {
+                pos = write_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void Publish(Sample& sample) noexcept {
+        sample.sequence.store(sample.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Must not be called concurrently with itself
+    template <typename Consumer>
+    void ConsumeAll(Consumer& consumer) {
+        while (true) {
+            auto& sample = samples_[read_pos_ % kCapacity];
+            if (sample.sequence.load(std::memory_order_acquire) != read_pos_ + 1) {
+                return;
+            }
+            consumer(sample);
+            sample.sequence.store(read_pos_ + kCapacity, std::memory_order_release);
+            ++read_pos_;
+        }
+    }
+
+private:
+    std::array<Sample, kCapacity> samples_;
+    std::atomic<std::uint64_t> write_pos_{0};
+    std::uint64_t read_pos_{0};
+};
+
+std::atomic<bool> is_running{false};
+// Intentionally leaked, as a late signal may still use it at exit
+std::atomic<SampleRing*> sample_ring{nullptr};
+std::atomic<std::uint64_t> samples_count{0};
+std::atomic<std::uint64_t> dropped_count{0};
+std::atomic<std::uint64_t> skipped_count{0};
+
+thread_local volatile std::sig_atomic_t is_context_switch_in_progress{0};
+
+struct State final {
+    engine::Mutex mutex;
+    // The SIGPROF disposition before Start, restored on Stop
+    struct sigaction previous_action {};
+    // The key is the tag, '\0' and the raw frame pointers
+    std::unordered_map<std::string, std::uint64_t> stacks;
+};
+
+State& GetState() {
+    static State state;
+    return state;
+}
+
+std::size_t WriteTag(std::array<char, kMaxTagSize>& tag) noexcept {
+    if (auto* context = engine::current_task::GetCurrentTaskContextUnchecked()) {
+        const auto* task_tag = context->GetCpuProfilerTag();
+        const std::string& name = task_tag ? *task_tag : context->GetTaskProcessor().Name();
+        const auto size = std::min(name.size(), tag.size());
+        std::memcpy(tag.data(), name.data(), size);
+        return size;
+    }
+
+#ifdef __linux__
+    // PR_GET_NAME writes up to 16 bytes, it is async-signal-safe unlike
+    // pthread_getname_np
+    static_assert(kMaxTagSize >= 16);
+    if (::prctl(PR_GET_NAME, tag.data(), 0, 0, 0) == 0) {
+        return ::strnlen(tag.data(), 16);
+    }
+#endif
+    return 0;
+}
+
+void ProfilerSignalHandler(int, siginfo_t*, void*) noexcept {
+    const auto saved_errno = errno;
+    auto* ring = sample_ring.load(std::memory_order_acquire);
+    if (ring && is_running.load(std::memory_order_relaxed)) {
+        if (is_context_switch_in_progress) {
+            skipped_count.fetch_add(1, std::memory_order_relaxed);
+        } else if (auto* sample = ring->TryAcquire()) {
+            auto depth = boost::stacktrace::safe_dump_to(kSkippedFrames, sample->frames.data(), sizeof(sample->frames));
+            // The depth includes the terminating null frame
+            while (depth > 0 && !sample->frames[depth - 1]) --depth;
+            sample->depth = static_cast<std::uint32_t>(depth);
+            sample->tag_size = static_cast<std::uint32_t>(WriteTag(sample->tag));
+            SampleRing::Publish(*sample);
+            samples_count.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    errno = saved_errno;
+}
+
+std::error_code MakeErrnoCode() { return {errno, std::system_category()}; }
+
+std::error_code SetTimer(std::uint32_t frequency) {
+    ::itimerval timer{};
+    if (frequency != 0) {
+        timer.it_interval.tv_usec = std::max(1'000'000 / frequency, 1U);
+        timer.it_value = timer.it_interval;
+    }
+    if (::setitimer(ITIMER_PROF, &timer, nullptr) == -1) {
+        return MakeErrnoCode();
+    }
+    return {};
+}
+
+std::error_code RestoreSignalAction(State& state) {
+    auto action = state.previous_action;
+    // A signal raised right before the timer was stopped may still be pending,
+    // the default action for SIGPROF would terminate the process
+    if (!(action.sa_flags & SA_SIGINFO) && action.sa_handler == SIG_DFL) {
+        action.sa_handler = SIG_IGN;
+    }
+    if (::sigaction(SIGPROF, &action, nullptr) == -1) {
+        return MakeErrnoCode();
+    }
+    return {};
+}
+
+void CollectLocked(State& state) {
+    auto* ring = sample_ring.load(std::memory_order_acquire);
+    if (!ring) return;
+
+    std::string key;
+    auto consumer = [&](const Sample& sample) {
+        key.assign(sample.tag.data(), sample.tag_size);
+        key.push_back('\0');
+        key.append(reinterpret_cast<const char*>(sample.frames.data()), sample.depth * sizeof(FramePtr));
+        ++state.stacks[key];
+    };
+    ring->ConsumeAll(consumer);
+}
+
+}  // namespace
+
+std::error_code Start(std::uint32_t frequency) {
+    if (frequency == 0) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+
+    auto& state = GetState();
+    const std::lock_guard lock{state.mutex};
+    if (is_running.load()) {
+        return std::make_error_code(std::errc::operation_in_progress);
+    }
+
+    if (!sample_ring.load()) {
+        sample_ring.store(new SampleRing(), std::memory_order_release);
+    }
+
+    // The first unwinding may allocate, do it outside of the signal handler
+    std::array<FramePtr, kMaxDepth> frames{};
+    boost::stacktrace::safe_dump_to(frames.data(), sizeof(frames));
+
+    struct sigaction action {};
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    action.sa_sigaction = &ProfilerSignalHandler;
+    sigemptyset(&action.sa_mask);
+    if (::sigaction(SIGPROF, &action, &state.previous_action) == -1) {
+        return MakeErrnoCode();
+    }
+
+    is_running = true;
+    if (auto ec = SetTimer(frequency)) {
+        is_running = false;
+        RestoreSignalAction(state);
+        return ec;
+    }
+    return {};
+}
+
+std::error_code Stop() {
+    auto& state = GetState();
+    const std::lock_guard lock{state.mutex};
+    if (!is_running.load()) return {};
+
+    auto ec = SetTimer(0);
+    is_running = false;
+    if (auto restore_ec = RestoreSignalAction(state); !ec) {
+        ec = restore_ec;
+    }
+    CollectLocked(state);
+    return ec;
+}
+
+bool IsRunning() noexcept { return is_running.load(); }
+
+void BeginContextSwitch() noexcept { is_context_switch_in_progress = 1; }
+
+void EndContextSwitch() noexcept { is_context_switch_in_progress = 0; }
+
+void Collect() {
+    auto& state = GetState();
+    const std::lock_guard lock{state.mutex};
+    CollectLocked(state);
+}
+
+std::string DumpCollapsed() {
+    std::unordered_map<std::string, std::uint64_t> stacks;
+    {
+        auto& state = GetState();
+        const std::lock_guard lock{state.mutex};
+        CollectLocked(state);
+        stacks = state.stacks;
+    }
+
+    // Symbolization is slow, every frame is resolved once
+    std::unordered_map<FramePtr, std::string> names;
+    const auto get_name = [&names](FramePtr frame) -> const std::string& {
+        auto& name = names[frame];
+        if (name.empty()) {
+            name = boost::stacktrace::frame{frame}.name();
+            if (name.empty()) {
+                name = fmt::format("{}", fmt::ptr(frame));
+            }
+            // ';' separates the frames in the collapsed format
+            std::replace(name.begin(), name.end(), ';', ':');
+        }
+        return name;
+    };
+
+    std::string result;
+    for (const auto& [key, count] : stacks) {
+        const auto tag_end = key.find('\0');
+        result.append(key, 0, tag_end);
+
+        std::vector<FramePtr> frames((key.size() - tag_end - 1) / sizeof(FramePtr));
+        std::memcpy(frames.data(), key.data() + tag_end + 1, frames.size() * sizeof(FramePtr));
+        // Innermost frames go last
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            result.push_back(';');
+            result.append(get_name(*it));
+        }
+        result.append(fmt::format(" {}\n", count));
+    }
+    return result;
+}
+
+void Reset() {
+    auto& state = GetState();
+    const std::lock_guard lock{state.mutex};
+    CollectLocked(state);
+    state.stacks.clear();
+}
+
+std::string Stats() {
+    std::size_t stacks_count = 0;
+    {
+        auto& state = GetState();
+        const std::lock_guard lock{state.mutex};
+        stacks_count = state.stacks.size();
+    }
+    return fmt::format(
+        "running: {}\nsamples: {}\ndropped: {}\nskipped: {}\nstacks: {}\n",
+        IsRunning(),
+        samples_count.load(),
+        dropped_count.load(),
+        skipped_count.load(),
+        stacks_count
+    );
+}
+
+TagScope::TagScope(const std::string& tag) noexcept
+    : context_(engine::current_task::GetCurrentTaskContextUnchecked()) {
+    if (context_) {
+        old_tag_ = context_->GetCpuProfilerTag();
+        context_->SetCpuProfilerTag(&tag);
+    }
+}
+
+TagScope::~TagScope() {
+    if (context_) {
+        context_->SetCpuProfilerTag(old_tag_);
+    }
+}
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+class TaskContext;
+}  // namespace engine::impl
+
+namespace utils::cpu_profiler {
+
+// A process-wide sampling CPU profiler. SIGPROF is raised in the thread that
+// consumes the CPU time, and the signal handler records the stack of that
+// thread along with a tag: the tag of the current task (see TagScope), or its
+// task processor name, or the thread name outside of tasks.
+
+// Starts sampling with the given frequency per second of the CPU time.
+std::error_code Start(std::uint32_t frequency);
+
+std::error_code Stop();
+
+bool IsRunning() noexcept;
+
+// Must be called right before and right after a coroutine context switch of
+// the current thread. The stack can not be unwound while it is being switched,
+// the samples taken meanwhile are skipped.
+void BeginContextSwitch() noexcept;
+void EndContextSwitch() noexcept;
+
+// Moves the recorded samples to the aggregated stacks. Must be called
+// regularly while the profiler is running, the samples that do not fit into
+// the buffer are dropped.
+void Collect();
+
+// Returns the aggregated stacks in the collapsed format of FlameGraph:
+// 'tag;outermost;...;innermost count' per line.
+std::string DumpCollapsed();
+
+// Forgets the aggregated stacks.
+void Reset();
+
+std::string Stats();
+
+// Attributes the samples of the current task to the tag while alive.
+// The tag must outlive the scope.
+class TagScope final {
+public:
+    explicit TagScope(const std::string& tag) noexcept;
+
+    TagScope(TagScope&&) = delete;
+    TagScope& operator=(TagScope&&) = delete;
+    ~TagScope();
+
+private:
+    engine::impl::TaskContext* context_;
+    const std::string* old_tag_{nullptr};
+};
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,108 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+double BurnCpu(std::chrono::milliseconds duration) {
+    double result = 0;
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+        for (int i = 1; i < 10000; ++i) {
+            result += std::sqrt(static_cast<double>(i));
+        }
+    }
+    return result;
+}
+
+// Checks the 'tag;outermost;...;innermost count' lines
+void ExpectWellFormed(const std::string& dump) {
+    std::istringstream lines{dump};
+    for (std::string line; std::getline(lines, line);) {
+        SCOPED_TRACE(line);
+        const auto count_pos = line.rfind(' ');
+        ASSERT_NE(count_pos, std::string::npos);
+        EXPECT_NE(line.find(';'), 0);
+        EXPECT_GT(std::stoull(line.substr(count_pos + 1)), 0);
+    }
+}
+
+std::uint64_t GetSkippedCount() {
+    const auto stats = utils::cpu_profiler::Stats();
+    const auto pos = stats.find("skipped: ");
+    if (pos == std::string::npos) return 0;
+    return std::stoull(stats.substr(pos + 9));
+}
+
+}  // namespace
+
+UTEST(CpuProfiler, TaggedSamples) {
+    const std::string tag = "test-tag";
+
+    ASSERT_FALSE(utils::cpu_profiler::Start(1000));
+    EXPECT_TRUE(utils::cpu_profiler::IsRunning());
+    EXPECT_EQ(utils::cpu_profiler::Start(1000), std::errc::operation_in_progress);
+
+    // The count of the samples depends on the load of the machine, so the CPU
+    // is burnt until a tagged sample shows up
+    std::string dump;
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (dump.find(tag + ';') == std::string::npos && !deadline.IsReached()) {
+        {
+            const utils::cpu_profiler::TagScope tag_scope{tag};
+            EXPECT_GT(BurnCpu(std::chrono::milliseconds{50}), 0);
+        }
+        dump = utils::cpu_profiler::DumpCollapsed();
+    }
+    ASSERT_FALSE(utils::cpu_profiler::Stop());
+    EXPECT_FALSE(utils::cpu_profiler::IsRunning());
+
+    EXPECT_NE(dump.find(tag + ';'), std::string::npos) << dump;
+    ExpectWellFormed(dump);
+
+    utils::cpu_profiler::Reset();
+    EXPECT_EQ(utils::cpu_profiler::DumpCollapsed(), "");
+}
+
+UTEST(CpuProfiler, RestoresSignalAction) {
+    struct sigaction previous {};
+    struct sigaction custom {};
+    custom.sa_handler = SIG_IGN;
+    sigemptyset(&custom.sa_mask);
+    ASSERT_EQ(::sigaction(SIGPROF, &custom, &previous), 0);
+
+    ASSERT_FALSE(utils::cpu_profiler::Start(1000));
+    ASSERT_FALSE(utils::cpu_profiler::Stop());
+
+    struct sigaction restored {};
+    ASSERT_EQ(::sigaction(SIGPROF, &previous, &restored), 0);
+    EXPECT_EQ(restored.sa_handler, SIG_IGN);
+    EXPECT_FALSE(restored.sa_flags & SA_SIGINFO);
+}
+
+UTEST(CpuProfiler, SkipsContextSwitches) {
+    const auto skipped_before = GetSkippedCount();
+    ASSERT_FALSE(utils::cpu_profiler::Start(1000));
+
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (GetSkippedCount() == skipped_before && !deadline.IsReached()) {
+        utils::cpu_profiler::BeginContextSwitch();
+        EXPECT_GT(BurnCpu(std::chrono::milliseconds{50}), 0);
+        utils::cpu_profiler::EndContextSwitch();
+    }
+    ASSERT_FALSE(utils::cpu_profiler::Stop());
+
+    EXPECT_GT(GetSkippedCount(), skipped_before);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,416 @@
+#include <userver/utils/statistics/exponential_histogram.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <thread>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <concurrent/impl/rseq.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl::exponential_histogram {
+
+using Counter = std::atomic<std::uint64_t>;
+
+inline constexpr std::size_t kCountersPerLine = concurrent::impl::kDestructiveInterferenceSize / sizeof(Counter);
+
+// Stripes never share cache lines.
+struct alignas(concurrent::impl::kDestructiveInterferenceSize) CounterLine final {
+    Counter counters[kCountersPerLine]{};
+};
+
+}  // namespace impl::exponential_histogram
+
+using impl::exponential_histogram::CounterLine;
+using impl::exponential_histogram::kCountersPerLine;
+
+namespace {
+
+constexpr int kMinSchema = -4;
+constexpr int kMaxSchema = 8;
+constexpr std::size_t kMaxStripes = 16;
+
+constexpr int kFractionDigits = std::numeric_limits<double>::digits - 1;
+constexpr std::uint64_t kFractionMask = (std::uint64_t{1} << kFractionDigits) - 1;
+constexpr std::int32_t kExponentBias = std::numeric_limits<double>::max_exponent - 1;
+
+using FractionBounds = std::array<std::uint64_t, std::size_t{1} << kMaxSchema>;
+
+std::uint64_t ToBits(double value) noexcept {
+    std::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double FromBits(std::uint64_t bits) noexcept {
+    double value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// The fraction bits of 2^(i / 2^kMaxSchema), which are the bucket bounds
+// within [1, 2) for the finest schema. A coarser schema uses every 2^N-th one.
+// Comparing the fraction bits is the same as comparing the doubles within
+// a power of 2.
+const FractionBounds& GetFractionBounds() noexcept {
+    static const FractionBounds bounds = [] {
+        FractionBounds result{};
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = ToBits(std::exp2(static_cast<double>(i) / result.size())) & kFractionMask;
+        }
+        return result;
+    }();
+    return bounds;
+}
+
+// Returns the index of the bucket (base^(index-1), base^index] for a positive
+// normal value, the same as Prometheus native histograms do. Reads the bits
+// of the double directly, as std::frexp is a library call.
+std::int32_t ComputeIndex(double value, int schema) noexcept {
+    const auto bits = ToBits(value);
+    const auto fraction = bits & kFractionMask;
+    // value is in [2^exponent, 2^(exponent+1))
+    const auto exponent = static_cast<std::int32_t>(bits >> kFractionDigits) - kExponentBias;
+
+    if (schema > 0) {
+        // Branchless binary search of the least bound that is not less than
+        // the value, as the values of a histogram are unpredictable
+        const auto& bounds = GetFractionBounds();
+        const int stride = 1 << (kMaxSchema - schema);
+        int first = 0;
+        for (int count = 1 << schema; count > 1; count /= 2) {
+            const int half = count / 2;
+            first = bounds[(first + half - 1) * stride] < fraction ? first + half : first;
+        }
+        first += bounds[first * stride] < fraction ? 1 : 0;
+        return exponent * (1 << schema) + first;
+    }
+
+    // Exact powers of 2 belong to the lower bucket
+    const auto index = exponent + (fraction == 0 ? 0 : 1);
+    return (index + (1 << -schema) - 1) >> -schema;
+}
+
+double ComputeUpperBound(std::int32_t index, int schema) noexcept {
+    if (schema > 0) {
+        const std::int32_t exponent = index >> schema;
+        const std::int32_t offset = index - exponent * (1 << schema);
+        const auto fraction = GetFractionBounds()[offset << (kMaxSchema - schema)];
+        return std::ldexp(FromBits((static_cast<std::uint64_t>(kExponentBias) << kFractionDigits) | fraction), exponent);
+    }
+    return std::ldexp(1.0, index * (1 << -schema));
+}
+
+// Returns the index of the bucket of the coarser schema that contains
+// the bucket of the finer schema.
+std::int32_t DownscaleIndex(std::int32_t index, int schema_decrease) noexcept {
+    return (index + (1 << schema_decrease) - 1) >> schema_decrease;
+}
+
+std::size_t GetStripeCount() noexcept {
+    const auto hardware_concurrency = std::max(std::thread::hardware_concurrency(), 1U);
+    std::size_t stripe_count = 1;
+    // Power of 2 to avoid a division in Account
+    while (stripe_count * 2 <= std::min<std::size_t>(hardware_concurrency, kMaxStripes)) {
+        stripe_count *= 2;
+    }
+    return stripe_count;
+}
+
+std::atomic<std::size_t> next_thread_stripe{0};
+
+compiler::ThreadLocal local_thread_stripe = [] {
+    return next_thread_stripe.fetch_add(1, std::memory_order_relaxed);
+};
+
+// Threads that run on different CPUs get different stripes, as long as there
+// are enough stripes.
+std::size_t GetStripeHint() noexcept {
+#ifdef USERVER_IMPL_HAS_RSEQ
+    const auto cpu_id = rseq_cpu_start();
+    if (concurrent::impl::IsCpuIdValid(cpu_id)) {
+        return cpu_id;
+    }
+#endif
+    auto stripe = local_thread_stripe.Use();
+    return *stripe;
+}
+
+}  // namespace
+
+ExponentialHistogramSnapshot::ExponentialHistogramSnapshot() noexcept = default;
+
+std::uint64_t ExponentialHistogramSnapshot::GetTotalCount() const noexcept {
+    std::uint64_t total = zero_count_ + overflow_count_;
+    for (const auto count : counts_) {
+        total += count;
+    }
+    return total;
+}
+
+double ExponentialHistogramSnapshot::GetUpperBound(std::int32_t index) const noexcept {
+    return ComputeUpperBound(index, schema_);
+}
+
+double ExponentialHistogramSnapshot::GetPercentile(double percent) const noexcept {
+    const auto total = GetTotalCount();
+    if (total == 0) return 0;
+
+    const auto rank = std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::ceil(total * percent / 100)));
+    std::uint64_t seen = zero_count_;
+    if (seen >= rank) return 0;
+
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            const auto index = first_index_ + static_cast<std::int32_t>(i);
+            const auto lower = GetUpperBound(index - 1);
+            const auto upper = GetUpperBound(index);
+            // Both bounds are within the same relative distance of it
+            return 2 * lower * upper / (lower + upper);
+        }
+    }
+    return GetUpperBound(GetLastIndex());
+}
+
+void ExponentialHistogramSnapshot::Downscale(int schema) {
+    UINVARIANT(schema >= kMinSchema && schema <= schema_, "Downscale cannot increase the schema");
+    if (schema == schema_) return;
+
+    const int decrease = schema_ - schema;
+    const auto first_index = DownscaleIndex(first_index_, decrease);
+    std::vector<std::uint64_t> counts(DownscaleIndex(GetLastIndex(), decrease) - first_index + 1);
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts[DownscaleIndex(first_index_ + static_cast<std::int32_t>(i), decrease) - first_index] += counts_[i];
+    }
+
+    schema_ = schema;
+    dump_schema_ = std::min(dump_schema_, schema);
+    first_index_ = first_index;
+    counts_ = std::move(counts);
+}
+
+ExponentialHistogramSnapshot& ExponentialHistogramSnapshot::operator+=(const ExponentialHistogramSnapshot& other) {
+    if (other.IsEmpty()) return *this;
+    if (IsEmpty()) {
+        *this = other;
+        return *this;
+    }
+
+    const auto* source = &other;
+    std::optional<ExponentialHistogramSnapshot> downscaled;
+    if (other.schema_ > schema_) {
+        downscaled.emplace(other);
+        downscaled->Downscale(schema_);
+        source = &*downscaled;
+    } else if (other.schema_ < schema_) {
+        Downscale(other.schema_);
+    }
+    dump_schema_ = std::min(dump_schema_, source->dump_schema_);
+
+    ExtendRange(source->first_index_, source->GetLastIndex());
+    zero_count_ += source->zero_count_;
+    overflow_count_ += source->overflow_count_;
+    for (std::size_t i = 0; i < source->counts_.size(); ++i) {
+        counts_[source->first_index_ + static_cast<std::int32_t>(i) - first_index_] += source->counts_[i];
+    }
+    RaiseZeroThreshold(source->zero_threshold_);
+    return *this;
+}
+
+ExponentialHistogramSnapshot& ExponentialHistogramSnapshot::operator+=(const ExponentialHistogram& histogram) {
+    if (IsEmpty()) {
+        histogram.SetShape(*this);
+    }
+    if (histogram.IsShapeOf(*this)) {
+        histogram.AddCountsTo(*this);
+        return *this;
+    }
+    return *this += histogram.GetSnapshot();
+}
+
+std::int32_t ExponentialHistogramSnapshot::GetLastIndex() const noexcept {
+    return first_index_ + static_cast<std::int32_t>(counts_.size()) - 1;
+}
+
+void ExponentialHistogramSnapshot::RaiseZeroThreshold(double zero_threshold) {
+    if (zero_threshold <= zero_threshold_) return;
+    zero_threshold_ = zero_threshold;
+
+    // The bucket that contains the threshold stays, as its values are unknown
+    std::size_t moved = 0;
+    while (GetUpperBound(first_index_ + static_cast<std::int32_t>(moved)) <= zero_threshold) {
+        zero_count_ += counts_[moved];
+        ++moved;
+        // The last bucket is above the threshold of the histogram it came from
+        UASSERT(moved < counts_.size());
+    }
+    counts_.erase(counts_.begin(), counts_.begin() + moved);
+    first_index_ += static_cast<std::int32_t>(moved);
+}
+
+void ExponentialHistogramSnapshot::ExtendRange(std::int32_t first_index, std::int32_t last_index) {
+    if (first_index < first_index_) {
+        counts_.insert(counts_.begin(), first_index_ - first_index, 0);
+        first_index_ = first_index;
+    }
+    if (last_index > GetLastIndex()) {
+        counts_.resize(last_index - first_index_ + 1);
+    }
+}
+
+void DumpMetric(Writer& writer, const ExponentialHistogramSnapshot& snapshot) {
+    if (snapshot.IsEmpty()) return;
+
+    auto dumped = snapshot;
+    dumped.Downscale(snapshot.dump_schema_);
+
+    std::vector<double> bounds;
+    bounds.reserve(dumped.counts_.size() + 1);
+    bounds.push_back(dumped.zero_threshold_);
+    for (std::size_t i = 0; i < dumped.counts_.size(); ++i) {
+        bounds.push_back(dumped.GetUpperBound(dumped.first_index_ + static_cast<std::int32_t>(i)));
+    }
+
+    Histogram histogram{bounds};
+    histogram.Account(bounds[0], dumped.zero_count_);
+    for (std::size_t i = 0; i < dumped.counts_.size(); ++i) {
+        histogram.Account(bounds[i + 1], dumped.counts_[i]);
+    }
+    histogram.Account(std::numeric_limits<double>::infinity(), dumped.overflow_count_);
+    writer = histogram.GetView();
+}
+
+ExponentialHistogram::ExponentialHistogram() : ExponentialHistogram(ExponentialHistogramSettings{}) {}
+
+ExponentialHistogram::ExponentialHistogram(const ExponentialHistogramSettings& settings)
+    : schema_(settings.schema),
+      dump_schema_(std::min(settings.dump_schema, settings.schema)),
+      zero_threshold_(settings.zero_threshold) {
+    UINVARIANT(schema_ >= kMinSchema && schema_ <= kMaxSchema, "ExponentialHistogram schema must be in [-4, 8]");
+    UINVARIANT(dump_schema_ >= kMinSchema, "ExponentialHistogram dump schema must be at least -4");
+    UINVARIANT(std::isnormal(zero_threshold_) && zero_threshold_ > 0, "Zero threshold must be positive");
+    UINVARIANT(
+        std::isfinite(settings.max_value) && settings.max_value > zero_threshold_,
+        "Max value must be greater than the zero threshold"
+    );
+
+    first_index_ = ComputeIndex(zero_threshold_, schema_);
+    if (ComputeUpperBound(first_index_, schema_) == zero_threshold_) {
+        ++first_index_;
+    }
+    const auto last_index = ComputeIndex(settings.max_value, schema_);
+    max_bound_ = ComputeUpperBound(last_index, schema_);
+
+    counters_per_stripe_ = static_cast<std::size_t>(last_index - first_index_ + 1) + 2;
+    lines_per_stripe_ = (counters_per_stripe_ + kCountersPerLine - 1) / kCountersPerLine;
+    const auto stripe_count = GetStripeCount();
+    stripe_mask_ = stripe_count - 1;
+    lines_ = std::make_unique<CounterLine[]>(lines_per_stripe_ * stripe_count);
+}
+
+ExponentialHistogram::ExponentialHistogram(const ExponentialHistogram& other)
+    : schema_(other.schema_),
+      dump_schema_(other.dump_schema_),
+      zero_threshold_(other.zero_threshold_),
+      max_bound_(other.max_bound_),
+      first_index_(other.first_index_),
+      counters_per_stripe_(other.counters_per_stripe_),
+      lines_per_stripe_(other.lines_per_stripe_),
+      stripe_mask_(other.stripe_mask_),
+      lines_(std::make_unique<CounterLine[]>(lines_per_stripe_ * (stripe_mask_ + 1))) {
+    for (std::size_t stripe = 0; stripe <= stripe_mask_; ++stripe) {
+        for (std::size_t bucket = 0; bucket < counters_per_stripe_; ++bucket) {
+            GetCounter(0, bucket).fetch_add(
+                other.GetCounter(stripe, bucket).load(std::memory_order_relaxed), std::memory_order_relaxed
+            );
+        }
+    }
+}
+
+ExponentialHistogram& ExponentialHistogram::operator=(const ExponentialHistogram& other) {
+    *this = ExponentialHistogram{other};
+    return *this;
+}
+
+ExponentialHistogram::ExponentialHistogram(ExponentialHistogram&&) noexcept = default;
+
+ExponentialHistogram& ExponentialHistogram::operator=(ExponentialHistogram&&) noexcept = default;
+
+ExponentialHistogram::~ExponentialHistogram() = default;
+
+void ExponentialHistogram::Account(double value, std::uint64_t count) noexcept {
+    // NaN falls into the zero bucket
+    std::size_t bucket = 0;
+    if (value > max_bound_) {
+        bucket = counters_per_stripe_ - 1;
+    } else if (value > zero_threshold_) {
+        bucket = static_cast<std::size_t>(ComputeIndex(value, schema_) - first_index_) + 1;
+    }
+    GetCounter(GetStripeHint() & stripe_mask_, bucket).fetch_add(count, std::memory_order_relaxed);
+}
+
+ExponentialHistogramSnapshot ExponentialHistogram::GetSnapshot() const {
+    ExponentialHistogramSnapshot snapshot;
+    SetShape(snapshot);
+    AddCountsTo(snapshot);
+    return snapshot;
+}
+
+void ExponentialHistogram::Reset() noexcept {
+    for (std::size_t stripe = 0; stripe <= stripe_mask_; ++stripe) {
+        for (std::size_t bucket = 0; bucket < counters_per_stripe_; ++bucket) {
+            GetCounter(stripe, bucket).store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ResetMetric(ExponentialHistogram& histogram) noexcept { histogram.Reset(); }
+
+std::atomic<std::uint64_t>& ExponentialHistogram::GetCounter(std::size_t stripe, std::size_t bucket) const noexcept {
+    UASSERT(stripe <= stripe_mask_ && bucket < counters_per_stripe_);
+    return lines_[stripe * lines_per_stripe_ + bucket / kCountersPerLine].counters[bucket % kCountersPerLine];
+}
+
+bool ExponentialHistogram::IsShapeOf(const ExponentialHistogramSnapshot& snapshot) const noexcept {
+    return snapshot.schema_ == schema_ && snapshot.zero_threshold_ == zero_threshold_ &&
+           snapshot.first_index_ == first_index_ && snapshot.counts_.size() + 2 == counters_per_stripe_;
+}
+
+void ExponentialHistogram::SetShape(ExponentialHistogramSnapshot& snapshot) const {
+    snapshot.schema_ = schema_;
+    snapshot.dump_schema_ = dump_schema_;
+    snapshot.zero_threshold_ = zero_threshold_;
+    snapshot.first_index_ = first_index_;
+    snapshot.counts_.assign(counters_per_stripe_ - 2, 0);
+}
+
+void ExponentialHistogram::AddCountsTo(ExponentialHistogramSnapshot& snapshot) const noexcept {
+    UASSERT(IsShapeOf(snapshot));
+    const auto overflow_bucket = counters_per_stripe_ - 1;
+    for (std::size_t stripe = 0; stripe <= stripe_mask_; ++stripe) {
+        snapshot.zero_count_ += GetCounter(stripe, 0).load(std::memory_order_relaxed);
+        for (std::size_t bucket = 1; bucket < overflow_bucket; ++bucket) {
+            snapshot.counts_[bucket - 1] += GetCounter(stripe, bucket).load(std::memory_order_relaxed);
+        }
+        snapshot.overflow_count_ += GetCounter(stripe, overflow_bucket).load(std::memory_order_relaxed);
+    }
+}
+
+void DumpMetric(Writer& writer, const ExponentialHistogram& histogram) { writer = histogram.GetSnapshot(); }
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,205 @@
+#include <userver/utils/statistics/exponential_histogram.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/pretty_format.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::statistics::ExponentialHistogram;
+using utils::statistics::ExponentialHistogramSettings;
+using utils::statistics::ExponentialHistogramSnapshot;
+
+ExponentialHistogramSettings MakeSettings(int schema, double zero_threshold, double max_value, int dump_schema = 0) {
+    ExponentialHistogramSettings settings;
+    settings.schema = schema;
+    settings.zero_threshold = zero_threshold;
+    settings.max_value = max_value;
+    settings.dump_schema = dump_schema;
+    return settings;
+}
+
+std::vector<std::uint64_t> GetCounts(const ExponentialHistogramSnapshot& snapshot) {
+    const auto counts = snapshot.GetCounts();
+    return {counts.begin(), counts.end()};
+}
+
+}  // namespace
+
+UTEST(StatisticsExponentialHistogram, Buckets) {
+    ExponentialHistogram histogram{MakeSettings(0, 0.5, 8)};
+    histogram.Account(0.1);
+    histogram.Account(-3);
+    histogram.Account(1);
+    histogram.Account(1.5, 2);
+    histogram.Account(2);
+    histogram.Account(8);
+    histogram.Account(8.5);
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetSchema(), 0);
+    EXPECT_EQ(snapshot.GetZeroCount(), 2);
+    // (0.5, 1], (1, 2], (2, 4], (4, 8]
+    EXPECT_EQ(snapshot.GetFirstIndex(), 0);
+    EXPECT_THAT(GetCounts(snapshot), testing::ElementsAre(1, 3, 0, 1));
+    EXPECT_EQ(snapshot.GetOverflowCount(), 1);
+    EXPECT_EQ(snapshot.GetTotalCount(), 8);
+    EXPECT_EQ(snapshot.GetUpperBound(-1), 0.5);
+    EXPECT_EQ(snapshot.GetUpperBound(3), 8);
+}
+
+UTEST(StatisticsExponentialHistogram, BucketBorders) {
+    for (const int schema : {-2, 0, 1, 3, 8}) {
+        ExponentialHistogram histogram{MakeSettings(schema, 1e-3, 1e3)};
+        const auto empty = histogram.GetSnapshot();
+        const auto first_index = empty.GetFirstIndex();
+
+        for (std::size_t i = 0; i < empty.GetCounts().size(); ++i) {
+            const auto index = first_index + static_cast<std::int32_t>(i);
+            // Values on the bucket borders fall into the lower bucket
+            histogram.Account(empty.GetUpperBound(index));
+        }
+
+        const auto snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(snapshot.GetZeroCount(), 0) << "schema=" << schema;
+        EXPECT_EQ(snapshot.GetOverflowCount(), 0) << "schema=" << schema;
+        for (const auto count : snapshot.GetCounts()) {
+            EXPECT_EQ(count, 1) << "schema=" << schema;
+        }
+    }
+}
+
+UTEST(StatisticsExponentialHistogram, RelativeError) {
+    ExponentialHistogram histogram{MakeSettings(3, 1e-3, 1e6)};
+    std::vector<double> values;
+    for (int i = 1; i <= 10000; ++i) {
+        values.push_back(i * 0.37);
+        histogram.Account(values.back());
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    // (base - 1) / (base + 1) for base = 2^(1/8)
+    constexpr double kMaxRelativeError = 0.0433;
+    for (const double percent : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        const auto expected = values[static_cast<std::size_t>(percent * values.size() / 100) - 1];
+        EXPECT_NEAR(snapshot.GetPercentile(percent), expected, expected * kMaxRelativeError) << "percent=" << percent;
+    }
+}
+
+UTEST(StatisticsExponentialHistogram, Reset) {
+    ExponentialHistogram histogram;
+    histogram.Account(42, 5);
+    ResetMetric(histogram);
+    EXPECT_EQ(histogram.GetSnapshot().GetTotalCount(), 0);
+}
+
+UTEST(StatisticsExponentialHistogram, Copy) {
+    ExponentialHistogram histogram{MakeSettings(2, 1, 100)};
+    histogram.Account(42, 5);
+    const ExponentialHistogram copy{histogram};
+    histogram.Account(42);
+
+    const auto snapshot = copy.GetSnapshot();
+    EXPECT_EQ(snapshot.GetSchema(), 2);
+    EXPECT_EQ(snapshot.GetTotalCount(), 5);
+    EXPECT_EQ(snapshot.GetPercentile(50), histogram.GetSnapshot().GetPercentile(50));
+}
+
+UTEST(StatisticsExponentialHistogram, Downscale) {
+    ExponentialHistogram histogram{MakeSettings(2, 0.5, 8)};
+    for (int i = 1; i <= 8; ++i) {
+        histogram.Account(i);
+    }
+
+    auto snapshot = histogram.GetSnapshot();
+    snapshot.Downscale(0);
+    EXPECT_EQ(snapshot.GetSchema(), 0);
+    EXPECT_EQ(snapshot.GetFirstIndex(), 0);
+    EXPECT_THAT(GetCounts(snapshot), testing::ElementsAre(1, 1, 2, 4));
+}
+
+UTEST(StatisticsExponentialHistogram, MergeDifferentSettings) {
+    ExponentialHistogram fine{MakeSettings(3, 0.01, 100)};
+    ExponentialHistogram coarse{MakeSettings(1, 1, 1000)};
+    for (const double value : {0.1, 3.0, 50.0, 500.0}) {
+        fine.Account(value);
+        coarse.Account(value);
+    }
+
+    ExponentialHistogramSnapshot merged;
+    merged += fine;
+    merged += coarse;
+
+    EXPECT_EQ(merged.GetSchema(), 1);
+    EXPECT_EQ(merged.GetZeroThreshold(), 1);
+    EXPECT_EQ(merged.GetTotalCount(), 8);
+    // 0.1 from both histograms is below the greater zero threshold
+    EXPECT_EQ(merged.GetZeroCount(), 2);
+    // 500 is beyond the range of the fine histogram
+    EXPECT_EQ(merged.GetOverflowCount(), 1);
+    EXPECT_GT(merged.GetUpperBound(merged.GetFirstIndex()), 1);
+}
+
+UTEST(StatisticsExponentialHistogram, Dump) {
+    ExponentialHistogram histogram{MakeSettings(3, 0.5, 8, 0)};
+    histogram.Account(0.1);
+    histogram.Account(1.1);
+    histogram.Account(1.2);
+    histogram.Account(3);
+    histogram.Account(100);
+
+    utils::statistics::Storage storage;
+    const auto holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+    EXPECT_EQ(
+        utils::statistics::ToPrettyFormat(storage),
+        "test:\tHIST_RATE\t[0.5]=1,[1]=0,[2]=2,[4]=1,[8]=0,[inf]=1\n"
+    );
+}
+
+/// [recent period]
+UTEST(StatisticsExponentialHistogram, RecentPeriod) {
+    utils::statistics::RecentPeriod<ExponentialHistogram, ExponentialHistogramSnapshot> recent_period;
+    recent_period.GetCurrentCounter().Account(10);
+    recent_period.GetCurrentCounter().Account(20);
+
+    const auto snapshot =
+        recent_period.GetStatsForPeriod(std::chrono::seconds{60}, /*with_current_epoch=*/true);
+    EXPECT_EQ(snapshot.GetTotalCount(), 2);
+    EXPECT_NEAR(snapshot.GetPercentile(50), 10, 10 * 0.05);
+}
+/// [recent period]
+
+UTEST_MT(StatisticsExponentialHistogram, ConcurrentAccount, 4) {
+    constexpr std::size_t kTasks = 4;
+    constexpr std::size_t kIterations = 10000;
+    ExponentialHistogram histogram{MakeSettings(3, 1e-3, 1e3)};
+
+    auto tasks = utils::GenerateFixedArray(kTasks, [&](std::size_t task_index) {
+        return engine::AsyncNoSpan([&histogram, task_index] {
+            for (std::size_t i = 0; i < kIterations; ++i) {
+                histogram.Account(static_cast<double>(task_index + 1));
+            }
+        });
+    });
+    for (auto& task : tasks) {
+        task.Get();
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), kTasks * kIterations);
+    EXPECT_NEAR(snapshot.GetPercentile(100), kTasks, kTasks * 0.05);
+}
+
+USERVER_NAMESPACE_END
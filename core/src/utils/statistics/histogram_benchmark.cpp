@@ -1,10 +1,13 @@
 #include <userver/utils/statistics/histogram.hpp>
 
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <boost/range/irange.hpp>
 
 #include <userver/utils/algo.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/exponential_histogram.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,4 +37,44 @@ void HistogramAccount(benchmark::State& state) {
 // poorly (fixed).
 BENCHMARK(HistogramAccount)->DenseRange(10, 50, 10);
 
+namespace {
+
+// Latencies of a hot handler, in milliseconds
+std::vector<double> MakeLatencies() {
+    auto values = std::vector<double>(1024);
+    for (auto& value : values) {
+        value = utils::RandRange(0.1, 1000.0);
+    }
+    return Launder(std::move(values));
+}
+
+std::vector<double> MakeLatencyBounds() {
+    return {0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+}
+
+// All the benchmark threads record into the same histogram
+template <typename HistogramType>
+void RunContendedAccount(benchmark::State& state, HistogramType& histogram) {
+    const auto values = MakeLatencies();
+    while (state.KeepRunningBatch(values.size())) {
+        for (const auto value : values) {
+            histogram.Account(value);
+        }
+    }
+}
+
+}  // namespace
+
+void HistogramAccountContended(benchmark::State& state) {
+    static utils::statistics::Histogram histogram{MakeLatencyBounds()};
+    RunContendedAccount(state, histogram);
+}
+BENCHMARK(HistogramAccountContended)->ThreadRange(1, 16);
+
+void ExponentialHistogramAccountContended(benchmark::State& state) {
+    static utils::statistics::ExponentialHistogram histogram;
+    RunContendedAccount(state, histogram);
+}
+BENCHMARK(ExponentialHistogramAccountContended)->ThreadRange(1, 16);
+
 USERVER_NAMESPACE_END
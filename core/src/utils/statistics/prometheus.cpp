@@ -1,12 +1,18 @@
 #include <userver/utils/statistics/prometheus.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -22,23 +28,65 @@ namespace {
 
 enum class Typed { kYes, kNo };
 
+struct MetricName final {
+    std::string prometheus_name;
+    // Number of the output the metric was last written to, the `# TYPE` line
+    // is written once per output
+    std::uint64_t output{0};
+};
+
+using MetricNames = utils::impl::TransparentMap<std::string, MetricName>;
+
 template <Typed IsTyped>
-class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
+class Renderer final {
 public:
-    explicit FormatBuilder() = default;
+    Renderer(fmt::memory_buffer& buf, MetricNames& names, std::uint64_t output)
+        : buf_(buf), names_(names), output_(output) {}
 
-    void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
+    // Appends the metric and returns the offset of its value in the buffer
+    std::size_t Render(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) {
+        last_name_ = nullptr;
         if (value.IsHistogram()) {
             HandleHistogram(path, labels, value);
-            return;
+            return buf_.size();
         }
 
         DumpMetricNameAndType(path, value);
         DumpLabels(labels);
+        const auto value_offset = buf_.size();
+        AppendValue(value);
+        return value_offset;
+    }
+
+    void AppendValue(const MetricValue& value) {
         fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
     }
 
-    std::string Release() { return fmt::to_string(buf_); }
+    // Whether Render writes the `# TYPE` line for the metric, `name` is the
+    // name of the metric if it is known already
+    bool HasTypeLine(std::string_view path, const MetricName* name, const MetricValue& value) const {
+        if (value.IsHistogram()) {
+            return true;
+        }
+        if (IsTyped == Typed::kNo && !value.IsRate()) {
+            return false;
+        }
+        if (!name) {
+            name = utils::impl::FindTransparentOrNullptr(names_, path);
+        }
+        return !name || name->output != output_;
+    }
+
+    // Must be called if the text of the metric was written not by Render
+    void MarkWritten(MetricName* name) {
+        if (name) {
+            name->output = output_;
+        }
+    }
+
+    // Name of the metric written by the last Render call, nullptr for
+    // histograms. Stays valid until the names are destroyed.
+    MetricName* GetLastName() const { return last_name_; }
 
 private:
     void AppendHistogramMetric(
@@ -92,15 +140,20 @@ private:
     }
 
     void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
-        if (const auto* const converted = utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-            buf_.append(*converted);
+        if (auto* const converted = utils::impl::FindTransparentOrNullptr(names_, name)) {
+            if (converted->output != output_) {
+                converted->output = output_;
+                DumpMetricType(converted->prometheus_name, value);
+            }
+            buf_.append(converted->prometheus_name);
+            last_name_ = converted;
             return;
         }
 
         auto prometheus_name = impl::ToPrometheusName(name);
         DumpMetricType(prometheus_name, value);
         buf_.append(prometheus_name);
-        metrics_.emplace(name, std::move(prometheus_name));
+        last_name_ = &names_.emplace(name, MetricName{std::move(prometheus_name), output_}).first->second;
     }
 
     void DumpMetricType([[maybe_unused]] std::string_view prometheus_name, [[maybe_unused]] const MetricValue& value) {
@@ -143,10 +196,239 @@ private:
         buf_.push_back('}');
     }
 
+    fmt::memory_buffer& buf_;
+    MetricNames& names_;
+    const std::uint64_t output_;
+    MetricName* last_name_{nullptr};
+};
+
+template <Typed IsTyped>
+class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
+public:
+    explicit FormatBuilder() = default;
+
+    void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
+        renderer_.Render(path, labels, value);
+    }
+
+    std::string Release() { return fmt::to_string(buf_); }
+
+private:
     fmt::memory_buffer buf_;
-    utils::impl::TransparentMap<std::string, std::string> metrics_;
+    MetricNames names_;
+    Renderer<IsTyped> renderer_{buf_, names_, 1};
+};
+
+enum class ValueKind {
+    kInt,
+    kDouble,
+    kRate,
+    kHistogram,
 };
 
+ValueKind GetKind(const MetricValue& value) {
+    return value.Visit(utils::Overloaded{
+        [](std::int64_t) { return ValueKind::kInt; },
+        [](double) { return ValueKind::kDouble; },
+        [](Rate) { return ValueKind::kRate; },
+        [](HistogramView) { return ValueKind::kHistogram; },
+    });
+}
+
+// A metric written to the output of PrometheusFormatCache
+struct CachedMetric final {
+    // Path and labels
+    std::string key;
+    // nullptr for histograms
+    MetricName* name{nullptr};
+    ValueKind kind{ValueKind::kInt};
+    bool has_type_line{false};
+    // Bits of an int, double or Rate value
+    std::uint64_t value{0};
+    // Bucket values of a histogram, the last one is for +Inf
+    std::vector<std::uint64_t> buckets;
+
+    // Text of the metric is [begin, end) of the output
+    std::size_t begin{0};
+    std::size_t end{0};
+    // Offset of the value from `begin`, for non-histogram metrics
+    std::size_t value_offset{0};
+};
+
+std::uint64_t GetValueBits(const MetricValue& value) {
+    return value.Visit(utils::Overloaded{
+        [](std::int64_t x) { return static_cast<std::uint64_t>(x); },
+        [](double x) {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return bits;
+        },
+        [](Rate x) { return x.value; },
+        [](HistogramView) { return std::uint64_t{0}; },
+    });
+}
+
+void StoreValue(CachedMetric& metric, const MetricValue& value) {
+    metric.kind = GetKind(value);
+    metric.value = GetValueBits(value);
+    metric.buckets.clear();
+    if (value.IsHistogram()) {
+        const auto histogram = value.AsHistogram();
+        const auto bucket_count = histogram.GetBucketCount();
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            metric.buckets.push_back(histogram.GetValueAt(i));
+        }
+        metric.buckets.push_back(histogram.GetValueAtInf());
+    }
+}
+
+bool HasSameValue(const CachedMetric& metric, const MetricValue& value) {
+    if (!value.IsHistogram()) {
+        return metric.value == GetValueBits(value);
+    }
+
+    const auto histogram = value.AsHistogram();
+    const auto bucket_count = histogram.GetBucketCount();
+    if (metric.buckets.size() != bucket_count + 1) {
+        return false;
+    }
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        if (metric.buckets[i] != histogram.GetValueAt(i)) {
+            return false;
+        }
+    }
+    return metric.buckets.back() == histogram.GetValueAtInf();
+}
+
+// The previous output is the source of the reused text. Its text is immutable
+// and shared with the callers that may still be sending it, so the current one
+// is rendered into a new buffer. The current metrics recycle the allocations
+// of the output before the previous one.
+struct CacheState final {
+    MetricNames names;
+    std::uint64_t output{0};
+
+    fmt::memory_buffer text;
+    std::vector<CachedMetric> metrics;
+    std::size_t metrics_count{0};
+
+    std::shared_ptr<const fmt::memory_buffer> previous_text{std::make_shared<const fmt::memory_buffer>()};
+    std::vector<CachedMetric> previous_metrics;
+};
+
+template <Typed IsTyped>
+class CachingFormatBuilder final : public utils::statistics::BaseFormatBuilder {
+public:
+    explicit CachingFormatBuilder(CacheState& state)
+        : state_(state), renderer_(state.text, state.names, state.output) {}
+
+    void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
+        auto& metric = AddMetric();
+        MakeKey(metric.key, path, labels);
+
+        auto& text = state_.text;
+        metric.begin = text.size();
+
+        const auto* const previous = FindPrevious(metric.key);
+        if (previous && previous->kind == GetKind(value) &&
+            previous->has_type_line == renderer_.HasTypeLine(path, previous->name, value)) {
+            metric.name = previous->name;
+            metric.has_type_line = previous->has_type_line;
+
+            const auto* const previous_begin = state_.previous_text->data() + previous->begin;
+            if (HasSameValue(*previous, value)) {
+                text.append(previous_begin, state_.previous_text->data() + previous->end);
+                renderer_.MarkWritten(metric.name);
+                metric.value_offset = previous->value_offset;
+            } else if (!value.IsHistogram()) {
+                // Only the value is formatted, the name and the labels are reused
+                text.append(previous_begin, previous_begin + previous->value_offset);
+                renderer_.MarkWritten(metric.name);
+                renderer_.AppendValue(value);
+                metric.value_offset = previous->value_offset;
+            } else {
+                metric.value_offset = renderer_.Render(path, labels, value) - metric.begin;
+            }
+        } else {
+            metric.has_type_line = renderer_.HasTypeLine(path, nullptr, value);
+            metric.value_offset = renderer_.Render(path, labels, value) - metric.begin;
+            metric.name = renderer_.GetLastName();
+        }
+
+        metric.end = text.size();
+        StoreValue(metric, value);
+    }
+
+private:
+    CachedMetric& AddMetric() {
+        auto& metrics = state_.metrics;
+        if (state_.metrics_count == metrics.size()) {
+            metrics.emplace_back();
+        }
+        return metrics[state_.metrics_count++];
+    }
+
+    static void MakeKey(std::string& key, std::string_view path, utils::statistics::LabelsSpan labels) {
+        key.assign(path);
+        for (const auto& label : labels) {
+            key.push_back('\0');
+            key.append(label.Name());
+            key.push_back('\0');
+            key.append(label.Value());
+        }
+    }
+
+    // The metrics usually come in the same order as in the previous output,
+    // the index is built only if they do not
+    const CachedMetric* FindPrevious(const std::string& key) {
+        const auto& previous = state_.previous_metrics;
+        if (next_previous_ < previous.size() && previous[next_previous_].key == key) {
+            return &previous[next_previous_++];
+        }
+
+        if (previous_index_.empty()) {
+            previous_index_.reserve(previous.size());
+            for (std::size_t i = 0; i < previous.size(); ++i) {
+                previous_index_.emplace(previous[i].key, i);
+            }
+        }
+        const auto it = previous_index_.find(key);
+        if (it == previous_index_.end()) {
+            return nullptr;
+        }
+        next_previous_ = it->second + 1;
+        return &previous[it->second];
+    }
+
+    CacheState& state_;
+    Renderer<IsTyped> renderer_;
+
+    std::size_t next_previous_{0};
+    std::unordered_map<std::string_view, std::size_t> previous_index_;
+};
+
+// Returns the complete output, it stays valid after the next calls
+template <Typed IsTyped>
+std::shared_ptr<const fmt::memory_buffer> FormatCached(
+    CacheState& state,
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request
+) {
+    ++state.output;
+    state.text.clear();
+    state.text.reserve(state.previous_text->size());
+    state.metrics_count = 0;
+
+    CachingFormatBuilder<IsTyped> builder{state};
+    statistics.VisitMetrics(builder, request);
+
+    // The output is complete, it becomes the source of the reused text
+    state.metrics.resize(state.metrics_count);
+    state.previous_text = std::make_shared<const fmt::memory_buffer>(std::move(state.text));
+    std::swap(state.metrics, state.previous_metrics);
+    return state.previous_text;
+}
+
 }  // namespace
 
 std::string ToPrometheusName(std::string_view data) {
@@ -195,6 +477,49 @@ ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const ut
     return builder.Release();
 }
 
+struct PrometheusFormatCache::Impl final {
+    explicit Impl(Format format) : format(format) {}
+
+    std::shared_ptr<const fmt::memory_buffer>
+    Render(const utils::statistics::Storage& statistics, const Request& request) {
+        const std::lock_guard lock{mutex};
+        if (format == Format::kTyped) {
+            return impl::FormatCached<impl::Typed::kYes>(state, statistics, request);
+        }
+        return impl::FormatCached<impl::Typed::kNo>(state, statistics, request);
+    }
+
+    const Format format;
+    engine::Mutex mutex;
+    impl::CacheState state;
+};
+
+PrometheusFormatCache::PrometheusFormatCache(Format format) : impl_(std::make_unique<Impl>(format)) {}
+
+PrometheusFormatCache::~PrometheusFormatCache() = default;
+
+std::string PrometheusFormatCache::ToString(const utils::statistics::Storage& statistics, const Request& request) {
+    const auto text = impl_->Render(statistics, request);
+    return std::string(text->data(), text->size());
+}
+
+void PrometheusFormatCache::WriteChunks(
+    const utils::statistics::Storage& statistics,
+    const Request& request,
+    std::size_t chunk_size,
+    ChunkConsumer consumer
+) {
+    UASSERT(chunk_size > 0);
+    // The consumer may be slow, e.g. it sends the chunks over the network, so
+    // the chunks are passed on without the lock. The text is immutable, the
+    // next calls render into a new buffer.
+    const auto text = impl_->Render(statistics, request);
+    const std::string_view output{text->data(), text->size()};
+    for (std::size_t offset = 0; offset < output.size(); offset += chunk_size) {
+        consumer(output.substr(offset, chunk_size));
+    }
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
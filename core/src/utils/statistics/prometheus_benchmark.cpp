@@ -0,0 +1,62 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Each scrape sees a few of the metrics changed, as in a real service
+constexpr std::size_t kChangedPerScrape = 100;
+
+template <typename Format>
+void RunPrometheusFormat(benchmark::State& state, Format format) {
+    engine::RunStandalone([&] {
+        const auto metrics_count = static_cast<std::size_t>(state.range(0));
+        std::vector<std::string> handlers;
+        for (std::size_t i = 0; i < metrics_count; ++i) {
+            handlers.push_back("/v1/handler-" + std::to_string(i));
+        }
+        std::vector<utils::statistics::RateCounter> counters(metrics_count);
+
+        utils::statistics::Storage storage;
+        const auto holder = storage.RegisterWriter("http.handler", [&](utils::statistics::Writer& writer) {
+            for (std::size_t i = 0; i < metrics_count; ++i) {
+                writer["requests"].ValueWithLabels(counters[i], {"http_path", handlers[i]});
+            }
+        });
+
+        std::size_t next_changed = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            for (std::size_t i = 0; i < kChangedPerScrape; ++i) {
+                ++counters[next_changed];
+                next_changed = (next_changed + 1) % metrics_count;
+            }
+            benchmark::DoNotOptimize(format(storage));
+        }
+    });
+}
+
+}  // namespace
+
+void PrometheusFormat(benchmark::State& state) {
+    RunPrometheusFormat(state, [](const utils::statistics::Storage& storage) {
+        return utils::statistics::ToPrometheusFormat(storage);
+    });
+}
+BENCHMARK(PrometheusFormat)->Range(1000, 100000);
+
+void PrometheusFormatCache(benchmark::State& state) {
+    utils::statistics::PrometheusFormatCache cache;
+    RunPrometheusFormat(state, [&cache](const utils::statistics::Storage& storage) { return cache.ToString(storage); });
+}
+BENCHMARK(PrometheusFormatCache)->Range(1000, 100000);
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,9 @@
 #include <userver/utest/utest.hpp>
 
 #include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/utils/text.hpp>
 
@@ -392,6 +394,96 @@ child{application="processing"} 8
     }
 }
 
+UTEST(MetricsPrometheus, FormatCache) {
+    const double bounds[] = {10, 20};
+    utils::statistics::Histogram histogram{bounds};
+    utils::statistics::RateCounter requests;
+    std::int64_t connections = 1;
+    bool with_extra = false;
+
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("server", [&](utils::statistics::Writer& writer) {
+        writer["requests"].ValueWithLabels(requests, {"handler", "a"});
+        writer["requests"].ValueWithLabels(requests, {"handler", "b"});
+        if (with_extra) {
+            writer["extra"] = 1.5;
+        }
+        writer["connections"] = connections;
+        writer["timings"] = histogram;
+    });
+
+    for (const auto format : {PrometheusFormatCache::Format::kTyped, PrometheusFormatCache::Format::kUntyped}) {
+        const auto expected = [&](const utils::statistics::Request& request = {}) {
+            return format == PrometheusFormatCache::Format::kTyped ? ToPrometheusFormat(storage, request)
+                                                                   : ToPrometheusFormatUntyped(storage, request);
+        };
+
+        PrometheusFormatCache cache{format};
+        EXPECT_EQ(cache.ToString(storage), expected());
+        EXPECT_EQ(cache.ToString(storage), expected());
+
+        ++requests;
+        connections = 100500;
+        histogram.Account(15);
+        EXPECT_EQ(cache.ToString(storage), expected());
+
+        with_extra = true;
+        EXPECT_EQ(cache.ToString(storage), expected());
+
+        with_extra = false;
+        ++requests;
+        EXPECT_EQ(cache.ToString(storage), expected());
+
+        const auto path_request = utils::statistics::Request::MakeWithPath("server.connections");
+        EXPECT_EQ(cache.ToString(storage, path_request), expected(path_request));
+        EXPECT_EQ(cache.ToString(storage), expected());
+    }
+}
+
+UTEST(MetricsPrometheus, FormatCacheChunks) {
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("test", [](utils::statistics::Writer& writer) {
+        for (int i = 0; i < 100; ++i) {
+            writer["metric"].ValueWithLabels(i, {"index", std::to_string(i)});
+        }
+    });
+
+    PrometheusFormatCache cache;
+    for (int i = 0; i < 2; ++i) {
+        std::vector<std::string> chunks;
+        cache.WriteChunks(storage, {}, 1000, [&chunks](std::string_view chunk) { chunks.emplace_back(chunk); });
+
+        ASSERT_GT(chunks.size(), 1);
+        for (std::size_t j = 0; j + 1 < chunks.size(); ++j) {
+            EXPECT_EQ(chunks[j].size(), 1000);
+        }
+        EXPECT_LE(chunks.back().size(), 1000);
+        EXPECT_EQ(utils::text::Join(chunks, ""), ToPrometheusFormat(storage));
+    }
+}
+
+UTEST(MetricsPrometheus, FormatCacheConsumerIsCalledUnlocked) {
+    utils::statistics::Storage storage;
+    int value = 42;
+    const auto holder = storage.RegisterWriter("test", [&value](utils::statistics::Writer& writer) {
+        writer["metric"] = value;
+    });
+
+    PrometheusFormatCache cache;
+    const auto expected = ToPrometheusFormat(storage);
+    std::string output;
+    std::string nested;
+    cache.WriteChunks(storage, {}, 1, [&](std::string_view chunk) {
+        output.append(chunk);
+        // Would deadlock if the cache was still locked. The chunks that are
+        // not consumed yet must not be changed by the next output.
+        ++value;
+        nested = cache.ToString(storage);
+    });
+    EXPECT_EQ(output, expected);
+    EXPECT_EQ(nested, ToPrometheusFormat(storage));
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
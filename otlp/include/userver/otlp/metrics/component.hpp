@@ -0,0 +1,51 @@
+#pragma once
+
+/// @file userver/otlp/metrics/component.hpp
+/// @brief @copybrief otlp::MetricsExporterComponent
+
+#include <memory>
+
+#include <userver/components/component_fwd.hpp>
+#include <userver/components/raw_component_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that periodically sends the metrics of
+/// components::StatisticsStorage to an OTLP collector.
+///
+/// utils::statistics::Rate metrics and histograms are sent with the delta
+/// aggregation temporality, other metrics are sent as gauges.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | URI of otel collector (e.g. 127.0.0.1:4317) | -
+/// period | Interval between the exports | 1m
+/// service-name | Service name | unknown_service
+/// extra-attributes | Extra resource attributes for OTLP, object of key/value strings | -
+
+// clang-format on
+class MetricsExporterComponent final : public components::RawComponentBase {
+public:
+    static constexpr std::string_view kName = "otlp-metrics-exporter";
+
+    MetricsExporterComponent(const components::ComponentConfig&, const components::ComponentContext&);
+
+    ~MetricsExporterComponent();
+
+    static yaml_config::Schema GetStaticConfigSchema();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "logger.hpp"
 
+#include <charconv>
 #include <chrono>
 
 #include <userver/engine/async.hpp>
@@ -13,6 +14,7 @@
 #include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/text_light.hpp>
+#include <userver/utils/trivial_map.hpp>
 #include <userver/utils/underlying_value.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,6 +27,57 @@ constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
 constexpr std::string_view kServiceName = "service.name";
 
 const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+// Suffix of the tracing::ScopeTime tags, must match the one of the span tags
+constexpr std::string_view kTimerSuffix = "_time";
+
+enum class SpanTag {
+    kTraceId,
+    kSpanId,
+    kParentId,
+    kName,
+    kTotalTime,
+    kStartTimestamp,
+    kIgnored,
+};
+
+constexpr utils::TrivialBiMap kSpanTags = [](auto selector) {
+    return selector()
+        .Case("trace_id", SpanTag::kTraceId)
+        .Case("span_id", SpanTag::kSpanId)
+        .Case("parent_id", SpanTag::kParentId)
+        .Case("stopwatch_name", SpanTag::kName)
+        .Case("total_time", SpanTag::kTotalTime)
+        .Case("start_timestamp", SpanTag::kStartTimestamp)
+        .Case("timestamp", SpanTag::kIgnored)
+        .Case("text", SpanTag::kIgnored);
+};
+
+// Parses the "seconds.microseconds" start_timestamp of a span without losing
+// precision, returns 0 on errors
+std::uint64_t ParseStartTimestampNanoseconds(std::string_view value) {
+    const auto dot = value.find('.');
+    const auto integral = value.substr(0, dot);
+    const auto fractional = dot == std::string_view::npos ? std::string_view{} : value.substr(dot + 1, 9);
+
+    std::uint64_t seconds = 0;
+    if (std::from_chars(integral.data(), integral.data() + integral.size(), seconds).ec != std::errc{}) {
+        return 0;
+    }
+
+    std::uint64_t nanoseconds = 0;
+    for (std::size_t i = 0; i < 9; ++i) {
+        nanoseconds *= 10;
+        if (i < fractional.size()) {
+            if (fractional[i] < '0' || fractional[i] > '9') {
+                return 0;
+            }
+            nanoseconds += fractional[i] - '0';
+        }
+    }
+    return seconds * 1'000'000'000 + nanoseconds;
+}
+
 }  // namespace
 
 Formatter::Formatter(
@@ -67,40 +120,96 @@ Formatter::Formatter(
 }
 
 void Formatter::AddTag(std::string_view key, const logging::LogExtra::Value& value) {
+    if (is_span_set_) {
+        if (item_.forwarded_formatter) {
+            item_.forwarded_formatter->AddTag(key, value);
+        }
+        return;
+    }
+
+    if (const auto* str = std::get_if<std::string>(&value)) {
+        AddTag(key, std::string_view{*str});
+        return;
+    }
+
     std::visit(
         utils::Overloaded{
             [&](opentelemetry::proto::trace::v1::Span& span) {
-                if (key == "trace_id") {
-                    span.set_trace_id(utils::encoding::FromHex(std::get<std::string>(value)));
-                } else if (key == "span_id") {
-                    span.set_span_id(utils::encoding::FromHex(std::get<std::string>(value)));
-                } else if (key == "parent_id") {
-                    span.set_parent_span_id(utils::encoding::FromHex(std::get<std::string>(value)));
-                } else if (key == "stopwatch_name") {
-                    span.set_name(std::get<std::string>(value));
-                } else if (key == "total_time") {
-                    item_.total_time = std::get<double>(value);
-                } else if (key == "start_timestamp") {
-                    auto start_timestamp_str = std::get<std::string>(value);
-                    item_.start_timestamp = std::stod(start_timestamp_str);
-                    span.set_start_time_unix_nano(item_.start_timestamp * 1'000'000'000);
-                } else if (key == "timestamp" || key == "text") {
-                    // nothing
-                } else {
+                const auto tag = kSpanTags.TryFind(key);
+                if (tag == SpanTag::kTotalTime) {
+                    if (const auto* total_time = std::get_if<double>(&value)) {
+                        item_.total_time = *total_time;
+                    }
+                } else if (!tag) {
                     auto attributes = span.add_attributes();
                     attributes->set_key(std::string{logger_.MapAttribute(key)});
                     logger_.SetAttributeValue(attributes->mutable_value(), value);
                 }
             },
+            [&](opentelemetry::proto::logs::v1::LogRecord& log_record) {
+                auto attributes = log_record.add_attributes();
+                attributes->set_key(std::string{logger_.MapAttribute(key)});
+                logger_.SetAttributeValue(attributes->mutable_value(), value);
+            },
+        },
+        item_.otlp
+    );
+
+    if (item_.forwarded_formatter) {
+        item_.forwarded_formatter->AddTag(key, value);
+    }
+}
+
+void Formatter::AddTag(std::string_view key, std::string_view value) {
+    if (is_span_set_) {
+        if (item_.forwarded_formatter) {
+            item_.forwarded_formatter->AddTag(key, value);
+        }
+        return;
+    }
+
+    std::visit(
+        utils::Overloaded{
+            [&](opentelemetry::proto::trace::v1::Span& span) {
+                const auto tag = kSpanTags.TryFind(key);
+                if (!tag) {
+                    auto attributes = span.add_attributes();
+                    attributes->set_key(std::string{logger_.MapAttribute(key)});
+                    attributes->mutable_value()->set_string_value(std::string{value});
+                    return;
+                }
+
+                switch (*tag) {
+                    case SpanTag::kTraceId:
+                        span.set_trace_id(utils::encoding::FromHex(value));
+                        break;
+                    case SpanTag::kSpanId:
+                        span.set_span_id(utils::encoding::FromHex(value));
+                        break;
+                    case SpanTag::kParentId:
+                        span.set_parent_span_id(utils::encoding::FromHex(value));
+                        break;
+                    case SpanTag::kName:
+                        span.set_name(std::string{value});
+                        break;
+                    case SpanTag::kStartTimestamp:
+                        item_.start_timestamp = ParseStartTimestampNanoseconds(value);
+                        span.set_start_time_unix_nano(item_.start_timestamp);
+                        break;
+                    case SpanTag::kTotalTime:
+                    case SpanTag::kIgnored:
+                        break;
+                }
+            },
             [&](opentelemetry::proto::logs::v1::LogRecord& log_record) {
                 if (key == "trace_id") {
-                    log_record.set_trace_id(utils::encoding::FromHex(std::get<std::string>(value)));
+                    log_record.set_trace_id(utils::encoding::FromHex(value));
                 } else if (key == "span_id") {
-                    log_record.set_span_id(utils::encoding::FromHex(std::get<std::string>(value)));
+                    log_record.set_span_id(utils::encoding::FromHex(value));
                 } else {
                     auto attributes = log_record.add_attributes();
                     attributes->set_key(std::string{logger_.MapAttribute(key)});
-                    logger_.SetAttributeValue(attributes->mutable_value(), value);
+                    attributes->mutable_value()->set_string_value(std::string{value});
                 }
             },
         },
@@ -112,10 +221,6 @@ void Formatter::AddTag(std::string_view key, const logging::LogExtra::Value& val
     }
 }
 
-void Formatter::AddTag(std::string_view key, std::string_view value) {
-    AddTag(key, logging::LogExtra::Value{std::string{value}});
-}
-
 void Formatter::SetText(std::string_view text) {
     if (auto* log_record = std::get_if<::opentelemetry::proto::logs::v1::LogRecord>(&item_.otlp)) {
         log_record->mutable_body()->set_string_value(std::string(text));
@@ -126,9 +231,44 @@ void Formatter::SetText(std::string_view text) {
     }
 }
 
+bool Formatter::SetSpan(const logging::impl::formatters::SpanRecord& record) {
+    auto* span = std::get_if<::opentelemetry::proto::trace::v1::Span>(&item_.otlp);
+    if (!span) {
+        return false;
+    }
+
+    span->set_trace_id(utils::encoding::FromHex(record.trace_id));
+    span->set_span_id(utils::encoding::FromHex(record.span_id));
+    span->set_parent_span_id(utils::encoding::FromHex(record.parent_id));
+    span->set_name(std::string{record.name});
+
+    const auto start_timestamp =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(record.start_time.time_since_epoch()).count();
+    span->set_start_time_unix_nano(start_timestamp);
+    span->set_end_time_unix_nano(start_timestamp + record.duration.count());
+
+    record.ForEachTag([&](std::string_view key, const logging::LogExtra::Value& value) {
+        auto* attributes = span->add_attributes();
+        attributes->set_key(std::string{logger_.MapAttribute(key)});
+        logger_.SetAttributeValue(attributes->mutable_value(), value);
+    });
+    for (const auto& [key, duration] : record.timings) {
+        auto* attributes = span->add_attributes();
+        attributes->set_key(std::string{logger_.MapAttribute(utils::StrCat(key, kTimerSuffix))});
+        attributes->mutable_value()->set_double_value(
+            std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count()
+        );
+    }
+
+    is_span_set_ = true;
+    // The default logger still needs the span tags
+    return !item_.forwarded_formatter;
+}
+
 logging::impl::formatters::LoggerItemRef Formatter::ExtractLoggerItem() {
-    if (auto* span = std::get_if<::opentelemetry::proto::trace::v1::Span>(&item_.otlp)) {
-        span->set_end_time_unix_nano((item_.start_timestamp + item_.total_time / 1'000) * 1'000'000'000LL);
+    auto* span = std::get_if<::opentelemetry::proto::trace::v1::Span>(&item_.otlp);
+    if (span && !is_span_set_) {
+        span->set_end_time_unix_nano(item_.start_timestamp + static_cast<std::uint64_t>(item_.total_time * 1'000'000));
     }
     return item_;
 }
@@ -249,15 +389,15 @@ void Logger::SendingLoop(Queue::Consumer& consumer, LogClient& log_client, Trace
         auto deadline = engine::Deadline::FromDuration(config_.max_batch_delay);
 
         do {
+            // The records are moved into the batch, the batch keeps the
+            // cleared records of the previous batches for reuse
             std::visit(
                 utils::Overloaded{
-                    [&scope_spans](const opentelemetry::proto::trace::v1::Span& action) {
-                        auto span = scope_spans->add_spans();
-                        *span = action;
+                    [&scope_spans](opentelemetry::proto::trace::v1::Span& action) {
+                        scope_spans->add_spans()->Swap(&action);
                     },
-                    [&scope_logs](const opentelemetry::proto::logs::v1::LogRecord& action) {
-                        auto log_records = scope_logs->add_log_records();
-                        *log_records = action;
+                    [&scope_logs](opentelemetry::proto::logs::v1::LogRecord& action) {
+                        scope_logs->add_log_records()->Swap(&action);
                     }},
                 action
             );
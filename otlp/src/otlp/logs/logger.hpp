@@ -40,8 +40,10 @@ struct LoggerConfig {
 
 struct Item final : logging::impl::formatters::LoggerItemBase {
     std::variant<::opentelemetry::proto::logs::v1::LogRecord, ::opentelemetry::proto::trace::v1::Span> otlp;
+    // milliseconds
     double total_time{};
-    double start_timestamp{};
+    // nanoseconds since epoch
+    std::uint64_t start_timestamp{};
 
     logging::impl::formatters::BasePtr forwarded_formatter;  // can be null
 };
@@ -55,11 +57,14 @@ public:
     void AddTag(std::string_view key, const logging::LogExtra::Value& value) override;
     void AddTag(std::string_view key, std::string_view value) override;
     void SetText(std::string_view text) override;
+    bool SetSpan(const logging::impl::formatters::SpanRecord& record) override;
     logging::impl::formatters::LoggerItemRef ExtractLoggerItem() override;
 
 private:
     Item item_;
     Logger& logger_;
+    // Set if the span was converted from SpanRecord, the tags are forwarded only
+    bool is_span_set_{false};
 };
 
 class Logger final : public logging::impl::LoggerBase {
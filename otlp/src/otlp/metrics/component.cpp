@@ -0,0 +1,100 @@
+#include <userver/otlp/metrics/component.hpp>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include "exporter.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace {
+
+using MetricsClient = ::opentelemetry::proto::collector::metrics::v1::MetricsServiceClient;
+
+MetricsExporterConfig ParseExporterConfig(const components::ComponentConfig& config) {
+    MetricsExporterConfig exporter_config;
+    exporter_config.service_name = config["service-name"].As<std::string>("unknown_service");
+    exporter_config.extra_attributes =
+        config["extra-attributes"].As<std::unordered_map<std::string, std::string>>({});
+    return exporter_config;
+}
+
+}  // namespace
+
+struct MetricsExporterComponent::Impl {
+    Impl(MetricsClient&& client, MetricsExporterConfig&& config, const utils::statistics::Storage& storage)
+        : client(std::move(client)), exporter(std::move(config)), storage(storage) {}
+
+    void Export() {
+        const auto request = exporter.Collect(storage, std::chrono::system_clock::now());
+        client.Export(request);
+    }
+
+    MetricsClient client;
+    MetricsExporter exporter;
+    const utils::statistics::Storage& storage;
+    utils::PeriodicTask task;
+};
+
+MetricsExporterComponent::MetricsExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context
+) {
+    auto& client_factory = context.FindComponent<ugrpc::client::ClientFactoryComponent>().GetFactory();
+    auto client = client_factory.MakeClient<MetricsClient>("otlp-metrics", config["endpoint"].As<std::string>());
+    const auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
+
+    impl_ = std::make_unique<Impl>(std::move(client), ParseExporterConfig(config), storage);
+
+    const auto period = config["period"].As<std::chrono::milliseconds>(std::chrono::minutes{1});
+    impl_->task.Start(
+        "otlp-metrics-exporter",
+        utils::PeriodicTask::Settings{period, utils::PeriodicTask::Flags::kStrong},
+        [this] { impl_->Export(); }
+    );
+}
+
+MetricsExporterComponent::~MetricsExporterComponent() { impl_->task.Stop(); }
+
+yaml_config::Schema MetricsExporterComponent::GetStaticConfigSchema() {
+    return yaml_config::MergeSchemas<components::RawComponentBase>(R"(
+type: object
+description: >
+    OpenTelemetry metrics exporter component
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: >
+            Hostname:port of otel collector (gRPC).
+    period:
+        type: string
+        description: interval between the exports (e.g. 10s or 1m)
+        defaultDescription: 1m
+    service-name:
+        type: string
+        description: service name
+        defaultDescription: unknown_service
+    extra-attributes:
+        type: object
+        description: extra OTLP resource attributes
+        properties: {}
+        additionalProperties:
+            type: string
+            description: attribute value
+)");
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,221 @@
+#include "exporter.hpp"
+
+#include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace {
+
+namespace proto = ::opentelemetry::proto;
+
+constexpr std::string_view kTelemetrySdkLanguage = "telemetry.sdk.language";
+constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
+constexpr std::string_view kServiceName = "service.name";
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void AddStringAttribute(
+    google::protobuf::RepeatedPtrField<proto::common::v1::KeyValue>& attributes,
+    std::string_view key,
+    std::string_view value
+) {
+    auto* attribute = attributes.Add();
+    attribute->set_key(std::string{key});
+    attribute->mutable_value()->set_string_value(std::string{value});
+}
+
+// Counters may go down if a metric has been re-registered
+std::uint64_t Delta(std::uint64_t current, std::uint64_t previous) {
+    return current >= previous ? current - previous : current;
+}
+
+class RequestBuilder final : public utils::statistics::BaseFormatBuilder {
+public:
+    using Rates = std::unordered_map<std::string, std::uint64_t>;
+    using Histograms = std::unordered_map<std::string, std::vector<std::uint64_t>>;
+
+    RequestBuilder(
+        proto::metrics::v1::ScopeMetrics& scope,
+        std::uint64_t start_time,
+        std::uint64_t time,
+        const Rates& previous_rates,
+        const Histograms& previous_histograms
+    )
+        : scope_(scope),
+          start_time_(start_time),
+          time_(time),
+          previous_rates_(previous_rates),
+          previous_histograms_(previous_histograms) {}
+
+    void HandleMetric(
+        std::string_view path,
+        utils::statistics::LabelsSpan labels,
+        const utils::statistics::MetricValue& value
+    ) override {
+        if (value.IsRate()) {
+            HandleRate(path, labels, value.AsRate().value);
+        } else if (value.IsHistogram()) {
+            HandleHistogram(path, labels, value.AsHistogram());
+        } else {
+            auto& point = *GetMetric(path, MetricKind::kGauge).mutable_gauge()->add_data_points();
+            FillPoint(point, labels);
+            value.Visit([&point](const auto& x) {
+                using Type = std::decay_t<decltype(x)>;
+                if constexpr (std::is_same_v<Type, std::int64_t>) {
+                    point.set_as_int(x);
+                } else if constexpr (std::is_same_v<Type, double>) {
+                    point.set_as_double(x);
+                }
+            });
+        }
+    }
+
+    Rates ExtractRates() && { return std::move(rates_); }
+
+    Histograms ExtractHistograms() && { return std::move(histograms_); }
+
+private:
+    enum class MetricKind : char {
+        kGauge = 'g',
+        kSum = 's',
+        kHistogram = 'h',
+    };
+
+    proto::metrics::v1::Metric& GetMetric(std::string_view path, MetricKind kind) {
+        key_.assign(path);
+        key_.push_back(static_cast<char>(kind));
+        auto& metric = metrics_[key_];
+        if (!metric) {
+            metric = scope_.add_metrics();
+            metric->set_name(std::string{path});
+            if (kind == MetricKind::kSum) {
+                auto& sum = *metric->mutable_sum();
+                sum.set_aggregation_temporality(proto::metrics::v1::AGGREGATION_TEMPORALITY_DELTA);
+                sum.set_is_monotonic(true);
+            } else if (kind == MetricKind::kHistogram) {
+                metric->mutable_histogram()->set_aggregation_temporality(
+                    proto::metrics::v1::AGGREGATION_TEMPORALITY_DELTA
+                );
+            }
+        }
+        return *metric;
+    }
+
+    template <typename Point>
+    void FillPoint(Point& point, utils::statistics::LabelsSpan labels) {
+        for (const auto& label : labels) {
+            AddStringAttribute(*point.mutable_attributes(), label.Name(), label.Value());
+        }
+        point.set_time_unix_nano(time_);
+    }
+
+    // Identifies a series among the metrics with the same kind
+    const std::string& MakeSeriesKey(std::string_view path, utils::statistics::LabelsSpan labels) {
+        key_.assign(path);
+        for (const auto& label : labels) {
+            key_.push_back('\0');
+            key_.append(label.Name());
+            key_.push_back('=');
+            key_.append(label.Value());
+        }
+        return key_;
+    }
+
+    void HandleRate(std::string_view path, utils::statistics::LabelsSpan labels, std::uint64_t value) {
+        auto& point = *GetMetric(path, MetricKind::kSum).mutable_sum()->add_data_points();
+        FillPoint(point, labels);
+        point.set_start_time_unix_nano(start_time_);
+
+        const auto& key = MakeSeriesKey(path, labels);
+        point.set_as_int(Delta(value, utils::FindOrDefault(previous_rates_, key, std::uint64_t{0})));
+        rates_.emplace(key, value);
+    }
+
+    void HandleHistogram(
+        std::string_view path,
+        utils::statistics::LabelsSpan labels,
+        utils::statistics::HistogramView histogram
+    ) {
+        auto& point = *GetMetric(path, MetricKind::kHistogram).mutable_histogram()->add_data_points();
+        FillPoint(point, labels);
+        point.set_start_time_unix_nano(start_time_);
+
+        const auto bucket_count = histogram.GetBucketCount();
+        std::vector<std::uint64_t> counters;
+        counters.reserve(bucket_count + 1);
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            counters.push_back(histogram.GetValueAt(i));
+            point.add_explicit_bounds(histogram.GetUpperBoundAt(i));
+        }
+        counters.push_back(histogram.GetValueAtInf());
+
+        const auto& key = MakeSeriesKey(path, labels);
+        const auto* previous = utils::FindOrNullptr(previous_histograms_, key);
+        // The buckets may have changed if the metric has been re-registered
+        const bool has_previous = previous && previous->size() == counters.size();
+
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < counters.size(); ++i) {
+            const auto delta = Delta(counters[i], has_previous ? (*previous)[i] : 0);
+            point.add_bucket_counts(delta);
+            total += delta;
+        }
+        point.set_count(total);
+
+        histograms_.emplace(key, std::move(counters));
+    }
+
+    proto::metrics::v1::ScopeMetrics& scope_;
+    const std::uint64_t start_time_;
+    const std::uint64_t time_;
+    const Rates& previous_rates_;
+    const Histograms& previous_histograms_;
+
+    std::string key_;
+    std::unordered_map<std::string, proto::metrics::v1::Metric*> metrics_;
+    Rates rates_;
+    Histograms histograms_;
+};
+
+}  // namespace
+
+MetricsExporter::MetricsExporter(MetricsExporterConfig&& config)
+    : config_(std::move(config)), previous_time_(std::chrono::system_clock::now()) {}
+
+MetricsExporter::Request
+MetricsExporter::Collect(const utils::statistics::Storage& storage, std::chrono::system_clock::time_point now) {
+    Request request;
+    auto& resource_metrics = *request.add_resource_metrics();
+
+    auto& attributes = *resource_metrics.mutable_resource()->mutable_attributes();
+    AddStringAttribute(attributes, kTelemetrySdkLanguage, "cpp");
+    AddStringAttribute(attributes, kTelemetrySdkName, "userver");
+    AddStringAttribute(attributes, kServiceName, config_.service_name);
+    for (const auto& [key, value] : config_.extra_attributes) {
+        AddStringAttribute(attributes, key, value);
+    }
+
+    RequestBuilder builder{
+        *resource_metrics.add_scope_metrics(),
+        ToUnixNano(previous_time_),
+        ToUnixNano(now),
+        previous_rates_,
+        previous_histograms_,
+    };
+    storage.VisitMetrics(builder);
+
+    // The metrics that have gone are forgotten
+    previous_rates_ = std::move(builder).ExtractRates();
+    previous_histograms_ = std::move(builder).ExtractHistograms();
+    previous_time_ = now;
+    return request;
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
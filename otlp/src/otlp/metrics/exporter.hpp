@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_client.usrv.pb.hpp>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+struct MetricsExporterConfig {
+    std::string service_name;
+    std::unordered_map<std::string, std::string> extra_attributes;
+};
+
+/// @brief Converts the metrics of utils::statistics::Storage into OTLP
+/// requests.
+///
+/// utils::statistics::Rate and histogram metrics are sent as sums and
+/// histograms with the delta aggregation temporality: each request carries the
+/// increase since the previous request. Other metrics are sent as gauges.
+class MetricsExporter final {
+public:
+    using Request = ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest;
+
+    explicit MetricsExporter(MetricsExporterConfig&& config);
+
+    /// Not thread-safe, remembers the counters to compute the next deltas
+    Request Collect(const utils::statistics::Storage& storage, std::chrono::system_clock::time_point now);
+
+private:
+    const MetricsExporterConfig config_;
+    std::chrono::system_clock::time_point previous_time_;
+    // Counters of the previous request by the path and the labels of a metric
+    std::unordered_map<std::string, std::uint64_t> previous_rates_;
+    std::unordered_map<std::string, std::vector<std::uint64_t>> previous_histograms_;
+};
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include <userver/utest/utest.hpp>
+
+#include <gmock/gmock.h>
+
+#include <otlp/metrics/exporter.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace metrics = ::opentelemetry::proto::metrics::v1;
+
+const metrics::Metric& GetMetric(const otlp::MetricsExporter::Request& request, std::string_view name) {
+    for (const auto& metric : request.resource_metrics(0).scope_metrics(0).metrics()) {
+        if (metric.name() == name) {
+            return metric;
+        }
+    }
+    throw std::runtime_error(fmt::format("No metric '{}'", name));
+}
+
+otlp::MetricsExporter MakeExporter() {
+    otlp::MetricsExporterConfig config;
+    config.service_name = "test-service";
+    return otlp::MetricsExporter{std::move(config)};
+}
+
+constexpr std::chrono::system_clock::time_point kFirstTime{std::chrono::seconds{10}};
+constexpr std::chrono::system_clock::time_point kSecondTime{std::chrono::seconds{20}};
+
+}  // namespace
+
+UTEST(OtlpMetrics, Gauges) {
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("test", [](utils::statistics::Writer& writer) {
+        writer["int"].ValueWithLabels(42, {"label", "value"});
+        writer["double"] = 1.5;
+    });
+
+    auto exporter = MakeExporter();
+    const auto request = exporter.Collect(storage, kFirstTime);
+
+    const auto& resource = request.resource_metrics(0).resource();
+    EXPECT_TRUE(std::any_of(resource.attributes().begin(), resource.attributes().end(), [](const auto& attribute) {
+        return attribute.key() == "service.name" && attribute.value().string_value() == "test-service";
+    }));
+
+    const auto& int_point = GetMetric(request, "test.int").gauge().data_points(0);
+    EXPECT_EQ(int_point.as_int(), 42);
+    ASSERT_EQ(int_point.attributes_size(), 1);
+    EXPECT_EQ(int_point.attributes(0).key(), "label");
+    EXPECT_EQ(int_point.attributes(0).value().string_value(), "value");
+    EXPECT_EQ(int_point.time_unix_nano(), 10'000'000'000);
+
+    EXPECT_EQ(GetMetric(request, "test.double").gauge().data_points(0).as_double(), 1.5);
+}
+
+UTEST(OtlpMetrics, RatesAreDeltas) {
+    utils::statistics::RateCounter counter;
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) {
+        writer["rate"].ValueWithLabels(counter, {"label", "a"});
+    });
+
+    auto exporter = MakeExporter();
+    counter.Add({5});
+    auto request = exporter.Collect(storage, kFirstTime);
+    const auto& sum = GetMetric(request, "test.rate").sum();
+    EXPECT_TRUE(sum.is_monotonic());
+    EXPECT_EQ(sum.aggregation_temporality(), metrics::AGGREGATION_TEMPORALITY_DELTA);
+    EXPECT_EQ(sum.data_points(0).as_int(), 5);
+
+    counter.Add({3});
+    request = exporter.Collect(storage, kSecondTime);
+    const auto& point = GetMetric(request, "test.rate").sum().data_points(0);
+    EXPECT_EQ(point.as_int(), 3);
+    EXPECT_EQ(point.start_time_unix_nano(), 10'000'000'000);
+    EXPECT_EQ(point.time_unix_nano(), 20'000'000'000);
+
+    request = exporter.Collect(storage, kSecondTime);
+    EXPECT_EQ(GetMetric(request, "test.rate").sum().data_points(0).as_int(), 0);
+}
+
+UTEST(OtlpMetrics, HistogramsAreDeltas) {
+    const double bounds[] = {10, 20};
+    utils::statistics::Histogram histogram{bounds};
+    utils::statistics::Storage storage;
+    const auto holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer["histogram"] = histogram; });
+
+    auto exporter = MakeExporter();
+    histogram.Account(5);
+    histogram.Account(15, 2);
+    auto request = exporter.Collect(storage, kFirstTime);
+    {
+        const auto& point = GetMetric(request, "test.histogram").histogram().data_points(0);
+        EXPECT_EQ(point.count(), 3);
+        EXPECT_THAT(point.explicit_bounds(), testing::ElementsAre(10, 20));
+        EXPECT_THAT(point.bucket_counts(), testing::ElementsAre(1, 2, 0));
+    }
+
+    histogram.Account(100);
+    request = exporter.Collect(storage, kSecondTime);
+    {
+        const auto& point = GetMetric(request, "test.histogram").histogram().data_points(0);
+        EXPECT_EQ(point.count(), 1);
+        EXPECT_THAT(point.bucket_counts(), testing::ElementsAre(0, 0, 1));
+    }
+}
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,11 @@
 #include <userver/utest/utest.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 #include <otlp/logs/logger.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/utils/encoding/hex.hpp>
 
 #include <userver/logging/impl/mem_logger.hpp>
 #include <userver/ugrpc/tests/service_fixtures.hpp>
@@ -165,4 +167,30 @@ UTEST_F(LogServiceTest, SmokeTrace) {
     EXPECT_LE(span.end_time_unix_nano(), timestamp2.count());
 }
 
+UTEST_F(LogServiceTest, TraceAttributes) {
+    std::string trace_id;
+    {
+        tracing::Span span("span_with_tags");
+        span.AddTag("some_tag", "some_value");
+        span.AddTag("some_number", 42);
+        trace_id = span.GetTraceId();
+    }
+
+    while (GetService2().spans.size() < 1) {
+        engine::SleepFor(std::chrono::milliseconds(10));
+    }
+
+    auto& span = GetService2().spans[0];
+    EXPECT_EQ(span.name(), "span_with_tags");
+    EXPECT_EQ(utils::encoding::ToHex(span.trace_id()), trace_id);
+    EXPECT_EQ(span.span_id().size(), 8);
+
+    std::unordered_map<std::string, ::opentelemetry::proto::common::v1::AnyValue> attributes;
+    for (const auto& attribute : span.attributes()) {
+        attributes.emplace(attribute.key(), attribute.value());
+    }
+    EXPECT_EQ(attributes["some_tag"].string_value(), "some_value");
+    EXPECT_EQ(attributes["some_number"].int_value(), 42);
+}
+
 USERVER_NAMESPACE_END
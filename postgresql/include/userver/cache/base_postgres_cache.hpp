@@ -97,6 +97,10 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// An incremental update copies the whole container before applying the
+/// changes. For large caches use cache::SharedChunkedMap as CacheContainer,
+/// its copies share the unchanged data.
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
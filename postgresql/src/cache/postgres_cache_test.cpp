@@ -4,7 +4,10 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <userver/cache/shared_chunked_map.hpp>
 #include <userver/components/minimal_server_component_list.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
 #include <userver/utils/projected_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -277,6 +280,17 @@ struct PostgresExamplePolicy7 {
     using CacheContainer = utils::ProjectedUnorderedSet<ValueType, kKeyMember>;
 };
 
+// Tests SharedChunkedMap as container
+struct PostgresExamplePolicy8 {
+    static constexpr std::string_view kName = "my-pg-cache";
+    using ValueType = MyStructure;
+    static constexpr auto kKeyMember = &MyStructure::id;
+    static constexpr const char* kQuery = "select id, bar, updated from test.my_data";
+    static constexpr const char* kUpdatedField = "updated";
+    using UpdatedFieldType = storages::postgres::TimePointTz;
+    using CacheContainer = cache::SharedChunkedMap<int, MyStructure>;
+};
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -286,6 +300,7 @@ using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
 using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
+using MyCache8 = PostgreCache<PostgresExamplePolicy8>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -295,6 +310,7 @@ static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
 static_assert(MyCache7::kIncrementalUpdates);
+static_assert(MyCache8::kIncrementalUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -304,6 +320,7 @@ static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache8::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
 // Update() instantiation test
 [[maybe_unused]] void
@@ -316,6 +333,32 @@ VerifyUpdateCompiles(const components::ComponentConfig& config, const components
     MyCache5 cache5{config, context};
     MyCache6 cache6{config, context};
     MyCache7 cache7{config, context};
+    MyCache8 cache8{config, context};
+}
+
+// An incremental update of a SharedChunkedMap container does not change the
+// previous cache value
+UTEST(PostgreCache, SharedChunkedMapContainer) {
+    using Container = pg_cache::detail::DataCacheContainerType<PostgresExamplePolicy8>;
+
+    Container previous;
+    for (int i = 0; i < 10'000; ++i) {
+        pg_cache::detail::CacheInsertOrAssign(previous, MyStructure{i, "old", {}}, PostgresExamplePolicy8::kKeyMember);
+    }
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("copy");
+    const auto current = pg_cache::detail::CopyContainer(previous, 0, scope_time);
+    pg_cache::detail::CacheInsertOrAssign(*current, MyStructure{1, "new", {}}, PostgresExamplePolicy8::kKeyMember);
+    pg_cache::detail::CacheInsertOrAssign(*current, MyStructure{-1, "new", {}}, PostgresExamplePolicy8::kKeyMember);
+
+    EXPECT_EQ(previous.size(), 10'000);
+    EXPECT_EQ(previous.at(1).bar, "old");
+    EXPECT_FALSE(previous.contains(-1));
+
+    EXPECT_EQ(current->size(), 10'001);
+    EXPECT_EQ(current->at(1).bar, "new");
+    EXPECT_EQ(current->at(-1).bar, "new");
+    EXPECT_EQ(current->at(2).bar, "old");
 }
 
 inline auto SampleOfComponentRegistration() {
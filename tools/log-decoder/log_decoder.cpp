@@ -0,0 +1,84 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <userver/logging/binary_decoder.hpp>
+#include <userver/logging/format.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+struct Config {
+    std::string format = "tskv";
+    std::vector<std::string> files;
+};
+
+Config ParseConfig(int argc, char** argv) {
+    namespace po = boost::program_options;
+
+    Config config;
+    po::options_description desc("Converts logs written in the `binary` format to text.\nAllowed options");
+    desc.add_options()("help,h", "produce help message")(
+        "format,f",
+        po::value(&config.format)->default_value(config.format),
+        "output format (tskv, ltsv, json, json_yadeploy)"
+    )("file", po::value(&config.files)->composing(), "binary log files to decode, standard input by default");
+
+    po::positional_options_description positional;
+    positional.add("file", -1);
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+        po::notify(vm);
+    } catch (const std::exception& ex) {
+        std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+        exit(1);
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << '\n';
+        exit(0);
+    }
+
+    return config;
+}
+
+std::string ReadAll(std::istream& input) {
+    return std::string{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto config = ParseConfig(argc, argv);
+
+    try {
+        const auto format = logging::FormatFromString(config.format);
+
+        std::string output;
+        if (config.files.empty()) {
+            logging::DecodeBinaryLogs(ReadAll(std::cin), format, output);
+        }
+        for (const auto& file : config.files) {
+            std::ifstream input{file, std::ios::binary};
+            if (!input) {
+                std::cerr << "Cannot open '" << file << "'\n";
+                return 1;
+            }
+            logging::DecodeBinaryLogs(ReadAll(input), format, output);
+        }
+        std::cout << output;
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
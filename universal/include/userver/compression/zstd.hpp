@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 
 #include <userver/compression/error.hpp>
@@ -8,6 +9,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace compression::zstd {
 
+/// Compresses the string into a single frame with the content size.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = 1);
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/logging/binary_decoder.hpp
+/// @brief @copybrief logging::DecodeBinaryLogs
+
+#include <string>
+#include <string_view>
+
+#include <userver/logging/format.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+/// @brief Converts logs written in logging::Format::kBinary into a text
+/// format and appends them to `output`.
+///
+/// `output_format` must be one of kTskv, kLtsv, kJson or kJsonYaDeploy.
+/// Records are written in the order of the input. A truncated chunk at the end
+/// of `data` (e.g. the log is still being written) is ignored.
+///
+/// @throws std::runtime_error if `data` is not a binary log
+void DecodeBinaryLogs(std::string_view data, Format output_format, std::string& output);
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
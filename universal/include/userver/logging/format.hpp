@@ -17,6 +17,9 @@ enum class Format {
     kStruct,
     kJson,
     kJsonYaDeploy,
+    /// Compact binary format with interned source locations and tag keys,
+    /// see userver/logging/binary_decoder.hpp for converting it to text
+    kBinary,
 };
 
 /// Parse Format enum from string
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/container/small_vector.hpp>
+
 #include <userver/logging/log_extra.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,6 +27,30 @@ protected:
 
 using LoggerItemRef = LoggerItemBase&;
 
+/// Finished tracing span, passed to the formatters that consume spans without
+/// turning them into tags, see Base::SetSpan()
+struct SpanRecord {
+    // hex encoded ids
+    std::string_view trace_id;
+    std::string_view span_id;
+    std::string_view parent_id;
+    std::string_view name;
+    std::chrono::system_clock::time_point start_time;
+    std::chrono::nanoseconds duration;
+    const LogExtra& tags;
+    // Accumulated times of the tracing::ScopeTime sections
+    const std::unordered_map<std::string, std::chrono::nanoseconds>& timings;
+
+    /// Calls `func(std::string_view key, const LogExtra::Value& value)` for each
+    /// of the `tags`
+    template <typename Func>
+    void ForEachTag(Func&& func) const {
+        for (const auto& [key, value] : *tags.extra_) {
+            func(std::string_view{key}, value.GetValue());
+        }
+    }
+};
+
 class Base {
 public:
     Base() = default;
@@ -34,6 +65,10 @@ public:
 
     virtual void SetText(std::string_view text) = 0;
 
+    /// Receives a whole tracing span instead of its tags.
+    /// @returns false if the span has to be written via AddTag() as well
+    virtual bool SetSpan(const SpanRecord& /*span*/) { return false; }
+
     virtual LoggerItemRef ExtractLoggerItem() = 0;
 };
 
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include <boost/container/small_vector.hpp>
 
@@ -20,6 +24,10 @@ class LogHelper;
 
 namespace logging::impl {
 
+namespace formatters {
+class BinaryDictionary;
+}  // namespace formatters
+
 class TagWriter;
 class LoggerBase;
 
@@ -41,6 +49,16 @@ public:
     virtual formatters::BasePtr
     MakeFormatter(Level level, LogClass log_class, const utils::impl::SourceLocation& location) = 0;
 
+    /// Makes a formatter for a record that was made at `timestamp` and is
+    /// written out later, e.g. by the tail sampling. By default the record gets
+    /// the time of the MakeFormatter call.
+    virtual formatters::BasePtr MakeFormatterAt(
+        Level level,
+        LogClass log_class,
+        const utils::impl::SourceLocation& location,
+        std::chrono::system_clock::time_point timestamp
+    );
+
     virtual void Flush() {}
 
     virtual void SetLevel(Level level);
@@ -49,6 +67,10 @@ public:
 
     bool ShouldLog(Level level) const noexcept;
 
+    /// Whether MakeFormatter returns formatters::Deferred and the Log()
+    /// implementation formats the captured records itself
+    bool IsFormattingDeferred() const noexcept { return is_formatting_deferred_; }
+
     void SetFlushOn(Level level);
 
     bool ShouldFlush(Level level) const;
@@ -58,13 +80,20 @@ public:
 protected:
     virtual bool DoShouldLog(Level level) const noexcept;
 
+    /// Must be called before the logger is used
+    void EnableDeferredFormatting() noexcept { is_formatting_deferred_ = true; }
+
 private:
     std::atomic<Level> level_{Level::kNone};
     std::atomic<Level> flush_level_{Level::kWarning};
+    bool is_formatting_deferred_{false};
 };
 
 struct TextLogItem : formatters::LoggerItemBase {
     utils::SmallString<4096> log_line;
+    // Size of the leading part of log_line that has to be written even if the
+    // record itself is dropped, e.g. the definitions of Format::kBinary
+    std::size_t undroppable_size{0};
 
     TextLogItem() = default;
     explicit TextLogItem(std::string_view str) : log_line(str) {}
@@ -72,15 +101,36 @@ struct TextLogItem : formatters::LoggerItemBase {
 
 class TextLogger : public LoggerBase {
 public:
-    explicit TextLogger(Format format) : format_(format) {}
+    /// @param deferred_formatting capture the records on the calling thread
+    /// and format them with RenderDeferred later, is ignored for Format::kBinary
+    explicit TextLogger(Format format, bool deferred_formatting = false);
+
+    ~TextLogger() override;
 
     Format GetFormat() const noexcept;
 
     formatters::BasePtr MakeFormatter(Level level, LogClass log_class, const utils::impl::SourceLocation& location)
         override;
 
+    formatters::BasePtr MakeFormatterAt(
+        Level level,
+        LogClass log_class,
+        const utils::impl::SourceLocation& location,
+        std::chrono::system_clock::time_point timestamp
+    ) override;
+
+protected:
+    /// For Format::kBinary, makes the following records repeat the stream
+    /// header and the definitions. Must be called after the output is reopened.
+    void StartNewBinaryStream() const noexcept;
+
+    /// For the loggers with IsFormattingDeferred(), formats a captured record
+    /// and appends it to `out`
+    void RenderDeferred(std::string_view record, std::string& out) const;
+
 private:
     const Format format_;
+    const std::unique_ptr<formatters::BinaryDictionary> binary_dictionary_;
 };
 
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept;
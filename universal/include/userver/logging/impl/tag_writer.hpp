@@ -54,6 +54,10 @@ public:
     // automatically.
     void ExtendLogExtra(const LogExtra& extra);
 
+    // Passes the span to the logger as is. Returns false if the logger needs the
+    // span as tags, see formatters::Base::SetSpan().
+    bool PutSpan(const formatters::SpanRecord& span);
+
 private:
     friend class logging::LogHelper;
 
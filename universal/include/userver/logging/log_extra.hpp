@@ -30,6 +30,10 @@ class LogHelper;
 
 namespace impl {
 class TagWriter;
+
+namespace formatters {
+struct SpanRecord;
+}  // namespace formatters
 }  // namespace impl
 
 /// Extra tskv fields storage
@@ -111,6 +115,7 @@ public:
 
     friend class LogHelper;
     friend class impl::TagWriter;
+    friend struct impl::formatters::SpanRecord;
     friend class tracing::Span;
     friend class tracing::TagScope;
 
@@ -28,6 +28,10 @@ namespace impl {
 
 class TagWriter;
 
+namespace formatters {
+struct SpanRecord;
+}  // namespace formatters
+
 struct Noop {};
 
 struct HexBase {
@@ -185,6 +189,8 @@ private:
 
     void InternalLoggingError(std::string_view message) noexcept;
 
+    bool PutSpan(const impl::formatters::SpanRecord& span) noexcept;
+
     void PutFloatingPoint(float value);
     void PutFloatingPoint(double value);
     void PutFloatingPoint(long double value);
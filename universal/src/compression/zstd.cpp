@@ -14,6 +14,17 @@ namespace {
 const size_t kDecompressBufferSize = ZSTD_DStreamOutSize();
 }  // namespace
 
+std::string Compress(std::string_view data, int level) {
+    std::string compressed(ZSTD_compressBound(data.size()), '\0');
+    const auto compressed_size = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), level);
+    if (ZSTD_isError(compressed_size)) {
+        throw CompressionError(fmt::format("Compression failed: {}", ZSTD_getErrorName(compressed_size)));
+    }
+
+    compressed.resize(compressed_size);
+    return compressed;
+}
+
 std::string DecompressStream(std::string_view compressed, size_t max_size) {
     std::string decompressed;
     std::string buf(kDecompressBufferSize, '\0');
@@ -60,4 +60,15 @@ TEST(Zstd, TestOverflow) {
     );
 }
 
+TEST(Zstd, CompressDecompress) {
+    std::string str;
+    for (int i = 0; i < 10'000; ++i) str += std::to_string(i % 100);
+
+    const auto compressed = compression::zstd::Compress(str);
+    EXPECT_LT(compressed.size(), str.size());
+    EXPECT_EQ(compression::zstd::Decompress(compressed, str.size()), str);
+
+    EXPECT_EQ(compression::zstd::Decompress(compression::zstd::Compress(""), 0), "");
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,362 @@
+#include <userver/logging/binary_decoder.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <logging/impl/binary_format.hpp>
+#include <logging/timestamp.hpp>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging {
+
+namespace {
+
+namespace binary = impl::binary;
+
+constexpr std::string_view kUnknown = "<unknown>";
+
+struct Location final {
+    std::string_view file{kUnknown};
+    std::string_view function{kUnknown};
+    std::uint64_t line{0};
+};
+
+// Records and definitions of a single logger instance. Definitions of a record
+// may be written after it by another thread, so records are rendered after the
+// whole session is read.
+struct Session final {
+    bool has_header{false};
+    std::uint64_t stream_id{0};
+    std::int64_t base_time_us{0};
+    std::unordered_map<std::uint64_t, Location> locations;
+    std::unordered_map<std::uint64_t, std::string_view> keys;
+    std::vector<std::string_view> records;
+};
+
+using Value = std::variant<std::string_view, std::int64_t, std::uint64_t, double>;
+
+[[noreturn]] void ThrowMalformed(std::size_t offset, std::string_view what) {
+    throw std::runtime_error(fmt::format("Malformed binary log at offset {}: {}", offset, what));
+}
+
+void ReadHeader(std::string_view payload, std::size_t offset, std::vector<Session>& sessions) {
+    if (payload.substr(0, binary::kMagic.size()) != binary::kMagic) {
+        ThrowMalformed(offset, "bad header magic");
+    }
+
+    binary::Reader reader{payload.substr(binary::kMagic.size())};
+    std::uint64_t version{};
+    std::uint64_t stream_id{};
+    std::uint64_t base_time_us{};
+    if (!reader.ReadVarint(version) || !reader.ReadVarint(stream_id) || !reader.ReadVarint(base_time_us)) {
+        ThrowMalformed(offset, "truncated header");
+    }
+    if (version != binary::kVersion) {
+        ThrowMalformed(offset, fmt::format("unsupported version {}", version));
+    }
+
+    // A reopened file repeats the header of the same stream id, other ids
+    // come from another logger instance, e.g. after a restart
+    if (sessions.back().has_header && sessions.back().stream_id != stream_id) {
+        sessions.emplace_back();
+    }
+    auto& session = sessions.back();
+    session.has_header = true;
+    session.stream_id = stream_id;
+    session.base_time_us = static_cast<std::int64_t>(base_time_us);
+}
+
+std::vector<Session> ReadSessions(std::string_view data) {
+    std::vector<Session> sessions(1);
+
+    binary::Reader reader{data};
+    while (!reader.IsEmpty()) {
+        const auto offset = reader.GetPosition();
+        std::uint8_t type{};
+        std::string_view payload;
+        if (!reader.ReadByte(type)) {
+            break;
+        }
+        if (type == '\n') {
+            // Separator of the runs that older versions of the file sinks
+            // wrote into binary logs as well
+            continue;
+        }
+        if (!reader.ReadString(payload)) {
+            // The last chunk is still being written
+            break;
+        }
+
+        binary::Reader chunk{payload};
+        switch (static_cast<binary::ChunkType>(type)) {
+            case binary::ChunkType::kHeader:
+                ReadHeader(payload, offset, sessions);
+                break;
+
+            case binary::ChunkType::kLocation: {
+                std::uint64_t id{};
+                Location location;
+                if (!chunk.ReadVarint(id) || !chunk.ReadVarint(location.line) || !chunk.ReadString(location.file) ||
+                    !chunk.ReadString(location.function)) {
+                    ThrowMalformed(offset, "truncated location");
+                }
+                sessions.back().locations[id] = location;
+                break;
+            }
+
+            case binary::ChunkType::kKey: {
+                std::uint64_t id{};
+                std::string_view key;
+                if (!chunk.ReadVarint(id) || !chunk.ReadString(key)) {
+                    ThrowMalformed(offset, "truncated key");
+                }
+                sessions.back().keys[id] = key;
+                break;
+            }
+
+            case binary::ChunkType::kRecord:
+                sessions.back().records.push_back(payload);
+                break;
+
+            default:
+                ThrowMalformed(offset, fmt::format("unknown chunk type {}", type));
+        }
+    }
+
+    return sessions;
+}
+
+bool ReadValue(binary::Reader& reader, Value& value) {
+    std::uint8_t type{};
+    if (!reader.ReadByte(type)) {
+        return false;
+    }
+
+    switch (static_cast<binary::ValueType>(type)) {
+        case binary::ValueType::kString: {
+            std::string_view result;
+            if (!reader.ReadString(result)) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+        case binary::ValueType::kSigned: {
+            std::int64_t result{};
+            if (!reader.ReadSigned(result)) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+        case binary::ValueType::kUnsigned: {
+            std::uint64_t result{};
+            if (!reader.ReadVarint(result)) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+        case binary::ValueType::kDouble: {
+            double result{};
+            if (!reader.ReadDouble(result)) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+class TskvWriter final {
+public:
+    TskvWriter(Format format, std::string& output) : format_(format), output_(output) {}
+
+    void Begin(Level level, TimePoint timestamp, const Location& location) {
+        fmt::format_to(
+            std::back_inserter(output_),
+            FMT_COMPILE("{}{}{}.{:06}\tlevel{}{}\tmodule{}{} ( {}:{} )"),
+            (format_ == Format::kTskv) ? "tskv\ttimestamp" : "timestamp",
+            Separator(),
+            GetCurrentTimeString(timestamp).ToStringView(),
+            FractionalMicroseconds(timestamp),
+            Separator(),
+            ToUpperCaseString(level),
+            Separator(),
+            location.function,
+            location.file,
+            location.line
+        );
+    }
+
+    void AddTag(std::string_view key, const Value& value) {
+        output_ += utils::encoding::kTskvPairsSeparator;
+        if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+            output_ += key;
+        } else {
+            utils::encoding::EncodeTskv(output_, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+        }
+        output_ += Separator();
+
+        std::visit(
+            [this](const auto& x) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::string_view>) {
+                    utils::encoding::EncodeTskv(output_, x, utils::encoding::EncodeTskvMode::kValue);
+                } else {
+                    fmt::format_to(std::back_inserter(output_), FMT_COMPILE("{}"), x);
+                }
+            },
+            value
+        );
+    }
+
+    void Finish() { output_ += '\n'; }
+
+private:
+    char Separator() const noexcept { return (format_ == Format::kTskv) ? '=' : ':'; }
+
+    const Format format_;
+    std::string& output_;
+};
+
+class JsonWriter final {
+public:
+    JsonWriter(Format format, std::string& output) : format_(format), output_(output) {}
+
+    void Begin(Level level, TimePoint timestamp, const Location& location) {
+        sb_ = std::make_unique<formats::json::StringBuilder>();
+        object_.emplace(*sb_);
+
+        sb_->Key((format_ == Format::kJson) ? "timestamp" : "@timestamp");
+        sb_->WriteString(fmt::format(
+            FMT_COMPILE("{}.{:06}"), GetCurrentTimeString(timestamp).ToStringView(), FractionalMicroseconds(timestamp)
+        ));
+
+        sb_->Key((format_ == Format::kJson) ? "level" : "levelStr");
+        sb_->WriteString(ToUpperCaseString(level));
+
+        sb_->Key("module");
+        sb_->WriteString(fmt::format(FMT_COMPILE("{} ( {}:{} )"), location.function, location.file, location.line));
+    }
+
+    void AddTag(std::string_view key, const Value& value) {
+        sb_->Key((format_ == Format::kJsonYaDeploy && key == "text") ? "message" : key);
+        std::visit(
+            [this](const auto& x) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::string_view>) {
+                    sb_->WriteString(x);
+                } else {
+                    WriteToStream(x, *sb_);
+                }
+            },
+            value
+        );
+    }
+
+    void Finish() {
+        object_.reset();
+        output_ += sb_->GetString();
+        output_ += '\n';
+        sb_.reset();
+    }
+
+private:
+    const Format format_;
+    std::string& output_;
+    std::unique_ptr<formats::json::StringBuilder> sb_;
+    std::optional<formats::json::StringBuilder::ObjectGuard> object_;
+};
+
+template <typename Writer>
+void WriteRecord(const Session& session, std::string_view record, Writer& writer) {
+    binary::Reader reader{record};
+
+    std::uint8_t level{};
+    std::int64_t time_delta_us{};
+    std::uint64_t location_id{};
+    if (!reader.ReadByte(level) || !reader.ReadSigned(time_delta_us) || !reader.ReadVarint(location_id)) {
+        throw std::runtime_error("Malformed binary log: truncated record");
+    }
+    if (level >= kLevelMax) {
+        throw std::runtime_error(fmt::format("Malformed binary log: bad level {}", level));
+    }
+
+    const auto location_it = session.locations.find(location_id);
+    const auto timestamp = TimePoint{} + std::chrono::microseconds{session.base_time_us + time_delta_us};
+    writer.Begin(
+        static_cast<Level>(level),
+        timestamp,
+        location_it != session.locations.end() ? location_it->second : Location{}
+    );
+
+    while (!reader.IsEmpty()) {
+        std::uint64_t key_id{};
+        Value value;
+        if (!reader.ReadVarint(key_id) || !ReadValue(reader, value)) {
+            throw std::runtime_error("Malformed binary log: truncated tag");
+        }
+        const auto key_it = session.keys.find(key_id);
+        writer.AddTag(key_it != session.keys.end() ? key_it->second : kUnknown, value);
+    }
+
+    writer.Finish();
+}
+
+template <typename Writer>
+void WriteSessions(const std::vector<Session>& sessions, Writer& writer) {
+    for (const auto& session : sessions) {
+        for (const auto record : session.records) {
+            WriteRecord(session, record, writer);
+        }
+    }
+}
+
+}  // namespace
+
+void DecodeBinaryLogs(std::string_view data, Format output_format, std::string& output) {
+    const auto sessions = ReadSessions(data);
+
+    switch (output_format) {
+        case Format::kTskv:
+        case Format::kLtsv: {
+            TskvWriter writer{output_format, output};
+            WriteSessions(sessions, writer);
+            return;
+        }
+
+        case Format::kJson:
+        case Format::kJsonYaDeploy: {
+            JsonWriter writer{output_format, output};
+            WriteSessions(sessions, writer);
+            return;
+        }
+
+        case Format::kRaw:
+        case Format::kStruct:
+        case Format::kBinary:
+            break;
+    }
+
+    UINVARIANT(false, "Binary logs can only be decoded into tskv, ltsv or json formats");
+}
+
+}  // namespace logging
+
+USERVER_NAMESPACE_END
@@ -16,7 +16,8 @@ constexpr utils::TrivialBiMap kLogFormats = [](auto selector) {
         .Case("ltsv", Format::kLtsv)
         .Case("raw", Format::kRaw)
         .Case("json", Format::kJson)
-        .Case("json_yadeploy", Format::kJsonYaDeploy);
+        .Case("json_yadeploy", Format::kJsonYaDeploy)
+        .Case("binary", Format::kBinary);
 };
 
 }  // namespace
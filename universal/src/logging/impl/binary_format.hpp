@@ -0,0 +1,143 @@
+#pragma once
+
+/// Wire format of logging::Format::kBinary.
+///
+/// The log is a sequence of chunks: [type: u8][payload size: varint][payload].
+/// All the integers are LEB128 varints, signed ones are zigzag-encoded,
+/// strings are [size: varint][bytes].
+///
+/// * kHeader: "ubl", version, stream id, base timestamp in microseconds
+///   since epoch. Starts a stream, is repeated after the log is reopened.
+/// * kLocation: id, line, file, function. Defines a source location.
+/// * kKey: id, key. Defines a tag key.
+/// * kRecord: level: u8, timestamp delta from the base timestamp in
+///   microseconds: signed, location id, then [key id, value] pairs until the
+///   end of the payload. Value is [ValueType: u8][value].
+///
+/// Definitions are written once per stream right before the first record that
+/// needs them, but records of other threads may get to the file earlier, so
+/// decoders should collect all the definitions of a stream first.
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+inline constexpr std::string_view kMagic = "ubl";
+inline constexpr std::uint64_t kVersion = 1;
+
+enum class ChunkType : std::uint8_t {
+    kHeader = 1,
+    kLocation = 2,
+    kKey = 3,
+    kRecord = 4,
+};
+
+enum class ValueType : std::uint8_t {
+    kString = 0,
+    kSigned = 1,
+    kUnsigned = 2,
+    kDouble = 3,
+};
+
+inline constexpr std::size_t kMaxVarintSize = 10;
+
+template <typename Buffer>
+void WriteVarint(Buffer& buffer, std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+template <typename Buffer>
+void WriteSigned(Buffer& buffer, std::int64_t value) {
+    WriteVarint(buffer, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+template <typename Buffer>
+void WriteString(Buffer& buffer, std::string_view value) {
+    WriteVarint(buffer, value.size());
+    buffer.append(value);
+}
+
+template <typename Buffer>
+void WriteDouble(Buffer& buffer, double value) {
+    static_assert(sizeof(double) == sizeof(std::uint64_t));
+    std::uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<char>(bits >> (i * 8)));
+    }
+}
+
+template <typename Buffer>
+void WriteChunk(Buffer& buffer, ChunkType type, std::string_view payload) {
+    buffer.push_back(static_cast<char>(type));
+    WriteString(buffer, payload);
+}
+
+/// Bounds-checked reader, every method returns false on truncated input
+class Reader final {
+public:
+    explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+    bool IsEmpty() const noexcept { return pos_ == data_.size(); }
+
+    std::size_t GetPosition() const noexcept { return pos_; }
+
+    bool ReadByte(std::uint8_t& value) noexcept {
+        if (pos_ == data_.size()) return false;
+        value = static_cast<std::uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    bool ReadVarint(std::uint64_t& value) noexcept {
+        value = 0;
+        for (std::size_t i = 0; i < kMaxVarintSize; ++i) {
+            std::uint8_t byte{};
+            if (!ReadByte(byte)) return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << (i * 7);
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool ReadSigned(std::int64_t& value) noexcept {
+        std::uint64_t raw{};
+        if (!ReadVarint(raw)) return false;
+        value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+        return true;
+    }
+
+    bool ReadString(std::string_view& value) noexcept {
+        std::uint64_t size{};
+        if (!ReadVarint(size) || size > data_.size() - pos_) return false;
+        value = data_.substr(pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool ReadDouble(double& value) noexcept {
+        if (data_.size() - pos_ < 8) return false;
+        std::uint64_t bits{};
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data_[pos_ + i])) << (i * 8);
+        }
+        pos_ += 8;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+private:
+    std::string_view data_;
+    std::size_t pos_{0};
+};
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,227 @@
+#include <logging/impl/formatters/binary.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <logging/impl/binary_format.hpp>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::formatters {
+
+namespace {
+
+std::atomic<std::uint64_t> dictionary_serial{0};
+
+// LOG_* macros pass string literals into SourceLocation, so the pointers
+// identify the location and the cache does not need to compare strings
+using LocationPtrKey = std::tuple<const char*, const char*, std::uint_least32_t>;
+
+struct LocationPtrKeyHash {
+    std::size_t operator()(const LocationPtrKey& key) const noexcept { return boost::hash_value(key); }
+};
+
+struct DictionaryCache final {
+    std::uint64_t stream{0};
+    std::unordered_map<LocationPtrKey, std::uint64_t, LocationPtrKeyHash> locations;
+    utils::impl::TransparentMap<std::string, std::uint64_t> keys;
+};
+
+// Ids known to be defined in the current stream, to avoid locking the
+// dictionary mutex on every record
+struct ThreadCache final {
+    // Cached dictionaries are never cleaned up individually, so the amount of
+    // them is limited instead
+    static constexpr std::size_t kMaxDictionaries = 16;
+
+    std::unordered_map<std::uint64_t, DictionaryCache> dictionaries;
+};
+
+compiler::ThreadLocal local_cache = [] { return ThreadCache{}; };
+
+DictionaryCache& GetDictionaryCache(ThreadCache& cache, std::uint64_t serial, std::uint64_t stream) {
+    auto it = cache.dictionaries.find(serial);
+    if (it == cache.dictionaries.end()) {
+        if (cache.dictionaries.size() >= ThreadCache::kMaxDictionaries) {
+            cache.dictionaries.clear();
+        }
+        it = cache.dictionaries.emplace(serial, DictionaryCache{}).first;
+    }
+
+    auto& result = it->second;
+    if (result.stream != stream) {
+        result.locations.clear();
+        result.keys.clear();
+        result.stream = stream;
+    }
+    return result;
+}
+
+}  // namespace
+
+std::size_t BinaryDictionary::LocationKeyHash::operator()(const LocationKey& key) const noexcept {
+    return boost::hash_value(key);
+}
+
+BinaryDictionary::BinaryDictionary()
+    : serial_(++dictionary_serial),
+      stream_id_(utils::Rand()),
+      base_time_(std::chrono::system_clock::now()) {}
+
+void BinaryDictionary::WriteHeaderIfNeeded(Buffer& out) {
+    const auto stream = stream_.load();
+    if (header_stream_.load() == stream || header_stream_.exchange(stream) == stream) {
+        return;
+    }
+
+    utils::SmallString<64> payload;
+    payload.append(binary::kMagic);
+    binary::WriteVarint(payload, binary::kVersion);
+    binary::WriteVarint(payload, stream_id_);
+    binary::WriteVarint(
+        payload,
+        std::chrono::duration_cast<std::chrono::microseconds>(base_time_.time_since_epoch()).count()
+    );
+    binary::WriteChunk(out, binary::ChunkType::kHeader, payload);
+}
+
+std::uint64_t BinaryDictionary::GetLocationId(const utils::impl::SourceLocation& location, Buffer& out) {
+    const auto stream = stream_.load();
+    const LocationPtrKey ptr_key{
+        location.GetFileName().data(), location.GetFunctionName().data(), location.GetLine()};
+    {
+        auto cache = local_cache.Use();
+        auto& dictionary_cache = GetDictionaryCache(*cache, serial_, stream);
+        const auto it = dictionary_cache.locations.find(ptr_key);
+        if (it != dictionary_cache.locations.end()) {
+            return it->second;
+        }
+    }
+
+    std::uint64_t id{};
+    bool should_define{};
+    {
+        const std::lock_guard lock(mutex_);
+        auto [it, inserted] = locations_.try_emplace(LocationKey{
+            std::string{location.GetFileName()}, std::string{location.GetFunctionName()}, location.GetLine()});
+        if (inserted) {
+            it->second.id = next_id_++;
+        }
+        should_define = it->second.stream != stream;
+        it->second.stream = stream;
+        id = it->second.id;
+    }
+
+    if (should_define) {
+        utils::SmallString<256> payload;
+        binary::WriteVarint(payload, id);
+        binary::WriteVarint(payload, location.GetLine());
+        binary::WriteString(payload, location.GetFileName());
+        binary::WriteString(payload, location.GetFunctionName());
+        binary::WriteChunk(out, binary::ChunkType::kLocation, payload);
+    }
+
+    auto cache = local_cache.Use();
+    GetDictionaryCache(*cache, serial_, stream).locations.emplace(ptr_key, id);
+    return id;
+}
+
+std::uint64_t BinaryDictionary::GetKeyId(std::string_view key, Buffer& out) {
+    const auto stream = stream_.load();
+    {
+        auto cache = local_cache.Use();
+        auto& dictionary_cache = GetDictionaryCache(*cache, serial_, stream);
+        if (const auto* id = utils::impl::FindTransparentOrNullptr(dictionary_cache.keys, key)) {
+            return *id;
+        }
+    }
+
+    std::uint64_t id{};
+    bool should_define{};
+    {
+        const std::lock_guard lock(mutex_);
+        auto* entry = utils::impl::FindTransparentOrNullptr(keys_, key);
+        if (!entry) {
+            entry = &keys_.emplace(std::string{key}, Entry{next_id_++, 0}).first->second;
+        }
+        should_define = entry->stream != stream;
+        entry->stream = stream;
+        id = entry->id;
+    }
+
+    if (should_define) {
+        utils::SmallString<64> payload;
+        binary::WriteVarint(payload, id);
+        binary::WriteString(payload, key);
+        binary::WriteChunk(out, binary::ChunkType::kKey, payload);
+    }
+
+    auto cache = local_cache.Use();
+    GetDictionaryCache(*cache, serial_, stream).keys.emplace(std::string{key}, id);
+    return id;
+}
+
+void BinaryDictionary::StartNewStream() noexcept { ++stream_; }
+
+Binary::Binary(
+    Level level,
+    const utils::impl::SourceLocation& location,
+    BinaryDictionary& dictionary,
+    std::chrono::system_clock::time_point timestamp
+)
+    : dictionary_(dictionary) {
+    dictionary_.WriteHeaderIfNeeded(item_.log_line);
+
+    record_.push_back(static_cast<char>(level));
+    binary::WriteSigned(
+        record_,
+        std::chrono::duration_cast<std::chrono::microseconds>(timestamp - dictionary_.GetBaseTime()).count()
+    );
+    binary::WriteVarint(record_, dictionary_.GetLocationId(location, item_.log_line));
+}
+
+void Binary::AddTag(std::string_view key, const LogExtra::Value& value) {
+    binary::WriteVarint(record_, dictionary_.GetKeyId(key, item_.log_line));
+    std::visit(
+        [this](const auto& x) {
+            using Type = std::decay_t<decltype(x)>;
+            if constexpr (std::is_same_v<Type, std::string>) {
+                record_.push_back(static_cast<char>(binary::ValueType::kString));
+                binary::WriteString(record_, x);
+            } else if constexpr (std::is_floating_point_v<Type>) {
+                record_.push_back(static_cast<char>(binary::ValueType::kDouble));
+                binary::WriteDouble(record_, x);
+            } else if constexpr (std::is_signed_v<Type>) {
+                record_.push_back(static_cast<char>(binary::ValueType::kSigned));
+                binary::WriteSigned(record_, x);
+            } else {
+                record_.push_back(static_cast<char>(binary::ValueType::kUnsigned));
+                binary::WriteVarint(record_, x);
+            }
+        },
+        value
+    );
+}
+
+void Binary::AddTag(std::string_view key, std::string_view value) {
+    binary::WriteVarint(record_, dictionary_.GetKeyId(key, item_.log_line));
+    record_.push_back(static_cast<char>(binary::ValueType::kString));
+    binary::WriteString(record_, value);
+}
+
+void Binary::SetText(std::string_view text) { AddTag("text", text); }
+
+LoggerItemRef Binary::ExtractLoggerItem() {
+    // The following records reference the definitions, so the logger keeps
+    // them even if it drops this record
+    item_.undroppable_size = item_.log_line.size();
+    binary::WriteChunk(item_.log_line, binary::ChunkType::kRecord, record_);
+    return item_;
+}
+
+}  // namespace logging::impl::formatters
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <userver/logging/impl/formatters/base.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/small_string.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::formatters {
+
+/// @brief Per-logger dictionary of the source locations and tag keys for
+/// Format::kBinary. Each of them is written to the log once per stream and is
+/// referenced by id afterwards.
+class BinaryDictionary final {
+public:
+    using Buffer = utils::SmallString<4096>;
+
+    BinaryDictionary();
+
+    BinaryDictionary(BinaryDictionary&&) = delete;
+    BinaryDictionary& operator=(BinaryDictionary&&) = delete;
+
+    /// Appends the stream header to `out` if it was not written in the
+    /// current stream yet
+    void WriteHeaderIfNeeded(Buffer& out);
+
+    /// Returns the id of the location, appending its definition to `out` if
+    /// it was not written in the current stream yet
+    std::uint64_t GetLocationId(const utils::impl::SourceLocation& location, Buffer& out);
+
+    /// Returns the id of the tag key, appending its definition to `out` if
+    /// it was not written in the current stream yet
+    std::uint64_t GetKeyId(std::string_view key, Buffer& out);
+
+    std::chrono::system_clock::time_point GetBaseTime() const noexcept { return base_time_; }
+
+    /// Makes the dictionary write the header and all the definitions again,
+    /// e.g. after the log file was reopened
+    void StartNewStream() noexcept;
+
+private:
+    struct Entry {
+        std::uint64_t id{0};
+        std::uint64_t stream{0};
+    };
+
+    using LocationKey = std::tuple<std::string, std::string, std::uint_least32_t>;
+
+    struct LocationKeyHash {
+        std::size_t operator()(const LocationKey& key) const noexcept;
+    };
+
+    const std::uint64_t serial_;
+    const std::uint64_t stream_id_;
+    const std::chrono::system_clock::time_point base_time_;
+    std::atomic<std::uint64_t> stream_{1};
+    std::atomic<std::uint64_t> header_stream_{0};
+
+    std::mutex mutex_;
+    std::uint64_t next_id_{0};
+    std::unordered_map<LocationKey, Entry, LocationKeyHash> locations_;
+    utils::impl::TransparentMap<std::string, Entry> keys_;
+};
+
+class Binary final : public Base {
+public:
+    Binary(
+        Level level,
+        const utils::impl::SourceLocation& location,
+        BinaryDictionary& dictionary,
+        std::chrono::system_clock::time_point timestamp
+    );
+
+    void AddTag(std::string_view key, const LogExtra::Value& value) override;
+
+    void AddTag(std::string_view key, std::string_view value) override;
+
+    void SetText(std::string_view text) override;
+
+    LoggerItemRef ExtractLoggerItem() override;
+
+private:
+    BinaryDictionary& dictionary_;
+    // definitions, followed by the record chunk; the definitions are
+    // TextLogItem::undroppable_size
+    TextLogItem item_;
+    utils::SmallString<1024> record_;
+};
+
+}  // namespace logging::impl::formatters
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,315 @@
+#include <logging/impl/formatters/deferred.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <logging/impl/formatters/json.hpp>
+#include <logging/impl/formatters/tskv.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::formatters {
+
+namespace {
+
+// The record is [RecordHeader][file name][function name], followed by entries:
+// * kTag: [key size: u32][key][LogExtra::Value index: u8][value]
+// * kText: [size: u32][text]
+// * kTextValue: [TextValueType: u8][value]
+// Strings are [size: u32][bytes], other values are copied as is.
+struct RecordHeader final {
+    std::chrono::system_clock::time_point timestamp;
+    std::uint32_t line;
+    std::uint32_t file_size;
+    std::uint32_t function_size;
+    Level level;
+};
+
+enum class EntryType : std::uint8_t {
+    kTag,
+    kText,
+    kTextValue,
+};
+
+enum class TextValueType : std::uint8_t {
+    kBool,
+    kSigned,
+    kUnsigned,
+    kFloat,
+    kDouble,
+    kLongDouble,
+};
+
+template <typename T>
+constexpr TextValueType kTextValueType = std::is_same_v<T, bool>                 ? TextValueType::kBool
+                                         : std::is_same_v<T, long long>          ? TextValueType::kSigned
+                                         : std::is_same_v<T, unsigned long long> ? TextValueType::kUnsigned
+                                         : std::is_same_v<T, float>              ? TextValueType::kFloat
+                                         : std::is_same_v<T, double>             ? TextValueType::kDouble
+                                                                                 : TextValueType::kLongDouble;
+
+// Upper bound of the formatted size of a number, to stop the text at
+// approximately the same size as the immediate formatting does
+constexpr std::size_t kTextValueSizeEstimate = 24;
+
+constexpr std::size_t kStringIndex = 0;
+static_assert(std::is_same_v<std::variant_alternative_t<kStringIndex, LogExtra::Value>, std::string>);
+
+using Buffer = decltype(TextLogItem::log_line);
+
+template <typename T>
+void WriteTrivial(Buffer& buffer, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    buffer.append(std::string_view{reinterpret_cast<const char*>(&value), sizeof(value)});
+}
+
+void WriteString(Buffer& buffer, std::string_view value) {
+    WriteTrivial(buffer, static_cast<std::uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+class Reader final {
+public:
+    explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+    bool IsEmpty() const noexcept { return data_.empty(); }
+
+    template <typename T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        UINVARIANT(data_.size() >= sizeof(T), "Truncated deferred log record");
+        T result;
+        std::memcpy(&result, data_.data(), sizeof(T));
+        data_.remove_prefix(sizeof(T));
+        return result;
+    }
+
+    std::string_view ReadBytes(std::size_t size) {
+        UINVARIANT(data_.size() >= size, "Truncated deferred log record");
+        const auto result = data_.substr(0, size);
+        data_.remove_prefix(size);
+        return result;
+    }
+
+    std::string_view ReadString() { return ReadBytes(Read<std::uint32_t>()); }
+
+private:
+    std::string_view data_;
+};
+
+template <std::size_t Index = kStringIndex + 1>
+void ReplayTag(Base& formatter, std::string_view key, std::size_t index, Reader& reader) {
+    if constexpr (Index < std::variant_size_v<LogExtra::Value>) {
+        if (index == Index) {
+            using Type = std::variant_alternative_t<Index, LogExtra::Value>;
+            formatter.AddTag(key, LogExtra::Value{std::in_place_index<Index>, reader.Read<Type>()});
+        } else {
+            ReplayTag<Index + 1>(formatter, key, index, reader);
+        }
+    } else {
+        UINVARIANT(false, "Unknown tag type in a deferred log record");
+    }
+}
+
+template <typename T>
+void FormatTextValue(fmt::memory_buffer& text, Reader& reader) {
+    fmt::format_to(fmt::appender(text), FMT_COMPILE("{}"), reader.Read<T>());
+}
+
+void ReplayTextValue(fmt::memory_buffer& text, Reader& reader) {
+    switch (static_cast<TextValueType>(reader.Read<std::uint8_t>())) {
+        case TextValueType::kBool:
+            FormatTextValue<bool>(text, reader);
+            return;
+        case TextValueType::kSigned:
+            FormatTextValue<long long>(text, reader);
+            return;
+        case TextValueType::kUnsigned:
+            FormatTextValue<unsigned long long>(text, reader);
+            return;
+        case TextValueType::kFloat:
+            FormatTextValue<float>(text, reader);
+            return;
+        case TextValueType::kDouble:
+            FormatTextValue<double>(text, reader);
+            return;
+        case TextValueType::kLongDouble:
+            FormatTextValue<long double>(text, reader);
+            return;
+    }
+    UINVARIANT(false, "Unknown text value type in a deferred log record");
+}
+
+void ReplayEntries(Reader& reader, Base& formatter) {
+    fmt::memory_buffer text;
+    while (!reader.IsEmpty()) {
+        switch (static_cast<EntryType>(reader.Read<std::uint8_t>())) {
+            case EntryType::kTag: {
+                const auto key = reader.ReadString();
+                const auto index = reader.Read<std::uint8_t>();
+                if (index == kStringIndex) {
+                    formatter.AddTag(key, reader.ReadString());
+                } else {
+                    ReplayTag(formatter, key, index, reader);
+                }
+                break;
+            }
+            case EntryType::kText:
+                text.append(reader.ReadString());
+                break;
+            case EntryType::kTextValue:
+                ReplayTextValue(text, reader);
+                break;
+            default:
+                UINVARIANT(false, "Unknown entry type in a deferred log record");
+        }
+    }
+
+    formatter.SetText({text.data(), text.size()});
+}
+
+void Replay(Reader& reader, Base& formatter, std::string& out) {
+    ReplayEntries(reader, formatter);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    const auto& item = static_cast<const TextLogItem&>(formatter.ExtractLoggerItem());
+    out.append(item.log_line.data(), item.log_line.size());
+}
+
+}  // namespace
+
+Deferred::Deferred(
+    Level level,
+    const utils::impl::SourceLocation& location,
+    std::chrono::system_clock::time_point timestamp
+) {
+    const auto file = location.GetFileName();
+    const auto function = location.GetFunctionName();
+    const RecordHeader header{
+        timestamp,
+        location.GetLine(),
+        static_cast<std::uint32_t>(file.size()),
+        static_cast<std::uint32_t>(function.size()),
+        level,
+    };
+    WriteTrivial(item_.log_line, header);
+    item_.log_line.append(file);
+    item_.log_line.append(function);
+}
+
+void Deferred::AddTag(std::string_view key, const LogExtra::Value& value) {
+    item_.log_line.push_back(static_cast<char>(EntryType::kTag));
+    WriteString(item_.log_line, key);
+    item_.log_line.push_back(static_cast<char>(value.index()));
+    std::visit(
+        [this](const auto& x) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::string>) {
+                WriteString(item_.log_line, x);
+            } else {
+                WriteTrivial(item_.log_line, x);
+            }
+        },
+        value
+    );
+    last_text_part_offset_ = 0;
+}
+
+void Deferred::AddTag(std::string_view key, std::string_view value) {
+    item_.log_line.push_back(static_cast<char>(EntryType::kTag));
+    WriteString(item_.log_line, key);
+    item_.log_line.push_back(static_cast<char>(kStringIndex));
+    WriteString(item_.log_line, value);
+    last_text_part_offset_ = 0;
+}
+
+void Deferred::AddText(std::string_view text) {
+    text_size_ += text.size();
+    if (last_text_part_offset_ != 0) {
+        std::uint32_t size{};
+        std::memcpy(&size, item_.log_line.data() + last_text_part_offset_, sizeof(size));
+        size += text.size();
+        std::memcpy(item_.log_line.data() + last_text_part_offset_, &size, sizeof(size));
+        item_.log_line.append(text);
+        return;
+    }
+
+    item_.log_line.push_back(static_cast<char>(EntryType::kText));
+    last_text_part_offset_ = item_.log_line.size();
+    WriteString(item_.log_line, text);
+}
+
+template <typename T>
+void Deferred::DoAddValue(T value) {
+    text_size_ += kTextValueSizeEstimate;
+    item_.log_line.push_back(static_cast<char>(EntryType::kTextValue));
+    item_.log_line.push_back(static_cast<char>(kTextValueType<T>));
+    WriteTrivial(item_.log_line, value);
+    last_text_part_offset_ = 0;
+}
+
+void Deferred::AddValue(bool value) { DoAddValue(value); }
+
+void Deferred::AddValue(long long value) { DoAddValue(value); }
+
+void Deferred::AddValue(unsigned long long value) { DoAddValue(value); }
+
+void Deferred::AddValue(float value) { DoAddValue(value); }
+
+void Deferred::AddValue(double value) { DoAddValue(value); }
+
+void Deferred::AddValue(long double value) { DoAddValue(value); }
+
+void DispatchDeferred(std::string_view record, LogClass log_class, LoggerBase& logger) {
+    Reader reader{record};
+    const auto header = reader.Read<RecordHeader>();
+    const auto file = reader.ReadBytes(header.file_size);
+    const auto function = reader.ReadBytes(header.function_size);
+    const auto location = utils::impl::SourceLocation::Custom(header.line, file, function);
+
+    auto formatter = logger.MakeFormatterAt(header.level, log_class, location, header.timestamp);
+    ReplayEntries(reader, *formatter);
+    logger.Log(header.level, formatter->ExtractLoggerItem());
+}
+
+void RenderDeferred(std::string_view record, Format format, std::string& out) {
+    Reader reader{record};
+    const auto header = reader.Read<RecordHeader>();
+    const auto file = reader.ReadBytes(header.file_size);
+    const auto function = reader.ReadBytes(header.function_size);
+    const auto location = utils::impl::SourceLocation::Custom(header.line, file, function);
+
+    switch (format) {
+        case Format::kTskv:
+        case Format::kLtsv:
+        case Format::kRaw: {
+            Tskv formatter{header.level, format, location, header.timestamp};
+            Replay(reader, formatter, out);
+            return;
+        }
+
+        case Format::kJson:
+        case Format::kJsonYaDeploy: {
+            Json formatter{header.level, format, location, header.timestamp};
+            Replay(reader, formatter, out);
+            return;
+        }
+
+        case Format::kStruct:
+        case Format::kBinary:
+            break;
+    }
+
+    UINVARIANT(false, "Deferred formatting is not supported for the log format");
+}
+
+}  // namespace logging::impl::formatters
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <userver/logging/format.hpp>
+#include <userver/logging/impl/formatters/base.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::formatters {
+
+/// @brief Captures the tags and the text of a record without formatting them.
+///
+/// The values are copied into a compact record as is, the record is converted
+/// into the logger format by RenderDeferred later, e.g. by the consumer task
+/// of an asynchronous logger. The record is only valid within the process.
+class Deferred final : public Base {
+public:
+    Deferred(Level level, const utils::impl::SourceLocation& location, std::chrono::system_clock::time_point timestamp);
+
+    void AddTag(std::string_view key, const LogExtra::Value& value) override;
+
+    void AddTag(std::string_view key, std::string_view value) override;
+
+    /// Appends to the text, may be called multiple times
+    void SetText(std::string_view text) override { AddText(text); }
+
+    LoggerItemRef ExtractLoggerItem() override { return item_; }
+
+    void AddText(std::string_view text);
+
+    /// @{
+    /// Appends a value to the text, it is formatted as `fmt::format("{}", value)`
+    void AddValue(bool value);
+    void AddValue(long long value);
+    void AddValue(unsigned long long value);
+    void AddValue(float value);
+    void AddValue(double value);
+    void AddValue(long double value);
+    /// @}
+
+    /// Estimated size of the formatted text
+    std::size_t GetTextSize() const noexcept { return text_size_; }
+
+private:
+    template <typename T>
+    void DoAddValue(T value);
+
+    TextLogItem item_;
+    std::size_t text_size_{0};
+    // Consecutive strings are merged into a single text part
+    std::size_t last_text_part_offset_{0};
+};
+
+/// Formats a record captured by Deferred in `format` and appends it to `out`
+void RenderDeferred(std::string_view record, Format format, std::string& out);
+
+/// Writes a record captured by Deferred to `logger` through its own formatter.
+/// The record keeps the timestamp it was captured at.
+void DispatchDeferred(std::string_view record, LogClass log_class, LoggerBase& logger);
+
+}  // namespace logging::impl::formatters
+
+USERVER_NAMESPACE_END
@@ -11,9 +11,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl::formatters {
 
-Json::Json(Level level, Format format, const utils::impl::SourceLocation& location) : format_(format) {
-    const auto now = std::chrono::system_clock::now();
-
+Json::Json(Level level, Format format, const utils::impl::SourceLocation& location)
+    : Json(level, format, location, std::chrono::system_clock::now()) {}
+
+Json::Json(
+    Level level,
+    Format format,
+    const utils::impl::SourceLocation& location,
+    std::chrono::system_clock::time_point now
+)
+    : format_(format) {
     object_.emplace(sb_);
 
     sb_.Key((format_ == Format::kJson) ? "timestamp" : "@timestamp");
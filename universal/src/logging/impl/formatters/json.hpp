@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/impl/formatters/base.hpp>
@@ -14,6 +16,13 @@ class Json final : public Base {
 public:
     explicit Json(Level level, Format format, const utils::impl::SourceLocation& source_location) noexcept(false);
 
+    Json(
+        Level level,
+        Format format,
+        const utils::impl::SourceLocation& source_location,
+        std::chrono::system_clock::time_point timestamp
+    );
+
     Json(const Json&) = delete;
 
     void AddTag(std::string_view key, const LogExtra::Value& value) override;
@@ -16,11 +16,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl::formatters {
 
-Tskv::Tskv(Level level, Format format, const utils::impl::SourceLocation& location) : format_(format) {
+Tskv::Tskv(Level level, Format format, const utils::impl::SourceLocation& location)
+    : Tskv(level, format, location, std::chrono::system_clock::now()) {}
+
+Tskv::Tskv(
+    Level level,
+    Format format,
+    const utils::impl::SourceLocation& location,
+    std::chrono::system_clock::time_point now
+)
+    : format_(format) {
     switch (format) {
         case Format::kTskv: {
             constexpr std::string_view kTemplate = "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
-            const auto now = std::chrono::system_clock::now();
             const auto level_string = logging::ToUpperCaseString(level);
             item_.log_line.resize(kTemplate.size() + level_string.size());
             fmt::format_to(
@@ -41,7 +49,6 @@ Tskv::Tskv(Level level, Format format, const utils::impl::SourceLocation& locati
         }
         case Format::kLtsv: {
             constexpr std::string_view kTemplate = "timestamp:0000-00-00T00:00:00.000000\tlevel:";
-            const auto now = TimePoint::clock::now();
             const auto level_string = logging::ToUpperCaseString(level);
             item_.log_line.resize(kTemplate.size() + level_string.size());
             fmt::format_to(
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <userver/logging/impl/formatters/base.hpp>
 
 #include <userver/logging/format.hpp>
@@ -14,6 +16,13 @@ class Tskv final : public Base {
 public:
     Tskv(Level level, Format format, const utils::impl::SourceLocation& source_location);
 
+    Tskv(
+        Level level,
+        Format format,
+        const utils::impl::SourceLocation& source_location,
+        std::chrono::system_clock::time_point timestamp
+    );
+
     void AddTag(std::string_view key, const LogExtra::Value& value) override;
 
     void AddTag(std::string_view key, std::string_view value) override;
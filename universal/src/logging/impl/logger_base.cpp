@@ -1,5 +1,7 @@
 #include <userver/logging/impl/logger_base.hpp>
 
+#include <logging/impl/formatters/binary.hpp>
+#include <logging/impl/formatters/deferred.hpp>
 #include <logging/impl/formatters/json.hpp>
 #include <logging/impl/formatters/tskv.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
@@ -22,21 +24,59 @@ void LoggerBase::SetFlushOn(Level level) { flush_level_ = level; }
 
 bool LoggerBase::ShouldFlush(Level level) const { return flush_level_ <= level; }
 
+formatters::BasePtr LoggerBase::MakeFormatterAt(
+    Level level,
+    LogClass log_class,
+    const utils::impl::SourceLocation& location,
+    std::chrono::system_clock::time_point /*timestamp*/
+) {
+    return MakeFormatter(level, log_class, location);
+}
+
 void LoggerBase::ForwardTo(LoggerBase*) {}
 
 bool LoggerBase::DoShouldLog(Level /*level*/) const noexcept { return true; }
 
-formatters::BasePtr TextLogger::MakeFormatter(Level level, LogClass, const utils::impl::SourceLocation& location) {
+TextLogger::TextLogger(Format format, bool deferred_formatting)
+    : format_(format),
+      binary_dictionary_(format == Format::kBinary ? std::make_unique<formatters::BinaryDictionary>() : nullptr) {
+    // Binary records are not formatted anyway
+    if (deferred_formatting && format != Format::kBinary) {
+        UINVARIANT(format != Format::kStruct, "Invalid logger type");
+        EnableDeferredFormatting();
+    }
+}
+
+TextLogger::~TextLogger() = default;
+
+formatters::BasePtr
+TextLogger::MakeFormatter(Level level, LogClass log_class, const utils::impl::SourceLocation& location) {
+    return MakeFormatterAt(level, log_class, location, std::chrono::system_clock::now());
+}
+
+formatters::BasePtr TextLogger::MakeFormatterAt(
+    Level level,
+    LogClass,
+    const utils::impl::SourceLocation& location,
+    std::chrono::system_clock::time_point timestamp
+) {
+    if (IsFormattingDeferred()) {
+        return std::make_unique<formatters::Deferred>(level, location, timestamp);
+    }
+
     auto format = GetFormat();
     switch (format) {
         case Format::kLtsv:
         case Format::kTskv:
         case Format::kRaw:
-            return std::make_unique<formatters::Tskv>(level, format, location);
+            return std::make_unique<formatters::Tskv>(level, format, location, timestamp);
 
         case Format::kJson:
         case Format::kJsonYaDeploy:
-            return std::make_unique<formatters::Json>(level, format, location);
+            return std::make_unique<formatters::Json>(level, format, location, timestamp);
+
+        case Format::kBinary:
+            return std::make_unique<formatters::Binary>(level, location, *binary_dictionary_, timestamp);
 
         case Format::kStruct:
             UINVARIANT(false, "Invalid logger type");
@@ -48,6 +88,17 @@ formatters::BasePtr TextLogger::MakeFormatter(Level level, LogClass, const utils
 
 Format TextLogger::GetFormat() const noexcept { return format_; }
 
+void TextLogger::StartNewBinaryStream() const noexcept {
+    if (binary_dictionary_) {
+        binary_dictionary_->StartNewStream();
+    }
+}
+
+void TextLogger::RenderDeferred(std::string_view record, std::string& out) const {
+    UASSERT(IsFormattingDeferred());
+    formatters::RenderDeferred(record, format_, out);
+}
+
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept {
     return logger.GetLevel() <= level && level != Level::kNone;
 }
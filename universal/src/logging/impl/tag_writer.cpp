@@ -43,6 +43,8 @@ void TagWriter::ExtendLogExtra(const LogExtra& extra) {
 
 void TagWriter::PutTag(RuntimeTagKey key, std::string_view value) { lh_.PutSwTag(key.GetUnescapedKey(), value); }
 
+bool TagWriter::PutSpan(const formatters::SpanRecord& span) { return lh_.PutSpan(span); }
+
 TagWriter::TagWriter(LogHelper& lh) noexcept : lh_(lh) {}
 
 }  // namespace logging::impl
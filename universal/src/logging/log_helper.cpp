@@ -279,33 +279,32 @@ LogHelper& LogHelper::PutSwTag(std::string_view key, std::string_view value) noe
     return *this;
 }
 
+bool LogHelper::PutSpan(const impl::formatters::SpanRecord& span) noexcept {
+    try {
+        return pimpl_->SetSpan(span);
+    } catch (...) {
+        InternalLoggingError("Failed to log span");
+    }
+    return false;
+}
+
 LogHelper& LogHelper::operator<<(const LogExtra::Value& value) noexcept {
     std::visit([this](const auto& unwrapped) { *this << unwrapped; }, value);
     return *this;
 }
 
-void LogHelper::PutFloatingPoint(float value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutFloatingPoint(double value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutFloatingPoint(long double value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutUnsigned(unsigned long long value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutSigned(long long value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutBoolean(bool value) {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{}"), value);
-}
+void LogHelper::PutFloatingPoint(float value) { pimpl_->AddValue(value); }
+void LogHelper::PutFloatingPoint(double value) { pimpl_->AddValue(value); }
+void LogHelper::PutFloatingPoint(long double value) { pimpl_->AddValue(value); }
+void LogHelper::PutUnsigned(unsigned long long value) { pimpl_->AddValue(value); }
+void LogHelper::PutSigned(long long value) { pimpl_->AddValue(value); }
+void LogHelper::PutBoolean(bool value) { pimpl_->AddValue(value); }
 
 LogHelper& LogHelper::operator<<(Hex hex) noexcept {
     try {
-        fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("0x{:016X}"), hex.value);
+        fmt::basic_memory_buffer<char, 32> buffer;
+        fmt::format_to(fmt::appender(buffer), FMT_COMPILE("0x{:016X}"), hex.value);
+        Put(std::string_view(buffer.data(), buffer.size()));
     } catch (...) {
         InternalLoggingError("Failed to extend log Hex");
     }
@@ -314,7 +313,9 @@ LogHelper& LogHelper::operator<<(Hex hex) noexcept {
 
 LogHelper& LogHelper::operator<<(HexShort hex) noexcept {
     try {
-        fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()), FMT_COMPILE("{:X}"), hex.value);
+        fmt::basic_memory_buffer<char, 32> buffer;
+        fmt::format_to(fmt::appender(buffer), FMT_COMPILE("{:X}"), hex.value);
+        Put(std::string_view(buffer.data(), buffer.size()));
     } catch (...) {
         InternalLoggingError("Failed to extend log HexShort");
     }
@@ -334,9 +335,7 @@ void LogHelper::Put(std::string_view value) { pimpl_->AddText(value); }
 
 void LogHelper::Put(char value) { pimpl_->AddText(std::string_view(&value, 1)); }
 
-void LogHelper::PutRaw(std::string_view value_needs_no_escaping) {
-    pimpl_->GetBufferForRawValuePart().append(value_needs_no_escaping);
-}
+void LogHelper::PutRaw(std::string_view value_needs_no_escaping) { pimpl_->AddText(value_needs_no_escaping); }
 
 void LogHelper::PutException(const std::exception& ex) {
     if (!impl::ShouldLogStacktrace()) {
@@ -4,6 +4,7 @@
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <logging/impl/formatters/deferred.hpp>
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
 #include <userver/logging/impl/logger_base.hpp>
@@ -22,18 +23,56 @@ LogHelper::Impl::Impl(
 ) noexcept
     : level_(std::max(level, logger.GetLevel())),
       logger_(logger),
-      formatter_(logger.MakeFormatter(level, log_class, location)) {}
+      formatter_(logger.MakeFormatter(level, log_class, location)) {
+    if (logger.IsFormattingDeferred()) {
+        UASSERT(dynamic_cast<impl::formatters::Deferred*>(formatter_.get()));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+        deferred_ = static_cast<impl::formatters::Deferred*>(formatter_.get());
+    }
+}
+
+void LogHelper::Impl::AddText(std::string_view text) {
+    if (deferred_) {
+        deferred_->AddText(text);
+        return;
+    }
+    msg_.append(text);
+}
+
+template <typename T>
+void LogHelper::Impl::DoAddValue(T value) {
+    if (deferred_) {
+        deferred_->AddValue(value);
+        return;
+    }
+    fmt::format_to(fmt::appender(msg_), FMT_COMPILE("{}"), value);
+}
+
+void LogHelper::Impl::AddValue(bool value) { DoAddValue(value); }
 
-void LogHelper::Impl::AddText(std::string_view text) { msg_.append(text); }
+void LogHelper::Impl::AddValue(long long value) { DoAddValue(value); }
 
-size_t LogHelper::Impl::GetTextSize() const { return msg_.size(); }
+void LogHelper::Impl::AddValue(unsigned long long value) { DoAddValue(value); }
+
+void LogHelper::Impl::AddValue(float value) { DoAddValue(value); }
+
+void LogHelper::Impl::AddValue(double value) { DoAddValue(value); }
+
+void LogHelper::Impl::AddValue(long double value) { DoAddValue(value); }
+
+size_t LogHelper::Impl::GetTextSize() const { return deferred_ ? deferred_->GetTextSize() : msg_.size(); }
 
 void LogHelper::Impl::AddTag(std::string_view key, const LogExtra::Value& value) { formatter_->AddTag(key, value); }
 
 void LogHelper::Impl::AddTag(std::string_view key, std::string_view value) { formatter_->AddTag(key, value); }
 
+bool LogHelper::Impl::SetSpan(const impl::formatters::SpanRecord& span) { return formatter_->SetSpan(span); }
+
 void LogHelper::Impl::Finish() {
-    formatter_->SetText(to_string(msg_));
+    // Deferred formatter has got the text already
+    if (!deferred_) {
+        formatter_->SetText(to_string(msg_));
+    }
 
     auto& log_item = formatter_->ExtractLoggerItem();
     logger_.Log(level_, log_item);
@@ -41,12 +80,13 @@ void LogHelper::Impl::Finish() {
 
 auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
     if (c == std::streambuf::traits_type::eof()) return c;
-    impl_.msg_.push_back(c);
+    const char ch = c;
+    impl_.AddText(std::string_view(&ch, 1));
     return c;
 }
 
 std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s, std::streamsize n) {
-    impl_.msg_.append(std::string_view(s, n));
+    impl_.AddText(std::string_view(s, n));
     return n;
 }
 
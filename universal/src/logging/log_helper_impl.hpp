@@ -15,6 +15,8 @@ USERVER_NAMESPACE_BEGIN
 namespace logging::impl::formatters {
 class Base;
 using BasePtr = std::unique_ptr<Base>;
+class Deferred;
+struct SpanRecord;
 }  // namespace logging::impl::formatters
 
 namespace logging {
@@ -35,19 +37,30 @@ public:
 
     void AddText(std::string_view text);
 
+    /// @{
+    /// Formats the value into the text, or captures it for the logger to
+    /// format it later if the logger IsFormattingDeferred()
+    void AddValue(bool value);
+    void AddValue(long long value);
+    void AddValue(unsigned long long value);
+    void AddValue(float value);
+    void AddValue(double value);
+    void AddValue(long double value);
+    /// @}
+
     size_t GetTextSize() const;
 
     void AddTag(std::string_view key, const LogExtra::Value& value);
 
     void AddTag(std::string_view key, std::string_view value);
 
+    bool SetSpan(const impl::formatters::SpanRecord& span);
+
     void Finish();
 
     void MarkAsBroken() {  // TODO
     }
 
-    LogBuffer& GetBufferForRawValuePart() noexcept { return msg_; }
-
     bool IsStreamInitialized() const noexcept { return !!lazy_stream_; }
 
     std::ostream& Stream() { return GetLazyInitedStream().ostr; }
@@ -74,6 +87,9 @@ private:
         explicit LazyInitedStream(Impl& impl) : sbuf{impl}, ostr(&sbuf) {}
     };
 
+    template <typename T>
+    void DoAddValue(T value);
+
     LazyInitedStream& GetLazyInitedStream() {
         if (!lazy_stream_) lazy_stream_.emplace(*this);
         return *lazy_stream_;
@@ -85,6 +101,8 @@ private:
     std::optional<std::unordered_set<std::string>> debug_tag_keys_;
     LoggerRef logger_;
     impl::formatters::BasePtr formatter_;
+    // Set if formatter_ captures the text instead of msg_
+    impl::formatters::Deferred* deferred_{nullptr};
 };
 
 }  // namespace logging